@@ -5,6 +5,7 @@
 #include "../src/hardware/LEDInterface.h"
 #include "../src/hardware/MPU9250Interface.h"
 #include "../src/detection/UltraBasicPositionDetector.h"
+#include "../src/core/CalibrationStore.h"
 #include "../src/core/SystemTypes.h"
 #include "../src/core/Config.h"
 
@@ -62,6 +63,9 @@ struct PositionSampleData {
 
 PositionSampleData positionData[6]; // One for each position
 
+// Profile the results are saved to ('1'-'4' to choose; the active one by default)
+uint8_t targetProfile = 0;
+
 // Function prototypes
 void updateLEDs();
 void collectSensorData();
@@ -96,6 +100,9 @@ void setup() {
     }
   }
   
+  // Hardware init loaded the stored calibration; detection mode starts from it
+  targetProfile = CalibrationStore::activeProfile();
+  
   // Initialize position detector
   Serial.println("Initializing UBPD...");
   if (detector->init(hardware)) {
@@ -120,6 +127,8 @@ void setup() {
   Serial.println("Enter command to begin:");
   Serial.println("  c - Start Calibration Routine");
   Serial.println("  d - Enter Detection Mode");
+  Serial.println("  1-4 - Choose the profile to save to");
+  Serial.printf("Saving to profile %u\n", targetProfile + 1);
   Serial.println("==================================\n");
 }
 
@@ -740,6 +749,21 @@ void calculateThresholds() {
   // Print Config.h format
   detector->printConfigFormat();
   
+  // Store the result in the chosen profile; the gauntlet firmware loads it at boot
+  CalibrationData calibration = CalibrationStore::data();
+  if (targetProfile >= calibration.profileCount) {
+    CalibrationStore::defaults(calibration.profiles[targetProfile], targetProfile);
+    calibration.profileCount = targetProfile + 1;
+  }
+  detector->captureProfile(calibration.profiles[targetProfile]);
+  calibration.scalingFactor = detector->getScalingFactor();
+  if (CalibrationStore::commit(calibration)) {
+    Serial.printf("\nSaved to profile %u \"%s\" (sequence %lu)\n", targetProfile + 1,
+                  calibration.profiles[targetProfile].name, (unsigned long)CalibrationStore::sequence());
+  } else {
+    Serial.println("\nFailed to save to the calibration store");
+  }
+  
   Serial.println("\n==================================");
   Serial.println("Calibration Complete!");
   Serial.println("Enter 'd' to test detection or 'c' to recalibrate");
@@ -792,6 +816,19 @@ void processSerialCommands() {
         Serial.println("Enter 'c' for Calibration or 'd' for Detection");
         Serial.println("==================================");
         break;
+        
+      case '1':
+      case '2':
+      case '3':
+      case '4':
+        // Choose the profile to save to; one past the last adds a profile
+        if (cmd - '1' <= CalibrationStore::profileCount() && cmd - '1' < CALIBRATION_MAX_PROFILES) {
+          targetProfile = cmd - '1';
+          Serial.printf("Saving to profile %u\n", targetProfile + 1);
+        } else {
+          Serial.printf("Profiles are added in order; the next is %u\n", CalibrationStore::profileCount() + 1);
+        }
+        break;
     }
     
     // Consume any remaining characters
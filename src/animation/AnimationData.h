@@ -3,12 +3,13 @@
 
 #include <Arduino.h>
 #include "../core/SystemTypes.h"
+#include "../core/Config.h"
 
 /**
  * @brief Single frame of LED animation data
  */
 struct AnimationFrame {
-  uint8_t ledValues[12][3];  // RGB values for each LED
+  uint8_t ledValues[Config::NUM_LEDS][3];  // RGB values for each LED
   uint8_t duration;          // Frame duration in 10ms units
 };
 
@@ -46,107 +47,9 @@ namespace AnimColors {
   const PROGMEM uint8_t SCAN_BEAM[3] = {255, 255, 255};   // White beam
 }
 
-// Transition animations stored in program memory
-
-// Transition to Invocation (purple flash)
-const PROGMEM AnimationFrame invocationTransition[] = {
-  // Frame 1: All LEDs purple (50% brightness)
-  {
-    {{64, 0, 64}, {64, 0, 64}, {64, 0, 64}, {64, 0, 64},
-     {64, 0, 64}, {64, 0, 64}, {64, 0, 64}, {64, 0, 64},
-     {64, 0, 64}, {64, 0, 64}, {64, 0, 64}, {64, 0, 64}}, 
-    5  // 50ms duration
-  },
-  // Frame 2: All LEDs purple (100% brightness)
-  {
-    {{128, 0, 128}, {128, 0, 128}, {128, 0, 128}, {128, 0, 128},
-     {128, 0, 128}, {128, 0, 128}, {128, 0, 128}, {128, 0, 128},
-     {128, 0, 128}, {128, 0, 128}, {128, 0, 128}, {128, 0, 128}}, 
-    10 // 100ms duration
-  },
-  // Frame 3: All LEDs off
-  {
-    {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
-     {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
-     {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}}, 
-    5  // 50ms duration
-  }
-};
-
-// Transition to Freecast (shield blue flash)
-const PROGMEM AnimationFrame freecastTransition[] = {
-  // Frame 1: All LEDs shield blue (50% brightness)
-  {
-    {{Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2}, 
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2}, 
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2}, 
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2},
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2}, 
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2}, 
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2}, 
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2},
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2}, 
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2}, 
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2}, 
-     {Config::Colors::SHIELD_COLOR[0]/2, Config::Colors::SHIELD_COLOR[1]/2, Config::Colors::SHIELD_COLOR[2]/2}}, 
-    5  // 50ms duration
-  },
-  // Frame 2: All LEDs shield blue (100% brightness)
-  {
-    {{Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]}, 
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]}, 
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]}, 
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]},
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]}, 
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]}, 
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]}, 
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]},
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]}, 
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]}, 
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]}, 
-     {Config::Colors::SHIELD_COLOR[0], Config::Colors::SHIELD_COLOR[1], Config::Colors::SHIELD_COLOR[2]}}, 
-    10 // 100ms duration
-  },
-  // Frame 3: All LEDs off
-  {
-    {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
-     {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
-     {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}}, 
-    5  // 50ms duration
-  }
-};
-
-// Checkpoint flash animation (camera flash effect)
-const PROGMEM AnimationFrame checkpointFlash[] = {
-  // Frame 1: All LEDs white (25% brightness)
-  {
-    {{64, 64, 64}, {64, 64, 64}, {64, 64, 64}, {64, 64, 64},
-     {64, 64, 64}, {64, 64, 64}, {64, 64, 64}, {64, 64, 64},
-     {64, 64, 64}, {64, 64, 64}, {64, 64, 64}, {64, 64, 64}}, 
-    2  // 20ms duration
-  },
-  // Frame 2: All LEDs white (100% brightness)
-  {
-    {{255, 255, 255}, {255, 255, 255}, {255, 255, 255}, {255, 255, 255},
-     {255, 255, 255}, {255, 255, 255}, {255, 255, 255}, {255, 255, 255},
-     {255, 255, 255}, {255, 255, 255}, {255, 255, 255}, {255, 255, 255}}, 
-    10 // 100ms duration
-  },
-  // Frame 3: All LEDs white (25% brightness)
-  {
-    {{64, 64, 64}, {64, 64, 64}, {64, 64, 64}, {64, 64, 64},
-     {64, 64, 64}, {64, 64, 64}, {64, 64, 64}, {64, 64, 64},
-     {64, 64, 64}, {64, 64, 64}, {64, 64, 64}, {64, 64, 64}}, 
-    5  // 50ms duration
-  },
-  // Frame 4: All LEDs off
-  {
-    {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
-     {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0},
-     {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}}, 
-    3  // 30ms duration
-  }
-};
+// Transition animations (invocation, freecast, checkpoint flash) are keyframe
+// programs compiled from src/animation/scripts/*.anim into AnimationPrograms.h
+// and played by AnimationPlayer.
 
 // Helper function to read colors from PROGMEM
 inline void readColorFromProgmem(const uint8_t* colorPtr, Color& color) {
@@ -0,0 +1,289 @@
+#include "AnimationPlayer.h"
+#include "ColorEngine.h"
+
+namespace {
+
+inline uint16_t read16(const uint8_t* p) {
+  return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+
+inline uint8_t lerp8(uint8_t a, uint8_t b, uint8_t amount) {
+  return (uint8_t)(a + ((int16_t)(b - a) * amount) / 255);
+}
+
+// Key field offsets
+constexpr uint8_t KEY_TIME = 0;
+constexpr uint8_t KEY_SOURCE = 2;
+constexpr uint8_t KEY_DATA = 3;
+constexpr uint8_t KEY_VALUE = 6;
+constexpr uint8_t KEY_EASE = 7;
+
+// sin(x * pi/2) for x = 0-255, interpolated from the quarter wave of sine8
+uint8_t sineOut(uint8_t x) {
+  if (x == 255) {
+    return 255;
+  }
+  uint8_t idx = x >> 2;
+  uint8_t frac = x & 0x03;
+  uint16_t s = (uint16_t)ColorEngine::sine8(idx) * (4 - frac) + (uint16_t)ColorEngine::sine8(idx + 1) * frac;
+  int16_t centred = (int16_t)(s / 4) - 128;
+  if (centred < 0) {
+    centred = 0;
+  }
+  return (uint8_t)((centred * 255) / 127);
+}
+
+} // namespace
+
+uint8_t AnimBytecode::applyEase(uint8_t ease, uint8_t x) {
+  switch (ease) {
+    case EASE_STEP:
+      return 0;
+    case EASE_IN:
+      return (uint8_t)(((uint16_t)x * x) / 255);
+    case EASE_OUT: {
+      uint8_t inv = 255 - x;
+      return 255 - (uint8_t)(((uint16_t)inv * inv) / 255);
+    }
+    case EASE_IN_OUT:
+      // x^2 * (3 - 2x) scaled to 0-255
+      return (uint8_t)(((uint32_t)x * x * (765 - 2 * (uint32_t)x)) / 65025UL);
+    case EASE_SINE_IN:
+      return 255 - sineOut(255 - x);
+    case EASE_SINE_OUT:
+      return sineOut(x);
+    case EASE_LINEAR:
+    default:
+      return x;
+  }
+}
+
+AnimationPlayer::AnimationPlayer()
+    : program_(nullptr),
+      length_(0),
+      duration_(0),
+      flags_(0),
+      trackCount_(0),
+      startTime_(0),
+      playing_(false) {
+  for (uint8_t i = 0; i < MAX_PARAMS; i++) {
+    params_[i] = {255, 255, 255};
+  }
+}
+
+bool AnimationPlayer::validate(const uint8_t* program, uint16_t length) {
+  using namespace AnimBytecode;
+
+  if (!program || length < HEADER_SIZE + 1) {
+    return false;
+  }
+  if (program[0] != MAGIC_0 || program[1] != MAGIC_1 || program[2] != VERSION) {
+    return false;
+  }
+
+  const uint8_t trackCount = program[8];
+  const uint8_t* p = program + HEADER_SIZE;
+  const uint8_t* end = program + length;
+
+  for (uint8_t t = 0; t < trackCount; t++) {
+    if (p + TRACK_SIZE > end || p[0] != OP_TRACK) {
+      return false;
+    }
+    const uint8_t keyCount = p[13];
+    if (keyCount == 0 || read16(p + 3) == 0) {
+      return false;
+    }
+    const uint8_t* key = p + TRACK_SIZE;
+    if (key + (uint16_t)keyCount * KEY_SIZE > end) {
+      return false;
+    }
+
+    uint16_t lastTime = 0;
+    for (uint8_t k = 0; k < keyCount; k++, key += KEY_SIZE) {
+      uint16_t time = read16(key + KEY_TIME);
+      if (time < lastTime || key[KEY_SOURCE] > SRC_PARAM || key[KEY_EASE] >= EASE_COUNT) {
+        return false;
+      }
+      if (key[KEY_SOURCE] == SRC_PARAM && key[KEY_DATA] >= MAX_PARAMS) {
+        return false;
+      }
+      lastTime = time;
+    }
+    p = key;
+  }
+
+  return p < end && *p == OP_END;
+}
+
+bool AnimationPlayer::load(const uint8_t* program, uint16_t length) {
+  playing_ = false;
+  if (!validate(program, length)) {
+    program_ = nullptr;
+    return false;
+  }
+
+  program_ = program;
+  length_ = length;
+  flags_ = program[3];
+  duration_ = read16(program + 6);
+  trackCount_ = program[8];
+  return true;
+}
+
+void AnimationPlayer::start(uint32_t nowMs) {
+  startTime_ = nowMs;
+  playing_ = (program_ != nullptr);
+}
+
+void AnimationPlayer::stop() {
+  playing_ = false;
+}
+
+void AnimationPlayer::setParam(uint8_t slot, const Color& color) {
+  if (slot < MAX_PARAMS) {
+    params_[slot] = color;
+  }
+}
+
+bool AnimationPlayer::render(uint32_t nowMs, Color* frame, uint16_t ledCount) {
+  if (!playing_) {
+    return false;
+  }
+  if (!evaluate(nowMs - startTime_, frame, ledCount)) {
+    playing_ = false;
+  }
+  return playing_;
+}
+
+bool AnimationPlayer::evaluate(uint32_t elapsedMs, Color* frame, uint16_t ledCount, uint8_t* coverage) const {
+  if (!program_) {
+    return false;
+  }
+
+  bool running = true;
+  uint32_t t = elapsedMs;
+  if (duration_ == 0) {
+    t = 0;
+    running = false;
+  } else if (flags_ & AnimBytecode::FLAG_LOOP) {
+    t = elapsedMs % duration_;
+  } else if (elapsedMs >= duration_) {
+    // Hold the final frame once the program is over
+    t = duration_ - 1;
+    running = false;
+  }
+
+  const uint8_t* p = program_ + AnimBytecode::HEADER_SIZE;
+  for (uint8_t i = 0; i < trackCount_; i++) {
+    renderTrack(p, t, frame, ledCount, coverage);
+    p += AnimBytecode::TRACK_SIZE + (uint16_t)p[13] * AnimBytecode::KEY_SIZE;
+  }
+
+  return running;
+}
+
+void AnimationPlayer::renderTrack(const uint8_t* track, uint32_t t, Color* frame, uint16_t ledCount,
+                                  uint8_t* coverage) const {
+  using namespace AnimBytecode;
+
+  const uint16_t first = read16(track + 1);
+  const uint16_t count = read16(track + 3);
+  const uint8_t stride = track[5] ? track[5] : 1;
+  const uint8_t spread = track[6];
+  const uint16_t start = read16(track + 7);
+  const uint16_t end = read16(track + 9);
+  const uint16_t loop = read16(track + 11);
+  const uint8_t keyCount = track[13];
+  const uint8_t* keys = track + TRACK_SIZE;
+
+  if (t < start || (end != END_OF_PROGRAM && t >= end)) {
+    return;
+  }
+
+  uint32_t local = t - start;
+  if (loop > 0) {
+    local %= loop;
+  }
+
+  // Find the segment [a, b) containing local; b is null past the last key
+  const uint8_t* a = keys;
+  const uint8_t* b = nullptr;
+  for (uint8_t k = 1; k < keyCount; k++) {
+    const uint8_t* key = keys + (uint16_t)k * KEY_SIZE;
+    if (read16(key + KEY_TIME) <= local) {
+      a = key;
+    } else {
+      b = key;
+      break;
+    }
+  }
+
+  const uint16_t timeA = read16(a + KEY_TIME);
+  uint8_t x = 0;
+  if (local < timeA) {
+    b = nullptr;  // Before the first key: hold it
+  } else if (b) {
+    uint16_t span = read16(b + KEY_TIME) - timeA;
+    x = span ? (uint8_t)(((local - timeA) * 255UL) / span) : 0;
+  }
+
+  const uint8_t ease = a[KEY_EASE];
+  const uint8_t e = applyEase(ease, x);
+  const uint8_t xHue = (ease == EASE_STEP) ? 0 : x;
+  const bool hueBlend = b && a[KEY_SOURCE] == SRC_HUE && b[KEY_SOURCE] == SRC_HUE;
+  const bool perLed = spread != 0 && (a[KEY_SOURCE] == SRC_HUE || (b && b[KEY_SOURCE] == SRC_HUE));
+
+  // Resolve a key to RGB at full value for the given hue offset
+  auto resolve = [this](const uint8_t* key, uint8_t hueOffset) -> Color {
+    switch (key[KEY_SOURCE]) {
+      case SRC_HUE:
+        return ColorEngine::hsv(key[KEY_DATA] + hueOffset, key[KEY_DATA + 1], 255);
+      case SRC_PARAM:
+        return params_[key[KEY_DATA]];
+      case SRC_RGB:
+      default:
+        return {key[KEY_DATA], key[KEY_DATA + 1], key[KEY_DATA + 2]};
+    }
+  };
+
+  auto colorAt = [&](uint8_t hueOffset) -> Color {
+    if (hueBlend) {
+      uint8_t hue = a[KEY_DATA] + (uint8_t)(((uint16_t)(uint8_t)(b[KEY_DATA] - a[KEY_DATA]) * xHue) / 255);
+      uint8_t sat = lerp8(a[KEY_DATA + 1], b[KEY_DATA + 1], e);
+      uint8_t val = lerp8(a[KEY_VALUE], b[KEY_VALUE], e);
+      return ColorEngine::hsv(hue + hueOffset, sat, val);
+    }
+
+    Color colA = resolve(a, hueOffset);
+    if (!b) {
+      return ColorEngine::scale(colA, a[KEY_VALUE]);
+    }
+
+    Color colB = resolve(b, hueOffset);
+    bool same = colA.r == colB.r && colA.g == colB.g && colA.b == colB.b;
+    Color rgb = same ? colA : ColorEngine::blend(colA, colB, e);
+    return ColorEngine::scale(rgb, lerp8(a[KEY_VALUE], b[KEY_VALUE], e));
+  };
+
+  if (!perLed) {
+    const Color c = colorAt(0);
+    uint32_t led = first;
+    for (uint16_t k = 0; k < count && led < ledCount; k++, led += stride) {
+      frame[led] = c;
+      if (coverage) {
+        coverage[led] = 255;
+      }
+    }
+    return;
+  }
+
+  uint32_t led = first;
+  for (uint16_t k = 0; k < count && led < ledCount; k++, led += stride) {
+    // Rounded hue offset of this LED within the selection
+    uint8_t offset = (uint8_t)(((uint32_t)k * 256 * spread + count / 2) / count);
+    frame[led] = colorAt(offset);
+    if (coverage) {
+      coverage[led] = 255;
+    }
+  }
+}
@@ -0,0 +1,164 @@
+#ifndef ANIMATION_PLAYER_H
+#define ANIMATION_PLAYER_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+
+/**
+ * @brief Keyframe animation bytecode format
+ *
+ * Programs are compiled on the host from `.anim` text files by
+ * `utils/anim_compiler.py` and stored in flash (see AnimationPrograms.h).
+ * All multi-byte fields are little-endian.
+ *
+ * Header (10 bytes):
+ *   'K' 'F' version flags ledCount:u16 duration:u16 trackCount reserved
+ *
+ * Each track (14 bytes + keys):
+ *   OP_TRACK first:u16 count:u16 stride spread start:u16 end:u16 loop:u16 keyCount
+ *   - LEDs first, first+stride, ... (count of them) are driven by the track
+ *   - spread = hue revolutions across the selection (0 = same hue on every LED)
+ *   - the track is active for start <= t < end (END_OF_PROGRAM = until the end)
+ *   - loop > 0 repeats the key timeline every loop ms while active
+ *
+ * Each key (8 bytes), times relative to the track start:
+ *   time:u16 source data0 data1 data2 value ease
+ *   - SRC_RGB:   data = r, g, b
+ *   - SRC_HUE:   data = hue, saturation, unused
+ *   - SRC_PARAM: data = parameter slot, unused, unused
+ *   - value scales the color (255 = unchanged)
+ *   - ease shapes the transition from this key to the next one
+ *
+ * The program ends with OP_END. Tracks are drawn in order, so later tracks
+ * overwrite earlier ones where they overlap.
+ */
+namespace AnimBytecode {
+  constexpr uint8_t MAGIC_0 = 'K';
+  constexpr uint8_t MAGIC_1 = 'F';
+  constexpr uint8_t VERSION = 1;
+
+  constexpr uint8_t HEADER_SIZE = 10;
+  constexpr uint8_t TRACK_SIZE = 14;
+  constexpr uint8_t KEY_SIZE = 8;
+
+  // Opcodes
+  constexpr uint8_t OP_END = 0x00;
+  constexpr uint8_t OP_TRACK = 0x54;  // 'T'
+
+  // Program flags
+  constexpr uint8_t FLAG_LOOP = 0x01;   // Restart from 0 when the duration is reached
+
+  // Track end marker
+  constexpr uint16_t END_OF_PROGRAM = 0xFFFF;
+
+  // Key color sources
+  enum Source : uint8_t {
+    SRC_RGB = 0,
+    SRC_HUE = 1,
+    SRC_PARAM = 2
+  };
+
+  // Easing curves
+  enum Ease : uint8_t {
+    EASE_LINEAR = 0,
+    EASE_STEP = 1,      // Hold this key until the next one
+    EASE_IN = 2,        // Quadratic
+    EASE_OUT = 3,       // Quadratic
+    EASE_IN_OUT = 4,    // Smoothstep
+    EASE_SINE_IN = 5,   // 1 - cos(x * pi/2)
+    EASE_SINE_OUT = 6,  // sin(x * pi/2)
+    EASE_COUNT
+  };
+
+  /**
+   * @brief Apply an easing curve to an 8-bit fraction
+   * @param ease Curve to apply
+   * @param x Linear progress 0-255
+   * @return Eased progress 0-255
+   */
+  uint8_t applyEase(uint8_t ease, uint8_t x);
+}
+
+/**
+ * @brief Heap-free interpreter for keyframe animation programs
+ *
+ * A player references a program in flash, remembers when it was started
+ * and evaluates a full frame for any point in time. Evaluation walks the
+ * program once per frame and does not keep per-frame state, so seeking
+ * and restarting are free.
+ */
+class AnimationPlayer {
+public:
+  static constexpr uint8_t MAX_PARAMS = 4;
+
+  AnimationPlayer();
+
+  /**
+   * @brief Validate and attach a program
+   * @param program Pointer to the compiled program (flash resident)
+   * @param length Size of the program in bytes
+   * @return True if the program is well formed
+   */
+  bool load(const uint8_t* program, uint16_t length);
+
+  /**
+   * @brief Start (or restart) playback
+   * @param nowMs Current time in milliseconds
+   */
+  void start(uint32_t nowMs);
+
+  /**
+   * @brief Stop playback; render() returns false until restarted
+   */
+  void stop();
+
+  /**
+   * @brief Set a color parameter slot referenced by SRC_PARAM keys
+   * @param slot Slot index (0 to MAX_PARAMS-1)
+   * @param color Color to use
+   */
+  void setParam(uint8_t slot, const Color& color);
+
+  /**
+   * @brief Render the frame for the current time
+   * @param nowMs Current time in milliseconds
+   * @param frame Output buffer
+   * @param ledCount Number of LEDs in the output buffer
+   * @return True while the animation is still running
+   */
+  bool render(uint32_t nowMs, Color* frame, uint16_t ledCount);
+
+  /**
+   * @brief Evaluate the loaded program at a given offset from its start
+   * @param elapsedMs Time since the program started
+   * @param frame Output buffer (LEDs not driven by any track are left untouched)
+   * @param ledCount Number of LEDs in the output buffer
+   * @param coverage Optional ledCount entries; set to 255 for every LED a track drove
+   * @return True if elapsedMs is within the program (always true when looping)
+   */
+  bool evaluate(uint32_t elapsedMs, Color* frame, uint16_t ledCount, uint8_t* coverage = nullptr) const;
+
+  bool isLoaded() const { return program_ != nullptr; }
+  bool isPlaying() const { return playing_; }
+  uint16_t getDuration() const { return duration_; }
+
+  /**
+   * @brief Check a program for structural errors without loading it
+   * @return True if the header, every track and every key are in bounds
+   */
+  static bool validate(const uint8_t* program, uint16_t length);
+
+private:
+  const uint8_t* program_;
+  uint16_t length_;
+  uint16_t duration_;
+  uint8_t flags_;
+  uint8_t trackCount_;
+  uint32_t startTime_;
+  bool playing_;
+  Color params_[MAX_PARAMS];
+
+  void renderTrack(const uint8_t* track, uint32_t t, Color* frame, uint16_t ledCount, uint8_t* coverage) const;
+};
+
+#endif // ANIMATION_PLAYER_H
@@ -0,0 +1,91 @@
+#ifndef ANIMATION_PROGRAMS_H
+#define ANIMATION_PROGRAMS_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Compiled keyframe animation programs
+ *
+ * GENERATED by utils/anim_compiler.py - do not edit by hand.
+ * Sources: cancel_flash.anim, checkpoint_flash.anim, freecast_transition.anim, invocation_transition.anim, lumina.anim, rainbow_burst.anim
+ */
+
+// cancel_flash: 1 tracks, 300 ms, 41 bytes
+const PROGMEM uint8_t ANIM_CANCEL_FLASH[] = {
+  0x4B, 0x46, 0x01, 0x00, 0x0C, 0x00, 0x2C, 0x01, 0x01, 0x00, 0x54, 0x00, 0x00, 0x0C, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0xFF, 0xFF, 0x64, 0x00, 0x02, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x01,
+  0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00,
+};
+constexpr uint16_t ANIM_CANCEL_FLASH_SIZE = sizeof(ANIM_CANCEL_FLASH);
+
+// checkpoint_flash: 1 tracks, 200 ms, 57 bytes
+const PROGMEM uint8_t ANIM_CHECKPOINT_FLASH[] = {
+  0x4B, 0x46, 0x01, 0x00, 0x0C, 0x00, 0xC8, 0x00, 0x01, 0x00, 0x54, 0x00, 0x00, 0x0C, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x40, 0x01,
+  0x14, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x78, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x40, 0x01,
+  0xAA, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00,
+};
+constexpr uint16_t ANIM_CHECKPOINT_FLASH_SIZE = sizeof(ANIM_CHECKPOINT_FLASH);
+
+// freecast_transition: 1 tracks, 200 ms, 49 bytes
+const PROGMEM uint8_t ANIM_FREECAST_TRANSITION[] = {
+  0x4B, 0x46, 0x01, 0x00, 0x0C, 0x00, 0xC8, 0x00, 0x01, 0x00, 0x54, 0x00, 0x00, 0x0C, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0xFF, 0x69, 0xB4, 0x80, 0x01,
+  0x32, 0x00, 0x00, 0xFF, 0x69, 0xB4, 0xFF, 0x01, 0x96, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00,
+  0x00,
+};
+constexpr uint16_t ANIM_FREECAST_TRANSITION_SIZE = sizeof(ANIM_FREECAST_TRANSITION);
+
+// invocation_transition: 1 tracks, 200 ms, 49 bytes
+const PROGMEM uint8_t ANIM_INVOCATION_TRANSITION[] = {
+  0x4B, 0x46, 0x01, 0x00, 0x0C, 0x00, 0xC8, 0x00, 0x01, 0x00, 0x54, 0x00, 0x00, 0x0C, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x03, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x80, 0x01,
+  0x32, 0x00, 0x02, 0x00, 0x00, 0x00, 0xFF, 0x01, 0x96, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00,
+  0x00,
+};
+constexpr uint16_t ANIM_INVOCATION_TRANSITION_SIZE = sizeof(ANIM_INVOCATION_TRANSITION);
+
+// lumina: 2 tracks, 60000 ms, 63 bytes
+const PROGMEM uint8_t ANIM_LUMINA[] = {
+  0x4B, 0x46, 0x01, 0x00, 0x0C, 0x00, 0x60, 0xEA, 0x02, 0x00, 0x54, 0x00, 0x00, 0x0C, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00,
+  0x54, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x02, 0x00, 0x00,
+  0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x60, 0xEA, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
+};
+constexpr uint16_t ANIM_LUMINA_SIZE = sizeof(ANIM_LUMINA);
+
+// rainbow_burst: 11 tracks, 8000 ms, 453 bytes
+const PROGMEM uint8_t ANIM_RAINBOW_BURST[] = {
+  0x4B, 0x46, 0x01, 0x00, 0x0C, 0x00, 0x40, 0x1F, 0x0B, 0x00, 0x54, 0x00, 0x00, 0x0C, 0x00, 0x01,
+  0x01, 0x00, 0x00, 0xD0, 0x07, 0xE8, 0x03, 0x05, 0x00, 0x00, 0x01, 0x00, 0xFF, 0x00, 0x99, 0x06,
+  0xFA, 0x00, 0x01, 0x40, 0xFF, 0x00, 0xFF, 0x05, 0xF4, 0x01, 0x01, 0x80, 0xFF, 0x00, 0x99, 0x06,
+  0xEE, 0x02, 0x01, 0xC0, 0xFF, 0x00, 0x33, 0x05, 0xE8, 0x03, 0x01, 0x00, 0xFF, 0x00, 0x99, 0x00,
+  0x54, 0x00, 0x00, 0x0C, 0x00, 0x01, 0x01, 0xD0, 0x07, 0xA0, 0x0F, 0xF4, 0x01, 0x05, 0x00, 0x00,
+  0x01, 0x00, 0xFF, 0x00, 0x99, 0x06, 0x7D, 0x00, 0x01, 0x40, 0xFF, 0x00, 0xFF, 0x05, 0xFA, 0x00,
+  0x01, 0x80, 0xFF, 0x00, 0x99, 0x06, 0x77, 0x01, 0x01, 0xC0, 0xFF, 0x00, 0x33, 0x05, 0xF4, 0x01,
+  0x01, 0x00, 0xFF, 0x00, 0x99, 0x00, 0x54, 0x00, 0x00, 0x0C, 0x00, 0x01, 0x01, 0xA0, 0x0F, 0x70,
+  0x17, 0xFA, 0x00, 0x05, 0x00, 0x00, 0x01, 0x00, 0xFF, 0x00, 0x99, 0x06, 0x3E, 0x00, 0x01, 0x40,
+  0xFF, 0x00, 0xFF, 0x05, 0x7D, 0x00, 0x01, 0x80, 0xFF, 0x00, 0x99, 0x06, 0xBB, 0x00, 0x01, 0xC0,
+  0xFF, 0x00, 0x33, 0x05, 0xFA, 0x00, 0x01, 0x00, 0xFF, 0x00, 0x99, 0x00, 0x54, 0x00, 0x00, 0x06,
+  0x00, 0x02, 0x00, 0x70, 0x17, 0xFF, 0xFF, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x99, 0x99, 0x99,
+  0xFF, 0x00, 0xD0, 0x07, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x54, 0x01, 0x00, 0x01, 0x00, 0x01,
+  0x00, 0x70, 0x17, 0xFF, 0xFF, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x99, 0x99, 0x99, 0xFF, 0x01,
+  0x2C, 0x01, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x01, 0x26, 0x02, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00,
+  0x54, 0x07, 0x00, 0x01, 0x00, 0x01, 0x00, 0x70, 0x17, 0xFF, 0xFF, 0x00, 0x00, 0x03, 0x00, 0x00,
+  0x00, 0x99, 0x99, 0x99, 0xFF, 0x01, 0x58, 0x02, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0x01, 0x52, 0x03,
+  0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x54, 0x03, 0x00, 0x01, 0x00, 0x01, 0x00, 0x70, 0x17, 0xFF,
+  0xFF, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x99, 0x99, 0x99, 0xFF, 0x01, 0x84, 0x03, 0x00, 0x00,
+  0xFF, 0x00, 0xFF, 0x01, 0x7E, 0x04, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x54, 0x09, 0x00, 0x01,
+  0x00, 0x01, 0x00, 0x70, 0x17, 0xFF, 0xFF, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x99, 0x99, 0x99,
+  0xFF, 0x01, 0xB0, 0x04, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x01, 0xAA, 0x05, 0x00, 0x00, 0x00, 0x00,
+  0xFF, 0x00, 0x54, 0x05, 0x00, 0x01, 0x00, 0x01, 0x00, 0x70, 0x17, 0xFF, 0xFF, 0x00, 0x00, 0x03,
+  0x00, 0x00, 0x00, 0x99, 0x99, 0x99, 0xFF, 0x01, 0xDC, 0x05, 0x00, 0x80, 0x00, 0xFF, 0xFF, 0x01,
+  0xD6, 0x06, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x54, 0x0B, 0x00, 0x01, 0x00, 0x01, 0x00, 0x70,
+  0x17, 0xFF, 0xFF, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x99, 0x99, 0x99, 0xFF, 0x01, 0x08, 0x07,
+  0x00, 0xFF, 0x69, 0xB4, 0xFF, 0x01, 0x02, 0x08, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x54, 0x00,
+  0x00, 0x0C, 0x00, 0x01, 0x00, 0x70, 0x17, 0xA2, 0x17, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x99,
+  0x99, 0x99, 0xFF, 0x00, 0x00,
+};
+constexpr uint16_t ANIM_RAINBOW_BURST_SIZE = sizeof(ANIM_RAINBOW_BURST);
+
+#endif // ANIMATION_PROGRAMS_H
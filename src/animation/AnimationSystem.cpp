@@ -0,0 +1,264 @@
+#include "AnimationSystem.h"
+#include <string.h>
+
+AnimationRequest AnimationRequest::fromProgram(const uint8_t* program, uint16_t length,
+                                               LEDLayer layer, uint8_t priority) {
+  AnimationRequest request = {program, length, nullptr, nullptr, layer, priority, 0, false, nullptr, nullptr};
+  return request;
+}
+
+AnimationRequest AnimationRequest::fromCallback(AnimationRenderFn render, void* context,
+                                                LEDLayer layer, uint8_t priority) {
+  AnimationRequest request = {nullptr, 0, render, context, layer, priority, 0, false, nullptr, nullptr};
+  return request;
+}
+
+AnimationSystem::AnimationSystem()
+    : compositor_(nullptr),
+      activeCount_(0),
+      drawnLayers_(0) {
+  for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+    slots_[i].active = false;
+    slots_[i].generation = 0;
+  }
+}
+
+bool AnimationSystem::init(LEDCompositor* compositor) {
+  compositor_ = compositor;
+  for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+    slots_[i].active = false;
+  }
+  activeCount_ = 0;
+  drawnLayers_ = 0;
+  return compositor_ != nullptr;
+}
+
+AnimationHandle AnimationSystem::start(const AnimationRequest& request, uint32_t nowMs) {
+  if (!compositor_ || request.layer >= LEDLayer::COUNT) {
+    return 0;
+  }
+  if (request.program ? !AnimationPlayer::validate(request.program, request.programLength) : !request.render) {
+    return 0;
+  }
+
+  int8_t index = freeSlot();
+  if (index < 0) {
+    // Full: evict the lowest priority across all layers, if it is lower
+    uint8_t victim = order_[0];
+    for (uint8_t k = 1; k < activeCount_; k++) {
+      if (slots_[order_[k]].priority < slots_[victim].priority) {
+        victim = order_[k];
+      }
+    }
+    if (slots_[victim].priority >= request.priority) {
+      return 0;
+    }
+    end(victim, AnimationEnd::PREEMPTED);
+    // The victim's callback may have started something in its place
+    index = freeSlot();
+    if (index < 0) {
+      return 0;
+    }
+  }
+
+  Slot& slot = slots_[index];
+  slot.player.load(request.program, request.programLength);
+  slot.render = request.render;
+  slot.renderContext = request.renderContext;
+  slot.onDone = request.onDone;
+  slot.doneContext = request.doneContext;
+  slot.startMs = nowMs;
+  slot.durationMs = request.durationMs;
+  slot.layer = request.layer;
+  slot.priority = request.priority;
+  slot.loop = request.loop;
+  slot.active = true;
+  slot.generation++;
+  insertOrdered(index);
+  return handleFor(index);
+}
+
+bool AnimationSystem::stop(AnimationHandle handle) {
+  int8_t index = findSlot(handle);
+  if (index < 0) {
+    return false;
+  }
+  end(index, AnimationEnd::STOPPED);
+  return true;
+}
+
+bool AnimationSystem::cancel(AnimationHandle handle) {
+  int8_t index = findSlot(handle);
+  if (index < 0) {
+    return false;
+  }
+  end(index, AnimationEnd::CANCELLED);
+  return true;
+}
+
+void AnimationSystem::cancelLayer(LEDLayer layer, uint8_t maxPriority) {
+  // Collect first: callbacks may start or end other animations
+  AnimationHandle matches[SLOT_COUNT];
+  uint8_t count = 0;
+  for (uint8_t k = 0; k < activeCount_; k++) {
+    const Slot& slot = slots_[order_[k]];
+    if (slot.layer == layer && slot.priority <= maxPriority) {
+      matches[count++] = handleFor(order_[k]);
+    }
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    cancel(matches[i]);
+  }
+}
+
+void AnimationSystem::cancelAll() {
+  AnimationHandle matches[SLOT_COUNT];
+  uint8_t count = activeCount_;
+  for (uint8_t k = 0; k < count; k++) {
+    matches[k] = handleFor(order_[k]);
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    cancel(matches[i]);
+  }
+}
+
+bool AnimationSystem::isActive(AnimationHandle handle) const {
+  return findSlot(handle) >= 0;
+}
+
+bool AnimationSystem::setParam(AnimationHandle handle, uint8_t slot, const Color& color) {
+  int8_t index = findSlot(handle);
+  if (index < 0 || !slots_[index].player.isLoaded()) {
+    return false;
+  }
+  slots_[index].player.setParam(slot, color);
+  return true;
+}
+
+void AnimationSystem::update(uint32_t nowMs) {
+  if (!compositor_) {
+    return;
+  }
+
+  // Start from empty layers; anything still running is redrawn below
+  for (uint8_t layer = 0; drawnLayers_ != 0; layer++) {
+    if (drawnLayers_ & (1u << layer)) {
+      compositor_->clear(static_cast<LEDLayer>(layer));
+      drawnLayers_ &= ~(1u << layer);
+    }
+  }
+
+  AnimationHandle finished[SLOT_COUNT];
+  uint8_t finishedCount = 0;
+  for (uint8_t k = 0; k < activeCount_; k++) {
+    uint8_t index = order_[k];
+    Slot& slot = slots_[index];
+    uint32_t elapsed = nowMs - slot.startMs;
+    if ((slot.durationMs > 0 && elapsed >= slot.durationMs) || !renderSlot(slot, elapsed)) {
+      finished[finishedCount++] = handleFor(index);
+      continue;
+    }
+    for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+      if (coverage_[i] != 0) {
+        compositor_->setPixel(slot.layer, i, frame_[i], coverage_[i]);
+      }
+    }
+    drawnLayers_ |= 1u << static_cast<uint8_t>(slot.layer);
+  }
+
+  // Callbacks run last so they can chain new animations safely. By handle,
+  // since an earlier callback may already have ended or replaced a slot.
+  for (uint8_t f = 0; f < finishedCount; f++) {
+    int8_t index = findSlot(finished[f]);
+    if (index >= 0) {
+      end(index, AnimationEnd::COMPLETED);
+    }
+  }
+}
+
+int8_t AnimationSystem::freeSlot() const {
+  for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+    if (!slots_[i].active) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int8_t AnimationSystem::findSlot(AnimationHandle handle) const {
+  uint8_t index = handle & 0xFF;
+  if (index == 0 || index > SLOT_COUNT) {
+    return -1;
+  }
+  index--;
+  const Slot& slot = slots_[index];
+  if (!slot.active || slot.generation != (handle >> 8)) {
+    return -1;
+  }
+  return index;
+}
+
+AnimationHandle AnimationSystem::handleFor(uint8_t slot) const {
+  return (AnimationHandle)(((uint16_t)slots_[slot].generation << 8) | (slot + 1));
+}
+
+bool AnimationSystem::drawsBefore(uint8_t a, uint8_t b) const {
+  if (slots_[a].layer != slots_[b].layer) {
+    return slots_[a].layer < slots_[b].layer;
+  }
+  return slots_[a].priority < slots_[b].priority;
+}
+
+void AnimationSystem::insertOrdered(uint8_t slot) {
+  // Equal priorities keep start order, so the newest draws on top
+  uint8_t k = activeCount_;
+  while (k > 0 && drawsBefore(slot, order_[k - 1])) {
+    order_[k] = order_[k - 1];
+    k--;
+  }
+  order_[k] = slot;
+  activeCount_++;
+}
+
+void AnimationSystem::removeOrdered(uint8_t slot) {
+  uint8_t k = 0;
+  while (k < activeCount_ && order_[k] != slot) {
+    k++;
+  }
+  if (k == activeCount_) {
+    return;
+  }
+  for (; k + 1 < activeCount_; k++) {
+    order_[k] = order_[k + 1];
+  }
+  activeCount_--;
+}
+
+bool AnimationSystem::renderSlot(Slot& slot, uint32_t elapsedMs) {
+  memset(coverage_, 0, sizeof(coverage_));
+
+  if (slot.player.isLoaded()) {
+    uint16_t duration = slot.player.getDuration();
+    if (slot.loop && duration > 0) {
+      elapsedMs %= duration;
+    }
+    return slot.player.evaluate(elapsedMs, frame_, Config::NUM_LEDS, coverage_);
+  }
+  return slot.render(slot.renderContext, elapsedMs, frame_, coverage_);
+}
+
+void AnimationSystem::end(uint8_t slot, AnimationEnd reason) {
+  Slot& s = slots_[slot];
+  if (!s.active) {
+    return;
+  }
+  AnimationHandle handle = handleFor(slot);
+  AnimationDoneFn onDone = s.onDone;
+  void* context = s.doneContext;
+
+  s.active = false;
+  removeOrdered(slot);
+  if (onDone) {
+    onDone(handle, reason, context);
+  }
+}
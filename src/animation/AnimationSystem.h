@@ -1,171 +1,181 @@
 #ifndef ANIMATION_SYSTEM_H
 #define ANIMATION_SYSTEM_H
 
+#include <stdint.h>
 #include "../core/SystemTypes.h"
-#include "../hardware/HardwareManager.h"
+#include "../core/Config.h"
+#include "../hardware/LEDCompositor.h"
+#include "AnimationPlayer.h"
 
 /**
- * @brief Coordinates all LED animations for the gauntlet
+ * @brief Identifies a started animation; 0 is never a valid handle
+ *
+ * A handle names one run of one slot, so it goes stale once that animation
+ * ends even if the slot is reused.
+ */
+typedef uint16_t AnimationHandle;
+
+/**
+ * @brief Why an animation ended
+ */
+enum class AnimationEnd : uint8_t {
+  COMPLETED,  // Reached its end
+  STOPPED,    // stop() by its owner
+  CANCELLED,  // cancel(), cancelLayer() or cancelAll()
+  PREEMPTED   // Evicted by a higher-priority animation while the pool was full
+};
+
+/**
+ * @brief Procedural animation frame
+ * @param context Pointer given in the request
+ * @param elapsedMs Time since the animation started
+ * @param frame Config::NUM_LEDS colors to draw into
+ * @param coverage Config::NUM_LEDS alphas, all 0 on entry; set for each LED drawn
+ * @return False once the animation has finished
+ */
+typedef bool (*AnimationRenderFn)(void* context, uint32_t elapsedMs, Color* frame, uint8_t* coverage);
+
+/**
+ * @brief Called once when an animation ends, for any reason
+ */
+typedef void (*AnimationDoneFn)(AnimationHandle handle, AnimationEnd reason, void* context);
+
+/**
+ * @brief Everything needed to start an animation
+ *
+ * The source is either a compiled keyframe program or a render callback.
+ * Animations on higher layers draw over lower ones; within a layer, higher
+ * priorities draw last.
+ */
+struct AnimationRequest {
+  const uint8_t* program;    // Keyframe program, or nullptr for a callback
+  uint16_t programLength;
+  AnimationRenderFn render;  // Used when program is nullptr
+  void* renderContext;
+  LEDLayer layer;
+  uint8_t priority;
+  uint32_t durationMs;       // 0 = until the program/callback finishes
+  bool loop;                 // Repeat the program until durationMs, stop() or cancel()
+  AnimationDoneFn onDone;
+  void* doneContext;
+
+  static AnimationRequest fromProgram(const uint8_t* program, uint16_t length, LEDLayer layer, uint8_t priority);
+  static AnimationRequest fromCallback(AnimationRenderFn render, void* context, LEDLayer layer, uint8_t priority);
+};
+
+/**
+ * @brief Runs concurrent LED animations from a fixed pool
+ *
+ * Modes post animations instead of writing pixels, and update() advances
+ * every active animation once per frame, drawing each into its compositor
+ * layer in layer and priority order. Slots are preallocated, starting and
+ * ending an animation never allocates, and the per-frame cost is
+ * proportional to the number of active animations. When the pool is full a
+ * new animation takes the slot of the lowest-priority one, if that is
+ * strictly lower than its own.
+ *
+ * Layers the system draws into belong to it: they are cleared at the start
+ * of every update() that drew into them last time.
  */
 class AnimationSystem {
 public:
+  static constexpr uint8_t PRIORITY_LOW = 64;
+  static constexpr uint8_t PRIORITY_NORMAL = 128;
+  static constexpr uint8_t PRIORITY_HIGH = 192;
+  static constexpr uint8_t PRIORITY_ALERT = 255;
+
+  AnimationSystem();
+
   /**
-   * @brief Initialize the animation system
-   * @param hardware Pointer to hardware manager
+   * @brief Attach the compositor and drop all animations without callbacks
+   * @param compositor Layers to draw into
    * @return True if initialization successful
    */
-  bool init(HardwareManager* hardware);
-  
-  /**
-   * @brief Update animations, called from main loop
-   */
-  void update();
-  
-  // Idle mode animations
-  
-  /**
-   * @brief Show the current hand position in Idle mode
-   * @param position Current position reading
-   */
-  void showIdlePosition(const PositionReading& position);
-  
-  /**
-   * @brief Show warning animation for LongNull approaching completion
-   * @param progress Progress value 0.0-1.0
-   */
-  void showLongNullWarning(float progress);
-  
-  // Transition animations
-  
-  /**
-   * @brief Show transition to Invocation mode animation
-   */
-  void showTransitionToInvocation();
-  
-  /**
-   * @brief Show transition to Freecast mode animation
-   */
-  void showTransitionToFreecast();
-  
-  // Invocation mode animations
-  
-  /**
-   * @brief Show slot indicator animation
-   * @param slotIndex Slot being activated (0-2)
-   */
-  void showSlotIndicator(uint8_t slotIndex);
-  
-  /**
-   * @brief Show countdown animation
-   * @param progress Progress value 0.0-1.0
-   */
-  void showCountdownAnimation(float progress);
-  
-  /**
-   * @brief Show checkpoint flash effect
-   */
-  void showCheckpointFlash();
-  
-  /**
-   * @brief Show slot confirmation animation
-   * @param slotIndex Slot being confirmed (0-2)
-   * @param position Position detected for this slot
-   */
-  void showSlotConfirmation(uint8_t slotIndex, uint8_t position);
-  
-  // Resolution mode animations
-  
-  /**
-   * @brief Show resolution preparation animation
-   * @param slots Invocation slots data
-   */
-  void showResolutionPrepare(const InvocationSlots& slots);
-  
-  /**
-   * @brief Show spell selection animation
-   * @param slots Invocation slots data
-   */
-  void showResolutionSelect(const InvocationSlots& slots);
-  
-  /**
-   * @brief Show spell core animation
-   * @param slots Invocation slots data
-   */
-  void showResolutionCore(const InvocationSlots& slots);
-  
+  bool init(LEDCompositor* compositor);
+
   /**
-   * @brief Determine which spell to cast based on slots
-   * @param slots Invocation slots data
-   * @return Spell type index (0-5)
+   * @brief Start an animation
+   * @param request What to play and where
+   * @param nowMs Current time in milliseconds
+   * @return Handle, or 0 if the request is invalid or the pool is full of equal or higher priorities
    */
-  uint8_t determineSpellType(const InvocationSlots& slots);
-  
+  AnimationHandle start(const AnimationRequest& request, uint32_t nowMs);
+
   /**
-   * @brief Show spell effect animation
-   * @param spellType Spell type index (0-5)
-   * @param progress Progress value 0.0-1.0
+   * @brief End an animation early; its callback sees STOPPED
+   * @return False if the handle is not active
    */
-  void showSpellEffect(uint8_t spellType, float progress);
-  
+  bool stop(AnimationHandle handle);
+
   /**
-   * @brief Show complete blackout (all LEDs off)
+   * @brief End an animation early; its callback sees CANCELLED
+   * @return False if the handle is not active
    */
-  void showBlackout();
-  
+  bool cancel(AnimationHandle handle);
+
   /**
-   * @brief Show return to idle animation
-   * @param progress Progress value 0.0-1.0
-   * @param position Current position
+   * @brief Cancel every animation on a layer up to a priority
+   * @param layer Layer to clear
+   * @param maxPriority Animations above this priority keep running
    */
-  void showIdleReturn(float progress, const PositionReading& position);
-  
-  // Freecast mode animations
-  
+  void cancelLayer(LEDLayer layer, uint8_t maxPriority = PRIORITY_ALERT);
+
   /**
-   * @brief Show freecast initialization animation
+   * @brief Cancel every animation
    */
-  void showFreecastInit();
-  
+  void cancelAll();
+
+  bool isActive(AnimationHandle handle) const;
+  uint8_t getActiveCount() const { return activeCount_; }
+
   /**
-   * @brief Show freecast collecting animation
-   * @param progress Progress value 0.0-1.0
+   * @brief Set a color parameter of a program animation
+   * @return False if the handle is not an active program animation
    */
-  void showFreecastCollecting(float progress);
-  
+  bool setParam(AnimationHandle handle, uint8_t slot, const Color& color);
+
   /**
-   * @brief Show freecast pattern animation
-   * @param motionData Array of motion data samples
-   * @param sampleCount Number of samples
-   * @param progress Progress value 0.0-1.0
+   * @brief Advance and draw every active animation, then end the finished ones
+   * @param nowMs Current time in milliseconds
    */
-  void showFreecastPattern(SensorData* motionData, uint8_t sampleCount, float progress);
+  void update(uint32_t nowMs);
 
 private:
-  // Hardware reference
-  HardwareManager* hardwareRef = nullptr;
-  
-  // Animation state tracking
-  uint8_t currentAnimationFrame = 0;
-  unsigned long lastFrameTime = 0;
-  unsigned long animationStartTime = 0;
-  
-  // Helper methods for various animations
-  
-  // Idle animations
-  void showIdlePositionIndicators(uint8_t position);
-  
-  // Spell effects
-  void showInfernoEffect(float progress);
-  void showBlizzardEffect(float progress);
-  void showWildGrowthEffect(float progress);
-  void showDetectMagicEffect(float progress);
-  void showRainbowBurstEffect(float progress);
-  void showRainbowPopEffect(float progress);
-  
-  // Utility functions
-  Color interpolateColor(const Color& start, const Color& end, float progress);
-  Color colorWheel(uint8_t position);
-  uint8_t countPositionInSlots(const InvocationSlots& slots, uint8_t position);
+  struct Slot {
+    AnimationPlayer player;
+    AnimationRenderFn render;
+    void* renderContext;
+    AnimationDoneFn onDone;
+    void* doneContext;
+    uint32_t startMs;
+    uint32_t durationMs;
+    LEDLayer layer;
+    uint8_t priority;
+    uint8_t generation;
+    bool loop;
+    bool active;
+  };
+
+  static constexpr uint8_t SLOT_COUNT = Config::ANIMATION_SLOTS;
+
+  LEDCompositor* compositor_;
+  Slot slots_[SLOT_COUNT];
+  uint8_t order_[SLOT_COUNT];  // Active slots in drawing order
+  uint8_t activeCount_;
+  uint8_t drawnLayers_;        // Bit per layer drawn by the last update()
+
+  // Scratch for the animation being drawn
+  Color frame_[Config::NUM_LEDS];
+  uint8_t coverage_[Config::NUM_LEDS];
+
+  int8_t freeSlot() const;
+  int8_t findSlot(AnimationHandle handle) const;
+  AnimationHandle handleFor(uint8_t slot) const;
+  bool drawsBefore(uint8_t a, uint8_t b) const;
+  void insertOrdered(uint8_t slot);
+  void removeOrdered(uint8_t slot);
+  bool renderSlot(Slot& slot, uint32_t elapsedMs);
+  void end(uint8_t slot, AnimationEnd reason);
 };
 
-#endif // ANIMATION_SYSTEM_H 
\ No newline at end of file
+#endif // ANIMATION_SYSTEM_H
@@ -0,0 +1,156 @@
+#ifndef COLOR_ENGINE_H
+#define COLOR_ENGINE_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+
+/**
+ * @brief Table-driven color math shared by all modes
+ *
+ * Replaces per-pixel float HSV conversion with 8-bit lookups:
+ * - Hue, saturation and value are all 0-255
+ * - The full-saturation spectrum is a 256-entry table, so a rainbow
+ *   pixel costs one table read plus one scale per channel
+ * - 16-entry palettes interpolate between neighbouring entries using
+ *   the low nibble of the index
+ *
+ * Everything here is integer-only and allocation-free so it can run
+ * inside the render path at any frame rate.
+ */
+namespace ColorEngine {
+
+  /**
+   * @brief 16-entry color palette addressed by an 8-bit index
+   *
+   * The high nibble selects an entry, the low nibble blends toward the
+   * next entry (wrapping from 15 back to 0).
+   */
+  struct Palette16 {
+    Color entries[16];
+  };
+
+  // Built-in palette: 16 evenly spaced spectrum hues
+  extern const Palette16 RAINBOW_PALETTE;
+
+  /**
+   * @brief Scale an 8-bit value by an 8-bit fraction (255 = unchanged)
+   */
+  inline uint8_t scale8(uint8_t value, uint8_t scale) {
+    return (uint8_t)(((uint16_t)value * (uint16_t)(1 + scale)) >> 8);
+  }
+
+  /**
+   * @brief Scale all channels of a color by an 8-bit fraction
+   */
+  inline Color scale(const Color& c, uint8_t amount) {
+    return {scale8(c.r, amount), scale8(c.g, amount), scale8(c.b, amount)};
+  }
+
+  /**
+   * @brief Linear blend between two colors
+   * @param a Color returned at amount 0
+   * @param b Color approached as amount goes to 255
+   * @param amount Blend fraction (0-255)
+   */
+  inline Color blend(const Color& a, const Color& b, uint8_t amount) {
+    uint8_t inv = 255 - amount;
+    return {
+      (uint8_t)(scale8(a.r, inv) + scale8(b.r, amount)),
+      (uint8_t)(scale8(a.g, inv) + scale8(b.g, amount)),
+      (uint8_t)(scale8(a.b, inv) + scale8(b.b, amount))
+    };
+  }
+
+  /**
+   * @brief Convert elapsed time to an 8-bit phase within a period
+   * @param elapsedMs Elapsed time in milliseconds
+   * @param periodMs Period length in milliseconds (must be > 0)
+   * @return Phase 0-255 (256 steps per period)
+   */
+  inline uint8_t phase8(uint32_t elapsedMs, uint32_t periodMs) {
+    return (uint8_t)(((elapsedMs % periodMs) * 256UL) / periodMs);
+  }
+
+  /**
+   * @brief Repeatable pseudo-random number for renderers
+   *
+   * An LCG (Numerical Recipes constants) on caller-held state, so a frame
+   * seeded from its time slot renders the same every time without touching
+   * the global Arduino RNG.
+   * @param state Generator state, advanced by each call
+   * @param range Number of possible results
+   * @return 0 to range - 1
+   */
+  inline uint16_t rand16(uint32_t& state, uint16_t range) {
+    state = state * 1664525UL + 1013904223UL;
+    return (uint16_t)(((state >> 16) * range) >> 16);
+  }
+
+  /**
+   * @brief Table sine: 128 + 127*sin(2*pi*theta/256)
+   * @param theta Angle, 256 steps per revolution
+   * @return Value in the range 1-255, centred on 128
+   */
+  uint8_t sine8(uint8_t theta);
+
+  /**
+   * @brief Full saturation, full value spectrum color for a hue
+   * @param hue 0-255 (0 = red, 85 = green, 170 = blue)
+   */
+  Color rainbow(uint8_t hue);
+
+  /**
+   * @brief 8-bit HSV to RGB conversion
+   * @param hue 0-255
+   * @param sat 0-255 (0 = white)
+   * @param val 0-255 (0 = black)
+   */
+  Color hsv(uint8_t hue, uint8_t sat, uint8_t val);
+
+  /**
+   * @brief Look up a palette color with interpolation
+   * @param palette Palette to sample
+   * @param index 0-255 position around the palette
+   * @param brightness Optional brightness scale (255 = unchanged)
+   */
+  Color fromPalette(const Palette16& palette, uint8_t index, uint8_t brightness = 255);
+
+  /**
+   * @brief Fill a buffer with a linear rainbow gradient
+   * @param out Destination buffer
+   * @param count Number of pixels
+   * @param startHue Hue of the first pixel
+   * @param hueStep Hue increment per pixel in 8.8 fixed point
+   * @param val Value (brightness) applied to every pixel
+   */
+  void fillRainbow(Color* out, uint16_t count, uint8_t startHue, uint16_t hueStep, uint8_t val);
+
+  /**
+   * @brief Fill a ring with exactly one full rainbow revolution
+   *
+   * Like fillRainbow() with a step of 256/count, but each pixel's hue
+   * offset is rounded individually so opposite pixels land exactly half
+   * a revolution apart even when the ring size does not divide 256.
+   *
+   * @param out Destination buffer
+   * @param count Number of pixels in the ring
+   * @param rotation Hue of pixel 0
+   * @param val Value (brightness) applied to every pixel
+   */
+  void fillRingRainbow(Color* out, uint16_t count, uint8_t rotation, uint8_t val);
+
+  /**
+   * @brief Fill a buffer by sweeping across a palette
+   * @param out Destination buffer
+   * @param count Number of pixels
+   * @param palette Palette to sample
+   * @param startIndex Palette index of the first pixel
+   * @param indexStep Palette index increment per pixel
+   * @param brightness Brightness scale (255 = unchanged)
+   */
+  void fillPalette(Color* out, uint16_t count, const Palette16& palette,
+                   uint8_t startIndex, uint8_t indexStep, uint8_t brightness = 255);
+
+} // namespace ColorEngine
+
+#endif // COLOR_ENGINE_H
@@ -0,0 +1,265 @@
+#include "FrameCodec.h"
+
+namespace {
+
+inline uint16_t read16(const uint8_t* p) {
+  return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+
+inline void write16(uint8_t* p, uint16_t value) {
+  p[0] = (uint8_t)(value & 0xFF);
+  p[1] = (uint8_t)(value >> 8);
+}
+
+inline bool sameColor(const Color& a, const Color& b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+// Header field offsets
+constexpr uint8_t HDR_FLAGS = 3;
+constexpr uint8_t HDR_LED_COUNT = 4;
+constexpr uint8_t HDR_FRAME_COUNT = 6;
+constexpr uint8_t HDR_FRAME_MS = 8;
+constexpr uint8_t HDR_PALETTE_SIZE = 9;
+
+} // namespace
+
+void FrameCodec::writeHeader(uint8_t* out, uint16_t ledCount, uint16_t frameCount, uint8_t frameMs) {
+  out[0] = MAGIC_0;
+  out[1] = MAGIC_1;
+  out[2] = VERSION;
+  out[HDR_FLAGS] = 0;
+  write16(out + HDR_LED_COUNT, ledCount);
+  write16(out + HDR_FRAME_COUNT, frameCount);
+  out[HDR_FRAME_MS] = frameMs;
+  out[HDR_PALETTE_SIZE] = 0;
+}
+
+uint16_t FrameCodec::encodeFrame(const Color* prev, const Color* next, uint16_t ledCount,
+                                 uint8_t* out, uint16_t capacity) {
+  uint16_t pos = 0;
+  uint16_t i = 0;
+
+  while (i < ledCount) {
+    uint8_t run = 1;
+
+    // Unchanged LEDs: one opcode byte per run
+    if (sameColor(prev[i], next[i])) {
+      while (i + run < ledCount && run < MAX_RUN && sameColor(prev[i + run], next[i + run])) {
+        run++;
+      }
+      if (pos + 1 > capacity) {
+        return 0;
+      }
+      out[pos++] = OP_SKIP | (run - 1);
+      i += run;
+      continue;
+    }
+
+    // Two or more LEDs set to the same color: opcode + one color
+    while (i + run < ledCount && run < MAX_RUN && sameColor(next[i + run], next[i])) {
+      run++;
+    }
+    if (run >= 2) {
+      if (pos + 4 > capacity) {
+        return 0;
+      }
+      out[pos++] = OP_FILL | (run - 1);
+      out[pos++] = next[i].r;
+      out[pos++] = next[i].g;
+      out[pos++] = next[i].b;
+      i += run;
+      continue;
+    }
+
+    // Changed LEDs up to the next unchanged LED or the start of a fill
+    while (i + run < ledCount && run < MAX_RUN) {
+      uint16_t j = i + run;
+      if (sameColor(prev[j], next[j]) || (j + 1 < ledCount && sameColor(next[j], next[j + 1]))) {
+        break;
+      }
+      run++;
+    }
+    if (pos + 1 + 3 * (uint16_t)run > capacity) {
+      return 0;
+    }
+    out[pos++] = OP_LITERAL | (run - 1);
+    for (uint8_t k = 0; k < run; k++, i++) {
+      out[pos++] = prev[i].r ^ next[i].r;
+      out[pos++] = prev[i].g ^ next[i].g;
+      out[pos++] = prev[i].b ^ next[i].b;
+    }
+  }
+
+  return pos;
+}
+
+bool FrameCodec::validate(const uint8_t* clip, uint32_t length) {
+  if (!clip || length < HEADER_SIZE) {
+    return false;
+  }
+  if (clip[0] != MAGIC_0 || clip[1] != MAGIC_1 || clip[2] != VERSION) {
+    return false;
+  }
+
+  const uint16_t ledCount = read16(clip + HDR_LED_COUNT);
+  const uint16_t frameCount = read16(clip + HDR_FRAME_COUNT);
+  const bool palette = (clip[HDR_FLAGS] & FLAG_PALETTE) != 0;
+  const uint8_t paletteSize = clip[HDR_PALETTE_SIZE];
+  const uint8_t valueSize = palette ? 1 : 3;
+
+  if (ledCount == 0 || clip[HDR_FRAME_MS] == 0 || (palette && paletteSize == 0)) {
+    return false;
+  }
+
+  uint32_t pos = HEADER_SIZE + (palette ? 3UL * paletteSize : 0);
+  if (pos > length) {
+    return false;
+  }
+
+  for (uint16_t f = 0; f < frameCount; f++) {
+    uint16_t covered = 0;
+    while (covered < ledCount) {
+      if (pos >= length) {
+        return false;
+      }
+      const uint8_t op = clip[pos] & OP_MASK;
+      const uint8_t run = (clip[pos] & ~OP_MASK) + 1;
+      pos++;
+      if (covered + run > ledCount) {
+        return false;
+      }
+
+      uint8_t values = 0;
+      if (op == OP_LITERAL) {
+        values = run;
+      } else if (op == OP_FILL) {
+        values = 1;
+      } else if (op != OP_SKIP) {
+        return false;
+      }
+      if (pos + (uint32_t)values * valueSize > length) {
+        return false;
+      }
+      if (palette) {
+        for (uint8_t k = 0; k < values; k++) {
+          if (clip[pos + k] >= paletteSize) {
+            return false;
+          }
+        }
+      }
+      pos += (uint32_t)values * valueSize;
+      covered += run;
+    }
+  }
+
+  return pos == length;
+}
+
+FrameDecoder::FrameDecoder()
+    : clip_(nullptr),
+      palette_(nullptr),
+      frames_(nullptr),
+      cursor_(nullptr),
+      ledCount_(0),
+      frameCount_(0),
+      nextFrame_(0),
+      frameMs_(0) {
+}
+
+bool FrameDecoder::load(const uint8_t* clip, uint32_t length) {
+  if (!FrameCodec::validate(clip, length)) {
+    clip_ = nullptr;
+    return false;
+  }
+
+  clip_ = clip;
+  ledCount_ = read16(clip + HDR_LED_COUNT);
+  frameCount_ = read16(clip + HDR_FRAME_COUNT);
+  frameMs_ = clip[HDR_FRAME_MS];
+  if (clip[HDR_FLAGS] & FrameCodec::FLAG_PALETTE) {
+    palette_ = clip + FrameCodec::HEADER_SIZE;
+    frames_ = palette_ + 3 * clip[HDR_PALETTE_SIZE];
+  } else {
+    palette_ = nullptr;
+    frames_ = clip + FrameCodec::HEADER_SIZE;
+  }
+  cursor_ = frames_;
+  nextFrame_ = 0;
+  return true;
+}
+
+void FrameDecoder::rewind(Color* frame) {
+  for (uint16_t i = 0; i < ledCount_; i++) {
+    frame[i] = {0, 0, 0};
+  }
+  cursor_ = frames_;
+  nextFrame_ = 0;
+}
+
+bool FrameDecoder::next(Color* frame) {
+  using namespace FrameCodec;
+
+  if (!clip_ || nextFrame_ >= frameCount_) {
+    return false;
+  }
+
+  // The clip was validated on load, so runs never overrun the frame
+  const uint8_t* p = cursor_;
+  Color* led = frame;
+  Color* const end = frame + ledCount_;
+
+  while (led < end) {
+    const uint8_t op = *p & OP_MASK;
+    uint8_t run = (*p & ~OP_MASK) + 1;
+    p++;
+
+    if (op == OP_SKIP) {
+      led += run;
+    } else if (op == OP_FILL) {
+      Color c;
+      if (palette_) {
+        const uint8_t* entry = palette_ + 3 * (*p++);
+        c = {entry[0], entry[1], entry[2]};
+      } else {
+        c = {p[0], p[1], p[2]};
+        p += 3;
+      }
+      while (run--) {
+        *led++ = c;
+      }
+    } else if (palette_) {
+      while (run--) {
+        const uint8_t* entry = palette_ + 3 * (*p++);
+        *led++ = {entry[0], entry[1], entry[2]};
+      }
+    } else {
+      while (run--) {
+        led->r ^= p[0];
+        led->g ^= p[1];
+        led->b ^= p[2];
+        p += 3;
+        led++;
+      }
+    }
+  }
+
+  cursor_ = p;
+  nextFrame_++;
+  return true;
+}
+
+void FrameDecoder::seek(uint16_t index, Color* frame) {
+  if (!clip_ || frameCount_ == 0) {
+    return;
+  }
+  if (index >= frameCount_) {
+    index = frameCount_ - 1;
+  }
+  if ((int32_t)index < getFrameIndex()) {
+    rewind(frame);
+  }
+  while (getFrameIndex() < (int32_t)index) {
+    next(frame);
+  }
+}
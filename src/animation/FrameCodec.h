@@ -0,0 +1,137 @@
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+
+/**
+ * @brief Compressed storage format for pre-baked frame animations
+ *
+ * A clip stores every frame as a delta against the previous one, so LEDs
+ * that do not change cost almost nothing. Clips are usually encoded on the
+ * host by `utils/frame_codec.py`; encodeFrame() produces the same format on
+ * the device. All multi-byte fields are little-endian.
+ *
+ * Header (10 bytes):
+ *   'F' 'C' version flags ledCount:u16 frameCount:u16 frameMs paletteSize
+ *
+ * With FLAG_PALETTE the header is followed by paletteSize RGB triplets
+ * (1-255 entries) and pixel values are single-byte palette indices.
+ * Otherwise pixel values are 3-byte RGB.
+ *
+ * Each frame is a list of run opcodes covering exactly ledCount LEDs. The
+ * top two bits select the operation, the low six bits hold run length - 1:
+ *   OP_SKIP    n          - n LEDs keep their previous value
+ *   OP_LITERAL n v[n]     - n values; RGB values are XORed onto the previous
+ *                           frame, palette indices replace it
+ *   OP_FILL    n v        - n LEDs are set to one value
+ *
+ * The first frame is a delta against black.
+ */
+namespace FrameCodec {
+  constexpr uint8_t MAGIC_0 = 'F';
+  constexpr uint8_t MAGIC_1 = 'C';
+  constexpr uint8_t VERSION = 1;
+
+  constexpr uint8_t HEADER_SIZE = 10;
+
+  // Header flags
+  constexpr uint8_t FLAG_PALETTE = 0x01;
+
+  // Run opcodes
+  constexpr uint8_t OP_SKIP = 0x00;
+  constexpr uint8_t OP_LITERAL = 0x40;
+  constexpr uint8_t OP_FILL = 0x80;
+  constexpr uint8_t OP_MASK = 0xC0;
+  constexpr uint8_t MAX_RUN = 64;
+
+  /**
+   * @brief Write a clip header for an RGB (non-palette) clip
+   * @param out Destination, at least HEADER_SIZE bytes
+   * @param ledCount LEDs per frame
+   * @param frameCount Number of frames that will follow
+   * @param frameMs Frame period in milliseconds
+   */
+  void writeHeader(uint8_t* out, uint16_t ledCount, uint16_t frameCount, uint8_t frameMs);
+
+  /**
+   * @brief Encode one RGB frame as a delta against the previous frame
+   * @param prev Previous frame (all black for the first frame)
+   * @param next Frame to encode
+   * @param ledCount Number of LEDs in both frames
+   * @param out Destination buffer
+   * @param capacity Space available in out
+   * @return Number of bytes written, or 0 if the frame did not fit
+   */
+  uint16_t encodeFrame(const Color* prev, const Color* next, uint16_t ledCount,
+                       uint8_t* out, uint16_t capacity);
+
+  /**
+   * @brief Check a clip for structural errors
+   * @return True if the header, palette and every frame are in bounds and
+   *         every frame covers exactly ledCount LEDs
+   */
+  bool validate(const uint8_t* clip, uint32_t length);
+}
+
+/**
+ * @brief Heap-free sequential decoder for FrameCodec clips
+ *
+ * Frames are decoded in place: the caller's LED buffer holds the previous
+ * frame and only the changed LEDs are rewritten. The buffer must have
+ * getLedCount() entries and must not be modified between frames.
+ */
+class FrameDecoder {
+public:
+  FrameDecoder();
+
+  /**
+   * @brief Validate and attach a clip
+   * @param clip Pointer to the clip (flash resident)
+   * @param length Size of the clip in bytes
+   * @return True if the clip is well formed
+   */
+  bool load(const uint8_t* clip, uint32_t length);
+
+  /**
+   * @brief Clear the buffer to black and return to the first frame
+   * @param frame LED buffer
+   */
+  void rewind(Color* frame);
+
+  /**
+   * @brief Decode the next frame into the buffer
+   * @param frame LED buffer holding the previous frame
+   * @return False once every frame has been decoded
+   */
+  bool next(Color* frame);
+
+  /**
+   * @brief Decode up to a given frame, rewinding first if it lies behind
+   * @param index Frame to show (clamped to the last frame)
+   * @param frame LED buffer holding the current frame
+   */
+  void seek(uint16_t index, Color* frame);
+
+  bool isLoaded() const { return clip_ != nullptr; }
+  uint16_t getLedCount() const { return ledCount_; }
+  uint16_t getFrameCount() const { return frameCount_; }
+  uint8_t getFrameMs() const { return frameMs_; }
+
+  /**
+   * @brief Index of the frame currently in the buffer (-1 before the first)
+   */
+  int32_t getFrameIndex() const { return (int32_t)nextFrame_ - 1; }
+
+private:
+  const uint8_t* clip_;
+  const uint8_t* palette_;
+  const uint8_t* frames_;
+  const uint8_t* cursor_;
+  uint16_t ledCount_;
+  uint16_t frameCount_;
+  uint16_t nextFrame_;
+  uint8_t frameMs_;
+};
+
+#endif // FRAME_CODEC_H
@@ -0,0 +1,258 @@
+#include "FreecastPatterns.h"
+#include <Arduino.h>
+#include "../core/Config.h"
+#include "../hardware/LEDTopology.h"
+#include "ColorEngine.h"
+#include "TopologyRenderer.h"
+
+static void fill(Color* frame, const Color& color) {
+    for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+        frame[i] = color;
+    }
+}
+
+// Render shooting stars pattern (for quick flicks)
+static void renderShootingStars(const FreecastPatternParams& params, unsigned long elapsedTime, Color* frame) {
+    // Parameters based on motion
+    uint8_t numStars = 1 + (params.intensity * 3); // 1-4 shooting stars
+    uint8_t starSpeed = 50 + (params.intensity * 200); // Speed factor
+    // Ensure tailLength is never zero by using max()
+    uint8_t tailLength = max(1, 3 + (int)(params.intensity * 6)); // 3-9 LEDs, guaranteed at least 1
+    
+    // Clear all LEDs first
+    fill(frame, {0, 0, 0});
+    
+    const uint16_t ringSize = ActiveTopology::ringSize(0);
+    
+    // Create stars at different positions
+    for (uint8_t star = 0; star < numStars; star++) {
+        // Calculate position within the ring based on time and star index
+        uint16_t pos = ((elapsedTime / (200 - starSpeed)) + (star * 7)) % ringSize;
+        
+        // Each star has its own color based on position and time
+        // This ensures variety between stars and runs
+        uint8_t starHue = (star * 40 + (elapsedTime / 50)) % 255; // Spaced hues, slowly shifting
+        Color headColor = ColorEngine::rainbow(starHue); // Full saturation and brightness for head
+        
+        // Create tail
+        for (uint8_t tail = 0; tail < tailLength; tail++) {
+            // Calculate tail position (wrapping around the ring)
+            uint16_t tailPos = (pos + ringSize - (tail % ringSize)) % ringSize;
+            
+            // Calculate tail brightness (fading out)
+            // tailLength is now guaranteed to be at least 1
+            uint8_t brightness = 255 - ((255 * tail) / tailLength);
+            
+            // For tail colors, fade to white or yellow at the tips
+            Color tailColor;
+            
+            if (tail < tailLength / 3) {
+                // Head section - keep the star's color
+                tailColor = headColor;
+            } else {
+                // Tail section - blend toward white/yellow for a fiery effect
+                // Guard against division by zero or very small divisor
+                float divisor = max(1.0f, (float)(tailLength - tailLength/3));
+                float blendFactor = (float)(tail - tailLength/3) / divisor;
+                Color fadeColor = {255, 180, 0}; // Yellowish/orange
+                tailColor = ColorEngine::blend(headColor, fadeColor, blendFactor * 255);
+            }
+            
+            // Scale by brightness and intensity
+            float intensityFactor = 0.4f + (params.intensity * 0.6f); // 0.4-1.0 scaling
+            uint8_t finalBrightness = brightness * intensityFactor;
+            tailColor = ColorEngine::scale(tailColor, finalBrightness);
+            
+            // Set the LED on every ring
+            for (uint8_t ring = 0; ring < ActiveTopology::RING_COUNT; ring++) {
+                frame[ActiveTopology::ringStart(ring) + tailPos] = tailColor;
+            }
+        }
+    }
+}
+
+// Render waves pattern (for circular motions)
+static void renderWaves(const FreecastPatternParams& params, unsigned long elapsedTime, Color* frame) {
+    // Parameters based on motion
+    float speed = 0.05f + (params.intensity * 0.3f); // Increased wave speed responsiveness
+    float intensity = 0.5f + (params.intensity * 0.5f); // Brightness intensity
+    
+    // Use directionality to control wave frequency
+    float waveFrequency = 1.0f + (params.directionality * 3.0f); // 1-4 waves based on directionality
+    
+    // Create wave effect around each ring
+    for (uint16_t i = 0; i < ActiveTopology::LED_COUNT; i++) {
+        // Calculate wave phase for this LED from its angle around the ring
+        uint8_t angle = ActiveTopology::angle(i);
+        float phase = waveFrequency * (angle / 256.0f * TWO_PI) + elapsedTime * speed;
+        
+        // Generate sinusoidal wave
+        float wave = (sinf(phase) + 1.0f) / 2.0f; // 0.0-1.0
+        
+        // Full rainbow color selection - HSV color wheel
+        // Use the full color wheel based on position and time
+        // Scale up the time division to make the colors shift more slowly
+        uint8_t hue = (angle + (elapsedTime / 30)) % 255;
+        
+        // Use the wave to vary the specific hue around the base
+        // Convert wave to an integer offset before using modulo
+        uint8_t waveOffset = (uint8_t)(wave * 30.0f);
+        hue = (hue + waveOffset) % 255;
+        
+        // Saturation based on directionality - more directional = more saturated
+        uint8_t sat = 200 + (params.directionality * 55); // 200-255
+        
+        // Brightness based on wave value and motion intensity
+        uint8_t val = 128 + (wave * 127 * intensity); // 128-255 with intensity scaling
+        
+        // Set LED from HSV color
+        frame[i] = ColorEngine::hsv(hue, sat, val);
+    }
+}
+
+// Render sparkles pattern (for shaking motions)
+static void renderSparkles(const FreecastPatternParams& params, unsigned long elapsedTime, Color* frame) {
+    // Parameters based on motion
+    uint8_t numSparkles = 3 + (params.intensity * 9); // 3-12 sparkles
+    uint8_t changeRate = 100 - (params.intensity * 70); // How often sparkles change
+    
+    // Same sparkles for every frame within one change period
+    uint32_t state = elapsedTime / changeRate;
+    
+    // Clear all LEDs first
+    fill(frame, {0, 0, 0});
+    
+    // Define a more varied color palette using preset colors
+    static const Color sparkleColors[] = {
+        {255, 0, 0},     // Red
+        {255, 255, 0},   // Yellow
+        {0, 255, 0},     // Green
+        {0, 255, 255},   // Cyan
+        {0, 0, 255},     // Blue
+        {255, 0, 255},   // Magenta
+        {255, 255, 255}  // White
+    };
+    
+    // Create random sparkles
+    for (uint8_t i = 0; i < numSparkles; i++) {
+        // Random position
+        uint16_t pos = ColorEngine::rand16(state, Config::NUM_LEDS);
+        
+        // Get a random color from our defined palette
+        Color color = sparkleColors[ColorEngine::rand16(state, 7)];
+        
+        // Random brightness with intensity scaling
+        uint8_t brightness = 128 + ColorEngine::rand16(state, 128);
+        uint8_t scaling = 128 + (uint8_t)(params.intensity * 127);  // Scale 50-100% based on motion
+        
+        color = ColorEngine::scale(color, ColorEngine::scale8(brightness, scaling));
+        
+        // Set LED
+        frame[pos] = color;
+    }
+}
+
+// Render color trails pattern (for directional movements)
+static void renderColorTrails(const FreecastPatternParams& params, unsigned long elapsedTime, Color* frame) {
+    // Parameters based on motion
+    uint8_t speed = 50 + (params.intensity * 150); // Rotation speed
+    
+    // Ensure we don't divide by zero in position calculation
+    uint8_t speedForCalculation = (speed < 199) ? speed : 199; // Prevent 200-speed from being zero
+    
+    // Calculate the head position within the ring
+    uint16_t pos = (elapsedTime / (200 - speedForCalculation)) % ActiveTopology::ringSize(0);
+    
+    // Base hue depends on time, making the color pattern rotate over time
+    uint8_t baseHue = (elapsedTime / 20) % 255;
+    
+    // Saturation based on directionality - more directional = more saturated
+    uint8_t sat = 200 + (params.directionality * 55); // 200-255
+    
+    // Brightness based on motion intensity; the trail falls off to 60% away from the head
+    uint8_t val = 200 + (params.intensity * 55);
+    
+    // Rainbow gradient around every ring, brightest at the head
+    TopologyRenderer::ringTrail<ActiveTopology>(frame, ActiveTopology::angle(pos), baseHue, sat, val);
+}
+
+// Render pulses pattern (for sharp direction changes)
+static void renderPulses(const FreecastPatternParams& params, unsigned long elapsedTime, Color* frame) {
+    // Parameters based on motion
+    // Ensure numPulses is never zero by using max()
+    uint8_t numPulses = max(1, 1 + (int)(params.intensity * 2)); // 1-3 pulses, guaranteed at least 1
+    uint8_t pulseSpeed = 100 + (params.intensity * 400); // Expansion speed
+    
+    // Clear all LEDs first
+    fill(frame, {0, 0, 0});
+    
+    const uint16_t ringSize = ActiveTopology::ringSize(0);
+    
+    // Create pulses
+    for (uint8_t pulse = 0; pulse < numPulses; pulse++) {
+        // Calculate pulse center and radius - numPulses is now guaranteed to be at least 1
+        uint16_t center = (pulse * ringSize / numPulses); // Evenly spaced around each ring
+        float radius = ((elapsedTime / pulseSpeed) + (pulse * 0.33f)) * ringSize;
+        radius = fmodf(radius, ringSize * 1.5f); // Wrap around with gap
+        
+        // Each pulse has its own color based on motion intensity
+        uint8_t hue = (pulse * 85 + (elapsedTime / 30)) % 255; // Spaced evenly around color wheel
+        uint8_t sat = 200 + (params.directionality * 55); // 200-255 based on directionality
+        uint8_t val = 200 + (params.intensity * 55); // 200-255 based on intensity
+        Color pulseColor = ColorEngine::hsv(hue, sat, val);
+        
+        // Draw pulse
+        for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+            // Calculate distance from pulse center (shortest path around the LED's ring)
+            uint16_t position = ActiveTopology::position(i);
+            uint16_t distance = min(
+                (position + ringSize - center) % ringSize,
+                (center + ringSize - position) % ringSize
+            );
+            
+            // Check if this LED is within pulse radius
+            if (distance <= radius && distance >= radius - 3) {
+                // Calculate intensity based on distance from radius edge
+                float intensity = 1.0f - fabsf((radius - distance) / 3.0f);
+                
+                // Scale by intensity
+                Color color = ColorEngine::scale(pulseColor, intensity * 255);
+                
+                // Set LED
+                frame[i] = color;
+            }
+        }
+    }
+}
+
+void FreecastPatterns::render(const FreecastPatternParams& params, unsigned long elapsedTime, Color* frame) {
+    // Without recorded motion there is nothing to base a pattern on
+    if (!params.hasMotion) {
+        // Create a simple pulsing effect on all LEDs
+        uint8_t pulse = (ColorEngine::sine8(elapsedTime / 20) * 128) / 255 + 40; // 40-168 brightness pulse
+        fill(frame, {pulse, pulse, pulse}); // White pulsing
+        return;
+    }
+    
+    // Regular rendering with pattern selection
+    switch (params.type) {
+        case PatternType::SHOOTING_STARS:
+            renderShootingStars(params, elapsedTime, frame);
+            break;
+        case PatternType::WAVES:
+            renderWaves(params, elapsedTime, frame);
+            break;
+        case PatternType::SPARKLES:
+            renderSparkles(params, elapsedTime, frame);
+            break;
+        case PatternType::COLOR_TRAILS:
+            renderColorTrails(params, elapsedTime, frame);
+            break;
+        case PatternType::PULSES:
+            renderPulses(params, elapsedTime, frame);
+            break;
+        default:
+            renderSparkles(params, elapsedTime, frame); // Default to sparkles
+            break;
+    }
+}
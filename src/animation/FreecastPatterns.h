@@ -0,0 +1,47 @@
+#ifndef FREECAST_PATTERNS_H
+#define FREECAST_PATTERNS_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+
+// Pattern types
+enum class PatternType {
+    SHOOTING_STARS,  // For quick flicks
+    WAVES,           // For circular motions
+    SPARKLES,        // For shaking motions
+    COLOR_TRAILS,    // For directional movements
+    PULSES           // For sharp direction changes
+};
+
+/**
+ * @brief Everything a FreeCast display pattern depends on besides time
+ *
+ * Fixed for the whole display phase once the recorded motion has been analyzed.
+ */
+struct FreecastPatternParams {
+    PatternType type;
+    float intensity;       // Overall motion intensity (0.0-1.0)
+    float directionality;  // How directional vs. chaotic (0.0-1.0)
+    bool hasMotion;        // False shows a plain white pulse
+};
+
+/**
+ * @brief FreeCast display patterns as pure functions of parameters and time
+ *
+ * Each call writes a complete frame of Config::NUM_LEDS pixels, so the same
+ * elapsed time always yields the same frame. That lets FreeCastMode bake a
+ * whole display phase ahead of time and play it back.
+ */
+namespace FreecastPatterns {
+
+    /**
+     * @brief Render one frame of the display phase
+     * @param params Pattern and motion parameters
+     * @param elapsedTime Milliseconds since the display phase started
+     * @param frame Output buffer of Config::NUM_LEDS colors
+     */
+    void render(const FreecastPatternParams& params, unsigned long elapsedTime, Color* frame);
+
+} // namespace FreecastPatterns
+
+#endif // FREECAST_PATTERNS_H
@@ -0,0 +1,80 @@
+#include "PatternCache.h"
+#include <Arduino.h>
+
+PatternCache::PatternCache()
+    : size_(0),
+      frameCount_(0),
+      bakedFrames_(0),
+      frameMs_(1),
+      sealed_(false),
+      stats_{0, 0, 0, 0} {
+}
+
+void PatternCache::begin(uint16_t frameCount, uint8_t frameMs) {
+  decoder_ = FrameDecoder();
+  size_ = FrameCodec::HEADER_SIZE;
+  frameCount_ = frameCount;
+  bakedFrames_ = 0;
+  frameMs_ = frameMs > 0 ? frameMs : 1;
+  sealed_ = false;
+  stats_ = {0, 0, 0, 0};
+
+  // The first frame is a delta against black
+  for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+    previous_[i] = {0, 0, 0};
+  }
+}
+
+bool PatternCache::addFrame(const Color* frame) {
+  if (sealed_ || bakedFrames_ >= frameCount_) {
+    return false;
+  }
+
+  uint32_t start = micros();
+  uint16_t written = FrameCodec::encodeFrame(previous_, frame, Config::NUM_LEDS,
+                                             clip_ + size_, sizeof(clip_) - size_);
+  if (written == 0) {
+    // Out of space: keep what fits, the rest is rendered live
+    seal();
+    return false;
+  }
+  size_ += written;
+  bakedFrames_++;
+  for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+    previous_[i] = frame[i];
+  }
+  stats_.bakeMicros += micros() - start;
+  stats_.bakedFrames++;
+  return true;
+}
+
+void PatternCache::seal() {
+  if (sealed_) {
+    return;
+  }
+  sealed_ = true;
+  if (bakedFrames_ == 0) {
+    return;
+  }
+  FrameCodec::writeHeader(clip_, Config::NUM_LEDS, bakedFrames_, frameMs_);
+  if (decoder_.load(clip_, size_)) {
+    decoder_.rewind(current_);
+  }
+}
+
+bool PatternCache::play(uint32_t elapsedMs, Color* out) {
+  if (!decoder_.isLoaded()) {
+    return false;
+  }
+  uint32_t index = elapsedMs / frameMs_;
+  if (index >= decoder_.getFrameCount()) {
+    return false;
+  }
+
+  uint32_t start = micros();
+  decoder_.seek((uint16_t)index, current_);
+  memcpy(out, current_, sizeof(current_));
+  stats_.playbackMicros += micros() - start;
+  stats_.playedFrames++;
+  return true;
+}
@@ -0,0 +1,94 @@
+#ifndef PATTERN_CACHE_H
+#define PATTERN_CACHE_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+#include "../core/Config.h"
+#include "FrameCodec.h"
+
+/**
+ * @brief Time spent producing display frames, baked vs played back
+ */
+struct PatternCacheStats {
+  uint32_t bakeMicros;      // Rendering and encoding the cached frames
+  uint16_t bakedFrames;
+  uint32_t playbackMicros;  // Decoding and copying cached frames
+  uint16_t playedFrames;
+};
+
+/**
+ * @brief Frame cache for a fixed-length animation, filled once and replayed
+ *
+ * Frames are added in order and delta-encoded with FrameCodec into a fixed
+ * buffer. Once every frame is in (or the buffer is full) the clip is
+ * sealed and play() returns frames by decoding forward into an internal
+ * buffer and copying it out. Frames that did not fit, or are asked for
+ * before the cache is sealed, are left to the caller to render live.
+ */
+class PatternCache {
+public:
+  PatternCache();
+
+  /**
+   * @brief Drop the cached clip and start a new one
+   * @param frameCount Frames the clip will hold
+   * @param frameMs Time each frame is shown
+   */
+  void begin(uint16_t frameCount, uint8_t frameMs);
+
+  /**
+   * @brief Append the next frame
+   * @param frame Config::NUM_LEDS colors
+   * @return False if the cache no longer accepts frames (sealed or full)
+   */
+  bool addFrame(const Color* frame);
+
+  /**
+   * @brief Index of the next frame to add; its time is getNextFrame() * frameMs
+   */
+  uint16_t getNextFrame() const { return bakedFrames_; }
+
+  /**
+   * @brief Stop adding frames and make the clip playable
+   */
+  void seal();
+
+  bool isSealed() const { return sealed_; }
+
+  /**
+   * @brief Copy out the frame shown at a given time
+   * @param elapsedMs Time since the start of the clip
+   * @param out Config::NUM_LEDS colors
+   * @return False if the frame is not cached; the caller renders it instead
+   */
+  bool play(uint32_t elapsedMs, Color* out);
+
+  /**
+   * @brief Bytes used by the encoded clip
+   */
+  uint16_t getSize() const { return size_; }
+
+  /**
+   * @brief Timing of the current clip
+   */
+  const PatternCacheStats& getStats() const { return stats_; }
+
+  /**
+   * @brief Record time spent baking outside addFrame() (e.g. rendering)
+   */
+  void addBakeMicros(uint32_t elapsedMicros) { stats_.bakeMicros += elapsedMicros; }
+
+private:
+  uint8_t clip_[Config::FREECAST_CACHE_BYTES];
+  uint16_t size_;
+  uint16_t frameCount_;
+  uint16_t bakedFrames_;
+  uint8_t frameMs_;
+  bool sealed_;
+  Color previous_[Config::NUM_LEDS];  // Last frame added, for delta encoding
+  Color current_[Config::NUM_LEDS];   // Decoder state during playback
+  FrameDecoder decoder_;
+  PatternCacheStats stats_;
+};
+
+#endif // PATTERN_CACHE_H
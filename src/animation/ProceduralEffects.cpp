@@ -0,0 +1,47 @@
+#include "ProceduralEffects.h"
+#include <Arduino.h>
+#include "../core/Config.h"
+#include "ColorEngine.h"
+
+namespace {
+
+  Color configColor(const uint8_t rgb[3]) {
+    return {rgb[0], rgb[1], rgb[2]};
+  }
+
+  void fill(Color* frame, const Color& color) {
+    for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+      frame[i] = color;
+    }
+  }
+
+} // namespace
+
+void ProceduralEffects::lightningBlast(uint32_t startMs, uint32_t elapsedMs, Color* frame) {
+  uint32_t currentTime = startMs + elapsedMs;
+
+  // Hold the initial flash
+  if (elapsedMs < 50) {
+    fill(frame, configColor(Config::Colors::UNKNOWN_COLOR));
+    return;
+  }
+
+  // Dark unless a pixel flashes
+  fill(frame, configColor(Config::Colors::BLACK));
+
+  // Random pixels crackle in every other 100 ms slot (about 5 flashes/sec)
+  if ((currentTime / 100) % 2 == 0) {
+    // Same crackle for every frame rendered within one slot
+    uint32_t state = currentTime / 100;
+    for (uint16_t i = 0; i < Config::NUM_LEDS; ++i) {
+      if (ColorEngine::rand16(state, 5) == 0) { // 1 in 5 chance for a pixel to light up
+        // Choose a lightning color: red, blue, purple, white
+        uint8_t colorType = ColorEngine::rand16(state, 4);
+        if (colorType == 0) frame[i] = configColor(Config::Colors::RED);
+        else if (colorType == 1) frame[i] = configColor(Config::Colors::BLUE);
+        else if (colorType == 2) frame[i] = configColor(Config::Colors::PURPLE);
+        else frame[i] = configColor(Config::Colors::UNKNOWN_COLOR);
+      }
+    }
+  }
+}
@@ -0,0 +1,26 @@
+#ifndef PROCEDURAL_EFFECTS_H
+#define PROCEDURAL_EFFECTS_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+
+/**
+ * @brief Effects computed in code rather than from a keyframe program
+ *
+ * Each function writes a complete frame of Config::NUM_LEDS pixels from
+ * time alone, so the modes can post them as AnimationSystem callbacks and
+ * the host renderer can draw them without any hardware.
+ */
+namespace ProceduralEffects {
+
+  /**
+   * @brief Lightning Blast: a white flash, then random colored crackle
+   * @param startMs Time the spell started; the crackle is seeded from absolute time
+   * @param elapsedMs Time since the spell started
+   * @param frame Output buffer of Config::NUM_LEDS colors
+   */
+  void lightningBlast(uint32_t startMs, uint32_t elapsedMs, Color* frame);
+
+} // namespace ProceduralEffects
+
+#endif // PROCEDURAL_EFFECTS_H
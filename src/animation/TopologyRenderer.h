@@ -0,0 +1,58 @@
+#ifndef TOPOLOGY_RENDERER_H
+#define TOPOLOGY_RENDERER_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+#include "../hardware/LEDTopology.h"
+#include "ColorEngine.h"
+
+/**
+ * @brief Render kernels templated on an LED topology
+ *
+ * Each kernel writes a full frame of Topology::LED_COUNT pixels and works
+ * in angles (0-255 around a ring) rather than LED indices, so the same
+ * effect covers a 12-LED ring, several rings or a long strip. The LED
+ * count and geometry are compile-time constants of the topology.
+ */
+namespace TopologyRenderer {
+
+  /**
+   * @brief One rainbow revolution around every ring
+   *
+   * Matches ColorEngine::fillRingRainbow() applied to each ring.
+   * @param out Frame of Topology::LED_COUNT pixels
+   * @param rotation Hue at angle 0
+   * @param val Value (brightness) applied to every pixel
+   */
+  template <class Topology>
+  void ringRainbow(Color* out, uint8_t rotation, uint8_t val) {
+    for (uint16_t i = 0; i < Topology::LED_COUNT; i++) {
+      out[i] = ColorEngine::hsv((uint8_t)(rotation + Topology::angle(i)), 255, val);
+    }
+  }
+
+  /**
+   * @brief Rainbow trail that fades with distance from a head angle
+   *
+   * Hue shifts by up to a full revolution and brightness falls to 60%
+   * at the far side of the ring.
+   *
+   * @param out Frame of Topology::LED_COUNT pixels
+   * @param headAngle Angle of the brightest point on every ring
+   * @param baseHue Hue at the head
+   * @param sat Saturation of every pixel
+   * @param val Value at the head
+   */
+  template <class Topology>
+  void ringTrail(Color* out, uint8_t headAngle, uint8_t baseHue, uint8_t sat, uint8_t val) {
+    for (uint16_t i = 0; i < Topology::LED_COUNT; i++) {
+      uint8_t distance = angularDistance<Topology>(Topology::angle(i), headAngle);
+      uint8_t normalized = distance >= 128 ? 255 : (uint8_t)(distance * 2);
+      uint8_t falloff = ColorEngine::scale8(val, ColorEngine::scale8(normalized, 102));
+      out[i] = ColorEngine::hsv((uint8_t)(baseHue + normalized), sat, val - falloff);
+    }
+  }
+
+} // namespace TopologyRenderer
+
+#endif // TOPOLOGY_RENDERER_H
@@ -0,0 +1,110 @@
+#include "BootSequence.h"
+#include "Config.h"
+
+// Initialize static variables
+BootStage BootSequence::_stages[BOOT_MAX_STAGES];
+uint8_t BootSequence::_stageCount = 0;
+uint8_t BootSequence::_droppedStages = 0;
+BootSequence::Deferred BootSequence::_deferred[BOOT_MAX_DEFERRED];
+uint8_t BootSequence::_deferredCount = 0;
+BootSequence::Background BootSequence::_background = nullptr;
+void* BootSequence::_backgroundContext = nullptr;
+uint32_t BootSequence::_firstFrameUs = 0;
+uint32_t BootSequence::_readyUs = 0;
+bool BootSequence::_finished = false;
+
+void BootSequence::mark(const char* name) {
+    uint32_t now = micros();
+    if (_stageCount >= BOOT_MAX_STAGES) {
+        _droppedStages++;
+        return;
+    }
+    _stages[_stageCount].name = name;
+    _stages[_stageCount].endUs = now;
+    _stageCount++;
+}
+
+void BootSequence::wait(uint32_t ms) {
+    if (_background == nullptr) {
+        delay(ms);
+        return;
+    }
+    uint32_t start = millis();
+    while (millis() - start < ms) {
+        _background(_backgroundContext, millis());
+        // delay() rather than a busy loop, so the idle task still feeds the watchdog
+        delay(1);
+    }
+}
+
+void BootSequence::setBackground(Background task, void* context) {
+    _background = task;
+    _backgroundContext = context;
+}
+
+bool BootSequence::defer(const char* name, Task task, void* context) {
+    if (_finished || _deferredCount >= BOOT_MAX_DEFERRED) {
+        task(context);
+        mark(name);
+        return false;
+    }
+    _deferred[_deferredCount].name = name;
+    _deferred[_deferredCount].task = task;
+    _deferred[_deferredCount].context = context;
+    _deferredCount++;
+    return true;
+}
+
+void BootSequence::finish(Print* out) {
+    if (_finished) {
+        return;
+    }
+    mark("first frame");
+    _firstFrameUs = micros();
+    _finished = true;
+
+    for (uint8_t i = 0; i < _deferredCount; i++) {
+        _deferred[i].task(_deferred[i].context);
+        mark(_deferred[i].name);
+    }
+    _deferredCount = 0;
+    _readyUs = micros();
+
+    if (out != nullptr) {
+        report(*out);
+    }
+}
+
+void BootSequence::report(Print& out) {
+    out.println(F("Boot stages (ms since start, ms spent):"));
+    uint32_t previous = 0;
+    for (uint8_t i = 0; i < _stageCount; i++) {
+        uint32_t end = _stages[i].endUs;
+        out.printf("  %8.1f  %+7.1f  %s\n", end / 1000.0f, (end - previous) / 1000.0f, _stages[i].name);
+        previous = end;
+    }
+    if (_droppedStages > 0) {
+        out.printf("  (%u more stages not recorded)\n", _droppedStages);
+    }
+
+    if (!_finished) {
+        out.println(F("First frame not out yet"));
+        return;
+    }
+    out.printf("First frame at %.1f ms, ready at %.1f ms (budget %lu ms)\n",
+               _firstFrameUs / 1000.0f, _readyUs / 1000.0f, (unsigned long)Config::Boot::BUDGET_MS);
+    if (_firstFrameUs > Config::Boot::BUDGET_MS * 1000UL) {
+        out.println(F("WARNING: first frame is over the boot budget"));
+    }
+}
+
+void BootSequence::reset() {
+    _stageCount = 0;
+    _droppedStages = 0;
+    _deferredCount = 0;
+    _background = nullptr;
+    _backgroundContext = nullptr;
+    _firstFrameUs = 0;
+    _readyUs = 0;
+    _finished = false;
+}
@@ -0,0 +1,104 @@
+#ifndef BOOT_SEQUENCE_H
+#define BOOT_SEQUENCE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// Stages BootSequence records, and work it can hold back until the first frame
+#define BOOT_MAX_STAGES   20
+#define BOOT_MAX_DEFERRED 8
+
+/**
+ * @brief One timed step of startup
+ */
+struct BootStage {
+    const char* name;
+    uint32_t endUs;     // micros() when the stage finished
+};
+
+/**
+ * @brief Times the steps of startup and holds back what the first frame does not need
+ *
+ * Each step ends with mark(); report() prints every step with the time it
+ * took and its time since start. Steps that wait on hardware use wait()
+ * instead of delay(), which keeps a background task running meanwhile (the
+ * boot animation), so the LEDs show life while the IMU settles.
+ *
+ * Work only needed after the first frame is registered with defer().
+ * finish(), called once the first frame is out, marks it, runs the deferred
+ * tasks in order, each as a stage of its own, and reports the lot.
+ */
+class BootSequence {
+public:
+    typedef void (*Task)(void* context);
+    typedef void (*Background)(void* context, uint32_t nowMs);
+
+    /**
+     * @brief End a stage
+     * @param name Stage name; must outlive the boot (a string literal)
+     */
+    static void mark(const char* name);
+
+    /**
+     * @brief delay() that keeps the background task running
+     */
+    static void wait(uint32_t ms);
+
+    /**
+     * @brief Task run about once per millisecond during wait(); nullptr stops it
+     */
+    static void setBackground(Background task, void* context);
+
+    /**
+     * @brief Run a task after the first frame
+     * @param name Stage name it is reported under
+     * @return False if the deferred list is full; the task then runs at once
+     */
+    static bool defer(const char* name, Task task, void* context);
+
+    /**
+     * @brief First frame is out: mark it, run the deferred tasks and report
+     * @param out Where the report goes; nullptr for none
+     */
+    static void finish(Print* out);
+
+    static bool isFinished() { return _finished; }
+    static uint8_t stageCount() { return _stageCount; }
+    static const BootStage& stage(uint8_t index) { return _stages[index]; }
+
+    /**
+     * @brief Time from start to the first frame and to the last deferred task (0 until finished)
+     */
+    static uint32_t firstFrameUs() { return _firstFrameUs; }
+    static uint32_t readyUs() { return _readyUs; }
+
+    /**
+     * @brief Print the stages, their durations and the first frame against Config::Boot::BUDGET_MS
+     */
+    static void report(Print& out);
+
+    /**
+     * @brief Forget everything recorded, for tests
+     */
+    static void reset();
+
+private:
+    struct Deferred {
+        const char* name;
+        Task task;
+        void* context;
+    };
+
+    static BootStage _stages[BOOT_MAX_STAGES];
+    static uint8_t _stageCount;
+    static uint8_t _droppedStages;
+    static Deferred _deferred[BOOT_MAX_DEFERRED];
+    static uint8_t _deferredCount;
+    static Background _background;
+    static void* _backgroundContext;
+    static uint32_t _firstFrameUs;
+    static uint32_t _readyUs;
+    static bool _finished;
+};
+
+#endif // BOOT_SEQUENCE_H
@@ -0,0 +1,365 @@
+#include "CalibrationStore.h"
+#include "Config.h"
+#include "SystemTypes.h"
+#include "../hardware/SerialTx.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include <Preferences.h>
+#else
+#include <stdio.h>
+#endif
+
+// 'PTCS'; a slot holding anything else is treated as empty
+static const uint32_t CALIBRATION_MAGIC = 0x50544353;
+
+static const char* const SLOT_KEYS[CalibrationStore::SLOTS] = {"slot0", "slot1"};
+
+static_assert(sizeof(CalibrationProfile) == 44, "CalibrationProfile must not have padding");
+static_assert(sizeof(CalibrationData) == 44 * CALIBRATION_MAX_PROFILES + 24 + 4 * CALIBRATION_MAX_WEIGHTS,
+              "CalibrationData must not have padding");
+static_assert(sizeof(CalibrationHeader) == 16, "CalibrationHeader must not have padding");
+
+// Initialize static variables
+const uint16_t CalibrationStore::VERSION;
+const uint8_t CalibrationStore::SLOTS;
+const size_t CalibrationStore::SLOT_SIZE;
+const char* CalibrationStore::_name = CALIBRATION_STORE_NAME;
+CalibrationData CalibrationStore::_data;
+uint8_t CalibrationStore::_slot = CalibrationStore::SLOTS;
+uint8_t CalibrationStore::_active = 0;
+uint32_t CalibrationStore::_sequence = 0;
+uint16_t CalibrationStore::_storedVersion = 0;
+
+namespace {
+
+    // Schema 1: a single set of thresholds
+    struct CalibrationDataV1 {
+        float thresholds[6];
+        uint8_t dominantAxes[6];
+        uint8_t flags;
+        uint8_t weightCount;
+        int16_t accelOffset[3];
+        int16_t gyroOffset[3];
+        float scalingFactor;
+        float weights[CALIBRATION_MAX_WEIGHTS];
+    };
+
+#if !defined(ESP_PLATFORM)
+    // Host: one file per slot, "<name>.<key>.bin"
+    void slotPath(const char* name, uint8_t slot, char* path, size_t size) {
+        snprintf(path, size, "%s.%s.bin", name, SLOT_KEYS[slot]);
+    }
+#endif
+
+    uint32_t headerCrc(const CalibrationHeader& header, const uint8_t* payload) {
+        uint32_t crc = CalibrationStore::crc32((const uint8_t*)&header, offsetof(CalibrationHeader, crc));
+        return CalibrationStore::crc32(payload, header.size, crc);
+    }
+
+} // namespace
+
+bool CalibrationStore::begin(const char* name) {
+    _name = name;
+    _slot = SLOTS;
+    _active = 0;
+    _sequence = 0;
+    _storedVersion = 0;
+    defaults(_data);
+
+    uint8_t blob[SLOT_SIZE];
+    CalibrationHeader header;
+    CalibrationData candidate;
+    for (uint8_t slot = 0; slot < SLOTS; slot++) {
+        size_t length = readSlot(slot, blob, sizeof(blob));
+        if (!decode(blob, length, header, candidate)) {
+            continue;
+        }
+        // Newest intact record wins; the sequence comparison survives wrap-around
+        if (_slot == SLOTS || (int32_t)(header.sequence - _sequence) > 0) {
+            _data = candidate;
+            _slot = slot;
+            _sequence = header.sequence;
+            _storedVersion = header.version;
+        }
+    }
+
+    if (_slot == SLOTS) {
+        SerialOut.println("Calibration: none stored, using Config::Calibrated");
+        return false;
+    }
+    _active = _data.bootProfile;
+    if (_storedVersion != VERSION) {
+        SerialOut.printf("Calibration: migrated record from schema %u to %u\n", _storedVersion, VERSION);
+    }
+    return true;
+}
+
+bool CalibrationStore::commit(const CalibrationData& data) {
+    if (!validate(data)) {
+        return false;
+    }
+    uint8_t target = _slot == 0 ? 1 : 0;
+
+    uint8_t blob[SLOT_SIZE];
+    CalibrationHeader header;
+    header.magic = CALIBRATION_MAGIC;
+    header.version = VERSION;
+    header.size = sizeof(CalibrationData);
+    header.sequence = _sequence + 1;
+    header.crc = headerCrc(header, (const uint8_t*)&data);
+    memcpy(blob, &header, sizeof(header));
+    memcpy(blob + sizeof(header), &data, sizeof(data));
+
+    if (!writeSlot(target, blob, sizeof(blob))) {
+        return false;
+    }
+
+    // The new record only counts once it reads back intact
+    CalibrationData check;
+    size_t length = readSlot(target, blob, sizeof(blob));
+    if (!decode(blob, length, header, check) || memcmp(&check, &data, sizeof(data)) != 0) {
+        return false;
+    }
+
+    _data = data;
+    if (_active >= _data.profileCount) {
+        _active = _data.bootProfile;
+    }
+    _slot = target;
+    _sequence = header.sequence;
+    _storedVersion = VERSION;
+    return true;
+}
+
+bool CalibrationStore::erase() {
+    bool erased = true;
+#if defined(ESP_PLATFORM)
+    Preferences preferences;
+    erased = preferences.begin(_name, false) && preferences.clear();
+    preferences.end();
+#else
+    char path[128];
+    for (uint8_t slot = 0; slot < SLOTS; slot++) {
+        slotPath(_name, slot, path, sizeof(path));
+        remove(path);
+    }
+#endif
+    _slot = SLOTS;
+    _active = 0;
+    _sequence = 0;
+    _storedVersion = 0;
+    defaults(_data);
+    return erased;
+}
+
+bool CalibrationStore::select(uint8_t index) {
+    if (index >= _data.profileCount) {
+        return false;
+    }
+    _active = index;
+    return true;
+}
+
+int8_t CalibrationStore::find(const char* name) {
+    for (uint8_t i = 0; i < _data.profileCount; i++) {
+        if (strcmp(_data.profiles[i].name, name) == 0) {
+            return (int8_t)i;
+        }
+    }
+    char* end;
+    long number = strtol(name, &end, 10);
+    if (*name != '\0' && *end == '\0' && number >= 1 && number <= _data.profileCount) {
+        return (int8_t)(number - 1);
+    }
+    return -1;
+}
+
+void CalibrationStore::defaults(CalibrationData& data) {
+    memset(&data, 0, sizeof(data));
+    defaults(data.profiles[0], 0);
+    data.profileCount = 1;
+}
+
+void CalibrationStore::defaults(CalibrationProfile& profile, uint8_t index) {
+    memset(&profile, 0, sizeof(profile));
+    snprintf(profile.name, sizeof(profile.name), "wearer%u", index + 1);
+    profile.thresholds[POS_OFFER] = Config::Calibrated::OFFER_THRESHOLD;
+    profile.thresholds[POS_CALM] = Config::Calibrated::CALM_THRESHOLD;
+    profile.thresholds[POS_OATH] = Config::Calibrated::OATH_THRESHOLD;
+    profile.thresholds[POS_DIG] = Config::Calibrated::DIG_THRESHOLD;
+    profile.thresholds[POS_SHIELD] = Config::Calibrated::SHIELD_THRESHOLD;
+    profile.thresholds[POS_NULLPOS] = Config::Calibrated::NULL_THRESHOLD;
+    profile.dominantAxes[POS_OFFER] = Config::Calibrated::OFFER_AXIS;
+    profile.dominantAxes[POS_CALM] = Config::Calibrated::CALM_AXIS;
+    profile.dominantAxes[POS_OATH] = Config::Calibrated::OATH_AXIS;
+    profile.dominantAxes[POS_DIG] = Config::Calibrated::DIG_AXIS;
+    profile.dominantAxes[POS_SHIELD] = Config::Calibrated::SHIELD_AXIS;
+    profile.dominantAxes[POS_NULLPOS] = Config::Calibrated::NULL_AXIS;
+}
+
+void CalibrationStore::print(Print& out) {
+    static const char* const NAMES[6] = {"offer", "calm", "oath", "dig", "shield", "null"};
+    static const char AXES[3] = {'X', 'Y', 'Z'};
+
+    if (isStored()) {
+        out.printf("Calibration: slot %u, sequence %lu, schema %u\n", _slot, (unsigned long)_sequence, _storedVersion);
+    } else {
+        out.println("Calibration: none stored, Config::Calibrated defaults");
+    }
+    for (uint8_t p = 0; p < _data.profileCount; p++) {
+        const CalibrationProfile& profile = _data.profiles[p];
+        out.printf("%c %u %-*s%s\n", p == _active ? '*' : ' ', p + 1, CALIBRATION_NAME_LENGTH, profile.name,
+                   p == _data.bootProfile ? " (boot)" : "");
+        for (uint8_t i = 0; i < 6; i++) {
+            out.printf("    %-7s %c %7.2f m/s2\n", NAMES[i], AXES[profile.dominantAxes[i] % 3], profile.thresholds[i]);
+        }
+    }
+    if (_data.scalingFactor > 0.0f) {
+        out.printf("  scaling %.7f m/s2 per count\n", _data.scalingFactor);
+    }
+    if (_data.flags & CALIBRATION_HAS_IMU_OFFSETS) {
+        out.printf("  accel offset %d %d %d, gyro offset %d %d %d\n", _data.accelOffset[0], _data.accelOffset[1],
+                   _data.accelOffset[2], _data.gyroOffset[0], _data.gyroOffset[1], _data.gyroOffset[2]);
+        out.printf("  taken on WHO_AM_I 0x%02X at %.1f C\n", _data.imuWhoAmI, _data.imuTemperature / 100.0f);
+    }
+    if (_data.flags & CALIBRATION_HAS_WEIGHTS) {
+        out.printf("  classifier weights: %u\n", _data.weightCount);
+    }
+}
+
+uint32_t CalibrationStore::crc32(const uint8_t* data, size_t length, uint32_t crc) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+size_t CalibrationStore::readSlot(uint8_t slot, uint8_t* buffer, size_t size) {
+    if (slot >= SLOTS) return 0;
+#if defined(ESP_PLATFORM)
+    Preferences preferences;
+    if (!preferences.begin(_name, true)) {
+        return 0;
+    }
+    // One read of the whole blob; a blob larger than the buffer reads as empty
+    size_t length = preferences.getBytes(SLOT_KEYS[slot], buffer, size);
+    preferences.end();
+    return length;
+#else
+    char path[128];
+    slotPath(_name, slot, path, sizeof(path));
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return 0;
+    }
+    size_t length = fread(buffer, 1, size, file);
+    fclose(file);
+    return length;
+#endif
+}
+
+bool CalibrationStore::writeSlot(uint8_t slot, const uint8_t* data, size_t size) {
+    if (slot >= SLOTS) return false;
+#if defined(ESP_PLATFORM)
+    // NVS replaces a blob only once the new copy is fully written
+    Preferences preferences;
+    if (!preferences.begin(_name, false)) {
+        return false;
+    }
+    bool written = preferences.putBytes(SLOT_KEYS[slot], data, size) == size;
+    preferences.end();
+    return written;
+#else
+    // Write a temporary file and rename it over the slot, as NVS does
+    char path[128];
+    char temp[136];
+    slotPath(_name, slot, path, sizeof(path));
+    snprintf(temp, sizeof(temp), "%s.tmp", path);
+    FILE* file = fopen(temp, "wb");
+    if (!file) {
+        return false;
+    }
+    bool written = fwrite(data, 1, size, file) == size;
+    written = fclose(file) == 0 && written;
+    return written && rename(temp, path) == 0;
+#endif
+}
+
+/**
+ * Check a stored blob and bring its payload to the current schema
+ */
+bool CalibrationStore::decode(const uint8_t* blob, size_t length, CalibrationHeader& header, CalibrationData& data) {
+    if (length < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, blob, sizeof(header));
+    const uint8_t* payload = blob + sizeof(header);
+    if (header.magic != CALIBRATION_MAGIC || header.size > length - sizeof(header) ||
+        headerCrc(header, payload) != header.crc) {
+        return false;
+    }
+    return migrate(header.version, payload, header.size, data);
+}
+
+/**
+ * Bring a payload of any known schema version to the current CalibrationData
+ *
+ * Each step converts from the version before it; a record from firmware
+ * newer than this one is not understood and reads as empty.
+ */
+bool CalibrationStore::migrate(uint16_t version, const uint8_t* payload, size_t size, CalibrationData& data) {
+    switch (version) {
+        case 1: {
+            // Schema 1 thresholds become the first and only profile
+            CalibrationDataV1 v1;
+            if (size != sizeof(v1)) return false;
+            memcpy(&v1, payload, sizeof(v1));
+            defaults(data);
+            memcpy(data.profiles[0].thresholds, v1.thresholds, sizeof(v1.thresholds));
+            memcpy(data.profiles[0].dominantAxes, v1.dominantAxes, sizeof(v1.dominantAxes));
+            data.flags = v1.flags & ~CALIBRATION_HAS_IMU_OFFSETS;
+            data.weightCount = v1.weightCount;
+            memcpy(data.accelOffset, v1.accelOffset, sizeof(v1.accelOffset));
+            memcpy(data.gyroOffset, v1.gyroOffset, sizeof(v1.gyroOffset));
+            data.scalingFactor = v1.scalingFactor;
+            memcpy(data.weights, v1.weights, sizeof(v1.weights));
+            return validate(data);
+        }
+        case 2:
+            // Schema 3 appended the IMU fingerprint; offsets without one are taken again
+            if (size != offsetof(CalibrationData, imuWhoAmI)) return false;
+            memset(&data, 0, sizeof(data));
+            memcpy(&data, payload, size);
+            data.flags &= ~CALIBRATION_HAS_IMU_OFFSETS;
+            return validate(data);
+        case 3:
+            if (size != sizeof(CalibrationData)) return false;
+            memcpy(&data, payload, sizeof(data));
+            return validate(data);
+        default:
+            return false;
+    }
+}
+
+/**
+ * True if a record can be used as it is
+ */
+bool CalibrationStore::validate(const CalibrationData& data) {
+    if (data.profileCount == 0 || data.profileCount > CALIBRATION_MAX_PROFILES ||
+        data.bootProfile >= data.profileCount || data.weightCount > CALIBRATION_MAX_WEIGHTS) {
+        return false;
+    }
+    for (uint8_t p = 0; p < data.profileCount; p++) {
+        if (memchr(data.profiles[p].name, '\0', sizeof(data.profiles[p].name)) == nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
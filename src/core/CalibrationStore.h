@@ -0,0 +1,175 @@
+#ifndef CALIBRATION_STORE_H
+#define CALIBRATION_STORE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// NVS namespace of the store on the device; on the host, the files "<name>.slot<n>.bin"
+#ifndef CALIBRATION_STORE_NAME
+#define CALIBRATION_STORE_NAME "calib"
+#endif
+
+// Wearer profiles a record holds, and the longest profile name
+#define CALIBRATION_MAX_PROFILES 4
+#define CALIBRATION_NAME_LENGTH  11
+
+// Classifier weights a record can carry
+#define CALIBRATION_MAX_WEIGHTS 16
+
+// CalibrationData::flags
+#define CALIBRATION_HAS_IMU_OFFSETS 0x01
+#define CALIBRATION_HAS_WEIGHTS     0x02
+
+/**
+ * @brief Position thresholds of one wearer
+ *
+ * Hand size and mounting angle move the gravity vectors, so each wearer
+ * has their own.
+ */
+struct CalibrationProfile {
+    char name[CALIBRATION_NAME_LENGTH + 1];
+    float thresholds[6];        // Per HandPosition, m/s² on the dominant axis
+    uint8_t dominantAxes[6];    // Per HandPosition, 0 = X, 1 = Y, 2 = Z
+    uint8_t reserved[2];
+};
+
+/**
+ * @brief Everything calibrated for one gauntlet (schema version 3)
+ *
+ * Stored as is: little-endian, no padding. Changing the layout means a new
+ * CalibrationStore::VERSION and a migration step from the previous one.
+ */
+struct CalibrationData {
+    CalibrationProfile profiles[CALIBRATION_MAX_PROFILES];
+    uint8_t profileCount;       // Profiles in use, at least 1
+    uint8_t bootProfile;        // Profile active after boot
+    uint8_t flags;              // CALIBRATION_HAS_*
+    uint8_t weightCount;        // Classifier weights in use
+    int16_t accelOffset[3];     // IMU bias, raw counts (CALIBRATION_HAS_IMU_OFFSETS)
+    int16_t gyroOffset[3];
+    float scalingFactor;        // Raw counts to m/s²; 0 keeps the detector's default
+    float weights[CALIBRATION_MAX_WEIGHTS];  // Optional classifier weights (CALIBRATION_HAS_WEIGHTS)
+    uint8_t imuWhoAmI;          // Sensor the IMU offsets were taken on (CALIBRATION_HAS_IMU_OFFSETS)
+    uint8_t reserved;
+    int16_t imuTemperature;     // Its die temperature then, 0.01 °C
+};
+
+/**
+ * @brief Header in front of each stored record
+ */
+struct CalibrationHeader {
+    uint32_t magic;
+    uint16_t version;           // Schema version of the payload
+    uint16_t size;              // Payload bytes
+    uint32_t sequence;          // Commit counter; the intact slot with the higher one is current
+    uint32_t crc;               // CRC32 of the header fields above and the payload
+};
+
+/**
+ * @brief Versioned, CRC-checked calibration record in NVS
+ *
+ * Two slots hold the record. A commit writes the slot not holding the
+ * current record, with the next sequence number, and reads it back before
+ * it counts; power lost part way leaves a slot that fails its CRC and the
+ * previous record stays current. begin() reads each slot in one go at boot
+ * and keeps the newest intact record in RAM, migrated to the current schema.
+ *
+ * Every profile is in RAM from then on: select() switches the active one
+ * by index, without touching flash.
+ *
+ * Built for the host, the slots live in files instead of NVS.
+ */
+class CalibrationStore {
+public:
+    static const uint16_t VERSION = 3;
+    static const uint8_t SLOTS = 2;
+    static const size_t SLOT_SIZE = sizeof(CalibrationHeader) + sizeof(CalibrationData);
+
+    /**
+     * @brief Load the current record; call once at boot
+     * @param name NVS namespace, or host file name without ".bin"
+     * @return True if a stored record was found; otherwise the defaults are in use
+     */
+    static bool begin(const char* name = CALIBRATION_STORE_NAME);
+
+    /**
+     * @brief The current calibration, or the Config::Calibrated defaults if none is stored
+     */
+    static const CalibrationData& data() { return _data; }
+
+    /**
+     * @brief Profiles in use and the one the detector should use now
+     */
+    static uint8_t profileCount() { return _data.profileCount; }
+    static uint8_t activeProfile() { return _active; }
+    static const CalibrationProfile& active() { return _data.profiles[_active]; }
+    static const CalibrationProfile& profile(uint8_t index) { return _data.profiles[index]; }
+
+    /**
+     * @brief Make a profile the active one; RAM only, nothing is written
+     * @return False if there is no such profile
+     */
+    static bool select(uint8_t index);
+
+    /**
+     * @brief Index of a profile by name, or by its number as text ("1" is the first)
+     * @return The index, or -1
+     */
+    static int8_t find(const char* name);
+
+    /**
+     * @brief Store a new record in the free slot
+     * @return True once the record reads back intact; on failure the previous one stays current
+     */
+    static bool commit(const CalibrationData& data);
+
+    /**
+     * @brief Forget both slots and return to the defaults
+     */
+    static bool erase();
+
+    /**
+     * @brief Fill a record with one profile holding the Config::Calibrated thresholds and axes
+     */
+    static void defaults(CalibrationData& data);
+    static void defaults(CalibrationProfile& profile, uint8_t index);
+
+    static bool isStored() { return _slot < SLOTS; }
+    static uint32_t sequence() { return _sequence; }
+
+    /**
+     * @brief Schema version the current record was stored with (0 if none)
+     */
+    static uint16_t storedVersion() { return _storedVersion; }
+
+    /**
+     * @brief Print the current record, its profiles and where it came from
+     */
+    static void print(Print& out);
+
+    /**
+     * @brief CRC-32 (IEEE 802.3, reflected, poly 0xEDB88320)
+     */
+    static uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0);
+
+    /**
+     * @brief Raw slot access, for tests and tools
+     * @return Bytes read; 0 if the slot is empty
+     */
+    static size_t readSlot(uint8_t slot, uint8_t* buffer, size_t size);
+    static bool writeSlot(uint8_t slot, const uint8_t* data, size_t size);
+
+private:
+    static bool decode(const uint8_t* blob, size_t length, CalibrationHeader& header, CalibrationData& data);
+    static bool migrate(uint16_t version, const uint8_t* payload, size_t size, CalibrationData& data);
+    static bool validate(const CalibrationData& data);
+
+    static const char* _name;
+    static CalibrationData _data;
+    static uint8_t _slot;           // Slot holding the current record; SLOTS if none
+    static uint8_t _active;         // Active profile
+    static uint32_t _sequence;
+    static uint16_t _storedVersion;
+};
+
+#endif // CALIBRATION_STORE_H
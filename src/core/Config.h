@@ -14,9 +14,26 @@ namespace Config {
   constexpr uint8_t I2C_SCL_PIN = 22;   // I2C clock line
   
   // LED configuration
-  constexpr uint8_t NUM_LEDS = 12;      // Number of LEDs in the ring
+  constexpr uint16_t LEDS_PER_RING = 12; // LEDs in each ring (see hardware/LEDTopology.h)
+  constexpr uint8_t NUM_RINGS = 1;       // Rings wired in series
+  constexpr uint16_t NUM_LEDS = LEDS_PER_RING * NUM_RINGS; // Total number of LEDs
   constexpr uint8_t DEFAULT_BRIGHTNESS = 100; // Default brightness (0-255) - 39% brightness as per hardware analysis
   constexpr uint8_t LOW_POWER_BRIGHTNESS = 20;    // 0-255
+  constexpr uint16_t LED_FRAME_PERIOD_MS = 5;     // Minimum time between LED transfers (200 fps cap)
+  constexpr uint16_t DISPLAY_FRAME_PERIOD_MS = 8; // Time between rendered frames (125 fps; 5-10 ms for 100-200 fps)
+  constexpr uint16_t LOGIC_PERIOD_MS = 20;        // Mode and sensor update period (50 Hz)
+  constexpr uint16_t IDLE_LOGIC_PERIOD_MS = 40;   // Slower logic while idle (25 Hz); rendering keeps its rate
+  constexpr uint16_t SERIAL_DRAIN_POLL_MS = 2;     // Idle-time serial drain interval (the UART FIFO holds ~11 ms at 115200 baud)
+  constexpr bool LED_GAMMA_CORRECTION = true;    // Gamma 2.5 in the output stage
+  constexpr bool LED_TEMPORAL_DITHER = true;     // Keep 16-bit levels by dithering over frames
+  constexpr uint16_t LED_MA_PER_CHANNEL = 20;     // WS2812 current per color channel at full output
+  constexpr uint8_t LED_IDLE_MA = 1;              // WS2812 quiescent current per LED
+  constexpr uint16_t LED_POWER_BUDGET_MA = 450;   // Default LED current limit (full white ring is ~730 mA)
+  constexpr uint8_t LED_LIMIT_RELEASE_STEP = 8;   // Limiter recovery per frame (0-255 scale)
+  constexpr uint16_t LED_WIRE_US_PER_LED = 30;    // WS2812 bit-stream time per LED (24 bits at 800 kHz)
+  constexpr uint16_t LED_WIRE_RESET_US = 80;      // Latch time after the last bit
+  constexpr uint8_t LED_WIRE_TASK_CORE = 0;       // Core that runs the LED transfer task (loop() runs on core 1)
+  constexpr uint8_t LED_WIRE_TASK_PRIORITY = 2;
   
   // Sensor configuration
   constexpr uint8_t POSITION_SAMPLE_RATE = 50;  // Hz
@@ -66,6 +83,10 @@ namespace Config {
    * 4. Paste them below, replacing the current values
    * 5. Include the calibration date in the comment
    * 
+   * The protocol also saves its result to the CalibrationStore, which the
+   * firmware loads at boot in preference to these values; they remain the
+   * defaults when nothing is stored ('calibration erase' returns to them).
+   * 
    * Last calibration: 2025-03-30
    */
   namespace Calibrated {
@@ -92,6 +113,8 @@ namespace Config {
   constexpr uint16_t LONGNULL_WARNING_MS = 3000;  // When to start flashing during LongNull (deprecated)
   constexpr uint16_t LONGSHIELD_TIME_MS = 5000;   // Time required for LongShield gesture
   constexpr uint16_t LONGSHIELD_WARNING_MS = 3000; // When to start flashing during LongShield
+  constexpr uint16_t LONGOATH_TIME_MS = 5000;     // Oath held in Idle this long switches calibration profile
+  constexpr uint16_t PROFILE_FLASH_MS = 1000;     // How long the new profile number is shown
   constexpr uint16_t QUICKCAST_WINDOW_MS = 1000;   // Time window for QuickCast gestures
   
   // Gesture detection parameters
@@ -103,6 +126,11 @@ namespace Config {
   // Freecast timing
   constexpr uint16_t FREECAST_COLLECTION_MS = 2000; // Motion data collection window (Corrected to 2s)
   constexpr uint16_t FREECAST_DISPLAY_MS = 2000;    // Pattern display duration (Corrected to 2s)
+  constexpr uint16_t FREECAST_CACHE_BYTES = 10240;  // Baked display phase (2 s at the display rate, delta-encoded)
+  constexpr uint8_t FREECAST_BAKE_FRAMES_PER_TICK = 50; // Frames baked per logic tick at the start of the display phase
+  
+  // Animation scheduler
+  constexpr uint8_t ANIMATION_SLOTS = 8;            // Animations that can run at once
   
   // Power management
   constexpr uint32_t IDLE_SLEEP_DELAY_MS = 300000; // Time before entering sleep mode (5 min)
@@ -143,14 +171,6 @@ namespace Config {
   // System power states
   constexpr unsigned long IDLE_TIMEOUT = 30000;  // Time before entering low power (30s)
 
-  // QuickCast Spell Parameters <-- Added Namespace
-  namespace Spells {
-    constexpr uint16_t RAINBOW_DURATION_MS = 8000;   // Rainbow Burst duration (8s)
-    constexpr uint16_t LIGHTNING_DURATION_MS = 5000; // Lightning Blast duration (5s)
-    constexpr uint16_t LUMINA_DURATION_MS = 60000;  // Lumina duration (60s) - Updated from 20s
-    constexpr uint8_t LUMINA_BRIGHTNESS = 204;      // Lumina brightness (80% of 255)
-  }
-  
   // Shake Detection Parameters
   namespace ShakeDetection {
     // Detection thresholds
@@ -164,9 +184,34 @@ namespace Config {
     // Timing parameters
     constexpr uint16_t SHAKE_COOLDOWN_MS = 1000;        // Prevent rapid re-triggering
     
-    // Cancellation animation
-    constexpr uint8_t CANCEL_FLASH_COUNT = 3;          // Number of flashes for cancel animation
-    constexpr uint16_t CANCEL_FLASH_DURATION_MS = 50;  // Duration of each flash
+    // The cancellation flash is src/animation/scripts/cancel_flash.anim
+  }
+  
+  // IMU bias offsets: reused from the CalibrationStore at boot, refreshed while still
+  namespace ImuCalibration {
+    // Boot check of stored offsets
+    constexpr float MAX_TEMPERATURE_DRIFT_C = 15.0f;  // Die temperature change that calls for a new calibration
+    constexpr float GRAVITY_TOLERANCE = 0.25f;        // Corrected |accel| must be within 25% of 1g
+    
+    // A full calibration counts as good if no axis moved more than this (counts, ~0.2g at ±4g)
+    constexpr int16_t GOOD_CALIBRATION_SPAN = 1600;
+    
+    // Background check, one window per STILL_WINDOW_SAMPLES sensor updates (~1s)
+    constexpr uint8_t STILL_WINDOW_SAMPLES = 50;
+    constexpr int16_t STILL_GYRO_SPAN = 60;       // Counts, ~1 deg/s at ±500 deg/s
+    constexpr int16_t STILL_ACCEL_SPAN = 400;     // Counts, ~0.05g at ±4g
+    constexpr int16_t LEVEL_TOLERANCE = 820;      // Counts, ~0.1g; accel bias is only retaken lying level
+    constexpr int16_t GYRO_DRIFT = 8;             // Bias change worth applying, counts
+    constexpr int16_t ACCEL_DRIFT = 40;
+    constexpr uint32_t COMMIT_INTERVAL_MS = 600000; // At most one NVS write per 10 minutes
+  }
+  
+  // Startup, timed stage by stage by BootSequence
+  namespace Boot {
+    constexpr uint32_t BUDGET_MS = 500;            // Start to first frame; the boot report warns above it
+    constexpr uint16_t IMU_RESET_MS = 100;         // Settle time after an IMU device reset
+    constexpr uint16_t IMU_DATA_TIMEOUT_MS = 50;   // Longest wait for the first sample (125 Hz: one every 8 ms)
+    constexpr uint16_t ANIMATION_PERIOD_MS = 600;  // One turn of the boot sweep
   }
 }
 
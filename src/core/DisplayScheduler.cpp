@@ -0,0 +1,71 @@
+#include "DisplayScheduler.h"
+
+DisplayScheduler::DisplayScheduler()
+    : logicPeriodMs_(20),
+      renderPeriodMs_(10),
+      lastLogicMs_(0),
+      nextRenderMs_(0),
+      current_{0, 0, 0},
+      lastSecond_{0, 0, 0},
+      windowStartMs_(0)
+{
+}
+
+void DisplayScheduler::init(uint16_t logicPeriodMs, uint16_t renderPeriodMs, uint32_t nowMs) {
+    logicPeriodMs_ = logicPeriodMs;
+    setRenderPeriod(renderPeriodMs);
+
+    // The first tick and frame are due immediately
+    lastLogicMs_ = nowMs - logicPeriodMs_;
+    nextRenderMs_ = nowMs;
+
+    current_ = {0, 0, 0};
+    lastSecond_ = {0, 0, 0};
+    windowStartMs_ = nowMs;
+}
+
+bool DisplayScheduler::logicDue(uint32_t nowMs) {
+    rollStats(nowMs);
+    if (nowMs - lastLogicMs_ < logicPeriodMs_) {
+        return false;
+    }
+    lastLogicMs_ = nowMs;
+    current_.logicTicks++;
+    return true;
+}
+
+bool DisplayScheduler::renderDue(uint32_t nowMs) {
+    rollStats(nowMs);
+    // Signed difference so the comparison survives millis() wrapping
+    if ((int32_t)(nowMs - nextRenderMs_) < 0) {
+        return false;
+    }
+
+    nextRenderMs_ += renderPeriodMs_;
+    if ((int32_t)(nowMs - nextRenderMs_) >= 0) {
+        // More than a frame behind: drop the missed slots rather than bursting
+        uint32_t missed = (nowMs - nextRenderMs_) / renderPeriodMs_ + 1;
+        current_.lateFrames += missed;
+        nextRenderMs_ += missed * renderPeriodMs_;
+    }
+    current_.renderFrames++;
+    return true;
+}
+
+uint32_t DisplayScheduler::millisUntilNext(uint32_t nowMs) const {
+    uint32_t elapsed = nowMs - lastLogicMs_;
+    uint32_t untilLogic = elapsed >= logicPeriodMs_ ? 0 : logicPeriodMs_ - elapsed;
+    int32_t untilRender = (int32_t)(nextRenderMs_ - nowMs);
+    if (untilRender <= 0) {
+        return 0;
+    }
+    return (uint32_t)untilRender < untilLogic ? (uint32_t)untilRender : untilLogic;
+}
+
+void DisplayScheduler::rollStats(uint32_t nowMs) {
+    if (nowMs - windowStartMs_ >= 1000) {
+        lastSecond_ = current_;
+        current_ = {0, 0, 0};
+        windowStartMs_ = nowMs;
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef DISPLAY_SCHEDULER_H
+#define DISPLAY_SCHEDULER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Scheduler counters for one second of operation
+ */
+struct SchedulerStats {
+    uint16_t logicTicks;    // Mode/sensor updates run
+    uint16_t renderFrames;  // Frames rendered
+    uint16_t lateFrames;    // Render slots dropped because the loop fell behind
+};
+
+/**
+ * @brief Runs logic updates and frame rendering on independent clocks
+ *
+ * Logic (sensor reads, gesture detection, mode state) ticks at one rate and
+ * rendering at another, usually several times faster. Renderers are pure
+ * functions of mode state and the render time, so between two logic ticks
+ * they keep advancing animations and time-based transitions instead of
+ * repeating the last frame. The logic period can change at any time, e.g.
+ * to tick slower in Idle, without affecting the frame rate.
+ */
+class DisplayScheduler {
+public:
+    DisplayScheduler();
+
+    /**
+     * @brief Start both clocks
+     * @param logicPeriodMs Time between logic ticks
+     * @param renderPeriodMs Time between rendered frames
+     * @param nowMs Current time in milliseconds
+     */
+    void init(uint16_t logicPeriodMs, uint16_t renderPeriodMs, uint32_t nowMs);
+
+    /**
+     * @brief Change the logic rate; takes effect from the next tick
+     */
+    void setLogicPeriod(uint16_t periodMs) { logicPeriodMs_ = periodMs; }
+    uint16_t getLogicPeriod() const { return logicPeriodMs_; }
+
+    /**
+     * @brief Change the frame rate; takes effect from the next frame
+     */
+    void setRenderPeriod(uint16_t periodMs) { renderPeriodMs_ = periodMs > 0 ? periodMs : 1; }
+    uint16_t getRenderPeriod() const { return renderPeriodMs_; }
+
+    /**
+     * @brief True if a logic tick is due; claims it
+     * @param nowMs Current time in milliseconds
+     */
+    bool logicDue(uint32_t nowMs);
+
+    /**
+     * @brief True if a frame is due; claims it
+     *
+     * Frames keep a fixed cadence. If the loop stalled for more than a
+     * frame, the missed slots are counted as late and not rendered.
+     * @param nowMs Current time in milliseconds
+     */
+    bool renderDue(uint32_t nowMs);
+
+    /**
+     * @brief Time until the next tick or frame, whichever comes first
+     * @param nowMs Current time in milliseconds
+     */
+    uint32_t millisUntilNext(uint32_t nowMs) const;
+
+    /**
+     * @brief Counters for the last complete second
+     */
+    const SchedulerStats& getStats() const { return lastSecond_; }
+
+private:
+    uint16_t logicPeriodMs_;
+    uint16_t renderPeriodMs_;
+    uint32_t lastLogicMs_;
+    uint32_t nextRenderMs_;
+
+    SchedulerStats current_;
+    SchedulerStats lastSecond_;
+    uint32_t windowStartMs_;
+
+    void rollStats(uint32_t nowMs);
+};
+
+#endif // DISPLAY_SCHEDULER_H
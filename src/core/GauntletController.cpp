@@ -1,7 +1,13 @@
 #include "GauntletController.h"
 #include "Config.h"
+#include "CalibrationStore.h"
+#include "BootSequence.h"
 #include <Arduino.h>
 #include "../utils/DebugTools.h"
+#include "../hardware/SerialTx.h"
+#include "../animation/AnimationPrograms.h"
+#include "../diagnostics/TelemetryStream.h"
+#include "../diagnostics/FlightRecorder.h"
 
 // LUTT Diagnostic includes (conditionally compiled)
 #if DIAG_LOGGING_ENABLED
@@ -16,8 +22,7 @@ GauntletController::GauntletController()
       quickCastMode(nullptr),
       freecastMode(nullptr),
       currentMode(SystemMode::IDLE),
-      lastUpdateTime(0),
-      updateInterval(20), // 50Hz update rate
+      calibrationProfile(0),
       inModeTransition(false)
 {
     #if DIAG_LOGGING_ENABLED
@@ -66,20 +71,26 @@ void GauntletController::initialize() {
         DIAG_CRITICAL(DIAG_TAG_MODE, "HardwareManager initialization failed");
         #endif
         
+        FlightRecorder::halt(FLIGHT_EVENT_INIT_FAILED, FLIGHT_INIT_HARDWARE);
         while(1) delay(1000);
     }
     
-    // Initialize position detector
+    animations.init(hardwareManager->getCompositor());
+    
+    // Initialize position detector; HardwareManager::init() has loaded the stored calibration
     positionDetector = new UltraBasicPositionDetector();
     if (!positionDetector->init(hardwareManager)) {
-        Serial.println(F("Position detector initialization failed!"));
+        SerialOut.println(F("Position detector initialization failed!"));
         
         #if DIAG_LOGGING_ENABLED
         DIAG_CRITICAL(DIAG_TAG_MODE, "Position detector initialization failed");
         #endif
         
+        FlightRecorder::halt(FLIGHT_EVENT_INIT_FAILED, FLIGHT_INIT_DETECTOR);
         while(1) delay(1000);
     }
+    calibrationProfile = CalibrationStore::activeProfile();
+    BootSequence::mark("position detector");
     
     // Initialize Idle Mode
     idleMode = new IdleMode();
@@ -90,49 +101,116 @@ void GauntletController::initialize() {
         DIAG_CRITICAL(DIAG_TAG_MODE, "IdleMode initialization failed");
         #endif
         
+        FlightRecorder::halt(FLIGHT_EVENT_INIT_FAILED, FLIGHT_INIT_IDLE);
         while(1) delay(1000);
     }
     idleMode->initialize();
+    BootSequence::mark("idle mode");
+    
+    // QuickCast and FreeCast wait until the first frame is out
+    BootSequence::defer("spell modes", initSpellModes, this);
+    
+    TelemetryStream::setScalingFactor(positionDetector->getScalingFactor());
+    
+    // Set starting system mode
+    currentMode = SystemMode::IDLE;
+    scheduler.init(Config::IDLE_LOGIC_PERIOD_MS, Config::DISPLAY_FRAME_PERIOD_MS, millis());
+    
+    SerialOut.println(F("GauntletController initialized successfully"));
+    
+    #if DIAG_LOGGING_ENABLED
+    DIAG_INFO(DIAG_TAG_MODE, "GauntletController initialized successfully");
+    #endif
+}
+
+/**
+ * @brief Set up the QuickCast and FreeCast modes; deferred by initialize()
+ * @param context The GauntletController
+ */
+void GauntletController::initSpellModes(void* context) {
+    GauntletController* self = static_cast<GauntletController*>(context);
     
     // Initialize QuickCastSpells Mode
-    quickCastMode = new QuickCastSpellsMode();
-    if (!quickCastMode->init(hardwareManager)) {
-        Serial.println(F("QuickCastSpells mode initialization failed!"));
+    self->quickCastMode = new QuickCastSpellsMode();
+    if (!self->quickCastMode->init(self->hardwareManager, &self->animations)) {
+        SerialOut.println(F("QuickCastSpells mode initialization failed!"));
         
         #if DIAG_LOGGING_ENABLED
         DIAG_CRITICAL(DIAG_TAG_MODE, "QuickCastSpellsMode initialization failed");
         #endif
         
+        FlightRecorder::halt(FLIGHT_EVENT_INIT_FAILED, FLIGHT_INIT_QUICKCAST);
         while(1) delay(1000);
     }
     
     // Initialize Freecast Mode
-    freecastMode = new FreeCastMode();
-    if (!freecastMode->init(hardwareManager, positionDetector)) {
+    self->freecastMode = new FreeCastMode();
+    if (!self->freecastMode->init(self->hardwareManager, self->positionDetector)) {
         DEBUG_PRINTLN("ERROR: FreeCastMode initialization failed!");
         
         #if DIAG_LOGGING_ENABLED
         DIAG_CRITICAL(DIAG_TAG_MODE, "FreeCastMode initialization failed");
         #endif
         
+        FlightRecorder::halt(FLIGHT_EVENT_INIT_FAILED, FLIGHT_INIT_FREECAST);
         while(1) delay(1000);
     }
+}
+
+/**
+ * @brief Whether initSpellModes() has run; both modes are nullptr until then
+ */
+bool GauntletController::spellModesReady() const {
+    return quickCastMode != nullptr && freecastMode != nullptr;
+}
+
+void GauntletController::update() {
+    uint32_t now = millis();
     
-    // Set starting system mode
-    currentMode = SystemMode::IDLE;
-    lastUpdateTime = millis();
+    if (scheduler.logicDue(now)) {
+        SystemMode previousMode = currentMode;
+        uint32_t tickStartUs = micros();
+        updateLogic();
+        FlightRecorder::sample(hardwareManager->getSensorData(), positionDetector->getCurrentPosition().position,
+                               micros() - tickStartUs);
+        if (currentMode != previousMode) {
+            FlightRecorder::event(FLIGHT_EVENT_MODE, static_cast<uint16_t>(currentMode));
+        }
+        
+        // Idle only watches for gestures; spells and FreeCast sample motion at full rate
+        scheduler.setLogicPeriod(currentMode == SystemMode::IDLE ? Config::IDLE_LOGIC_PERIOD_MS
+                                                                 : Config::LOGIC_PERIOD_MS);
+        now = millis();
+    }
     
-    Serial.println(F("GauntletController initialized successfully"));
+    if (scheduler.renderDue(now)) {
+        uint32_t renderStartUs = micros();
+        renderFrame(now);
+        FlightRecorder::noteRender(micros() - renderStartUs);
+        
+        // The first frame is out: run what startup held back and report the boot
+        if (!BootSequence::isFinished()) {
+            BootSequence::finish(&SerialOut);
+        }
+    }
     
-    #if DIAG_LOGGING_ENABLED
-    DIAG_INFO(DIAG_TAG_MODE, "GauntletController initialized successfully");
-    #endif
+    // Telemetry samples the IMU on its own clock, usually faster than the logic tick
+    uint32_t nowUs = micros();
+    if (TelemetryStream::due(nowUs)) {
+        streamTelemetry(nowUs);
+    }
+    
+    // Sleep until the next tick or frame
+    maintainLoopTiming();
 }
 
-void GauntletController::update() {
+void GauntletController::updateLogic() {
     // Update hardware first
     hardwareManager->update();
     
+    // Book LED energy to the active mode
+    hardwareManager->getLEDInterface()->getPowerModel()->setMode(static_cast<uint8_t>(currentMode));
+    
     // Check for shake cancellation (only in non-idle modes)
     if (currentMode != SystemMode::IDLE) {
         ShakeGestureDetector* shakeDetector = hardwareManager->getShakeDetector();
@@ -141,21 +219,20 @@ void GauntletController::update() {
             handleShakeCancellation();
             
             // Skip further updates this cycle
-            maintainLoopTiming();
             return;
         }
     }
     
     // Update current mode
     ModeTransition modeTransition = ModeTransition::NONE;
-    SpellTransition spellTransition = SpellTransition::NONE;
+    SpellId spellCast = SpellRegistry::NONE;
     
     #if DIAG_LOGGING_ENABLED
     unsigned long updateStartTime = millis();
     #endif
 
     // Starting mode transition - set flag
-    if (modeTransition != ModeTransition::NONE || spellTransition != SpellTransition::NONE) {
+    if (modeTransition != ModeTransition::NONE || spellCast != SpellRegistry::NONE) {
         inModeTransition = true;
     }
 
@@ -163,45 +240,46 @@ void GauntletController::update() {
         case SystemMode::IDLE:
             idleMode->update();
             modeTransition = idleMode->checkForTransition();
-            spellTransition = idleMode->checkForSpellTransition();
+            spellCast = idleMode->checkForSpellTransition();
             
-            if (spellTransition != SpellTransition::NONE) {
-                DEBUG_PRINTF("Spell transition detected: %d\n", static_cast<int>(spellTransition));
+            // Gestures are ignored until the deferred spell mode setup has run
+            if (!spellModesReady()) {
+                spellCast = SpellRegistry::NONE;
+                if (modeTransition == ModeTransition::TO_FREECAST) {
+                    modeTransition = ModeTransition::NONE;
+                }
+            }
+            
+            // LongOath steps to the next calibration profile
+            if (idleMode->checkForProfileSwitch() && CalibrationStore::profileCount() > 1) {
+                CalibrationStore::select((CalibrationStore::activeProfile() + 1) % CalibrationStore::profileCount());
+            }
+            
+            if (spellCast != SpellRegistry::NONE) {
+                DEBUG_PRINTF("Spell transition detected: %s\n", SpellRegistry::SPELLS[spellCast].name);
                 
                 #if DIAG_LOGGING_ENABLED
-                DIAG_INFO(DIAG_TAG_MODE, "Spell transition detected: %d", (int)spellTransition);
+                DIAG_INFO(DIAG_TAG_MODE, "Transitioning to QuickCast Mode with spell: %s", SpellRegistry::SPELLS[spellCast].name);
+                
+                // Capture mode transition
+                StateSnapshotCapture::capture(SNAPSHOT_TRIGGER_MODE_CHANGE, "GauntletController::update");
+                StateSnapshotCapture::addField("previousMode", "IDLE");
+                StateSnapshotCapture::addField("newMode", "QUICKCAST_SPELL");
+                StateSnapshotCapture::addField("spellType", (int)spellCast);
                 #endif
                 
-                // Pass the detected spell type to QuickCast mode
-                SpellType typeToCast = SpellType::NONE;
-                if (spellTransition == SpellTransition::TO_RAINBOW) typeToCast = SpellType::RAINBOW;
-                else if (spellTransition == SpellTransition::TO_LIGHTNING) typeToCast = SpellType::LIGHTNING;
-                else if (spellTransition == SpellTransition::TO_LUMINA) typeToCast = SpellType::LUMINA;
+                FlightRecorder::event(FLIGHT_EVENT_SPELL, spellCast);
                 
-                if (typeToCast != SpellType::NONE) {
-                    #if DIAG_LOGGING_ENABLED
-                    DIAG_INFO(DIAG_TAG_MODE, "Transitioning to QuickCast Mode with spell type: %d", (int)typeToCast);
-                    
-                    // Capture mode transition
-                    StateSnapshotCapture::capture(SNAPSHOT_TRIGGER_MODE_CHANGE, "GauntletController::update");
-                    StateSnapshotCapture::addField("previousMode", "IDLE");
-                    StateSnapshotCapture::addField("newMode", "QUICKCAST_SPELL");
-                    StateSnapshotCapture::addField("spellType", (int)typeToCast);
-                    StateSnapshotCapture::addField("spellTransition", (int)spellTransition);
-                    #endif
-                    
-                    quickCastMode->enter(typeToCast);
-                    currentMode = SystemMode::QUICKCAST_SPELL;
-                    modeTransition = ModeTransition::NONE; // Prevent immediate mode change after spell start
-                    DEBUG_PRINTLN("Transitioning to QuickCast Mode");
-                }
+                // Pass the detected spell straight to QuickCast mode
+                quickCastMode->enter(spellCast);
+                currentMode = SystemMode::QUICKCAST_SPELL;
+                modeTransition = ModeTransition::NONE; // Prevent immediate mode change after spell start
+                DEBUG_PRINTLN("Transitioning to QuickCast Mode");
             }
             break;
             
         case SystemMode::QUICKCAST_SPELL:
-            modeTransition = quickCastMode->update();
-            // Explicitly render LEDs for QuickCast, similar to FreeCast mode
-            quickCastMode->renderLEDs();
+            modeTransition = quickCastMode ? quickCastMode->update() : ModeTransition::TO_IDLE;
             if (modeTransition == ModeTransition::TO_IDLE) {
                 #if DIAG_LOGGING_ENABLED
                 DIAG_INFO(DIAG_TAG_MODE, "QuickCast completed, transitioning back to Idle");
@@ -215,13 +293,12 @@ void GauntletController::update() {
                 
                 currentMode = SystemMode::IDLE;
                 idleMode->initialize();
-                Serial.println(F("Transitioning back to Idle Mode from QuickCast"));
+                SerialOut.println(F("Transitioning back to Idle Mode from QuickCast"));
             }
             break;
 
         case SystemMode::FREECAST:
-            modeTransition = freecastMode->update();
-            freecastMode->renderLEDs();
+            modeTransition = freecastMode ? freecastMode->update() : ModeTransition::TO_IDLE;
             if (modeTransition == ModeTransition::TO_IDLE) {
                 #if DIAG_LOGGING_ENABLED
                 DIAG_INFO(DIAG_TAG_MODE, "FreeCast completed, transitioning back to Idle");
@@ -236,7 +313,7 @@ void GauntletController::update() {
             break;
             
         default:
-             Serial.print(F("ERROR: Unknown SystemMode: ")); Serial.println((int)currentMode);
+             SerialOut.print(F("ERROR: Unknown SystemMode: ")); SerialOut.println((int)currentMode);
              
              #if DIAG_LOGGING_ENABLED
              DIAG_ERROR(DIAG_TAG_MODE, "Unknown SystemMode: %d", (int)currentMode);
@@ -247,6 +324,11 @@ void GauntletController::update() {
              break;
     }
     
+    // A profile selected by gesture or from the CLI takes effect from the next sample
+    if (CalibrationStore::activeProfile() != calibrationProfile) {
+        applyCalibrationProfile(millis());
+    }
+    
     // Handle mode transitions
     if (modeTransition != ModeTransition::NONE) {
         #if DIAG_LOGGING_ENABLED
@@ -261,14 +343,32 @@ void GauntletController::update() {
     #if DIAG_LOGGING_ENABLED
     unsigned long updateDuration = millis() - updateStartTime;
     // Log only if update took longer than expected
-    if (updateDuration > updateInterval) {
+    if (updateDuration > scheduler.getLogicPeriod()) {
         DIAG_WARNING(DIAG_TAG_MODE, "Slow update cycle: %lu ms (target: %lu ms)", 
-                    updateDuration, updateInterval);
+                    updateDuration, (unsigned long)scheduler.getLogicPeriod());
     }
     #endif
+}
+
+void GauntletController::renderFrame(uint32_t now) {
+    // Renderers only read mode state and the frame time; they never advance logic
+    switch (currentMode) {
+        case SystemMode::IDLE:
+            idleMode->renderLEDs(now);
+            break;
+        case SystemMode::QUICKCAST_SPELL:
+            // Spells are posted to the animation system
+            break;
+        case SystemMode::FREECAST:
+            if (freecastMode) {
+                freecastMode->renderLEDs(now);
+            }
+            break;
+    }
     
-    // Maintain consistent loop timing
-    maintainLoopTiming();
+    // One pass advances every posted animation, then the frame goes out once
+    animations.update(now);
+    hardwareManager->updateLEDs();
 }
 
 bool GauntletController::hasElapsed(unsigned long startTime, unsigned long duration) const {
@@ -276,18 +376,51 @@ bool GauntletController::hasElapsed(unsigned long startTime, unsigned long durat
     return (currentTime - startTime) >= duration;
 }
 
-void GauntletController::maintainLoopTiming() {
-    // Calculate time spent in this loop iteration
-    unsigned long currentTime = millis();
-    unsigned long elapsedTime = currentTime - lastUpdateTime;
+void GauntletController::streamTelemetry(uint32_t nowUs) {
+    TelemetrySample sample;
+    SensorData raw;
+    if (!hardwareManager->sampleIMU(raw)) {
+        raw = hardwareManager->getSensorData();
+    }
+    sample.timeUs = nowUs;
+    sample.raw[0] = raw.accelX;
+    sample.raw[1] = raw.accelY;
+    sample.raw[2] = raw.accelZ;
+    sample.raw[3] = raw.gyroX;
+    sample.raw[4] = raw.gyroY;
+    sample.raw[5] = raw.gyroZ;
     
-    // If we've used less than our target update interval, delay the remainder
-    if (elapsedTime < updateInterval) {
-        delay(updateInterval - elapsedTime);
+    // Detector state as of the latest logic tick
+    ProcessedData filtered = positionDetector->getProcessedData();
+    sample.filtered[0] = filtered.accelX;
+    sample.filtered[1] = filtered.accelY;
+    sample.filtered[2] = filtered.accelZ;
+    PositionReading position = positionDetector->getCurrentPosition();
+    sample.position = position.position;
+    sample.confidence = position.confidence;
+    
+    TelemetryStream::record(sample);
+}
+
+void GauntletController::maintainLoopTiming() {
+    // Wait for whichever comes first: the next logic tick, frame or telemetry sample
+    uint32_t start = millis();
+    uint32_t wait = scheduler.millisUntilNext(start);
+    uint32_t telemetryWait = TelemetryStream::millisUntilNext(micros());
+    if (telemetryWait < wait) {
+        wait = telemetryWait;
     }
     
-    // Update the last update time
-    lastUpdateTime = millis();
+    // Queued serial output goes out while waiting, as fast as the UART takes it
+    while (true) {
+        SerialOut.drain();
+        uint32_t elapsed = millis() - start;
+        if (elapsed >= wait) {
+            break;
+        }
+        uint32_t remaining = wait - elapsed;
+        delay(SerialOut.pending() > 0 && remaining > Config::SERIAL_DRAIN_POLL_MS ? Config::SERIAL_DRAIN_POLL_MS : remaining);
+    }
 }
 
 void GauntletController::setInterpolationEnabled(bool enabled) {
@@ -331,6 +464,18 @@ void GauntletController::handleModeTransition(ModeTransition modeTransition) {
     }
 }
 
+/**
+ * Hand the active calibration profile to the detector; it is already in RAM
+ */
+void GauntletController::applyCalibrationProfile(unsigned long now) {
+    calibrationProfile = CalibrationStore::activeProfile();
+    positionDetector->applyProfile(CalibrationStore::active());
+    if (currentMode == SystemMode::IDLE) {
+        idleMode->showProfile(calibrationProfile, now);
+    }
+    SerialOut.printf("Calibration profile %u \"%s\"\n", calibrationProfile + 1, CalibrationStore::active().name);
+}
+
 void GauntletController::handleShakeCancellation() {
     // Skip if already transitioning between modes
     if (inModeTransition) {
@@ -348,16 +493,22 @@ void GauntletController::handleShakeCancellation() {
     StateSnapshotCapture::addField("reason", "SHAKE_CANCEL");
     #endif
     
+    FlightRecorder::event(FLIGHT_EVENT_SHAKE_CANCEL, static_cast<uint16_t>(currentMode));
+    
     // Play cancellation animation
     playCancelAnimation();
     
     // Clean up based on current mode
     switch (currentMode) {
         case SystemMode::QUICKCAST_SPELL:
-            quickCastMode->stopActiveSpell();
+            if (quickCastMode) {
+                quickCastMode->stopActiveSpell();
+            }
             break;
         case SystemMode::FREECAST:
-            freecastMode->reset();
+            if (freecastMode) {
+                freecastMode->reset();
+            }
             break;
         default:
             // Nothing to do for other modes
@@ -372,19 +523,9 @@ void GauntletController::handleShakeCancellation() {
 }
 
 void GauntletController::playCancelAnimation() {
-    LEDInterface* ledInterface = hardwareManager->getLEDInterface();
-    
-    // Simple white flash sequence
-    for (int i = 0; i < Config::ShakeDetection::CANCEL_FLASH_COUNT; i++) {
-        // Convert to CRGB for FastLED compatibility
-        CRGB white = CRGB::White;
-        ledInterface->fillSolid(white);
-        ledInterface->show();
-        delay(Config::ShakeDetection::CANCEL_FLASH_DURATION_MS);
-        
-        CRGB black = CRGB::Black;
-        ledInterface->fillSolid(black);
-        ledInterface->show();
-        delay(Config::ShakeDetection::CANCEL_FLASH_DURATION_MS);
-    }
+    // White flashes over everything (scripts/cancel_flash.anim), drawn by the
+    // animation system so the loop keeps running while they play
+    animations.start(AnimationRequest::fromProgram(ANIM_CANCEL_FLASH, ANIM_CANCEL_FLASH_SIZE,
+                                                   LEDLayer::EFFECTS, AnimationSystem::PRIORITY_ALERT),
+                     millis());
 } 
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include "SystemTypes.h"
+#include "DisplayScheduler.h"
+#include "../animation/AnimationSystem.h"
 #include "../hardware/HardwareManager.h"
 #include "../detection/UltraBasicPositionDetector.h"
 #include "../modes/IdleMode.h"
@@ -32,21 +34,32 @@ private:
     
     // System state
     SystemMode currentMode;
+    uint8_t calibrationProfile; // Profile the detector is using
     
     // Helper methods
     void showTransitionAnimation(CRGB color);
     
-    // Loop timing helpers
-    unsigned long lastUpdateTime;
-    unsigned long updateInterval;
+    // Loop timing: logic ticks and rendered frames run on separate clocks
+    DisplayScheduler scheduler;
+    
+    // Posted animations (spells, cancel flash), drawn after the mode each frame
+    AnimationSystem animations;
     bool hasElapsed(unsigned long startTime, unsigned long duration) const;
     void maintainLoopTiming();
+    void updateLogic();
+    void renderFrame(uint32_t now);
+    void streamTelemetry(uint32_t nowUs);
     
     // Private helper methods
     void handleModeTransition(ModeTransition transition);
     void handleShakeCancellation();
+    void applyCalibrationProfile(unsigned long now);
     void playCancelAnimation();
     
+    // Spell modes are only needed once a gesture is seen; set up after the first frame
+    static void initSpellModes(void* context);
+    bool spellModesReady() const;
+    
     // State tracking
     bool inModeTransition; // Flag to prevent cancellation during transitions
     
@@ -55,6 +68,14 @@ public:
     ~GauntletController();
     
     void initialize();
+    
+    /**
+     * @brief Run a logic tick and/or render a frame, whichever is due
+     * 
+     * Called from loop(). Sleeps until the next tick or frame before
+     * returning, so the caller's own work (CLI, diagnostics) still runs
+     * between frames.
+     */
     void update();
     
     // Configuration methods
@@ -66,6 +87,13 @@ public:
      */
     SystemMode getCurrentMode() const;
     
+    /**
+     * @brief Logic and frame rate counters for the last second
+     */
+    const SchedulerStats& getSchedulerStats() const {
+        return scheduler.getStats();
+    }
+    
     /**
      * @brief Get the hardware manager instance
      * @return Pointer to the HardwareManager
@@ -0,0 +1,115 @@
+#ifndef SPELL_REGISTRY_H
+#define SPELL_REGISTRY_H
+
+#include <stdint.h>
+#include "SystemTypes.h"
+#include "Config.h"
+#include "../animation/AnimationPrograms.h"
+#include "../animation/ProceduralEffects.h"
+
+/**
+ * @brief Index of a spell in SpellRegistry::SPELLS
+ */
+typedef uint8_t SpellId;
+
+/**
+ * @brief Procedural spell renderer
+ * @param startMs Time the spell started
+ * @param elapsedMs Time since the spell started
+ * @param frame Output buffer of Config::NUM_LEDS colors
+ */
+typedef void (*SpellRenderFn)(uint32_t startMs, uint32_t elapsedMs, Color* frame);
+
+/**
+ * @brief How a spell hands control back to Idle mode
+ */
+enum class SpellExit : uint8_t {
+  ON_COMPLETE,  // Return to Idle when the animation has run for durationMs
+  ON_CANCEL     // Loop the animation until ShakeCancel
+};
+
+/**
+ * @brief Everything that defines a QuickCast spell
+ *
+ * The gesture is startPosition followed by endPosition within windowMs.
+ * A spell is drawn either by a keyframe program or by a procedural renderer.
+ */
+struct SpellDefinition {
+  const char* name;
+  HandPosition startPosition;
+  HandPosition endPosition;
+  uint16_t windowMs;
+  uint32_t durationMs;          // Ignored for ON_CANCEL spells
+  uint8_t brightness;           // Global brightness while the spell runs
+  const uint8_t* program;       // Keyframe program, or nullptr for a procedural spell
+  uint16_t programLength;
+  SpellRenderFn render;         // Procedural renderer, or nullptr for a program
+  SpellExit exit;
+};
+
+/**
+ * @brief The QuickCast spells
+ *
+ * The single place a spell is defined: IdleMode builds its gesture trackers,
+ * QuickCastSpellsMode its animation and the host renderer its catalog from
+ * this table. Everything else refers to a spell by its index.
+ */
+namespace SpellRegistry {
+
+  constexpr SpellDefinition SPELLS[] = {
+    // Calm -> Offer: rainbow_burst program, 8s
+    {"rainbow_burst", POS_CALM, POS_OFFER, Config::QUICKCAST_WINDOW_MS,
+     8000, 204, ANIM_RAINBOW_BURST, ANIM_RAINBOW_BURST_SIZE, nullptr, SpellExit::ON_COMPLETE},
+    // Dig -> Oath: white flash then random crackle at full brightness, 5s
+    {"lightning_blast", POS_DIG, POS_OATH, Config::QUICKCAST_WINDOW_MS,
+     5000, 255, nullptr, 0, ProceduralEffects::lightningBlast, SpellExit::ON_COMPLETE},
+    // Null -> Shield: six white LEDs fading out at 80% brightness, 60s
+    {"lumina", POS_NULLPOS, POS_SHIELD, Config::QUICKCAST_WINDOW_MS,
+     60000, 204, ANIM_LUMINA, ANIM_LUMINA_SIZE, nullptr, SpellExit::ON_COMPLETE},
+  };
+
+  constexpr SpellId COUNT = sizeof(SPELLS) / sizeof(SPELLS[0]);
+  constexpr SpellId NONE = 0xFF;
+
+  constexpr bool namesEqual(const char* a, const char* b) {
+    return *a == *b && (*a == '\0' || namesEqual(a + 1, b + 1));
+  }
+
+  /**
+   * @brief Index of a spell by name, for code that needs a particular spell
+   * @return The index, or NONE
+   */
+  constexpr SpellId find(const char* name, SpellId index = 0) {
+    return index >= COUNT ? NONE
+         : namesEqual(SPELLS[index].name, name) ? index
+         : find(name, index + 1);
+  }
+
+  // --- Compile-time checks of the table ---
+
+  constexpr bool gestureUnique(SpellId index, SpellId other) {
+    return other >= COUNT ||
+           ((other == index ||
+             SPELLS[other].startPosition != SPELLS[index].startPosition ||
+             SPELLS[other].endPosition != SPELLS[index].endPosition) &&
+            gestureUnique(index, other + 1));
+  }
+
+  constexpr bool valid(SpellId index = 0) {
+    return index >= COUNT ||
+           (SPELLS[index].startPosition != SPELLS[index].endPosition &&
+            SPELLS[index].startPosition != POS_UNKNOWN &&
+            SPELLS[index].endPosition != POS_UNKNOWN &&
+            (SPELLS[index].program != nullptr) != (SPELLS[index].render != nullptr) &&
+            (SPELLS[index].exit == SpellExit::ON_CANCEL || SPELLS[index].durationMs > 0) &&
+            gestureUnique(index, 0) &&
+            valid(index + 1));
+  }
+
+  static_assert(COUNT > 0 && COUNT < NONE, "SpellRegistry: spell count out of range");
+  static_assert(valid(), "SpellRegistry: each spell needs two distinct known positions, a unique gesture, "
+                         "exactly one of program/render and a duration");
+
+} // namespace SpellRegistry
+
+#endif // SPELL_REGISTRY_H
@@ -7,18 +7,28 @@
 #include "../diagnostics/StateSnapshotCapture.h"
 #endif
 
-GestureTransitionTracker::GestureTransitionTracker(HandPosition startPosition, HandPosition endPosition, uint32_t maxDurationMs, SpellTransition transitionType)
+GestureTransitionTracker::GestureTransitionTracker()
+    : startPosition_(POS_UNKNOWN),
+      endPosition_(POS_UNKNOWN),
+      maxDurationMs_(0),
+      spell_(SpellRegistry::NONE),
+      startPositionActive_(false),
+      startTimeMs_(0),
+      transitionComplete_(false) {
+}
+
+GestureTransitionTracker::GestureTransitionTracker(HandPosition startPosition, HandPosition endPosition, uint32_t maxDurationMs, SpellId spell)
     : startPosition_(startPosition),
       endPosition_(endPosition),
       maxDurationMs_(maxDurationMs),
-      transitionType_(transitionType),
+      spell_(spell),
       startPositionActive_(false),
       startTimeMs_(0),
       transitionComplete_(false) {
           
     #if DIAG_LOGGING_ENABLED
     DIAG_DEBUG(DIAG_TAG_GESTURE, "GestureTracker created: %d->%d, window: %lu ms, type: %d", 
-              (int)startPosition, (int)endPosition, maxDurationMs, (int)transitionType);
+              (int)startPosition, (int)endPosition, maxDurationMs, (int)spell);
     #endif
 }
 
@@ -29,7 +39,7 @@ void GestureTransitionTracker::update(HandPosition currentPosition, uint32_t cur
     }
 
     #if DIAG_LOGGING_ENABLED
-    static HandPosition lastLoggedPosition = {255}; // Invalid position to force first log
+    static HandPosition lastLoggedPosition = static_cast<HandPosition>(255); // Invalid position to force first log
     if (currentPosition != lastLoggedPosition) {
         DIAG_DEBUG(DIAG_TAG_GESTURE, "Position update: %d, active: %d, elapsed: %lu ms", 
                   (int)currentPosition, startPositionActive_, 
@@ -44,27 +54,23 @@ void GestureTransitionTracker::update(HandPosition currentPosition, uint32_t cur
             // Start position just became active, record the time
             startPositionActive_ = true;
             startTimeMs_ = currentTimestamp;
-            Serial.print("GestureTracker: Started "); Serial.println((int)transitionType_);
-            
             #if DIAG_LOGGING_ENABLED
-            DIAG_INFO(DIAG_TAG_GESTURE, "Gesture started: type %d", (int)transitionType_);
+            DIAG_INFO(DIAG_TAG_GESTURE, "Gesture started: type %d", (int)spell_);
             
             // Capture snapshot for gesture start
             StateSnapshotCapture::capture(SNAPSHOT_TRIGGER_GESTURE_START, "GestureTransitionTracker::update");
             StateSnapshotCapture::addField("startPosition", (int)startPosition_);
             StateSnapshotCapture::addField("endPosition", (int)endPosition_);
-            StateSnapshotCapture::addField("transitionType", (int)transitionType_);
+            StateSnapshotCapture::addField("transitionType", (int)spell_);
             StateSnapshotCapture::addField("maxDuration", (int)maxDurationMs_);
             #endif
         } else {
             // Start position is still active, check for timeout
             if (currentTimestamp - startTimeMs_ > maxDurationMs_) {
                 // Exceeded time limit, reset the timer
-                Serial.print("GestureTracker: Timeout "); Serial.println((int)transitionType_);
-                
                 #if DIAG_LOGGING_ENABLED
                 DIAG_INFO(DIAG_TAG_GESTURE, "Gesture timeout: type %d after %lu ms", 
-                         (int)transitionType_, currentTimestamp - startTimeMs_);
+                         (int)spell_, currentTimestamp - startTimeMs_);
                 #endif
                 
                 reset(); 
@@ -83,29 +89,26 @@ void GestureTransitionTracker::update(HandPosition currentPosition, uint32_t cur
             
             // End position achieved within the time window
             if (elapsed <= maxDurationMs_) {
-                Serial.print("GestureTracker: Completed "); Serial.println((int)transitionType_);
                 transitionComplete_ = true;
                 startPositionActive_ = false; // Stop tracking start pos
                 
                 #if DIAG_LOGGING_ENABLED
                 DIAG_INFO(DIAG_TAG_GESTURE, "Gesture completed: type %d in %lu ms", 
-                         (int)transitionType_, elapsed);
+                         (int)spell_, elapsed);
                          
                 // Capture snapshot for gesture completion
                 StateSnapshotCapture::capture(SNAPSHOT_TRIGGER_GESTURE_END, "GestureTransitionTracker::update");
                 StateSnapshotCapture::addField("startPosition", (int)startPosition_);
                 StateSnapshotCapture::addField("endPosition", (int)endPosition_);
-                StateSnapshotCapture::addField("transitionType", (int)transitionType_);
+                StateSnapshotCapture::addField("transitionType", (int)spell_);
                 StateSnapshotCapture::addField("duration", (int)elapsed);
                 StateSnapshotCapture::addField("success", true);
                 #endif
             } else {
                 // Reached end position, but too late. Reset.
-                Serial.print("GestureTracker: Too Late "); Serial.println((int)transitionType_);
-                
                 #if DIAG_LOGGING_ENABLED
                 DIAG_INFO(DIAG_TAG_GESTURE, "Gesture too late: type %d in %lu ms (max %lu ms)", 
-                         (int)transitionType_, elapsed, maxDurationMs_);
+                         (int)spell_, elapsed, maxDurationMs_);
                 #endif
                 
                 reset();
@@ -124,17 +127,15 @@ bool GestureTransitionTracker::isTransitionComplete() const {
     return transitionComplete_;
 }
 
-SpellTransition GestureTransitionTracker::getTransitionType() const {
-    return transitionType_;
+SpellId GestureTransitionTracker::getSpell() const {
+    return spell_;
 }
 
 void GestureTransitionTracker::reset() {
     startPositionActive_ = false;
     startTimeMs_ = 0;
     transitionComplete_ = false;
-    Serial.print("GestureTracker: Reset "); Serial.println((int)transitionType_);
-    
     #if DIAG_LOGGING_ENABLED
-    DIAG_DEBUG(DIAG_TAG_GESTURE, "Gesture tracker reset: type %d", (int)transitionType_);
+    DIAG_DEBUG(DIAG_TAG_GESTURE, "Gesture tracker reset: type %d", (int)spell_);
     #endif
 } 
\ No newline at end of file
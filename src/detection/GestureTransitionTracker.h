@@ -2,6 +2,7 @@
 #define GESTURE_TRANSITION_TRACKER_H
 
 #include "core/SystemTypes.h"
+#include "core/SpellRegistry.h"
 #include <stdint.h>
 
 /**
@@ -13,14 +14,19 @@
  */
 class GestureTransitionTracker {
 public:
+    /**
+     * @brief Constructs an unassigned tracker (never completes until given a transition)
+     */
+    GestureTransitionTracker();
+
     /**
      * @brief Constructor
      * @param startPosition The initial hand position that starts the timer.
      * @param endPosition The target hand position that completes the transition.
      * @param maxDurationMs The maximum time allowed (in milliseconds) for the transition.
-     * @param transitionType The type of transition this tracker represents (e.g., a QuickCast spell).
+     * @param spell The QuickCast spell this tracker detects.
      */
-    GestureTransitionTracker(HandPosition startPosition, HandPosition endPosition, uint32_t maxDurationMs, SpellTransition transitionType);
+    GestureTransitionTracker(HandPosition startPosition, HandPosition endPosition, uint32_t maxDurationMs, SpellId spell);
 
     /**
      * @brief Updates the tracker's state based on the current hand position.
@@ -36,10 +42,10 @@ public:
     bool isTransitionComplete() const;
 
     /**
-     * @brief Gets the type of transition associated with this tracker.
-     * @return The SpellTransition enum value.
+     * @brief Gets the spell associated with this tracker.
+     * @return Index into SpellRegistry::SPELLS.
      */
-    SpellTransition getTransitionType() const;
+    SpellId getSpell() const;
 
     /**
      * @brief Resets the tracker's state to its initial condition.
@@ -51,7 +57,7 @@ private:
     HandPosition startPosition_;
     HandPosition endPosition_;
     uint32_t maxDurationMs_;
-    SpellTransition transitionType_;
+    SpellId spell_;
 
     bool startPositionActive_; // True if the start position is currently held
     uint32_t startTimeMs_;      // Timestamp when the start position was first detected
@@ -1,6 +1,7 @@
 #include "ShakeGestureDetector.h"
 #include "../core/Config.h"
 #include <Arduino.h>
+#include "../hardware/SerialTx.h"
 
 // Diagnostic includes
 #if DIAG_LOGGING_ENABLED
@@ -20,7 +21,7 @@ ShakeGestureDetector::ShakeGestureDetector()
 
 bool ShakeGestureDetector::init(MPU9250Interface* mpuInterface) {
   if (!mpuInterface) {
-    Serial.println(F("ERROR: ShakeGestureDetector requires valid MPU interface"));
+    SerialOut.println(F("ERROR: ShakeGestureDetector requires valid MPU interface"));
     return false;
   }
   
@@ -0,0 +1,44 @@
+#include "SpellGestureDetector.h"
+
+SpellGestureDetector::SpellGestureDetector()
+  : completed_(SpellRegistry::NONE) {
+  for (SpellId id = 0; id < SpellRegistry::COUNT; id++) {
+    const SpellDefinition& spell = SpellRegistry::SPELLS[id];
+    trackers_[id] = GestureTransitionTracker(spell.startPosition, spell.endPosition, spell.windowMs, id);
+  }
+
+  // Index the spells by the positions they react to, in registry order
+  uint8_t count = 0;
+  for (uint8_t position = 0; position < POSITION_COUNT; position++) {
+    first_[position] = count;
+    for (SpellId id = 0; id < SpellRegistry::COUNT; id++) {
+      const SpellDefinition& spell = SpellRegistry::SPELLS[id];
+      if (spell.startPosition == position || spell.endPosition == position) {
+        positionSpells_[count++] = id;
+      }
+    }
+  }
+  first_[POSITION_COUNT] = count;
+}
+
+void SpellGestureDetector::update(HandPosition position, uint32_t now) {
+  if (position >= POSITION_COUNT) {
+    return;
+  }
+
+  for (uint8_t i = first_[position]; i < first_[position + 1]; i++) {
+    SpellId id = positionSpells_[i];
+    GestureTransitionTracker& tracker = trackers_[id];
+    tracker.update(position, now);
+    if (tracker.isTransitionComplete() && id < completed_) {
+      completed_ = id;
+    }
+  }
+}
+
+void SpellGestureDetector::reset() {
+  for (SpellId id = 0; id < SpellRegistry::COUNT; id++) {
+    trackers_[id].reset();
+  }
+  completed_ = SpellRegistry::NONE;
+}
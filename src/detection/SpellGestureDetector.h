@@ -0,0 +1,54 @@
+#ifndef SPELL_GESTURE_DETECTOR_H
+#define SPELL_GESTURE_DETECTOR_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+#include "../core/SpellRegistry.h"
+#include "GestureTransitionTracker.h"
+
+/**
+ * @brief Detects every QuickCast gesture in SpellRegistry
+ *
+ * One GestureTransitionTracker per spell, built from the registry. A tracker
+ * only changes state when the hand is at its start or end position, so each
+ * update visits just the trackers indexed under the current position: the
+ * per-tick cost depends on how many spells share a position, not on how many
+ * spells there are.
+ */
+class SpellGestureDetector {
+public:
+  SpellGestureDetector();
+
+  /**
+   * @brief Advance the trackers for the current hand position
+   * @param position Current hand position
+   * @param now Current time (millis())
+   */
+  void update(HandPosition position, uint32_t now);
+
+  /**
+   * @brief Spell whose gesture has completed, if any
+   *
+   * If several complete on the same update, the one first in the registry wins.
+   * @return Index into SpellRegistry::SPELLS, or SpellRegistry::NONE
+   */
+  SpellId completedSpell() const { return completed_; }
+
+  /**
+   * @brief Reset every tracker (after a spell is cast, or on entering Idle)
+   */
+  void reset();
+
+private:
+  static constexpr uint8_t POSITION_COUNT = POS_UNKNOWN + 1;
+
+  GestureTransitionTracker trackers_[SpellRegistry::COUNT];
+
+  // Spells that start or end at each position: positionSpells_[first_[p]..first_[p + 1])
+  uint8_t first_[POSITION_COUNT + 1];
+  SpellId positionSpells_[2 * SpellRegistry::COUNT];
+
+  SpellId completed_;
+};
+
+#endif // SPELL_GESTURE_DETECTOR_H
@@ -1,6 +1,7 @@
 #include "UltraBasicPositionDetector.h"
 #include "../core/Config.h"
 #include <Arduino.h>
+#include "../hardware/SerialTx.h"
 
 bool UltraBasicPositionDetector::init(HardwareManager* hardware) {
   // Store hardware reference
@@ -32,8 +33,12 @@ bool UltraBasicPositionDetector::init(HardwareManager* hardware) {
   }
   _currentSampleIndex = 0;
   
-  // Load default thresholds
+  // Load default thresholds, then the active stored profile if there is one
   loadDefaultThresholds();
+  if (CalibrationStore::isStored()) {
+    applyProfile(CalibrationStore::active());
+    setScalingFactor(CalibrationStore::data().scalingFactor);
+  }
   
   return true;
 }
@@ -98,49 +103,6 @@ void UltraBasicPositionDetector::processRawData(const SensorData& raw, Processed
   processed.accelX = raw.accelX * _currentScalingFactor;
   processed.accelY = raw.accelY * _currentScalingFactor;
   processed.accelZ = raw.accelZ * _currentScalingFactor;
-  
-  // Debug data flow every second to verify proper scaling
-  static unsigned long lastDebugTime = 0;
-  unsigned long currentTime = millis();
-  
-  if (currentTime - lastDebugTime > 1000) {
-    Serial.println("===== Data Flow Tracing =====");
-    Serial.print("Raw Values: X=");
-    Serial.print(raw.accelX);
-    Serial.print(", Y=");
-    Serial.print(raw.accelY);
-    Serial.print(", Z=");
-    Serial.println(raw.accelZ);
-    
-    Serial.print("Scaling Factor: ");
-    Serial.println(_currentScalingFactor, 10); // Print with high precision to verify correct value
-    
-    Serial.print("Processed (m/s²): X=");
-    Serial.print(processed.accelX, 2);
-    Serial.print(", Y=");
-    Serial.print(processed.accelY, 2);
-    Serial.print(", Z=");
-    Serial.println(processed.accelZ, 2);
-    
-    // Validate gravity reading when device is relatively flat
-    if (abs(processed.accelX) < 2.0f && abs(processed.accelY) < 2.0f) {
-      float gravityError = abs(abs(processed.accelZ) - 9.81f);
-      float errorPercent = (gravityError / 9.81f) * 100.0f;
-      
-      Serial.print("Gravity Reading: ");
-      Serial.print(processed.accelZ, 2);
-      Serial.print(" m/s² (Error: ");
-      Serial.print(errorPercent, 1);
-      Serial.println("%)");
-      
-      if (errorPercent > 5.0f) {
-        Serial.println("WARNING: Gravity reading error exceeds 5% - Scaling may be incorrect");
-      }
-    }
-    
-    Serial.println("=============================");
-    lastDebugTime = currentTime;
-  }
 }
 
 PositionReading UltraBasicPositionDetector::detectPosition(const ProcessedData& data) {
@@ -333,6 +295,20 @@ uint8_t UltraBasicPositionDetector::getDominantAxis(uint8_t position) const {
   return (position < 6) ? _dominantAxes[position] : 0;
 }
 
+void UltraBasicPositionDetector::applyProfile(const CalibrationProfile& profile) {
+  for (uint8_t pos = 0; pos < 6; pos++) {
+    setThreshold(pos, profile.thresholds[pos]);
+    setDominantAxis(pos, profile.dominantAxes[pos]);
+  }
+}
+
+void UltraBasicPositionDetector::captureProfile(CalibrationProfile& profile) const {
+  for (uint8_t pos = 0; pos < 6; pos++) {
+    profile.thresholds[pos] = _thresholds[pos];
+    profile.dominantAxes[pos] = _dominantAxes[pos];
+  }
+}
+
 void UltraBasicPositionDetector::printCalibrationData(Stream& serialOut) {
   serialOut.println("\n======= CALIBRATION DATA =======");
   serialOut.println("Position Detection Thresholds:");
@@ -411,8 +387,8 @@ const char* UltraBasicPositionDetector::getAxisName(uint8_t axis) const {
 }
 
 float UltraBasicPositionDetector::calibrateScalingFactor(uint16_t testDuration) {
-  Serial.println("\n=== ECHO Scaling Factor Validation ===");
-  Serial.println("Validating ECHO reference scaling factor against gravity readings...");
+  SerialOut.println("\n=== ECHO Scaling Factor Validation ===");
+  SerialOut.println("Validating ECHO reference scaling factor against gravity readings...");
   
   // Use the ECHO reference scaling factor
   _currentScalingFactor = DEFAULT_SCALING_FACTOR;
@@ -425,7 +401,7 @@ float UltraBasicPositionDetector::calibrateScalingFactor(uint16_t testDuration)
   int numSamples = 0;
   float zSum = 0.0f;
   
-  Serial.println("Hold the device flat and still for measurement...");
+  SerialOut.println("Hold the device flat and still for measurement...");
   delay(1000); // Give user time to stabilize
   
   // Collect samples for testDuration milliseconds
@@ -447,11 +423,11 @@ float UltraBasicPositionDetector::calibrateScalingFactor(uint16_t testDuration)
     
     // Print sample values every 500ms
     if (millis() - lastPrintTime > 500) {
-      Serial.printf("Sample %d: X=%.2f Y=%.2f Z=%.2f m/s²\n", 
-                  numSamples + 1, 
-                  processedData.accelX, 
-                  processedData.accelY, 
-                  processedData.accelZ);
+      SerialOut.printf("Sample %d: X=%.2f Y=%.2f Z=%.2f m/s²\n", 
+                     numSamples + 1, 
+                     processedData.accelX, 
+                     processedData.accelY, 
+                     processedData.accelZ);
       lastPrintTime = millis();
     }
     
@@ -479,20 +455,20 @@ float UltraBasicPositionDetector::calibrateScalingFactor(uint16_t testDuration)
   float gravityError = abs(zMean - 9.81f);
   float errorPercent = (gravityError / 9.81f) * 100.0f;
   
-  Serial.println("\n=== Validation Results ===");
-  Serial.printf("ECHO Scaling Factor: %.10f\n", DEFAULT_SCALING_FACTOR);
-  Serial.printf("Gravity Reading: %.2f m/s² (Expected: 9.81 m/s²)\n", zMean);
-  Serial.printf("Gravity Error: %.2f m/s² (%.1f%%)\n", gravityError, errorPercent);
-  Serial.printf("Stability: X=%.4f Y=%.4f Z=%.4f\n", xVariance, yVariance, zVariance);
+  SerialOut.println("\n=== Validation Results ===");
+  SerialOut.printf("ECHO Scaling Factor: %.10f\n", DEFAULT_SCALING_FACTOR);
+  SerialOut.printf("Gravity Reading: %.2f m/s² (Expected: 9.81 m/s²)\n", zMean);
+  SerialOut.printf("Gravity Error: %.2f m/s² (%.1f%%)\n", gravityError, errorPercent);
+  SerialOut.printf("Stability: X=%.4f Y=%.4f Z=%.4f\n", xVariance, yVariance, zVariance);
   
   if (errorPercent <= 5.0f) {
-    Serial.println("✓ VALIDATION PASSED: Gravity reading within 5% of expected value");
-    Serial.println("✓ ECHO reference scaling factor is appropriate for this device");
+    SerialOut.println("✓ VALIDATION PASSED: Gravity reading within 5% of expected value");
+    SerialOut.println("✓ ECHO reference scaling factor is appropriate for this device");
   } else {
-    Serial.println("⚠ VALIDATION WARNING: Gravity reading outside 5% tolerance");
-    Serial.println("Consider fine-tuning the scaling factor if detection issues persist");
+    SerialOut.println("⚠ VALIDATION WARNING: Gravity reading outside 5% tolerance");
+    SerialOut.println("Consider fine-tuning the scaling factor if detection issues persist");
   }
   
-  Serial.println("=== Validation Complete ===\n");
+  SerialOut.println("=== Validation Complete ===\n");
   return DEFAULT_SCALING_FACTOR;
 } 
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "../core/SystemTypes.h"
 #include "../hardware/HardwareManager.h"
 #include "../core/Config.h"
+#include "../core/CalibrationStore.h"
 
 // Number of samples to average for position detection
 #define POSITION_AVERAGE_SAMPLES 3
@@ -97,6 +98,18 @@ public:
    */
   uint8_t getDominantAxis(uint8_t position) const;
   
+  /**
+   * @brief Use the thresholds and axes of a calibration profile
+   * @param profile Profile to apply; twelve stores, no flash access
+   */
+  void applyProfile(const CalibrationProfile& profile);
+  
+  /**
+   * @brief Copy the current thresholds and axes into a calibration profile
+   * @param profile Profile to update; its name is left as it is
+   */
+  void captureProfile(CalibrationProfile& profile) const;
+  
   /**
    * @brief Output calibration data in a human-readable format
    * @param serialOut Stream to output to (defaults to Serial)
@@ -7,14 +7,22 @@
 #include "CommandLineInterface.h"
 #include "DiagnosticLogger.h"
 #include "StateSnapshotCapture.h"
+#include "TelemetryStream.h"
+#include "FlightRecorder.h"
+#include "MemoryMonitor.h"
+#include "MemoryMap.h"
 #include "VisualDebugIndicator.h"
+#include "../hardware/HardwareManager.h"
+#include "../hardware/SerialTx.h"
+#include "../core/CalibrationStore.h"
+#include "../core/BootSequence.h"
 
 // Initialize static variables
 char CommandLineInterface::_cmdBuffer[MAX_CMD_LENGTH + 1] = {0};
 uint8_t CommandLineInterface::_bufIndex = 0;
 bool CommandLineInterface::_initialized = false;
-const char* CommandLineInterface::_commandNames[10] = {0};
-CommandLineInterface::CommandCallback CommandLineInterface::_commandCallbacks[10] = {0};
+const char* CommandLineInterface::_commandNames[MAX_COMMANDS] = {0};
+CommandLineInterface::CommandCallback CommandLineInterface::_commandCallbacks[MAX_COMMANDS] = {0};
 uint8_t CommandLineInterface::_numCommands = 0;
 
 /**
@@ -34,6 +42,11 @@ void CommandLineInterface::init() {
   registerCommand("visual", cmdVisual);
   registerCommand("test", cmdTest);
   registerCommand("dump", cmdDump);
+  registerCommand("power", cmdPower);
+  registerCommand("trace", cmdTrace);
+  registerCommand("telemetry", cmdTelemetry);
+  registerCommand("flight", cmdFlight);
+  registerCommand("calibration", cmdCalibration);
   
   // Print welcome message
   Serial.println("\n\n--- LUTT Command-line Interface ---");
@@ -46,6 +59,12 @@ void CommandLineInterface::init() {
  */
 void CommandLineInterface::process() {
   if (!CLI_ENABLED || !_initialized) return;
+  if (!Serial.available()) return;
+  
+  // Send queued output first, then let the echo and command output go
+  // straight to the UART: a dump can be far larger than the TX ring
+  bool buffered = SerialOut.isBuffered();
+  SerialOut.setBuffered(false);
   
   while (Serial.available()) {
     char c = Serial.read();
@@ -85,6 +104,8 @@ void CommandLineInterface::process() {
       _cmdBuffer[_bufIndex++] = c;
     }
   }
+  
+  SerialOut.setBuffered(buffered);
 }
 
 /**
@@ -94,7 +115,7 @@ void CommandLineInterface::registerCommand(const char* command, CommandCallback
   if (!CLI_ENABLED || !_initialized) return;
   
   // Only add if we have space and the command doesn't already exist
-  if (_numCommands < 10) {
+  if (_numCommands < MAX_COMMANDS) {
     for (uint8_t i = 0; i < _numCommands; i++) {
       if (strcmp(_commandNames[i], command) == 0) {
         // Command already exists, update its callback
@@ -179,47 +200,95 @@ void CommandLineInterface::cmdHelp(int argc, char* argv[]) {
   
   Serial.println("\nBuilt-in command usage:");
   Serial.println("  help                  Show this help");
-  Serial.println("  log <level> <enable>  Control diagnostic logging");
+  Serial.println("  log [on|off] | log <tag|all> <level>  Show or set per-tag log levels");
   Serial.println("  snapshot <trigger>    Capture state snapshot");
+  Serial.println("  snapshot list|dump|clear Show, dump or clear the snapshot history");
   Serial.println("  visual <type> <args>  Control visual indicators");
   Serial.println("  test <component>      Run component test");
   Serial.println("  dump <component>      Dump component state");
+  Serial.println("  power [budget|reset]  LED current and energy report");
+  Serial.println("  trace [dump|clear|stats] Print, dump or clear the log trace ring");
+  Serial.println("  telemetry start [hz] [baud] | stop | stats  Binary motion telemetry stream");
+  Serial.println("  flight [live|clear]   Print the last crash's flight log");
+  Serial.println("  calibration [use <profile>|default|name <profile> <name>|erase]  Show or change calibration profiles");
 }
 
 /**
- * Log command - control diagnostic logging
+ * Log command - show or set the runtime level of each tag
  */
 void CommandLineInterface::cmdLog(int argc, char* argv[]) {
-  if (argc < 2) {
-    Serial.println("Usage: log <level> <enable>");
-    Serial.println("  level: 1=CRITICAL, 2=ERROR, 3=WARNING, 4=INFO, 5=DEBUG, 6=TRACE");
-    Serial.println("  enable: 0=disabled, 1=enabled");
-    Serial.println("Example: log 4 1  (enable INFO level logs)");
+  if (argc == 2 && (strcmp(argv[1], "on") == 0 || strcmp(argv[1], "off") == 0)) {
+    DiagnosticLogger::setEnabled(strcmp(argv[1], "on") == 0);
+    Serial.printf("Diagnostic logging %s\n", DiagnosticLogger::isEnabled() ? "enabled" : "disabled");
     return;
   }
-  
-  // Simple global control for now
-  if (argc >= 3 && strcmp(argv[2], "0") == 0) {
-    DiagnosticLogger::setEnabled(false);
-    Serial.println("Diagnostic logging disabled");
-  } else {
-    DiagnosticLogger::setEnabled(true);
-    Serial.println("Diagnostic logging enabled");
+
+  if (argc >= 3) {
+    uint8_t tag = DiagnosticLogger::findTag(argv[1]);
+    bool all = strcmp(argv[1], "all") == 0;
+    int level = atoi(argv[2]);
+    if ((!tag && !all) || level < 0 || level > DIAG_LEVEL_TRACE) {
+      Serial.println("Usage: log <tag|all> <level>  (level 0=off .. 6=TRACE)");
+      return;
+    }
+    for (uint8_t t = 1; t < DIAG_TAG_COUNT; t++) {
+      if (all || t == tag) {
+        DiagnosticLogger::setTagLevel(t, (uint8_t)level);
+      }
+    }
+    if (level > DIAG_LOG_LEVEL) {
+      Serial.printf("Note: sites above %s are compiled out (DIAG_LOG_LEVEL)\n",
+                    DiagnosticLogger::getLevelName(DIAG_LOG_LEVEL));
+    }
+  } else if (argc == 2) {
+    Serial.println("Usage: log [on|off] | log <tag|all> <level>");
+    Serial.println("  level: 0=off, 1=CRITICAL, 2=ERROR, 3=WARNING, 4=INFO, 5=DEBUG, 6=TRACE");
+    Serial.println("Example: log gesture 5  (gesture logs up to DEBUG)");
+    return;
+  }
+
+  Serial.printf("Diagnostic logging %s, compiled up to %s\n",
+                DiagnosticLogger::isEnabled() ? "enabled" : "disabled",
+                DiagnosticLogger::getLevelName(DIAG_LOG_LEVEL));
+  for (uint8_t t = 1; t < DIAG_TAG_COUNT; t++) {
+    uint8_t level = DiagnosticLogger::getTagLevel(t);
+    bool compiled = (DIAG_TAG_FILTER & DIAG_TAG_BIT(t)) != 0;
+    Serial.printf("  %-10s %s%s\n", DiagnosticLogger::getTagName(t),
+                  level ? DiagnosticLogger::getLevelName(level) : "off", compiled ? "" : " (compiled out)");
   }
+  Serial.printf("  %lu entries rate-limited, %lu dropped (ring full)\n",
+                (unsigned long)DiagnosticLogger::suppressed(), (unsigned long)TraceBuffer::dropped());
 }
 
 /**
- * Snapshot command - capture state snapshot
+ * Snapshot command - capture state snapshot or show the snapshot history
  */
 void CommandLineInterface::cmdSnapshot(int argc, char* argv[]) {
   if (argc < 2) {
-    Serial.println("Usage: snapshot <trigger>");
+    Serial.println("Usage: snapshot <trigger> | list | dump | clear");
     Serial.println("  trigger: 1=GESTURE_START, 2=GESTURE_END, 4=MODE_CHANGE");
     Serial.println("           8=ANIMATION, 16=FREECAST, 32=ERROR, 255=ALL");
+    Serial.println("  list:    print the last snapshots, oldest first");
+    Serial.println("  dump:    binary history for utils/snapshot_tool.py");
     Serial.println("Example: snapshot 1  (capture gesture start)");
     return;
   }
-  
+
+  if (strcmp(argv[1], "list") == 0) {
+    StateSnapshotCapture::printHistory();
+    return;
+  }
+  if (strcmp(argv[1], "dump") == 0) {
+    StateSnapshotCapture::dumpBinary(Serial);
+    Serial.println();
+    return;
+  }
+  if (strcmp(argv[1], "clear") == 0) {
+    StateSnapshotCapture::clear();
+    Serial.println("Snapshot history cleared");
+    return;
+  }
+
   int trigger = atoi(argv[1]);
   StateSnapshotCapture::capture(trigger, "CLI requested");
   StateSnapshotCapture::addField("cli_trigger", trigger);
@@ -328,6 +397,18 @@ void CommandLineInterface::cmdTest(int argc, char* argv[]) {
     VisualDebugIndicator::updateMotionFeature(0.8f, 0.6f);
     Serial.println("Visual test complete");
   }
+  else if (strcmp(argv[1], "serial") == 0) {
+    // Serial TX ring counters since boot
+    const SerialTxStats& tx = SerialOut.getStats();
+    Serial.printf("Serial TX ring (%u bytes, drop %s):\n", SERIAL_TX_BUFFER_SIZE,
+                  SerialOut.getPolicy() == SERIAL_TX_DROP_OLDEST ? "oldest" : "newest");
+    Serial.printf("  written: %lu bytes, dropped: %lu bytes, max depth: %u bytes\n",
+                  (unsigned long)tx.bytesWritten, (unsigned long)tx.bytesDropped, tx.maxDepth);
+  }
+  else if (strcmp(argv[1], "boot") == 0) {
+    // Startup stages as timed by BootSequence
+    BootSequence::report(Serial);
+  }
   else {
     Serial.print("Unknown component: ");
     Serial.println(argv[1]);
@@ -340,7 +421,7 @@ void CommandLineInterface::cmdTest(int argc, char* argv[]) {
 void CommandLineInterface::cmdDump(int argc, char* argv[]) {
   if (argc < 2) {
     Serial.println("Usage: dump <component>");
-    Serial.println("  component: commands, memory, thresholds");
+    Serial.println("  component: commands, memory, thresholds, leds, serial, boot");
     return;
   }
   
@@ -351,15 +432,260 @@ void CommandLineInterface::cmdDump(int argc, char* argv[]) {
     }
   }
   else if (strcmp(argv[1], "memory") == 0) {
-    // Simple memory dump - could be expanded if memory monitoring is added
-    Serial.println("Memory allocation not implemented yet");
+    printMemory();
   }
   else if (strcmp(argv[1], "thresholds") == 0) {
-    // Would access the threshold manager to dump values
-    Serial.println("Threshold dump not implemented yet");
+    CalibrationStore::print(Serial);
+  }
+  else if (strcmp(argv[1], "leds") == 0) {
+    // Frame presenter counters for the last complete second
+    const PresenterStats& stats = HardwareManager::getInstance()->getPresenter()->getStats();
+    Serial.println("LED frames (last second):");
+    Serial.printf("  pushed: %u, skipped: %u, coalesced: %u\n",
+                  stats.framesPushed, stats.framesSkipped, stats.framesCoalesced);
+    Serial.printf("  wire busy: %lu us, show() time: %lu us\n",
+                  (unsigned long)stats.wireMicros, (unsigned long)stats.showMicros);
+    
+    const LEDWireStats& wire = HardwareManager::getInstance()->getLEDInterface()->getWireStats();
+    Serial.printf("  wire: %lu transfers, %lu render waits (%lu us)\n",
+                  (unsigned long)wire.transfers, (unsigned long)wire.renderWaits,
+                  (unsigned long)wire.waitMicros);
+  }
+  else if (strcmp(argv[1], "serial") == 0) {
+    // Serial TX ring counters since boot
+    const SerialTxStats& tx = SerialOut.getStats();
+    Serial.printf("Serial TX ring (%u bytes, drop %s):\n", SERIAL_TX_BUFFER_SIZE,
+                  SerialOut.getPolicy() == SERIAL_TX_DROP_OLDEST ? "oldest" : "newest");
+    Serial.printf("  written: %lu bytes, dropped: %lu bytes, max depth: %u bytes\n",
+                  (unsigned long)tx.bytesWritten, (unsigned long)tx.bytesDropped, tx.maxDepth);
+  }
+  else if (strcmp(argv[1], "boot") == 0) {
+    // Startup stages as timed by BootSequence
+    BootSequence::report(Serial);
   }
   else {
     Serial.print("Unknown component: ");
     Serial.println(argv[1]);
   }
-} 
\ No newline at end of file
+} 
+
+/**
+ * Heap, task stacks, allocation counts and static RAM per subsystem
+ */
+void CommandLineInterface::printMemory() {
+  MemoryStats stats;
+  MemoryMonitor::sample(stats);
+  Serial.printf("Heap: %lu used, %lu free, largest block %lu, lowest free %lu\n",
+                (unsigned long)stats.heapUsed, (unsigned long)stats.heapFree,
+                (unsigned long)stats.heapLargestBlock, (unsigned long)stats.heapMinFree);
+  Serial.printf("Allocations since boot: %lu new, %lu delete (%ld live)\n",
+                (unsigned long)stats.allocations, (unsigned long)stats.frees,
+                (long)(stats.allocations - stats.frees));
+
+  TaskStackInfo tasks[MEMORY_MAX_TASKS];
+  uint8_t count = MemoryMonitor::sampleTasks(tasks, MEMORY_MAX_TASKS);
+  Serial.printf("Task stacks, bytes never used (loopTask of %lu):\n", (unsigned long)MemoryMonitor::loopStackSize());
+  for (uint8_t i = 0; i < count; i++) {
+    Serial.printf("  %-16s %6lu  core %c  prio %u\n", tasks[i].name, (unsigned long)tasks[i].stackFree,
+                  tasks[i].core == 0xFF ? '-' : (char)('0' + tasks[i].core), tasks[i].priority);
+  }
+
+  if (MEMORY_MAP_COUNT == 0) {
+    Serial.println("Static RAM: no table yet (build the esp32dev env twice to fill it)");
+    return;
+  }
+  Serial.println("Static RAM (bytes):        data    bss    rtc   iram");
+  uint32_t totals[4] = {0, 0, 0, 0};
+  for (uint8_t i = 0; i < MEMORY_MAP_COUNT; i++) {
+    const MemoryMapEntry& entry = MEMORY_MAP[i];
+    Serial.printf("  %-22s %6lu %6lu %6lu %6lu\n", entry.name, (unsigned long)entry.data, (unsigned long)entry.bss,
+                  (unsigned long)entry.rtc, (unsigned long)entry.iram);
+    totals[0] += entry.data;
+    totals[1] += entry.bss;
+    totals[2] += entry.rtc;
+    totals[3] += entry.iram;
+  }
+  Serial.printf("  %-22s %6lu %6lu %6lu %6lu\n", "total", (unsigned long)totals[0], (unsigned long)totals[1],
+                (unsigned long)totals[2], (unsigned long)totals[3]);
+}
+
+/**
+ * Power command - LED current estimate, limiter and energy per mode
+ */
+void CommandLineInterface::cmdPower(int argc, char* argv[]) {
+  LEDPowerModel* power = HardwareManager::getInstance()->getLEDInterface()->getPowerModel();
+  
+  if (argc >= 2 && strcmp(argv[1], "budget") == 0) {
+    if (argc < 3) {
+      Serial.println("Usage: power budget <mA>  (0 disables the limiter)");
+      return;
+    }
+    long budget = atol(argv[2]);
+    if (budget < 0 || budget > 0xFFFF || (budget > 0 && budget < LEDPowerModel::MIN_BUDGET_MA)) {
+      Serial.printf("Budget must be 0 or %u-65535 mA (the LEDs draw %u mA when dark)\n",
+                    LEDPowerModel::MIN_BUDGET_MA, LEDPowerModel::MIN_BUDGET_MA);
+      return;
+    }
+    power->setBudget((uint16_t)budget);
+    Serial.printf("LED current budget set to %u mA\n", power->getBudget());
+    return;
+  }
+  if (argc >= 2 && strcmp(argv[1], "reset") == 0) {
+    power->resetTotals();
+    Serial.println("LED energy totals cleared");
+    return;
+  }
+  
+  static const char* const MODE_NAMES[LEDPowerModel::MODE_COUNT] = {"idle", "freecast", "quickcast"};
+  const LEDPowerStats& stats = power->getStats();
+  Serial.printf("LED current: %u mA now, peak %u mA (requested %u mA), budget %u mA\n",
+                stats.lastMilliamps, stats.peakMilliamps, stats.peakRequestedMilliamps, power->getBudget());
+  Serial.printf("Limiter: scale %u/255, %lu limited frames\n", stats.limit, (unsigned long)stats.limitedFrames);
+  
+  float total = 0.0f;
+  uint32_t totalMs = 0;
+  for (uint8_t mode = 0; mode < LEDPowerModel::MODE_COUNT; mode++) {
+    float mAh = power->getMilliampHours(mode);
+    uint32_t ms = power->getModeMillis(mode);
+    total += mAh;
+    totalMs += ms;
+    Serial.printf("  %-10s %9.3f mAh over %7.1f s (avg %u mA)\n", MODE_NAMES[mode], mAh, ms / 1000.0f,
+                  ms > 0 ? (unsigned)(mAh * 3600000.0f / ms) : 0);
+  }
+  Serial.printf("  %-10s %9.3f mAh over %7.1f s\n", "total", total, totalMs / 1000.0f);
+}
+
+/**
+ * Trace command - print, dump or clear the binary log ring
+ */
+void CommandLineInterface::cmdTrace(int argc, char* argv[]) {
+  if (argc >= 2 && strcmp(argv[1], "dump") == 0) {
+    // Raw records for: python utils/trace_tool.py decode <capture>
+    DiagnosticLogger::dumpBinary(Serial);
+    Serial.println();
+    return;
+  }
+  if (argc >= 2 && strcmp(argv[1], "clear") == 0) {
+    TraceBuffer::clear();
+    Serial.println("Trace ring cleared");
+    return;
+  }
+  if (argc >= 2 && strcmp(argv[1], "stats") == 0) {
+    Serial.printf("Trace ring: %u/%u entries pending, %lu dropped\n",
+                  TraceBuffer::pending(), TraceBuffer::CAPACITY, (unsigned long)TraceBuffer::dropped());
+    return;
+  }
+
+  // Everything recorded so far; an explicit request may wait on Serial
+  char line[128];
+  TraceEntry entry;
+  while (TraceBuffer::pop(entry)) {
+    DiagnosticLogger::formatEntry(entry, line, sizeof(line));
+    Serial.println(line);
+  }
+}
+
+/**
+ * Telemetry command - start or stop the binary motion telemetry stream
+ */
+void CommandLineInterface::cmdTelemetry(int argc, char* argv[]) {
+  if (argc >= 2 && strcmp(argv[1], "start") == 0) {
+    uint16_t rate = argc >= 3 ? (uint16_t)atoi(argv[2]) : TELEMETRY_DEFAULT_RATE_HZ;
+    uint32_t baud = argc >= 4 ? (uint32_t)atol(argv[3]) : TELEMETRY_DEFAULT_BAUD;
+    TelemetryStream::start(rate, baud);
+    return;
+  }
+  if (argc >= 2 && strcmp(argv[1], "stop") == 0) {
+    TelemetryStream::stop();
+    return;
+  }
+  if (argc >= 2 && strcmp(argv[1], "stats") == 0) {
+    TelemetryStream::printStats();
+    return;
+  }
+
+  Serial.println("Usage: telemetry start [hz] [baud] | stop | stats");
+  Serial.printf("  Streams COBS-framed samples (default %u Hz at %lu baud)\n",
+                TELEMETRY_DEFAULT_RATE_HZ, (unsigned long)TELEMETRY_DEFAULT_BAUD);
+  Serial.printf("  115200 baud carries up to %u Hz; decode with utils/telemetry_decode.cpp\n",
+                TelemetryStream::maxRateFor(115200));
+}
+
+/**
+ * Flight command - print the crash flight log or the running one
+ */
+void CommandLineInterface::cmdFlight(int argc, char* argv[]) {
+  if (argc >= 2 && strcmp(argv[1], "live") == 0) {
+    FlightRecorder::printLive(Serial);
+    return;
+  }
+  if (argc >= 2 && strcmp(argv[1], "clear") == 0) {
+    FlightRecorder::clearCrash();
+    Serial.println("Flight recorder: crash log cleared");
+    return;
+  }
+  if (argc >= 2) {
+    Serial.println("Usage: flight [live|clear]");
+    return;
+  }
+  FlightRecorder::printCrash(Serial);
+}
+
+/**
+ * Calibration command - show, switch, name or erase calibration profiles
+ *
+ * "use" only changes the active profile in RAM; "default" and "name" commit.
+ */
+void CommandLineInterface::cmdCalibration(int argc, char* argv[]) {
+  if (argc == 3 && strcmp(argv[1], "use") == 0) {
+    int8_t index = CalibrationStore::find(argv[2]);
+    if (index < 0 || !CalibrationStore::select(index)) {
+      Serial.printf("Calibration: no profile '%s'\n", argv[2]);
+      return;
+    }
+    Serial.printf("Calibration: using profile %d \"%s\"\n", index + 1, CalibrationStore::active().name);
+    return;
+  }
+  if (argc == 2 && strcmp(argv[1], "default") == 0) {
+    CalibrationData data = CalibrationStore::data();
+    data.bootProfile = CalibrationStore::activeProfile();
+    if (CalibrationStore::commit(data)) {
+      Serial.printf("Calibration: profile %u is used from boot\n", data.bootProfile + 1);
+    } else {
+      Serial.println("Calibration: commit failed");
+    }
+    return;
+  }
+  if (argc == 4 && strcmp(argv[1], "name") == 0) {
+    int8_t index = CalibrationStore::find(argv[2]);
+    if (index < 0) {
+      Serial.printf("Calibration: no profile '%s'\n", argv[2]);
+      return;
+    }
+    if (strlen(argv[3]) > CALIBRATION_NAME_LENGTH) {
+      Serial.printf("Calibration: names are at most %d characters\n", CALIBRATION_NAME_LENGTH);
+      return;
+    }
+    CalibrationData data = CalibrationStore::data();
+    strncpy(data.profiles[index].name, argv[3], sizeof(data.profiles[index].name));
+    if (CalibrationStore::commit(data)) {
+      Serial.printf("Calibration: profile %d is \"%s\"\n", index + 1, argv[3]);
+    } else {
+      Serial.println("Calibration: commit failed");
+    }
+    return;
+  }
+  if (argc >= 2 && strcmp(argv[1], "erase") == 0) {
+    if (CalibrationStore::erase()) {
+      Serial.println("Calibration erased; Config::Calibrated applies from the next boot");
+    } else {
+      Serial.println("Calibration: erase failed");
+    }
+    return;
+  }
+  if (argc >= 2) {
+    Serial.println("Usage: calibration [use <profile>|default|name <profile> <name>|erase]");
+    return;
+  }
+  CalibrationStore::print(Serial);
+}
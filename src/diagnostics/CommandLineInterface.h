@@ -13,6 +13,7 @@
 // Maximum command length
 #define MAX_CMD_LENGTH 32
 #define MAX_ARGS 4
+#define MAX_COMMANDS 16
 
 // Control whether CLI is enabled through build flag
 #ifndef CLI_ENABLED
@@ -48,6 +49,11 @@ public:
   static void cmdVisual(int argc, char* argv[]);
   static void cmdTest(int argc, char* argv[]);
   static void cmdDump(int argc, char* argv[]);
+  static void cmdPower(int argc, char* argv[]);
+  static void cmdTrace(int argc, char* argv[]);
+  static void cmdTelemetry(int argc, char* argv[]);
+  static void cmdFlight(int argc, char* argv[]);
+  static void cmdCalibration(int argc, char* argv[]);
 
 private:
   /**
@@ -68,14 +74,19 @@ private:
    */
   static void printPrompt();
   
+  /**
+   * Print heap, task stack, allocation and static RAM figures ('dump memory')
+   */
+  static void printMemory();
+  
   // Command buffer
   static char _cmdBuffer[MAX_CMD_LENGTH + 1];
   static uint8_t _bufIndex;
   static bool _initialized;
   
-  // Simple command registry (limited to 10 commands)
-  static const char* _commandNames[10];
-  static CommandCallback _commandCallbacks[10];
+  // Simple command registry (limited to MAX_COMMANDS commands)
+  static const char* _commandNames[MAX_COMMANDS];
+  static CommandCallback _commandCallbacks[MAX_COMMANDS];
   static uint8_t _numCommands;
 };
 
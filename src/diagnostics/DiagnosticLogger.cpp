@@ -5,10 +5,65 @@
  */
 
 #include "DiagnosticLogger.h"
+#include "TraceStrings.h"
+#include "../hardware/SerialTx.h"
 #include <stdarg.h>
 
 // Initialize static variables
 bool DiagnosticLogger::_enabled = true;
+uint8_t DiagnosticLogger::_tagLevels[DIAG_TAG_COUNT] = {
+  DIAG_LOG_LEVEL, DIAG_LOG_LEVEL, DIAG_LOG_LEVEL, DIAG_LOG_LEVEL, DIAG_LOG_LEVEL, DIAG_LOG_LEVEL
+};
+uint32_t DiagnosticLogger::_suppressed = 0;
+uint32_t DiagnosticLogger::_reportedDrops = 0;
+uint32_t DiagnosticLogger::_reportedSuppressed = 0;
+uint32_t DiagnosticLogger::_suppressedReportMs = 0;
+
+// Longest formatted trace line, newline included; fits in an empty UART TX FIFO
+static const size_t TRACE_LINE_LENGTH = 120;
+
+// Shortest interval between "entries rate-limited" reports
+static const uint32_t SUPPRESSED_REPORT_MS = 1000;
+
+// Binary dump layout (see utils/trace_tool.py)
+static const uint16_t TRACE_DUMP_VERSION = 1;
+
+namespace {
+
+  /**
+   * Format one conversion of a recorded entry
+   * @param spec The conversion, e.g. "%-5lu", NUL-terminated
+   * @param conversion Its final character
+   */
+  int formatArgument(char* out, size_t size, const char* spec, char conversion, bool isLong, TraceWord word) {
+    switch (conversion) {
+      case 'd': case 'i':
+        return isLong ? snprintf(out, size, spec, (long)(int32_t)word) : snprintf(out, size, spec, (int)(int32_t)word);
+      case 'u': case 'x': case 'X': case 'o':
+        return isLong ? snprintf(out, size, spec, (unsigned long)(uint32_t)word) : snprintf(out, size, spec, (unsigned int)(uint32_t)word);
+      case 'c':
+        return snprintf(out, size, spec, (int)word);
+      case 's':
+        return snprintf(out, size, spec, word ? reinterpret_cast<const char*>(word) : "(null)");
+      case 'p':
+        return snprintf(out, size, spec, reinterpret_cast<void*>(word));
+      case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+        uint32_t bits = (uint32_t)word;
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return snprintf(out, size, spec, (double)value);
+      }
+      default:
+        return snprintf(out, size, "?");
+    }
+  }
+
+  void writeWord(Print& out, uint32_t value) {
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    out.write(bytes, sizeof(bytes));
+  }
+
+} // namespace
 
 /**
  * Get the name of a diagnostic tag as a string
@@ -19,10 +74,46 @@ const char* DiagnosticLogger::getTagName(uint8_t tag) {
     case DIAG_TAG_ANIMATION: return "ANIMATION";
     case DIAG_TAG_MODE:     return "MODE";
     case DIAG_TAG_MOTION:   return "MOTION";
+    case DIAG_TAG_SENSOR:   return "SENSOR";
     default:                return "UNKNOWN";
   }
 }
 
+/**
+ * Look up a tag by name, ignoring case
+ */
+uint8_t DiagnosticLogger::findTag(const char* name) {
+  for (uint8_t tag = 1; tag < DIAG_TAG_COUNT; tag++) {
+    if (strcasecmp(name, getTagName(tag)) == 0) {
+      return tag;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Token bucket refill and take
+ */
+bool DiagRateLimit::allow(uint16_t perSecond, uint16_t burst) {
+  uint32_t now = millis();
+  uint32_t capacity = (uint32_t)burst * 1000;
+  uint32_t elapsed = now - lastMs;
+  lastMs = now;
+  // Cap before multiplying so long quiet spells cannot overflow
+  if (!used || elapsed >= 1000UL * burst) {
+    used = true;
+    milliTokens = capacity;
+  } else {
+    milliTokens += elapsed * perSecond;
+    if (milliTokens > capacity) milliTokens = capacity;
+  }
+  if (milliTokens < 1000) {
+    return false;
+  }
+  milliTokens -= 1000;
+  return true;
+}
+
 /**
  * Cross-platform formatted print function
  * (handles platforms where Serial.printf is unavailable)
@@ -36,7 +127,7 @@ void DiagnosticLogger::print(const char* format, ...) {
   vsnprintf(buffer, sizeof(buffer), format, args);
   va_end(args);
   
-  Serial.print(buffer);
+  SerialOut.print(buffer);
 }
 
 /**
@@ -51,4 +142,190 @@ void DiagnosticLogger::setEnabled(bool enable) {
  */
 bool DiagnosticLogger::isEnabled() {
   return _enabled;
-} 
\ No newline at end of file
+} 
+
+/**
+ * Set the runtime level of one tag
+ */
+void DiagnosticLogger::setTagLevel(uint8_t tag, uint8_t level) {
+  if (tag < DIAG_TAG_COUNT) {
+    _tagLevels[tag] = level;
+  }
+}
+
+/**
+ * Runtime level of one tag
+ */
+uint8_t DiagnosticLogger::getTagLevel(uint8_t tag) {
+  return tag < DIAG_TAG_COUNT ? _tagLevels[tag] : 0;
+}
+
+/**
+ * Entries held back by rate limits since boot
+ */
+uint32_t DiagnosticLogger::suppressed() {
+  return _suppressed;
+}
+
+/**
+ * Binary search of the generated string table
+ */
+const char* DiagnosticLogger::findFormat(uint32_t id) {
+  uint16_t low = 0;
+  uint16_t high = TRACE_STRING_COUNT;
+  while (low < high) {
+    uint16_t mid = (low + high) / 2;
+    if (TRACE_STRINGS[mid].id < id) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low < TRACE_STRING_COUNT && TRACE_STRINGS[low].id == id ? TRACE_STRINGS[low].format : nullptr;
+}
+
+/**
+ * Format a recorded entry, one conversion at a time from its raw arguments
+ */
+size_t DiagnosticLogger::formatEntry(const TraceEntry& entry, char* buffer, size_t size) {
+  if (size == 0) return 0;
+  size_t length = 0;
+  auto append = [&](int written) {
+    if (written > 0) {
+      length += (size_t)written;
+      if (length >= size) length = size - 1;
+    }
+  };
+
+  append(snprintf(buffer, size, "%10lu [%s:%s] ", (unsigned long)entry.timestampUs,
+                  getLevelName(entry.level), getTagName(entry.tag)));
+
+  const char* format = findFormat(entry.id);
+  if (!format) {
+    // String table is older than the firmware's log sites
+    append(snprintf(buffer + length, size - length, "<id 0x%08lX>", (unsigned long)entry.id));
+    for (uint8_t i = 0; i < entry.argCount; i++) {
+      append(snprintf(buffer + length, size - length, " 0x%lx", (unsigned long)entry.args[i]));
+    }
+    return length;
+  }
+
+  uint8_t argIndex = 0;
+  for (const char* p = format; *p && length < size - 1; ) {
+    if (*p != '%') {
+      buffer[length++] = *p++;
+      continue;
+    }
+    if (p[1] == '%') {
+      buffer[length++] = '%';
+      p += 2;
+      continue;
+    }
+
+    // Copy the conversion (flags, width, precision, length) and find its type
+    char spec[16];
+    uint8_t n = 0;
+    bool isLong = false;
+    spec[n++] = *p++;
+    while (*p && !strchr("diuoxXcspfFeEgG", *p) && n < sizeof(spec) - 2) {
+      if (*p == 'l') {
+        isLong = true;
+      }
+      if (*p != 'h' && *p != 'z' && *p != 'j' && *p != 't') {
+        spec[n++] = *p;
+      }
+      p++;
+    }
+    if (!*p) break;
+    char conversion = *p++;
+    if (isLong && strchr("diuoxX", conversion) == nullptr) {
+      // 'l' only changes the integer conversions
+      uint8_t m = 0;
+      for (uint8_t i = 0; i < n; i++) {
+        if (spec[i] != 'l') spec[m++] = spec[i];
+      }
+      n = m;
+    }
+    spec[n++] = conversion;
+    spec[n] = '\0';
+
+    TraceWord word = argIndex < entry.argCount ? entry.args[argIndex] : 0;
+    argIndex++;
+    append(formatArgument(buffer + length, size - length, spec, conversion, isLong, word));
+  }
+  buffer[length] = '\0';
+  return length;
+}
+
+/**
+ * Print pending entries while the TX buffer can take each whole line
+ */
+uint16_t DiagnosticLogger::drain(uint16_t maxEntries) {
+  uint16_t printed = 0;
+  char line[TRACE_LINE_LENGTH];
+
+  uint32_t drops = TraceBuffer::dropped();
+  if (drops != _reportedDrops) {
+    int length = snprintf(line, sizeof(line), "[WARN:TRACE] %lu entries dropped (ring full)\n",
+                          (unsigned long)(drops - _reportedDrops));
+    if (SerialOut.availableForWrite() < length) {
+      return 0;
+    }
+    SerialOut.write(reinterpret_cast<const uint8_t*>(line), length);
+    _reportedDrops = drops;
+  }
+
+  // A site held back every frame would otherwise add a line to every drain
+  uint32_t suppressed = _suppressed;
+  if (suppressed != _reportedSuppressed && millis() - _suppressedReportMs >= SUPPRESSED_REPORT_MS) {
+    int length = snprintf(line, sizeof(line), "[WARN:TRACE] %lu entries rate-limited\n",
+                          (unsigned long)(suppressed - _reportedSuppressed));
+    if (SerialOut.availableForWrite() < length) {
+      return 0;
+    }
+    SerialOut.write(reinterpret_cast<const uint8_t*>(line), length);
+    _reportedSuppressed = suppressed;
+    _suppressedReportMs = millis();
+  }
+
+  // Format before taking the entry, so a line that does not fit waits for the next drain
+  TraceEntry entry;
+  while (printed < maxEntries && TraceBuffer::peek(entry)) {
+    size_t length = formatEntry(entry, line, sizeof(line) - 1);
+    line[length++] = '\n';
+    if (SerialOut.availableForWrite() < (int)length) {
+      break;
+    }
+    SerialOut.write(reinterpret_cast<const uint8_t*>(line), length);
+    TraceBuffer::pop(entry);
+    printed++;
+  }
+  return printed;
+}
+
+/**
+ * Write the pending entries as raw little-endian records
+ */
+uint16_t DiagnosticLogger::dumpBinary(Print& out) {
+  // Only entries already published: one still being written would leave the
+  // header promising more entries than follow it
+  uint16_t count = TraceBuffer::readable();
+  out.write(reinterpret_cast<const uint8_t*>("DTRC"), 4);
+  uint8_t header[4] = {(uint8_t)TRACE_DUMP_VERSION, (uint8_t)(TRACE_DUMP_VERSION >> 8), (uint8_t)count, (uint8_t)(count >> 8)};
+  out.write(header, sizeof(header));
+  writeWord(out, TraceBuffer::dropped());
+
+  // Entries recorded during the dump stay in the ring for the next one; the
+  // single reader guarantees the counted ones are still there to pop
+  TraceEntry entry;
+  for (uint16_t i = 0; i < count && TraceBuffer::pop(entry); i++) {
+    writeWord(out, entry.timestampUs);
+    writeWord(out, entry.id);
+    uint8_t fields[4] = {entry.level, entry.tag, entry.argCount, 0};
+    out.write(fields, sizeof(fields));
+    for (uint8_t a = 0; a < entry.argCount; a++) {
+      writeWord(out, (uint32_t)entry.args[a]);
+    }
+  }
+  return count;
+}
\ No newline at end of file
@@ -3,12 +3,23 @@
  * 
  * A lightweight logging component that provides configurable 
  * diagnostic output for debugging and troubleshooting.
+ *
+ * Log calls are binary traces: the call site records the hash of its
+ * format string and the raw arguments into TraceBuffer, and drain()
+ * formats them later, outside the code being measured.
+ *
+ * Three filters keep logging cheap: sites above DIAG_LOG_LEVEL or outside
+ * DIAG_TAG_FILTER are compiled out, each tag has a runtime level set from
+ * the CLI ('log <tag> <level>'), and each site has a token bucket so a
+ * message repeated every frame cannot flood the ring.
  */
 
 #ifndef DIAGNOSTIC_LOGGER_H
 #define DIAGNOSTIC_LOGGER_H
 
 #include <Arduino.h>
+#include <type_traits>
+#include "TraceBuffer.h"
 
 // Control whether diagnostic logging is enabled (set in platformio.ini)
 #ifndef DIAG_LOGGING_ENABLED
@@ -20,6 +31,15 @@
 #define DIAG_TAG_ANIMATION  0x02
 #define DIAG_TAG_MODE       0x03
 #define DIAG_TAG_MOTION     0x04
+#define DIAG_TAG_SENSOR     0x05
+#define DIAG_TAG_COUNT      6     // One past the highest tag
+
+// Tags compiled in, as a mask of DIAG_TAG_BIT(tag) values
+#define DIAG_TAG_BIT(tag)   (1u << (tag))
+#define DIAG_TAG_ALL        0xFF
+#ifndef DIAG_TAG_FILTER
+#define DIAG_TAG_FILTER DIAG_TAG_ALL
+#endif
 
 // Diagnostic log levels
 enum DiagnosticLogLevel {
@@ -31,25 +51,61 @@ enum DiagnosticLogLevel {
   DIAG_LEVEL_TRACE = 6
 };
 
-// Default minimum log level (only log messages with level <= this value)
+// Compile-time floor: sites with level > this value are removed entirely.
+// Also the initial runtime level of every tag.
 #ifndef DIAG_LOG_LEVEL
 #define DIAG_LOG_LEVEL DIAG_LEVEL_INFO
 #endif
 
+// Default per-site rate limit: messages per second and burst size
+#ifndef DIAG_SITE_RATE
+#define DIAG_SITE_RATE 10
+#endif
+#ifndef DIAG_SITE_BURST
+#define DIAG_SITE_BURST 20
+#endif
+
+/**
+ * Token bucket of one log site (a zero-initialized static starts full)
+ */
+struct DiagRateLimit {
+  uint32_t lastMs;
+  uint32_t milliTokens;   // Tokens x 1000, so slow rates refill smoothly
+  bool used;
+
+  /**
+   * Take a token if one is available
+   * @param perSecond Refill rate
+   * @param burst Bucket size
+   */
+  bool allow(uint16_t perSecond, uint16_t burst);
+};
+
 // Logging macros (conditionally compiled)
 #if DIAG_LOGGING_ENABLED
-  // Main logging macro with level and tag
-  #define DIAG_LOG(level, tag, ...) \
+  // Trace ID of a format string literal, computed at compile time
+  #define DIAG_TRACE_ID(format) (std::integral_constant<uint32_t, TraceBuffer::hash(format)>::value)
+
+  // Logging macro with level, tag and a rate limit for this site; format must
+  // be a string literal and %s arguments must point to strings that outlive
+  // the drain. The compile-time checks fold away; filtered sites cost nothing.
+  #define DIAG_LOG_RATE(level, tag, perSecond, burst, format, ...) \
     do { \
-      if (DiagnosticLogger::isEnabled() && (level) <= DIAG_LOG_LEVEL) { \
-        DiagnosticLogger::print("[%s:%s] ", \
-          DiagnosticLogger::getLevelName(level), \
-          DiagnosticLogger::getTagName(tag)); \
-        DiagnosticLogger::print(__VA_ARGS__); \
-        DiagnosticLogger::print("\n"); \
+      if ((level) <= DIAG_LOG_LEVEL && (DIAG_TAG_FILTER & DIAG_TAG_BIT(tag)) && \
+          DiagnosticLogger::shouldLog((level), (tag))) { \
+        static DiagRateLimit _diagSite; \
+        if (_diagSite.allow((perSecond), (burst))) { \
+          TraceBuffer::record(DIAG_TRACE_ID(format), (level), (tag), ##__VA_ARGS__); \
+        } else { \
+          DiagnosticLogger::countSuppressed(); \
+        } \
       } \
     } while(0)
 
+  // Main logging macro with the default rate limit
+  #define DIAG_LOG(level, tag, format, ...) \
+    DIAG_LOG_RATE(level, tag, DIAG_SITE_RATE, DIAG_SITE_BURST, format, ##__VA_ARGS__)
+
   // Level-specific convenience macros
   #define DIAG_CRITICAL(tag, ...) DIAG_LOG(DIAG_LEVEL_CRITICAL, tag, __VA_ARGS__)
   #define DIAG_ERROR(tag, ...)    DIAG_LOG(DIAG_LEVEL_ERROR, tag, __VA_ARGS__)
@@ -59,6 +115,7 @@ enum DiagnosticLogLevel {
   #define DIAG_TRACE(tag, ...)    DIAG_LOG(DIAG_LEVEL_TRACE, tag, __VA_ARGS__)
 #else
   // No-op versions when logging is disabled
+  #define DIAG_LOG_RATE(level, tag, perSecond, burst, ...)
   #define DIAG_LOG(level, tag, ...)
   #define DIAG_CRITICAL(tag, ...)
   #define DIAG_ERROR(tag, ...)
@@ -95,11 +152,44 @@ public:
    * Get the string representation of a diagnostic tag
    */
   static const char* getTagName(uint8_t tag);
+
+  /**
+   * Tag for a name as getTagName() returns it (any case), or 0
+   */
+  static uint8_t findTag(const char* name);
   
   /**
-   * Cross-platform formatted print function
+   * Cross-platform formatted print function (immediate, for non-trace output)
    */
   static void print(const char* format, ...);
+
+  /**
+   * Format and print recorded log entries without blocking on Serial
+   *
+   * Call from the main loop. Stops when the ring is empty, after
+   * maxEntries, or when SerialOut (the serial TX ring) has no room for a line.
+   * Entries dropped by a full ring or held back by rate limits are
+   * reported as counts.
+   * @return Entries printed
+   */
+  static uint16_t drain(uint16_t maxEntries = 8);
+
+  /**
+   * Write every published entry as a binary dump for utils/trace_tool.py
+   * @return Entries written
+   */
+  static uint16_t dumpBinary(Print& out);
+
+  /**
+   * Format a recorded entry as "<us> [LEVEL:TAG] message"
+   * @return Length written (truncated to size - 1)
+   */
+  static size_t formatEntry(const TraceEntry& entry, char* buffer, size_t size);
+
+  /**
+   * Format string for a trace ID from the generated table, or nullptr
+   */
+  static const char* findFormat(uint32_t id);
   
   /**
    * Enable or disable diagnostic output
@@ -110,9 +200,46 @@ public:
    * Check if diagnostics are currently enabled
    */
   static bool isEnabled();
+
+  /**
+   * Set the runtime level of a tag (0 silences it)
+   *
+   * Levels above DIAG_LOG_LEVEL are kept but have no effect, as those
+   * sites are not compiled in.
+   */
+  static void setTagLevel(uint8_t tag, uint8_t level);
+
+  /**
+   * Runtime level of a tag
+   */
+  static uint8_t getTagLevel(uint8_t tag);
+
+  /**
+   * Runtime filter of the logging macros
+   */
+  static bool shouldLog(uint8_t level, uint8_t tag) {
+    return _enabled && tag < DIAG_TAG_COUNT && level <= _tagLevels[tag];
+  }
+
+  /**
+   * Count an entry a site's rate limit held back (reported by drain())
+   */
+  static void countSuppressed() {
+    _suppressed++;
+  }
+
+  /**
+   * Entries held back by rate limits since boot
+   */
+  static uint32_t suppressed();
   
 private:
   static bool _enabled;
+  static uint8_t _tagLevels[DIAG_TAG_COUNT];
+  static uint32_t _suppressed;
+  static uint32_t _reportedDrops;
+  static uint32_t _reportedSuppressed;
+  static uint32_t _suppressedReportMs;
 };
 
 #endif // DIAGNOSTIC_LOGGER_H 
\ No newline at end of file
@@ -0,0 +1,285 @@
+/**
+ * FlightRecorder.cpp
+ *
+ * Implementation of the FlightRecorder class for the LUTT toolkit.
+ */
+
+#include "FlightRecorder.h"
+#include "../hardware/SerialTx.h"
+#include <esp_system.h>
+#include <Preferences.h>
+
+// Layout version; a log with another magic (garbage after power-on, older firmware) is ignored
+static const uint32_t FLIGHT_LOG_MAGIC = 0x464C5401;
+
+// NVS location of the saved crash log
+static const char* FLIGHT_NVS_NAMESPACE = "flight";
+static const char* FLIGHT_NVS_KEY = "crash";
+
+namespace {
+
+  // Kept across every reset except power-on
+  RTC_NOINIT_ATTR FlightLog rtcLog;
+
+  bool isValid(const FlightLog& log) {
+    return log.magic == FLIGHT_LOG_MAGIC && log.head < FLIGHT_RECORDER_CAPACITY &&
+           log.count <= FLIGHT_RECORDER_CAPACITY;
+  }
+
+  bool isCrash(uint8_t reason) {
+    switch (reason) {
+      case ESP_RST_PANIC:
+      case ESP_RST_INT_WDT:
+      case ESP_RST_TASK_WDT:
+      case ESP_RST_WDT:
+      case ESP_RST_BROWNOUT:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  const char* eventName(uint8_t code) {
+    switch (code) {
+      case FLIGHT_EVENT_BOOT:         return "boot";
+      case FLIGHT_EVENT_MODE:         return "mode";
+      case FLIGHT_EVENT_SPELL:        return "spell";
+      case FLIGHT_EVENT_SHAKE_CANCEL: return "shake_cancel";
+      case FLIGHT_EVENT_INIT_FAILED:  return "init_failed";
+      default:                        return "?";
+    }
+  }
+
+} // namespace
+
+// Initialize static variables
+FlightLog FlightRecorder::_crash = {};
+bool FlightRecorder::_crashLoaded = false;
+uint16_t FlightRecorder::_slowestRenderUs = 0;
+
+/**
+ * Recover the previous run's log, save it if it crashed, then start over
+ */
+void FlightRecorder::begin() {
+  uint8_t reason = (uint8_t)esp_reset_reason();
+  if (recover(reason)) {
+    save();
+    SerialOut.printf("Flight recorder: last run ended by %s, %u records saved ('flight' to print)\n",
+                     reasonName(reason), _crash.count);
+  }
+}
+
+/**
+ * Keep the RTC log of a crashed run and reset the ring for this one
+ */
+bool FlightRecorder::recover(uint8_t resetReason) {
+  bool valid = isValid(rtcLog);
+  bool crashed = valid && rtcLog.count > 0 && isCrash(resetReason);
+  if (crashed) {
+    _crash = rtcLog;
+    _crash.resetReason = resetReason;
+    _crashLoaded = true;
+  }
+
+  uint16_t bootCount = valid ? rtcLog.bootCount + 1 : 1;
+  rtcLog.magic = FLIGHT_LOG_MAGIC;
+  rtcLog.head = 0;
+  rtcLog.count = 0;
+  rtcLog.bootCount = bootCount;
+  rtcLog.resetReason = 0;
+  _slowestRenderUs = 0;
+  event(FLIGHT_EVENT_BOOT, resetReason);
+  return crashed;
+}
+
+/**
+ * The slot the next record goes into; commit() publishes it
+ */
+FlightRecord& FlightRecorder::slot() {
+  return rtcLog.records[rtcLog.head];
+}
+
+/**
+ * Advance the ring past a filled slot
+ */
+void FlightRecorder::commit() {
+  rtcLog.head = rtcLog.head + 1 == FLIGHT_RECORDER_CAPACITY ? 0 : rtcLog.head + 1;
+  if (rtcLog.count < FLIGHT_RECORDER_CAPACITY) {
+    rtcLog.count++;
+  }
+}
+
+/**
+ * Record a logic tick
+ */
+void FlightRecorder::sample(const SensorData& data, uint8_t position, uint32_t tickUs) {
+  FlightRecord& record = slot();
+  record.timeMs = millis();
+  record.type = FLIGHT_SAMPLE;
+  record.code = position;
+  record.value = tickUs > 0xFFFF ? 0xFFFF : (uint16_t)tickUs;
+  record.renderUs = _slowestRenderUs;
+  record.accel[0] = data.accelX;
+  record.accel[1] = data.accelY;
+  record.accel[2] = data.accelZ;
+  commit();
+  _slowestRenderUs = 0;
+}
+
+/**
+ * Record an event
+ */
+void FlightRecorder::event(uint8_t code, uint16_t value) {
+  FlightRecord& record = slot();
+  record.timeMs = millis();
+  record.type = FLIGHT_EVENT;
+  record.code = code;
+  record.value = value;
+  record.renderUs = 0;
+  record.accel[0] = record.accel[1] = record.accel[2] = 0;
+  commit();
+}
+
+/**
+ * Record a fatal event and save the log, as no reset will follow
+ */
+void FlightRecorder::halt(uint8_t code, uint16_t value) {
+  event(code, value);
+  _crash = rtcLog;
+  _crash.resetReason = FLIGHT_REASON_HALT;
+  _crashLoaded = true;
+  save();
+}
+
+/**
+ * Records in the running log
+ */
+uint16_t FlightRecorder::count() {
+  return rtcLog.count;
+}
+
+/**
+ * A record of the running log by age
+ */
+const FlightRecord* FlightRecorder::get(uint16_t age) {
+  if (age >= rtcLog.count) return nullptr;
+  uint16_t index = (rtcLog.head + FLIGHT_RECORDER_CAPACITY - 1 - age) % FLIGHT_RECORDER_CAPACITY;
+  return &rtcLog.records[index];
+}
+
+/**
+ * True if a crash log is in RAM or NVS
+ */
+bool FlightRecorder::hasCrash() {
+  return load() && _crash.count > 0;
+}
+
+/**
+ * The saved crash log
+ */
+const FlightLog& FlightRecorder::lastCrash() {
+  load();
+  return _crash;
+}
+
+/**
+ * Save the crash log to NVS
+ */
+void FlightRecorder::save() {
+  Preferences preferences;
+  if (!preferences.begin(FLIGHT_NVS_NAMESPACE, false)) return;
+  preferences.putBytes(FLIGHT_NVS_KEY, &_crash, sizeof(_crash));
+  preferences.end();
+}
+
+/**
+ * Read the crash log from NVS once
+ */
+bool FlightRecorder::load() {
+  if (_crashLoaded) return isValid(_crash);
+  _crashLoaded = true;
+
+  Preferences preferences;
+  bool loaded = false;
+  if (preferences.begin(FLIGHT_NVS_NAMESPACE, true)) {
+    // A log saved by firmware with another capacity has another size
+    loaded = preferences.getBytesLength(FLIGHT_NVS_KEY) == sizeof(_crash) &&
+             preferences.getBytes(FLIGHT_NVS_KEY, &_crash, sizeof(_crash)) == sizeof(_crash) &&
+             isValid(_crash);
+    preferences.end();
+  }
+  if (!loaded) {
+    memset(&_crash, 0, sizeof(_crash));
+  }
+  return loaded;
+}
+
+/**
+ * Forget the crash log
+ */
+void FlightRecorder::clearCrash() {
+  memset(&_crash, 0, sizeof(_crash));
+  _crashLoaded = true;
+  Preferences preferences;
+  if (preferences.begin(FLIGHT_NVS_NAMESPACE, false)) {
+    preferences.remove(FLIGHT_NVS_KEY);
+    preferences.end();
+  }
+}
+
+/**
+ * Print the saved crash log
+ */
+void FlightRecorder::printCrash(Print& out) {
+  if (!hasCrash()) {
+    out.println("Flight recorder: no crash log saved");
+    return;
+  }
+  out.printf("Flight recorder: run ended by %s on boot %u, %u records\n",
+             reasonName(_crash.resetReason), _crash.bootCount, _crash.count);
+  printLog(_crash, out);
+}
+
+/**
+ * Print the running log
+ */
+void FlightRecorder::printLive(Print& out) {
+  out.printf("Flight recorder: boot %u, %u records\n", rtcLog.bootCount, rtcLog.count);
+  printLog(rtcLog, out);
+}
+
+/**
+ * Records as CSV, oldest first
+ */
+void FlightRecorder::printLog(const FlightLog& log, Print& out) {
+  out.println("time_ms,record,code,value,render_us,accel_x,accel_y,accel_z");
+  uint16_t first = (log.head + FLIGHT_RECORDER_CAPACITY - log.count) % FLIGHT_RECORDER_CAPACITY;
+  for (uint16_t i = 0; i < log.count; i++) {
+    const FlightRecord& record = log.records[(first + i) % FLIGHT_RECORDER_CAPACITY];
+    if (record.type == FLIGHT_SAMPLE) {
+      out.printf("%lu,sample,%u,%u,%u,%d,%d,%d\n", (unsigned long)record.timeMs, record.code, record.value,
+                 record.renderUs, record.accel[0], record.accel[1], record.accel[2]);
+    } else {
+      out.printf("%lu,%s,%u,%u,,,,\n", (unsigned long)record.timeMs, eventName(record.code), record.code, record.value);
+    }
+  }
+}
+
+/**
+ * Name of a reset reason
+ */
+const char* FlightRecorder::reasonName(uint8_t reason) {
+  switch (reason) {
+    case ESP_RST_POWERON:   return "POWERON";
+    case ESP_RST_EXT:       return "EXTERNAL";
+    case ESP_RST_SW:        return "SOFTWARE";
+    case ESP_RST_PANIC:     return "PANIC";
+    case ESP_RST_INT_WDT:   return "INT_WDT";
+    case ESP_RST_TASK_WDT:  return "TASK_WDT";
+    case ESP_RST_WDT:       return "WDT";
+    case ESP_RST_DEEPSLEEP: return "DEEPSLEEP";
+    case ESP_RST_BROWNOUT:  return "BROWNOUT";
+    case FLIGHT_REASON_HALT: return "HALT";
+    default:                return "UNKNOWN";
+  }
+}
@@ -0,0 +1,166 @@
+/**
+ * FlightRecorder.h
+ *
+ * Crash flight recorder: the last few seconds of sensor samples, loop
+ * timings and mode events, kept in RTC slow memory so they survive a
+ * watchdog, panic or brownout reset. The next boot checks the reset
+ * reason, keeps the log of a run that ended badly and saves it to NVS,
+ * where the 'flight' CLI command finds it even after a power cycle.
+ */
+
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <Arduino.h>
+#include "../core/SystemTypes.h"
+
+// Records kept (16 bytes each; RTC slow memory is 8 KB). At the 50 Hz
+// logic rate 192 records cover almost 4 seconds, twice that while idle.
+#ifndef FLIGHT_RECORDER_CAPACITY
+#define FLIGHT_RECORDER_CAPACITY 192
+#endif
+
+// Record types
+#define FLIGHT_SAMPLE 1
+#define FLIGHT_EVENT  2
+
+// Event codes (FlightRecord::code of FLIGHT_EVENT records)
+#define FLIGHT_EVENT_BOOT         1   // value: reset reason
+#define FLIGHT_EVENT_MODE         2   // value: new SystemMode
+#define FLIGHT_EVENT_SPELL        3   // value: SpellId
+#define FLIGHT_EVENT_SHAKE_CANCEL 4   // value: mode cancelled
+#define FLIGHT_EVENT_INIT_FAILED  5   // value: FLIGHT_INIT_* stage
+
+// Initialization stages reported by FLIGHT_EVENT_INIT_FAILED
+#define FLIGHT_INIT_HARDWARE  1
+#define FLIGHT_INIT_DETECTOR  2
+#define FLIGHT_INIT_IDLE      3
+#define FLIGHT_INIT_QUICKCAST 4
+#define FLIGHT_INIT_FREECAST  5
+
+// Reset reason of a log saved by halt(): the run stopped without a reset
+#define FLIGHT_REASON_HALT 0xFF
+
+/**
+ * One logic tick or event
+ */
+struct FlightRecord {
+  uint32_t timeMs;
+  uint8_t type;             // FLIGHT_SAMPLE or FLIGHT_EVENT
+  uint8_t code;             // Sample: HandPosition; event: FLIGHT_EVENT_*
+  uint16_t value;           // Sample: logic tick in µs (saturating); event: argument
+  uint16_t renderUs;        // Sample: slowest frame render since the previous sample
+  int16_t accel[3];         // Sample: raw accelerometer
+};
+
+/**
+ * The ring as it sits in RTC memory and in NVS
+ */
+struct FlightLog {
+  uint32_t magic;
+  uint16_t head;            // Next slot to write
+  uint16_t count;           // Records held
+  uint16_t bootCount;       // Boots since power-on
+  uint8_t resetReason;      // Of a saved log: how its run ended (esp_reset_reason_t)
+  uint8_t reserved;
+  FlightRecord records[FLIGHT_RECORDER_CAPACITY];
+};
+
+class FlightRecorder {
+public:
+  static const uint16_t CAPACITY = FLIGHT_RECORDER_CAPACITY;
+
+  /**
+   * Check how the previous run ended; call first thing in setup()
+   *
+   * A log left by a panic, watchdog or brownout reset is saved to NVS and
+   * announced on Serial. Recording then starts over.
+   */
+  static void begin();
+
+  /**
+   * Adopt the RTC log left by the previous run
+   * @param resetReason esp_reset_reason() of this boot
+   * @return True if the previous run crashed and its log was kept (see lastCrash())
+   */
+  static bool recover(uint8_t resetReason);
+
+  /**
+   * Record a logic tick: a few stores into RTC memory
+   * @param tickUs Duration of the tick
+   */
+  static void sample(const SensorData& data, uint8_t position, uint32_t tickUs);
+
+  /**
+   * Note a frame render time; the slowest goes into the next sample
+   */
+  static void noteRender(uint32_t renderUs) {
+    if (renderUs > _slowestRenderUs) _slowestRenderUs = renderUs > 0xFFFF ? 0xFFFF : (uint16_t)renderUs;
+  }
+
+  /**
+   * Record an event
+   * @param code FLIGHT_EVENT_*
+   */
+  static void event(uint8_t code, uint16_t value);
+
+  /**
+   * Record a fatal event and save the log now, before the firmware stops
+   */
+  static void halt(uint8_t code, uint16_t value);
+
+  /**
+   * Records in the running log
+   */
+  static uint16_t count();
+
+  /**
+   * A record of the running log
+   * @param age 0 for the newest
+   * @return nullptr if age >= count()
+   */
+  static const FlightRecord* get(uint16_t age);
+
+  /**
+   * True if a crash log was recovered at boot or is saved in NVS
+   */
+  static bool hasCrash();
+
+  /**
+   * The saved crash log (empty if hasCrash() is false)
+   */
+  static const FlightLog& lastCrash();
+
+  /**
+   * Print the saved crash log as CSV, oldest record first
+   */
+  static void printCrash(Print& out);
+
+  /**
+   * Print the running log as CSV
+   */
+  static void printLive(Print& out);
+
+  /**
+   * Forget the saved crash log, in RAM and in NVS
+   */
+  static void clearCrash();
+
+  /**
+   * Name of an esp_reset_reason_t value
+   */
+  static const char* reasonName(uint8_t reason);
+
+private:
+  static FlightRecord& slot();
+  static void commit();
+  static void printLog(const FlightLog& log, Print& out);
+  static void save();
+  static bool load();
+
+  static FlightLog _crash;          // Copy of the last crashed run
+  static bool _crashLoaded;         // _crash holds what NVS has
+  static uint16_t _slowestRenderUs;
+};
+
+#endif // FLIGHT_RECORDER_H
@@ -0,0 +1,26 @@
+#ifndef MEMORY_MAP_H
+#define MEMORY_MAP_H
+
+#include <stdint.h>
+
+/**
+ * @brief Static RAM per subsystem, from the firmware's linker map
+ *
+ * GENERATED by utils/ram_map.py - do not edit by hand.
+ * Source: no firmware.map yet (run after an esp32dev build); sorted by total size.
+ */
+struct MemoryMapEntry {
+  const char* name;
+  uint32_t data;             // Initialized DRAM
+  uint32_t bss;              // Zeroed DRAM and .noinit
+  uint32_t rtc;              // RTC fast and slow memory
+  uint32_t iram;             // Code and data in IRAM
+};
+
+const MemoryMapEntry MEMORY_MAP[] = {
+  {"", 0, 0, 0, 0},
+};
+
+const uint8_t MEMORY_MAP_COUNT = 0;
+
+#endif // MEMORY_MAP_H
@@ -0,0 +1,242 @@
+/**
+ * MemoryMonitor.cpp
+ *
+ * Implementation of the MemoryMonitor class for the LUTT toolkit.
+ */
+
+#include "MemoryMonitor.h"
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+
+#if defined(ESP_PLATFORM)
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+// AddressSanitizer builds count through the sanitizer allocator instead of
+// replacing operator new, which would hide new/delete mismatches from it
+#if defined(__SANITIZE_ADDRESS__)
+#define MEMORY_SANITIZER 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define MEMORY_SANITIZER 1
+#endif
+#endif
+#ifndef MEMORY_SANITIZER
+#define MEMORY_SANITIZER 0
+#endif
+
+#if MEMORY_SANITIZER
+// From <sanitizer/allocator_interface.h>, which not every toolchain ships
+extern "C" {
+  size_t __sanitizer_get_current_allocated_bytes();
+  size_t __sanitizer_get_free_bytes();
+  int __sanitizer_install_malloc_and_free_hooks(void (*mallocHook)(const volatile void*, size_t),
+                                                void (*freeHook)(const volatile void*));
+}
+#endif
+
+namespace {
+
+  std::atomic<uint32_t> allocationCount(0);
+  std::atomic<uint32_t> freeCount(0);
+
+  inline void countAllocation() {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  inline void countFree(const void* ptr) {
+    if (ptr) freeCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+#if MEMORY_SANITIZER
+  uint32_t minFreeBytes = UINT32_MAX;
+
+  void onMalloc(const volatile void*, size_t) {
+    countAllocation();
+  }
+
+  void onFree(const volatile void* ptr) {
+    countFree((const void*)ptr);
+  }
+
+  // Installed before main() so the counts start at boot
+  struct SanitizerHooks {
+    SanitizerHooks() {
+      __sanitizer_install_malloc_and_free_hooks(onMalloc, onFree);
+    }
+  } sanitizerHooks;
+#endif
+
+#if defined(ESP_PLATFORM)
+  // Tasks the Arduino core and ESP-IDF start, looked up by name when the
+  // FreeRTOS trace facility that lists every task is not built in
+  const char* const KNOWN_TASKS[] = {
+    "loopTask", "IDLE0", "IDLE1", "Tmr Svc", "esp_timer", "ipc0", "ipc1", "arduino_events", "uart_event_task"
+  };
+
+  uint8_t coreOf(TaskHandle_t task) {
+    BaseType_t core = xTaskGetAffinity(task);
+    return core == tskNO_AFFINITY ? 0xFF : (uint8_t)core;
+  }
+#endif
+
+} // namespace
+
+#if MEMORY_COUNT_ALLOCATIONS && !MEMORY_SANITIZER
+/*
+ * Counting replacements of the global allocation functions. They allocate
+ * from the same heap as the originals; only the counters are added.
+ */
+static void* countedNew(size_t size) {
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr) {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+    throw std::bad_alloc();
+#else
+    abort();
+#endif
+  }
+  countAllocation();
+  return ptr;
+}
+
+static void* countedNewNothrow(size_t size) {
+  void* ptr = malloc(size ? size : 1);
+  if (ptr) countAllocation();
+  return ptr;
+}
+
+static void countedDelete(void* ptr) {
+  countFree(ptr);
+  free(ptr);
+}
+
+void* operator new(size_t size) { return countedNew(size); }
+void* operator new[](size_t size) { return countedNew(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedNewNothrow(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedNewNothrow(size); }
+void operator delete(void* ptr) noexcept { countedDelete(ptr); }
+void operator delete[](void* ptr) noexcept { countedDelete(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { countedDelete(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { countedDelete(ptr); }
+#endif
+
+/**
+ * Read the current figures
+ */
+void MemoryMonitor::sample(MemoryStats& stats) {
+  stats.heapUsed = 0;
+  stats.heapFree = 0;
+  stats.heapLargestBlock = 0;
+  stats.heapMinFree = 0;
+  stats.loopStackFree = 0;
+
+#if defined(ESP_PLATFORM)
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+  stats.heapUsed = info.total_allocated_bytes;
+  stats.heapFree = info.total_free_bytes;
+  stats.heapLargestBlock = info.largest_free_block;
+  stats.heapMinFree = info.minimum_free_bytes;
+
+  // uxTaskGetStackHighWaterMark() counts bytes on ESP-IDF (StackType_t is a byte)
+  TaskHandle_t loop = xTaskGetHandle("loopTask");
+  if (loop) stats.loopStackFree = uxTaskGetStackHighWaterMark(loop);
+#elif MEMORY_SANITIZER
+  stats.heapUsed = __sanitizer_get_current_allocated_bytes();
+  stats.heapFree = __sanitizer_get_free_bytes();
+  // The sanitizer allocator maps new regions on demand, so there is no
+  // largest block; heapFree is what it holds unused in mapped regions
+  if (stats.heapFree < minFreeBytes) minFreeBytes = stats.heapFree;
+  stats.heapMinFree = minFreeBytes;
+#endif
+
+  stats.allocations = allocations();
+  stats.frees = frees();
+}
+
+/**
+ * Stack high-water marks of every task, loop task first
+ */
+uint8_t MemoryMonitor::sampleTasks(TaskStackInfo* tasks, uint8_t max) {
+  uint8_t count = 0;
+#if defined(ESP_PLATFORM)
+#if configUSE_TRACE_FACILITY
+  TaskStatus_t status[MEMORY_MAX_TASKS];
+  UBaseType_t total = uxTaskGetSystemState(status, MEMORY_MAX_TASKS, nullptr);
+  for (UBaseType_t i = 0; i < total && count < max; i++) {
+    TaskStackInfo& task = tasks[count++];
+    task.name = status[i].pcTaskName;
+    task.stackFree = status[i].usStackHighWaterMark;
+    task.core = coreOf(status[i].xHandle);
+    task.priority = (uint8_t)status[i].uxCurrentPriority;
+  }
+#else
+  for (uint8_t i = 0; i < sizeof(KNOWN_TASKS) / sizeof(KNOWN_TASKS[0]) && count < max; i++) {
+    TaskHandle_t handle = xTaskGetHandle(KNOWN_TASKS[i]);
+    if (!handle) continue;
+    TaskStackInfo& task = tasks[count++];
+    task.name = KNOWN_TASKS[i];
+    task.stackFree = uxTaskGetStackHighWaterMark(handle);
+    task.core = coreOf(handle);
+    task.priority = (uint8_t)uxTaskPriorityGet(handle);
+  }
+#endif
+  // Loop task first: it runs the firmware
+  for (uint8_t i = 1; i < count; i++) {
+    if (strcmp(tasks[i].name, "loopTask") == 0) {
+      TaskStackInfo loop = tasks[i];
+      memmove(&tasks[1], &tasks[0], i * sizeof(TaskStackInfo));
+      tasks[0] = loop;
+      break;
+    }
+  }
+#else
+  (void)tasks;
+  (void)max;
+#endif
+  return count;
+}
+
+/**
+ * Size the loop task stack was created with
+ */
+uint32_t MemoryMonitor::loopStackSize() {
+#if defined(ESP_PLATFORM) && defined(SET_LOOP_TASK_STACK_SIZE)
+  return getArduinoLoopTaskStackSize();
+#elif defined(ESP_PLATFORM) && defined(CONFIG_ARDUINO_LOOP_STACK_SIZE)
+  return CONFIG_ARDUINO_LOOP_STACK_SIZE;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * True if the heap fields of MemoryStats are measured
+ */
+bool MemoryMonitor::hasHeapStats() {
+#if defined(ESP_PLATFORM) || MEMORY_SANITIZER
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * operator new calls since boot
+ */
+uint32_t MemoryMonitor::allocations() {
+  return allocationCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * operator delete calls since boot
+ */
+uint32_t MemoryMonitor::frees() {
+  return freeCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,90 @@
+/**
+ * MemoryMonitor.h
+ *
+ * Runtime memory figures for the LUTT toolkit: heap free, largest block and
+ * low-water mark, stack high-water marks per FreeRTOS task, and C++
+ * allocation counts since boot. Static RAM per subsystem comes from the
+ * linker map summary in MemoryMap.h (utils/ram_map.py).
+ *
+ * Host builds report the same figures through the AddressSanitizer
+ * allocator when built with -fsanitize=address; without it only the
+ * allocation counts are available.
+ */
+
+#ifndef MEMORY_MONITOR_H
+#define MEMORY_MONITOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Count operator new/delete calls (replaces the global operators)
+#ifndef MEMORY_COUNT_ALLOCATIONS
+#define MEMORY_COUNT_ALLOCATIONS 1
+#endif
+
+// Tasks listed by sampleTasks()
+#ifndef MEMORY_MAX_TASKS
+#define MEMORY_MAX_TASKS 20
+#endif
+
+/**
+ * Heap, loop stack and allocation figures at one moment
+ *
+ * Heap fields are 0 where the build cannot measure them (see hasHeapStats()).
+ */
+struct MemoryStats {
+  uint32_t heapUsed;          // Bytes allocated
+  uint32_t heapFree;          // Bytes free
+  uint32_t heapLargestBlock;  // Largest allocation that would succeed
+  uint32_t heapMinFree;       // Lowest heapFree since boot
+  uint32_t loopStackFree;     // Loop task stack never touched so far, in bytes
+  uint32_t allocations;       // operator new calls since boot (every malloc on sanitizer builds)
+  uint32_t frees;             // operator delete calls since boot
+};
+
+/**
+ * Stack high-water mark of one task
+ */
+struct TaskStackInfo {
+  const char* name;
+  uint32_t stackFree;         // Bytes never touched so far
+  uint8_t core;               // Pinned core, or 0xFF if the task may run on either
+  uint8_t priority;
+};
+
+class MemoryMonitor {
+public:
+  /**
+   * Read the current figures (a few microseconds; safe to call every second)
+   */
+  static void sample(MemoryStats& stats);
+
+  /**
+   * Stack high-water marks of every task, loop task first
+   * @param tasks Destination, up to max entries
+   * @return Entries written (0 on host builds)
+   */
+  static uint8_t sampleTasks(TaskStackInfo* tasks, uint8_t max);
+
+  /**
+   * Size the loop task stack was created with, or 0 if unknown
+   */
+  static uint32_t loopStackSize();
+
+  /**
+   * True if the heap fields of MemoryStats are measured
+   */
+  static bool hasHeapStats();
+
+  /**
+   * operator new calls since boot (every malloc on sanitizer builds)
+   */
+  static uint32_t allocations();
+
+  /**
+   * operator delete calls since boot
+   */
+  static uint32_t frees();
+};
+
+#endif // MEMORY_MONITOR_H
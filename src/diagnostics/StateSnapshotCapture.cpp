@@ -1,16 +1,74 @@
 /**
  * StateSnapshotCapture.cpp
- * 
+ *
  * Implementation of the StateSnapshotCapture class for the LUTT toolkit.
  */
 
 #include "StateSnapshotCapture.h"
-#include "DiagnosticLogger.h"
+#include "../hardware/SerialTx.h"
 
 // Initialize static variables
-StaticJsonDocument<512> StateSnapshotCapture::_snapshot;
+SnapshotRecord StateSnapshotCapture::_history[StateSnapshotCapture::HISTORY];
+uint32_t StateSnapshotCapture::_captures = 0;
+uint8_t StateSnapshotCapture::_count = 0;
 bool StateSnapshotCapture::_hasContent = false;
-unsigned long StateSnapshotCapture::_captureTime = 0;
+
+// Binary dump layout (see utils/snapshot_tool.py)
+static const uint16_t SNAPSHOT_DUMP_VERSION = 1;
+
+// Most distinct strings a dump can reference: a context plus a name and value per field
+static const uint16_t SNAPSHOT_MAX_STRINGS = SNAPSHOT_HISTORY * (1 + 2 * MAX_SNAPSHOT_FIELDS);
+
+namespace {
+
+  void writeWord(Print& out, uint32_t value) {
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    out.write(bytes, sizeof(bytes));
+  }
+
+  void writeHalf(Print& out, uint16_t value) {
+    uint8_t bytes[2] = {(uint8_t)value, (uint8_t)(value >> 8)};
+    out.write(bytes, sizeof(bytes));
+  }
+
+  const char* triggerName(uint8_t trigger) {
+    switch (trigger) {
+      case SNAPSHOT_TRIGGER_GESTURE_START: return "GESTURE_START";
+      case SNAPSHOT_TRIGGER_GESTURE_END:   return "GESTURE_END";
+      case SNAPSHOT_TRIGGER_MODE_CHANGE:   return "MODE_CHANGE";
+      case SNAPSHOT_TRIGGER_ANIMATION:     return "ANIMATION";
+      case SNAPSHOT_TRIGGER_FREECAST:      return "FREECAST";
+      case SNAPSHOT_TRIGGER_ERROR:         return "ERROR";
+      case SNAPSHOT_TRIGGER_TEST:          return "TEST";
+      default:                             return "OTHER";
+    }
+  }
+
+  /**
+   * String table for a dump: each distinct string once, referenced by index
+   */
+  class StringTable {
+  public:
+    StringTable() : _size(0) {}
+
+    uint16_t indexOf(const char* text) {
+      if (!text) text = "";
+      for (uint16_t i = 0; i < _size; i++) {
+        if (_strings[i] == text || strcmp(_strings[i], text) == 0) return i;
+      }
+      _strings[_size] = text;
+      return _size++;
+    }
+
+    uint16_t size() const { return _size; }
+    const char* at(uint16_t index) const { return _strings[index]; }
+
+  private:
+    const char* _strings[SNAPSHOT_MAX_STRINGS];
+    uint16_t _size;
+  };
+
+} // namespace
 
 /**
  * Initialize the state snapshot system
@@ -24,16 +82,21 @@ void StateSnapshotCapture::init() {
  */
 void StateSnapshotCapture::capture(uint8_t triggerPoint, const char* context) {
   // Skip if trigger doesn't match filter
-  if (!(SNAPSHOT_TRIGGER_FILTER & triggerPoint)) return;
-  
-  // Clear any previous snapshot
-  clear();
-  
-  // Set base metadata
-  _captureTime = millis();
-  _snapshot["time"] = _captureTime;
-  _snapshot["trigger"] = triggerPoint;
-  _snapshot["context"] = context;
+  if (!(SNAPSHOT_TRIGGER_FILTER & triggerPoint)) {
+    _hasContent = false;
+    return;
+  }
+
+  // Reuse the oldest slot; only the header is written, fields fill in after
+  SnapshotRecord& record = _history[_captures % HISTORY];
+  _captures++;
+  if (_count < HISTORY) _count++;
+
+  record.timeMs = millis();
+  record.sequence = _captures;
+  record.context = context;
+  record.trigger = triggerPoint;
+  record.fieldCount = 0;
   _hasContent = true;
 }
 
@@ -41,59 +104,180 @@ void StateSnapshotCapture::capture(uint8_t triggerPoint, const char* context) {
  * Add a field to the current snapshot (integer variant)
  */
 void StateSnapshotCapture::addField(const char* name, int value) {
-  if (!_hasContent) return;
-  _snapshot[name] = value;
+  SnapshotField* field = nextField(name, SNAPSHOT_FIELD_INT);
+  if (field) field->value.i = value;
 }
 
 /**
  * Add a field to the current snapshot (float variant)
  */
 void StateSnapshotCapture::addField(const char* name, float value) {
-  if (!_hasContent) return;
-  _snapshot[name] = value;
+  SnapshotField* field = nextField(name, SNAPSHOT_FIELD_FLOAT);
+  if (field) field->value.f = value;
 }
 
 /**
  * Add a field to the current snapshot (string variant)
  */
 void StateSnapshotCapture::addField(const char* name, const char* value) {
-  if (!_hasContent) return;
-  _snapshot[name] = value;
+  SnapshotField* field = nextField(name, SNAPSHOT_FIELD_STRING);
+  if (field) field->value.s = value;
 }
 
 /**
  * Add a field to the current snapshot (boolean variant)
  */
 void StateSnapshotCapture::addField(const char* name, bool value) {
-  if (!_hasContent) return;
-  _snapshot[name] = value;
+  SnapshotField* field = nextField(name, SNAPSHOT_FIELD_BOOL);
+  if (field) field->value.b = value;
+}
+
+/**
+ * Next free slot of the latest record, or nullptr if there is none
+ */
+SnapshotField* StateSnapshotCapture::nextField(const char* name, uint8_t type) {
+  if (!_hasContent) return nullptr;
+  SnapshotRecord& record = _history[(_captures - 1) % HISTORY];
+  if (record.fieldCount >= MAX_SNAPSHOT_FIELDS) return nullptr;
+
+  SnapshotField& field = record.fields[record.fieldCount++];
+  field.name = name;
+  field.type = type;
+  return &field;
 }
 
 /**
- * Clear the snapshot buffer
+ * Clear the snapshot history
  */
 void StateSnapshotCapture::clear() {
-  _snapshot.clear();
+  _count = 0;
   _hasContent = false;
-  _captureTime = 0;
 }
 
 /**
- * Output the snapshot to Serial
+ * Snapshots in the history
+ */
+uint8_t StateSnapshotCapture::count() {
+  return _count;
+}
+
+/**
+ * Snapshot by age
+ */
+const SnapshotRecord* StateSnapshotCapture::get(uint8_t age) {
+  if (age >= _count) return nullptr;
+  return &_history[(_captures - 1 - age) % HISTORY];
+}
+
+/**
+ * Output one snapshot to Serial
+ */
+void StateSnapshotCapture::printRecord(const SnapshotRecord& record) {
+  SerialOut.printf("--- SNAPSHOT #%lu [%lu] %s (%s) ---\n", (unsigned long)record.sequence,
+                   (unsigned long)record.timeMs, triggerName(record.trigger),
+                   record.context ? record.context : "");
+  for (uint8_t i = 0; i < record.fieldCount; i++) {
+    const SnapshotField& field = record.fields[i];
+    switch (field.type) {
+      case SNAPSHOT_FIELD_INT:
+        SerialOut.printf("  %s: %ld\n", field.name, (long)field.value.i);
+        break;
+      case SNAPSHOT_FIELD_FLOAT:
+        SerialOut.printf("  %s: %.4f\n", field.name, (double)field.value.f);
+        break;
+      case SNAPSHOT_FIELD_STRING:
+        SerialOut.printf("  %s: %s\n", field.name, field.value.s ? field.value.s : "");
+        break;
+      case SNAPSHOT_FIELD_BOOL:
+        SerialOut.printf("  %s: %s\n", field.name, field.value.b ? "true" : "false");
+        break;
+    }
+  }
+}
+
+/**
+ * Output the latest snapshot to Serial
  */
 void StateSnapshotCapture::printSnapshot() {
-  if (!_hasContent) {
-    DiagnosticLogger::print("No snapshot data available");
+  const SnapshotRecord* latest = get(0);
+  if (!latest) {
+    SerialOut.println("No snapshot data available");
+    return;
+  }
+  printRecord(*latest);
+  SerialOut.println("--- END SNAPSHOT ---");
+}
+
+/**
+ * Output every snapshot in the history to Serial, oldest first
+ */
+void StateSnapshotCapture::printHistory() {
+  if (_count == 0) {
+    SerialOut.println("No snapshot data available");
     return;
   }
-  
-  // Print metadata header
-  DiagnosticLogger::print("--- SNAPSHOT [%lu] ---", _captureTime);
-  
-  // Serialize to JSON and print
-  String jsonOutput;
-  serializeJsonPretty(_snapshot, jsonOutput);
-  Serial.println(jsonOutput);
-  
-  DiagnosticLogger::print("--- END SNAPSHOT ---");
-} 
\ No newline at end of file
+  for (uint8_t age = _count; age > 0; age--) {
+    printRecord(*get(age - 1));
+  }
+  SerialOut.printf("--- END SNAPSHOTS (%u of %lu) ---\n", _count, (unsigned long)_captures);
+}
+
+/**
+ * Write the history as a binary dump, oldest first
+ *
+ * Layout (little-endian):
+ *   header: 'DSNP', u16 version, u16 snapshot count, u16 string count
+ *   string: u8 length, bytes (no terminator), once per distinct string
+ *   record: u32 time (ms), u32 sequence, u16 context string, u8 trigger, u8 field count
+ *   field:  u16 name string, u8 type, u8 0, u32 value (string index for strings)
+ */
+uint8_t StateSnapshotCapture::dumpBinary(Print& out) {
+  // Static: the table is too big for the loop task's stack and dumps never overlap
+  static StringTable strings;
+  strings = StringTable();
+  for (uint8_t age = _count; age > 0; age--) {
+    const SnapshotRecord& record = *get(age - 1);
+    strings.indexOf(record.context);
+    for (uint8_t i = 0; i < record.fieldCount; i++) {
+      strings.indexOf(record.fields[i].name);
+      if (record.fields[i].type == SNAPSHOT_FIELD_STRING) strings.indexOf(record.fields[i].value.s);
+    }
+  }
+
+  out.write(reinterpret_cast<const uint8_t*>("DSNP"), 4);
+  writeHalf(out, SNAPSHOT_DUMP_VERSION);
+  writeHalf(out, _count);
+  writeHalf(out, strings.size());
+
+  for (uint16_t i = 0; i < strings.size(); i++) {
+    size_t length = strlen(strings.at(i));
+    uint8_t clipped = length > 255 ? 255 : (uint8_t)length;
+    out.write(clipped);
+    out.write(reinterpret_cast<const uint8_t*>(strings.at(i)), clipped);
+  }
+
+  for (uint8_t age = _count; age > 0; age--) {
+    const SnapshotRecord& record = *get(age - 1);
+    writeWord(out, record.timeMs);
+    writeWord(out, record.sequence);
+    writeHalf(out, strings.indexOf(record.context));
+    uint8_t header[2] = {record.trigger, record.fieldCount};
+    out.write(header, sizeof(header));
+
+    for (uint8_t i = 0; i < record.fieldCount; i++) {
+      const SnapshotField& field = record.fields[i];
+      writeHalf(out, strings.indexOf(field.name));
+      uint8_t type[2] = {field.type, 0};
+      out.write(type, sizeof(type));
+      uint32_t word = 0;
+      switch (field.type) {
+        case SNAPSHOT_FIELD_INT:    word = (uint32_t)field.value.i; break;
+        case SNAPSHOT_FIELD_FLOAT:  memcpy(&word, &field.value.f, sizeof(word)); break;
+        case SNAPSHOT_FIELD_STRING: word = strings.indexOf(field.value.s); break;
+        case SNAPSHOT_FIELD_BOOL:   word = field.value.b ? 1 : 0; break;
+      }
+      writeWord(out, word);
+    }
+  }
+  return _count;
+}
@@ -1,19 +1,27 @@
 /**
  * StateSnapshotCapture.h
- * 
+ *
  * A simple state serialization utility to capture and report system state at key points.
  * Part of the Lightweight Universal Troubleshooting Toolkit (LUTT)
+ *
+ * Snapshots are fixed-size binary records kept in a circular history of the
+ * last SNAPSHOT_HISTORY captures. Formatting happens only when a snapshot is
+ * printed or dumped for utils/snapshot_tool.py.
  */
 
 #ifndef STATE_SNAPSHOT_CAPTURE_H
 #define STATE_SNAPSHOT_CAPTURE_H
 
 #include <Arduino.h>
-#include <ArduinoJson.h>
 
 // Maximum number of fields in a snapshot
 #define MAX_SNAPSHOT_FIELDS 10
 
+// Snapshots kept in the history (set in platformio.ini to override)
+#ifndef SNAPSHOT_HISTORY
+#define SNAPSHOT_HISTORY 8
+#endif
+
 // Snapshot trigger points (for filtering)
 #define SNAPSHOT_TRIGGER_GESTURE_START  0x01
 #define SNAPSHOT_TRIGGER_GESTURE_END    0x02
@@ -28,62 +36,130 @@
 #define SNAPSHOT_TRIGGER_FILTER SNAPSHOT_TRIGGER_ALL
 #endif
 
+// Field value types
+#define SNAPSHOT_FIELD_INT    0
+#define SNAPSHOT_FIELD_FLOAT  1
+#define SNAPSHOT_FIELD_STRING 2
+#define SNAPSHOT_FIELD_BOOL   3
+
+/**
+ * One typed key/value slot
+ *
+ * Names and string values are kept by pointer, so they must be string
+ * literals or other strings that live for the whole program.
+ */
+struct SnapshotField {
+  const char* name;
+  uint8_t type;             // SNAPSHOT_FIELD_*
+  union {
+    int32_t i;
+    float f;
+    const char* s;
+    bool b;
+  } value;
+};
+
+/**
+ * One captured snapshot
+ */
+struct SnapshotRecord {
+  uint32_t timeMs;
+  uint32_t sequence;        // Capture number since startup, from 1
+  const char* context;      // Where the snapshot was taken (static string)
+  uint8_t trigger;          // SNAPSHOT_TRIGGER_*
+  uint8_t fieldCount;
+  SnapshotField fields[MAX_SNAPSHOT_FIELDS];
+};
+
 class StateSnapshotCapture {
 public:
+  static const uint8_t HISTORY = SNAPSHOT_HISTORY;
+
   /**
    * Initialize the state snapshot system
    */
   static void init();
-  
+
   /**
    * Capture state snapshot if trigger matches filter
+   *
+   * Starts a new record in the history, replacing the oldest one when full.
+   * Fields added afterwards go into this record.
    * @param triggerPoint One of the SNAPSHOT_TRIGGER_* constants
-   * @param context String describing where the snapshot was triggered
+   * @param context String describing where the snapshot was triggered (static string)
    */
   static void capture(uint8_t triggerPoint, const char* context);
-  
+
   /**
    * Add a field to the current snapshot (integer variant)
    * @param name Field name
    * @param value Integer value
    */
   static void addField(const char* name, int value);
-  
+
   /**
    * Add a field to the current snapshot (float variant)
    * @param name Field name
    * @param value Float value
    */
   static void addField(const char* name, float value);
-  
+
   /**
    * Add a field to the current snapshot (string variant)
    * @param name Field name
-   * @param value String value
+   * @param value String value (static string)
    */
   static void addField(const char* name, const char* value);
-  
+
   /**
    * Add a field to the current snapshot (boolean variant)
    * @param name Field name
    * @param value Boolean value
    */
   static void addField(const char* name, bool value);
-  
+
   /**
-   * Clear the snapshot buffer
+   * Clear the snapshot history
    */
   static void clear();
-  
+
   /**
-   * Output the snapshot to Serial
+   * Output the latest snapshot to Serial
    */
   static void printSnapshot();
 
+  /**
+   * Output every snapshot in the history to Serial, oldest first
+   */
+  static void printHistory();
+
+  /**
+   * Write the history as a binary dump for utils/snapshot_tool.py
+   * @param out Destination, usually Serial
+   * @return Number of snapshots written
+   */
+  static uint8_t dumpBinary(Print& out);
+
+  /**
+   * Snapshots in the history
+   */
+  static uint8_t count();
+
+  /**
+   * Snapshot by age
+   * @param age 0 for the latest, up to count() - 1 for the oldest
+   * @return The record, or nullptr if there is no such snapshot
+   */
+  static const SnapshotRecord* get(uint8_t age);
+
 private:
-  static StaticJsonDocument<512> _snapshot;
-  static bool _hasContent;
-  static unsigned long _captureTime;
+  static void printRecord(const SnapshotRecord& record);
+  static SnapshotField* nextField(const char* name, uint8_t type);
+
+  static SnapshotRecord _history[HISTORY];
+  static uint32_t _captures;       // Snapshots taken since startup
+  static uint8_t _count;           // Snapshots in the history
+  static bool _hasContent;         // Fields go into the latest record
 };
 
-#endif // STATE_SNAPSHOT_CAPTURE_H 
\ No newline at end of file
+#endif // STATE_SNAPSHOT_CAPTURE_H
@@ -0,0 +1,202 @@
+/**
+ * TelemetryFrame.cpp
+ *
+ * COBS framing, CRC and packet packing for the telemetry stream.
+ */
+
+#include "TelemetryFrame.h"
+#include <string.h>
+
+namespace {
+
+  void putU16(uint8_t*& out, uint16_t value) {
+    *out++ = (uint8_t)value;
+    *out++ = (uint8_t)(value >> 8);
+  }
+
+  void putU32(uint8_t*& out, uint32_t value) {
+    putU16(out, (uint16_t)value);
+    putU16(out, (uint16_t)(value >> 16));
+  }
+
+  uint16_t getU16(const uint8_t*& in) {
+    uint16_t value = (uint16_t)(in[0] | (in[1] << 8));
+    in += 2;
+    return value;
+  }
+
+  uint32_t getU32(const uint8_t*& in) {
+    uint32_t low = getU16(in);
+    return low | ((uint32_t)getU16(in) << 16);
+  }
+
+  int16_t toFixed(float value) {
+    float scaled = value * TelemetryFrame::FILTERED_SCALE;
+    if (scaled > 32767.0f) return 32767;
+    if (scaled < -32768.0f) return -32768;
+    return (int16_t)(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+  }
+
+  // Append the CRC, COBS-encode and delimit a payload
+  size_t frame(uint8_t* payload, size_t length, uint8_t* out) {
+    uint16_t crc = TelemetryFrame::crc16(payload, length);
+    payload[length] = (uint8_t)crc;
+    payload[length + 1] = (uint8_t)(crc >> 8);
+
+    out[0] = 0;
+    size_t encoded = TelemetryFrame::cobsEncode(payload, length + TelemetryFrame::CRC_SIZE, out + 1);
+    out[1 + encoded] = 0;
+    return encoded + 2;
+  }
+
+} // namespace
+
+uint16_t TelemetryFrame::crc16(const uint8_t* data, size_t length) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+size_t TelemetryFrame::cobsEncode(const uint8_t* data, size_t length, uint8_t* out) {
+  size_t codeIndex = 0;
+  size_t written = 1;
+  uint8_t code = 1;
+  for (size_t i = 0; i < length; i++) {
+    if (data[i] == 0) {
+      out[codeIndex] = code;
+      codeIndex = written++;
+      code = 1;
+    } else {
+      out[written++] = data[i];
+      code++;
+    }
+  }
+  out[codeIndex] = code;
+  return written;
+}
+
+size_t TelemetryFrame::cobsDecode(const uint8_t* data, size_t length, uint8_t* out) {
+  size_t written = 0;
+  size_t i = 0;
+  while (i < length) {
+    uint8_t code = data[i++];
+    if (code == 0 || i + code - 1 > length) {
+      return 0;
+    }
+    for (uint8_t j = 1; j < code; j++) {
+      if (data[i] == 0) {
+        return 0;
+      }
+      out[written++] = data[i++];
+    }
+    // A zero follows every block except the last
+    if (code < 0xFF && i < length) {
+      out[written++] = 0;
+    }
+  }
+  return written;
+}
+
+size_t TelemetryFrame::encodeSample(const TelemetrySample& sample, uint8_t* out) {
+  uint8_t payload[SAMPLE_PAYLOAD_SIZE + CRC_SIZE];
+  uint8_t* p = payload;
+  *p++ = PACKET_SAMPLE;
+  putU16(p, sample.sequence);
+  putU32(p, sample.timeUs);
+  for (uint8_t i = 0; i < 6; i++) {
+    putU16(p, (uint16_t)sample.raw[i]);
+  }
+  for (uint8_t i = 0; i < 3; i++) {
+    putU16(p, (uint16_t)toFixed(sample.filtered[i]));
+  }
+  *p++ = sample.position;
+  *p++ = sample.confidence;
+  return frame(payload, SAMPLE_PAYLOAD_SIZE, out);
+}
+
+size_t TelemetryFrame::encodeHeader(const TelemetryHeader& header, uint8_t* out) {
+  uint8_t payload[HEADER_PAYLOAD_SIZE + CRC_SIZE];
+  uint8_t* p = payload;
+  *p++ = PACKET_HEADER;
+  *p++ = VERSION;
+  putU16(p, header.rateHz);
+  putU32(p, header.baud);
+  uint32_t bits;
+  memcpy(&bits, &header.scalingFactor, sizeof(bits));
+  putU32(p, bits);
+  return frame(payload, HEADER_PAYLOAD_SIZE, out);
+}
+
+size_t TelemetryFrame::encodeMemory(const MemoryStats& stats, uint8_t* out) {
+  uint8_t payload[MEMORY_PAYLOAD_SIZE + CRC_SIZE];
+  uint8_t* p = payload;
+  *p++ = PACKET_MEMORY;
+  putU32(p, stats.heapUsed);
+  putU32(p, stats.heapFree);
+  putU32(p, stats.heapLargestBlock);
+  putU32(p, stats.heapMinFree);
+  putU16(p, stats.loopStackFree > 0xFFFF ? 0xFFFF : (uint16_t)stats.loopStackFree);
+  putU32(p, stats.allocations);
+  putU32(p, stats.frees);
+  return frame(payload, MEMORY_PAYLOAD_SIZE, out);
+}
+
+size_t TelemetryFrame::decodeFrame(const uint8_t* block, size_t length, uint8_t* payload) {
+  size_t decoded = cobsDecode(block, length, payload);
+  if (decoded <= CRC_SIZE) {
+    return 0;
+  }
+  size_t payloadLength = decoded - CRC_SIZE;
+  uint16_t crc = (uint16_t)(payload[payloadLength] | (payload[payloadLength + 1] << 8));
+  return crc16(payload, payloadLength) == crc ? payloadLength : 0;
+}
+
+bool TelemetryFrame::parseSample(const uint8_t* payload, size_t length, TelemetrySample& sample) {
+  if (length != SAMPLE_PAYLOAD_SIZE || payload[0] != PACKET_SAMPLE) {
+    return false;
+  }
+  const uint8_t* p = payload + 1;
+  sample.sequence = getU16(p);
+  sample.timeUs = getU32(p);
+  for (uint8_t i = 0; i < 6; i++) {
+    sample.raw[i] = (int16_t)getU16(p);
+  }
+  for (uint8_t i = 0; i < 3; i++) {
+    sample.filtered[i] = (int16_t)getU16(p) / FILTERED_SCALE;
+  }
+  sample.position = *p++;
+  sample.confidence = *p++;
+  return true;
+}
+
+bool TelemetryFrame::parseHeader(const uint8_t* payload, size_t length, TelemetryHeader& header) {
+  if (length != HEADER_PAYLOAD_SIZE || payload[0] != PACKET_HEADER || payload[1] != VERSION) {
+    return false;
+  }
+  const uint8_t* p = payload + 2;
+  header.rateHz = getU16(p);
+  header.baud = getU32(p);
+  uint32_t bits = getU32(p);
+  memcpy(&header.scalingFactor, &bits, sizeof(bits));
+  return true;
+}
+
+bool TelemetryFrame::parseMemory(const uint8_t* payload, size_t length, MemoryStats& stats) {
+  if (length != MEMORY_PAYLOAD_SIZE || payload[0] != PACKET_MEMORY) {
+    return false;
+  }
+  const uint8_t* p = payload + 1;
+  stats.heapUsed = getU32(p);
+  stats.heapFree = getU32(p);
+  stats.heapLargestBlock = getU32(p);
+  stats.heapMinFree = getU32(p);
+  stats.loopStackFree = getU16(p);
+  stats.allocations = getU32(p);
+  stats.frees = getU32(p);
+  return true;
+}
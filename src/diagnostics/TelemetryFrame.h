@@ -0,0 +1,138 @@
+/**
+ * TelemetryFrame.h
+ *
+ * Packet layout and framing of the binary telemetry stream, shared by the
+ * firmware (TelemetryStream) and the host decoder (utils/telemetry_decode.cpp).
+ */
+
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "MemoryMonitor.h"
+
+/**
+ * @brief One motion sample as streamed
+ *
+ * raw is the IMU reading at the stream rate; filtered, position and
+ * confidence are the position detector's state from the latest logic tick.
+ */
+struct TelemetrySample {
+  uint16_t sequence;        // Counts every sample taken, so gaps show dropped packets
+  uint32_t timeUs;
+  int16_t raw[6];           // accelX/Y/Z, gyroX/Y/Z in sensor units
+  float filtered[3];        // Averaged acceleration in m/s²
+  uint8_t position;         // HandPosition
+  uint8_t confidence;       // 0-100
+};
+
+/**
+ * @brief Stream settings, repeated about once a second so a capture can start anywhere
+ */
+struct TelemetryHeader {
+  uint16_t rateHz;
+  uint32_t baud;
+  float scalingFactor;      // Raw accelerometer units to m/s²
+};
+
+/**
+ * @brief COBS framing with a CRC for the telemetry stream
+ *
+ * Each packet is a little-endian payload followed by its CRC-16/CCITT-FALSE,
+ * COBS-encoded so it contains no zero bytes, with a zero byte before and
+ * after it. Text printed between packets (or a byte lost on the wire) only
+ * spoils the frame it lands in; the receiver resynchronizes at the next zero.
+ *
+ * Payloads:
+ *   PACKET_HEADER: type version rateHz:u16 baud:u32 scalingFactor:f32
+ *   PACKET_SAMPLE: type sequence:u16 timeUs:u32 raw:6xi16 filtered:3xi16 position confidence
+ *                  (filtered in units of 1/FILTERED_SCALE m/s²)
+ *   PACKET_MEMORY: type heapUsed:u32 heapFree:u32 heapLargestBlock:u32 heapMinFree:u32
+ *                  loopStackFree:u16 allocations:u32 frees:u32 (sent with each header)
+ */
+namespace TelemetryFrame {
+  constexpr uint8_t VERSION = 1;
+
+  constexpr uint8_t PACKET_HEADER = 0x01;
+  constexpr uint8_t PACKET_SAMPLE = 0x02;
+  constexpr uint8_t PACKET_MEMORY = 0x03;
+
+  constexpr uint8_t HEADER_PAYLOAD_SIZE = 12;
+  constexpr uint8_t SAMPLE_PAYLOAD_SIZE = 27;
+  constexpr uint8_t MEMORY_PAYLOAD_SIZE = 27;
+  constexpr uint8_t CRC_SIZE = 2;
+
+  constexpr float FILTERED_SCALE = 100.0f;
+
+  // Largest encoded frame: payload + CRC, one COBS overhead byte and two delimiters
+  constexpr uint8_t MAX_FRAME_SIZE = SAMPLE_PAYLOAD_SIZE + CRC_SIZE + 1 + 2;
+  static_assert(MEMORY_PAYLOAD_SIZE <= SAMPLE_PAYLOAD_SIZE, "memory packet exceeds MAX_FRAME_SIZE");
+
+  /**
+   * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+   */
+  uint16_t crc16(const uint8_t* data, size_t length);
+
+  /**
+   * @brief COBS-encode data (at most 253 bytes), without delimiters
+   * @param out Destination, at least length + 1 bytes
+   * @return Bytes written
+   */
+  size_t cobsEncode(const uint8_t* data, size_t length, uint8_t* out);
+
+  /**
+   * @brief Decode a COBS block (delimiters removed)
+   * @param out Destination, at least length bytes
+   * @return Bytes written, or 0 if the block is malformed
+   */
+  size_t cobsDecode(const uint8_t* data, size_t length, uint8_t* out);
+
+  /**
+   * @brief Build a complete frame for a sample
+   * @param out Destination, at least MAX_FRAME_SIZE bytes
+   * @return Frame length including both delimiters
+   */
+  size_t encodeSample(const TelemetrySample& sample, uint8_t* out);
+
+  /**
+   * @brief Build a complete frame for the stream header
+   * @param out Destination, at least MAX_FRAME_SIZE bytes
+   * @return Frame length including both delimiters
+   */
+  size_t encodeHeader(const TelemetryHeader& header, uint8_t* out);
+
+  /**
+   * @brief Build a complete frame for a memory report
+   * @param out Destination, at least MAX_FRAME_SIZE bytes
+   * @return Frame length including both delimiters
+   */
+  size_t encodeMemory(const MemoryStats& stats, uint8_t* out);
+
+  /**
+   * @brief Check and unpack the COBS block between two delimiters
+   * @param payload Destination for the checked payload, at least length bytes
+   * @return Payload length (CRC removed), or 0 if the block is malformed or fails its CRC
+   */
+  size_t decodeFrame(const uint8_t* block, size_t length, uint8_t* payload);
+
+  /**
+   * @brief Unpack a PACKET_SAMPLE payload
+   * @return False if the payload is not a sample
+   */
+  bool parseSample(const uint8_t* payload, size_t length, TelemetrySample& sample);
+
+  /**
+   * @brief Unpack a PACKET_HEADER payload
+   * @return False if the payload is not a header of this version
+   */
+  bool parseHeader(const uint8_t* payload, size_t length, TelemetryHeader& header);
+
+  /**
+   * @brief Unpack a PACKET_MEMORY payload
+   * @return False if the payload is not a memory report
+   */
+  bool parseMemory(const uint8_t* payload, size_t length, MemoryStats& stats);
+}
+
+#endif // TELEMETRY_FRAME_H
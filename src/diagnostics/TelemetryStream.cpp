@@ -0,0 +1,159 @@
+/**
+ * TelemetryStream.cpp
+ *
+ * Implementation of the TelemetryStream class for the LUTT toolkit.
+ */
+
+#include "TelemetryStream.h"
+#include "MemoryMonitor.h"
+#include "../hardware/SerialTx.h"
+
+// Initialize static variables
+bool TelemetryStream::_active = false;
+TelemetryHeader TelemetryStream::_header = {0, 0, 0.0f};
+uint32_t TelemetryStream::_periodUs = 0;
+uint32_t TelemetryStream::_nextUs = 0;
+uint16_t TelemetryStream::_sequence = 0;
+uint16_t TelemetryStream::_samplesSinceHeader = 0;
+uint32_t TelemetryStream::_sent = 0;
+uint32_t TelemetryStream::_dropped = 0;
+uint32_t TelemetryStream::_consoleBaud = TELEMETRY_DEFAULT_BAUD;
+
+/**
+ * Largest rate the baud rate can carry with some headroom
+ */
+uint16_t TelemetryStream::maxRateFor(uint32_t baud) {
+  // 10 bits per byte on the wire; leave 20% for headers and stray text
+  uint32_t rate = (baud / 10) * 8 / 10 / TelemetryFrame::MAX_FRAME_SIZE;
+  return rate > MAX_RATE_HZ ? MAX_RATE_HZ : (uint16_t)rate;
+}
+
+/**
+ * Start streaming
+ */
+void TelemetryStream::start(uint16_t rateHz, uint32_t baud) {
+  if (_active) stop();
+
+  uint16_t limit = maxRateFor(baud);
+  if (rateHz == 0) rateHz = TELEMETRY_DEFAULT_RATE_HZ;
+  if (rateHz > limit) {
+    Serial.printf("Telemetry: %u Hz needs a faster link, using %u Hz at %lu baud\n",
+                  rateHz, limit, (unsigned long)baud);
+    rateHz = limit;
+  }
+  if (rateHz == 0) {
+    Serial.println("Telemetry: baud rate too low to stream");
+    return;
+  }
+
+  _header.rateHz = rateHz;
+  _header.baud = baud;
+  _periodUs = 1000000UL / rateHz;
+  _sequence = 0;
+  _sent = 0;
+  _dropped = 0;
+
+  Serial.printf("Telemetry: %u Hz at %lu baud, 'telemetry stop' to end\n", rateHz, (unsigned long)baud);
+  _consoleBaud = Serial.baudRate();
+  if (baud != _consoleBaud) {
+    SerialOut.flush();
+    Serial.updateBaudRate(baud);
+  }
+
+  // The header goes out with the first sample
+  _samplesSinceHeader = rateHz;
+  _nextUs = micros();
+  _active = true;
+}
+
+/**
+ * Stop streaming and restore the normal baud rate
+ */
+void TelemetryStream::stop() {
+  if (!_active) return;
+  _active = false;
+  SerialOut.flush();
+  if (_header.baud != _consoleBaud) {
+    Serial.updateBaudRate(_consoleBaud);
+  }
+  Serial.println();
+  printStats();
+}
+
+/**
+ * Set the raw accelerometer to m/s² factor reported in the header
+ */
+void TelemetryStream::setScalingFactor(float scalingFactor) {
+  _header.scalingFactor = scalingFactor;
+}
+
+/**
+ * True while streaming
+ */
+bool TelemetryStream::isActive() {
+  return _active;
+}
+
+/**
+ * True when the next sample is due
+ */
+bool TelemetryStream::due(uint32_t nowUs) {
+  return _active && (int32_t)(nowUs - _nextUs) >= 0;
+}
+
+/**
+ * Milliseconds until the next sample
+ */
+uint32_t TelemetryStream::millisUntilNext(uint32_t nowUs) {
+  if (!_active) return UINT32_MAX;
+  int32_t remaining = (int32_t)(_nextUs - nowUs);
+  return remaining <= 0 ? 0 : (uint32_t)remaining / 1000;
+}
+
+/**
+ * Send a sample if the serial TX ring has room for it
+ */
+bool TelemetryStream::record(TelemetrySample& sample) {
+  if (!_active) return false;
+
+  // Keep the cadence; if the loop fell behind by more than a period, skip ahead
+  _nextUs += _periodUs;
+  if ((int32_t)(sample.timeUs - _nextUs) > (int32_t)_periodUs) {
+    _nextUs = sample.timeUs + _periodUs;
+  }
+
+  uint8_t frame[TelemetryFrame::MAX_FRAME_SIZE];
+  if (++_samplesSinceHeader >= _header.rateHz) {
+    _samplesSinceHeader = 0;
+    send(frame, TelemetryFrame::encodeHeader(_header, frame));
+    MemoryStats memory;
+    MemoryMonitor::sample(memory);
+    send(frame, TelemetryFrame::encodeMemory(memory, frame));
+  }
+
+  sample.sequence = _sequence++;
+  return send(frame, TelemetryFrame::encodeSample(sample, frame));
+}
+
+/**
+ * Queue a whole frame or nothing, so the loop never blocks on Serial
+ */
+bool TelemetryStream::send(const uint8_t* frame, size_t length) {
+  // The newest frame is the one dropped, whatever SerialOut's own policy
+  if ((size_t)SerialOut.availableForWrite() < length) {
+    _dropped++;
+    return false;
+  }
+  SerialOut.write(frame, length);
+  _sent++;
+  return true;
+}
+
+/**
+ * Print rate, baud and packet counts
+ */
+void TelemetryStream::printStats() {
+  if (_active) return;
+  Serial.printf("Telemetry: %u Hz at %lu baud, %lu packets sent, %lu dropped (TX buffer full)\n",
+                _header.rateHz, (unsigned long)_header.baud, (unsigned long)_sent, (unsigned long)_dropped);
+}
@@ -0,0 +1,98 @@
+/**
+ * TelemetryStream.h
+ *
+ * CLI-started binary motion telemetry: COBS-framed, CRC-checked samples of
+ * raw IMU data, filtered acceleration, position and confidence, plus a
+ * heap and stack report once a second, decoded on the host by
+ * utils/telemetry_decode.cpp.
+ */
+
+#ifndef TELEMETRY_STREAM_H
+#define TELEMETRY_STREAM_H
+
+#include <Arduino.h>
+#include "TelemetryFrame.h"
+
+// Default sample rate and baud rate of 'telemetry start'
+#ifndef TELEMETRY_DEFAULT_RATE_HZ
+#define TELEMETRY_DEFAULT_RATE_HZ 125
+#endif
+#ifndef TELEMETRY_DEFAULT_BAUD
+#define TELEMETRY_DEFAULT_BAUD 115200
+#endif
+
+class TelemetryStream {
+public:
+  // The IMU read and the rest of the loop leave about 2 ms per sample
+  static const uint16_t MAX_RATE_HZ = 500;
+
+  /**
+   * Start streaming
+   *
+   * Switches Serial to the given baud rate and lowers the rate if the link
+   * cannot carry it; the header packet records what was actually used.
+   * @param rateHz Samples per second
+   * @param baud Serial baud rate while streaming
+   */
+  static void start(uint16_t rateHz, uint32_t baud);
+
+  /**
+   * Set the raw accelerometer to m/s² factor reported in the header
+   */
+  static void setScalingFactor(float scalingFactor);
+
+  /**
+   * Stop streaming and restore the normal baud rate
+   */
+  static void stop();
+
+  /**
+   * True while streaming
+   */
+  static bool isActive();
+
+  /**
+   * True when the next sample is due
+   * @param nowUs Current time from micros()
+   */
+  static bool due(uint32_t nowUs);
+
+  /**
+   * Milliseconds until the next sample, or UINT32_MAX when not streaming
+   * @param nowUs Current time from micros()
+   */
+  static uint32_t millisUntilNext(uint32_t nowUs);
+
+  /**
+   * Send a sample if the serial TX ring has room for it, otherwise drop it
+   *
+   * Fills in the sequence number and schedules the next sample.
+   * @return False if the sample was dropped
+   */
+  static bool record(TelemetrySample& sample);
+
+  /**
+   * Print rate, baud and packet counts (only while not streaming)
+   */
+  static void printStats();
+
+  /**
+   * Largest rate the baud rate can carry with some headroom
+   */
+  static uint16_t maxRateFor(uint32_t baud);
+
+private:
+  static bool send(const uint8_t* frame, size_t length);
+
+  static bool _active;
+  static TelemetryHeader _header;
+  static uint32_t _periodUs;
+  static uint32_t _nextUs;
+  static uint16_t _sequence;
+  static uint16_t _samplesSinceHeader;
+  static uint32_t _sent;
+  static uint32_t _dropped;
+  static uint32_t _consoleBaud;     // Baud rate to return to when the stream stops
+};
+
+#endif // TELEMETRY_STREAM_H
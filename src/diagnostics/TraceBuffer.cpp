@@ -0,0 +1,107 @@
+/**
+ * TraceBuffer.cpp
+ *
+ * Implementation of the lock-free binary trace ring.
+ */
+
+#include "TraceBuffer.h"
+
+// Initialize static variables
+TraceEntry TraceBuffer::_entries[TraceBuffer::CAPACITY];
+std::atomic<uint32_t> TraceBuffer::_sequence[TraceBuffer::CAPACITY];
+std::atomic<uint32_t> TraceBuffer::_head(0);
+uint32_t TraceBuffer::_tail = 0;
+std::atomic<uint32_t> TraceBuffer::_dropped(0);
+
+/**
+ * Claim a slot, fill it and publish it
+ */
+bool TraceBuffer::push(uint32_t id, uint8_t level, uint8_t tag, uint8_t argCount, const TraceWord* args) {
+  uint32_t position = _head.load(std::memory_order_relaxed);
+  uint16_t slot;
+  for (;;) {
+    slot = position & (CAPACITY - 1);
+    int32_t lag = (int32_t)(_sequence[slot].load(std::memory_order_acquire) + slot - position);
+    if (lag == 0) {
+      // Slot is free for this lap; claim it unless another writer got there first
+      if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (lag < 0) {
+      // The reader has not freed this slot yet: the ring is full
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      position = _head.load(std::memory_order_relaxed);
+    }
+  }
+
+  TraceEntry& entry = _entries[slot];
+  entry.timestampUs = micros();
+  entry.id = id;
+  entry.level = level;
+  entry.tag = tag;
+  entry.argCount = argCount;
+  for (uint8_t i = 0; i < argCount; i++) {
+    entry.args[i] = args[i];
+  }
+
+  _sequence[slot].store(position + 1 - slot, std::memory_order_release);
+  return true;
+}
+
+/**
+ * Take the oldest published entry and free its slot for the next lap
+ */
+bool TraceBuffer::pop(TraceEntry& entry) {
+  uint16_t slot = _tail & (CAPACITY - 1);
+  uint32_t sequence = _sequence[slot].load(std::memory_order_acquire) + slot;
+  if (sequence != _tail + 1) {
+    return false;
+  }
+
+  entry = _entries[slot];
+  _sequence[slot].store(_tail + CAPACITY - slot, std::memory_order_release);
+  _tail++;
+  return true;
+}
+
+bool TraceBuffer::peek(TraceEntry& entry) {
+  uint16_t slot = _tail & (CAPACITY - 1);
+  uint32_t sequence = _sequence[slot].load(std::memory_order_acquire) + slot;
+  if (sequence != _tail + 1) {
+    return false;
+  }
+
+  entry = _entries[slot];
+  return true;
+}
+
+uint16_t TraceBuffer::pending() {
+  return (uint16_t)(_head.load(std::memory_order_relaxed) - _tail);
+}
+
+uint16_t TraceBuffer::readable() {
+  uint16_t count = 0;
+  uint32_t position = _tail;
+  uint32_t head = _head.load(std::memory_order_acquire);
+  while (position != head) {
+    uint16_t slot = position & (CAPACITY - 1);
+    if (_sequence[slot].load(std::memory_order_acquire) + slot != position + 1) {
+      break;
+    }
+    position++;
+    count++;
+  }
+  return count;
+}
+
+uint32_t TraceBuffer::dropped() {
+  return _dropped.load(std::memory_order_relaxed);
+}
+
+void TraceBuffer::clear() {
+  TraceEntry entry;
+  while (pop(entry)) {
+  }
+}
@@ -0,0 +1,148 @@
+/**
+ * TraceBuffer.h
+ *
+ * Binary trace ring for the diagnostic logger: log sites record a message
+ * ID, a timestamp and their raw arguments, and formatting happens later
+ * when the ring is drained.
+ */
+
+#ifndef TRACE_BUFFER_H
+#define TRACE_BUFFER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+// Entries in the ring (power of two, set in platformio.ini to override)
+#ifndef DIAG_TRACE_ENTRIES
+#define DIAG_TRACE_ENTRIES 64
+#endif
+
+// Largest number of arguments a log site can record
+#define DIAG_TRACE_MAX_ARGS 4
+
+/**
+ * Raw argument: an integer, a pointer (%s must point to a static string)
+ * or the bits of a float
+ */
+typedef uintptr_t TraceWord;
+
+/**
+ * One recorded log call
+ */
+struct TraceEntry {
+  uint32_t timestampUs;
+  uint32_t id;          // Hash of the format string, see TraceBuffer::hash()
+  uint8_t level;
+  uint8_t tag;
+  uint8_t argCount;
+  TraceWord args[DIAG_TRACE_MAX_ARGS];
+};
+
+/**
+ * Lock-free bounded ring of TraceEntry
+ *
+ * Any number of writers (tasks or ISRs) can record at once; a single
+ * reader drains. Each slot carries a sequence number: a writer claims
+ * a slot by advancing the head with a compare-and-swap, fills it and
+ * then publishes it by bumping the slot's sequence, so the reader never
+ * sees a half-written entry. When the ring is full new entries are
+ * dropped and counted rather than overwriting unread ones.
+ */
+class TraceBuffer {
+public:
+  static const uint16_t CAPACITY = DIAG_TRACE_ENTRIES;
+
+  /**
+   * FNV-1a hash of a format string, evaluated at compile time at each log site
+   *
+   * utils/trace_tool.py computes the same hash to build the string table.
+   */
+  static constexpr uint32_t hash(const char* text, uint32_t value = 2166136261u) {
+    return *text ? hash(text + 1, (value ^ (uint8_t)*text) * 16777619u) : value;
+  }
+
+  /**
+   * Record a log call
+   * @param id Message ID (hash of the format string)
+   * @param level Log level
+   * @param tag Subsystem tag
+   * @param args Values for the format's conversions, in order
+   * @return False if the ring was full and the entry was dropped
+   */
+  template<typename... Args>
+  static bool record(uint32_t id, uint8_t level, uint8_t tag, Args... args) {
+    static_assert(sizeof...(Args) <= DIAG_TRACE_MAX_ARGS, "Too many arguments for a trace entry");
+    const TraceWord words[] = {pack(args)..., 0};
+    return push(id, level, tag, sizeof...(Args), words);
+  }
+
+  /**
+   * Take the oldest entry (single reader)
+   * @param entry Filled if an entry was available
+   * @return False if the ring is empty
+   */
+  static bool pop(TraceEntry& entry);
+
+  /**
+   * Read the oldest entry without taking it (single reader)
+   * @return False if the ring is empty
+   */
+  static bool peek(TraceEntry& entry);
+
+  /**
+   * Entries recorded but not yet read
+   *
+   * Includes slots a writer has claimed but not yet published.
+   */
+  static uint16_t pending();
+
+  /**
+   * Entries pop() is sure to return now (single reader)
+   *
+   * The published entries from the oldest up to the first slot a writer
+   * is still filling.
+   */
+  static uint16_t readable();
+
+  /**
+   * Entries dropped because the ring was full, since startup
+   */
+  static uint32_t dropped();
+
+  /**
+   * Discard every entry (no writer may be recording)
+   */
+  static void clear();
+
+private:
+  static bool push(uint32_t id, uint8_t level, uint8_t tag, uint8_t argCount, const TraceWord* args);
+
+  template<typename T>
+  static TraceWord pack(T value) {
+    return (TraceWord)value;
+  }
+
+  static TraceWord pack(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  // Variadic calls promote floats, so doubles are stored as floats too
+  static TraceWord pack(double value) {
+    return pack((float)value);
+  }
+
+  static_assert((CAPACITY & (CAPACITY - 1)) == 0, "DIAG_TRACE_ENTRIES must be a power of two");
+
+  static TraceEntry _entries[CAPACITY];
+  // Slot sequence minus the slot index, so the zero-initialized ring is ready without setup
+  static std::atomic<uint32_t> _sequence[CAPACITY];
+  static std::atomic<uint32_t> _head;
+  static uint32_t _tail;
+  static std::atomic<uint32_t> _dropped;
+};
+
+#endif // TRACE_BUFFER_H
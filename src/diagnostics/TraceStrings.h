@@ -0,0 +1,66 @@
+#ifndef TRACE_STRINGS_H
+#define TRACE_STRINGS_H
+
+#include <stdint.h>
+
+/**
+ * @brief Format strings of the diagnostic log sites, by trace ID
+ *
+ * GENERATED by utils/trace_tool.py - do not edit by hand.
+ * Sorted by ID for binary search.
+ */
+struct TraceString {
+  uint32_t id;
+  const char* format;
+};
+
+const TraceString TRACE_STRINGS[] = {
+  {0x00DCF4E6, "GauntletController initialized successfully"},
+  {0x03338970, "All sensor values are zero - raw accel %d,%d,%d"},
+  {0x0493A109, "Position detector initialization failed"},
+  {0x060F188B, "Low variation in accelerometer readings"},
+  {0x0E5EE291, "HardwareManager initialization failed"},
+  {0x16EFACC4, "GauntletController destroyed"},
+  {0x21852B89, "Gesture too late: type %d in %lu ms (max %lu ms)"},
+  {0x23BC5CBB, "GauntletController constructed"},
+  {0x24BE1E30, "FreeCast completed, transitioning back to Idle"},
+  {0x26513A1C, "Shake downward crossing: count=%d, mag=%lu"},
+  {0x31F13FCE, "Transitioning to QuickCast Mode with spell: %s"},
+  {0x36ED85C1, "Gesture completed: type %d in %lu ms"},
+  {0x3C5BB16E, "Gesture tracker reset: type %d"},
+  {0x56DBDFB6, "End position without start: %d"},
+  {0x5706B958, "Gesture started: type %d"},
+  {0x60452863, "Failed to read sensor data for shake detection"},
+  {0x63620264, "GauntletController initializing"},
+  {0x6FDD26B6, "Shake cancellation detected, exiting mode: %d"},
+  {0x7424EB87, "All sensor values are zero - raw gyro %d,%d,%d"},
+  {0x77AE9EFA, "Cancelling %s spell after %lu ms (total duration: %lu ms)"},
+  {0x7C0767D1, "ShakeGestureDetector reset"},
+  {0x7D8E426B, "System initialized successfully"},
+  {0x8B5AE881, "Slow update cycle: %lu ms (target: %lu ms)"},
+  {0x90DFC9F5, "FreeCastMode reset by ShakeCancel"},
+  {0x947C09FD, "Shake upward crossing: count=%d, mag=%lu"},
+  {0x976743B9, "Test warning from CLI"},
+  {0x97724990, "ShakeGestureDetector initialized"},
+  {0x9D625E6E, "Too many identical consecutive readings"},
+  {0xA739CFD1, "Rainbow phase %s at %lu ms"},
+  {0xAC1A3008, "GestureTracker created: %d->%d, window: %lu ms, type: %d"},
+  {0xAED45E8A, "Unknown SystemMode: %d"},
+  {0xAF458A81, "Position update: %d, active: %d, elapsed: %lu ms"},
+  {0xB5E95685, "IdleMode initialization failed"},
+  {0xBC696C36, "Test log message from CLI"},
+  {0xD091FA5F, "Error reading sensor data"},
+  {0xD3639A26, "QuickCastSpellsMode initialization failed"},
+  {0xDBA58DD3, "End position detected, elapsed: %lu ms, max: %lu ms"},
+  {0xDBB68482, "Mode transition detected: %d"},
+  {0xDDB1AAC6, "FreeCastMode initialization failed"},
+  {0xE1FF8591, "Handling mode transition: %d from mode: %d"},
+  {0xEC63269B, "Test error from CLI"},
+  {0xEC6712E3, "Sensor values exceed maximum possible range"},
+  {0xEF863DC7, "Shake gesture detected! Intensity: %.2f"},
+  {0xF44A4708, "Gesture timeout: type %d after %lu ms"},
+  {0xFBAEC047, "QuickCast completed, transitioning back to Idle"},
+};
+constexpr uint16_t TRACE_STRING_COUNT = sizeof(TRACE_STRINGS) / sizeof(TRACE_STRINGS[0]);
+
+#endif // TRACE_STRINGS_H
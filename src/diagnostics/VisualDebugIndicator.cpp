@@ -7,6 +7,7 @@
 #include "VisualDebugIndicator.h"
 #include "../hardware/HardwareManager.h"
 #include "../core/SystemTypes.h" // Added include for Color struct
+#include "../animation/ColorEngine.h"
 
 // Initialize static variables
 HardwareManager* VisualDebugIndicator::_hardware = nullptr;
@@ -14,7 +15,6 @@ uint8_t VisualDebugIndicator::_indicatorType = 0;
 uint32_t VisualDebugIndicator::_lastUpdateTime = 0;
 uint8_t VisualDebugIndicator::_indicatorLEDs[4] = {0, 3, 6, 9}; // Default LEDs to use
 bool VisualDebugIndicator::_indicatorActive = false;
-Color VisualDebugIndicator::_storedLEDValues[12]; // Changed to store Color structs
 float VisualDebugIndicator::_progressValue = 0.0f;
 uint8_t VisualDebugIndicator::_typeValue = 0;
 float VisualDebugIndicator::_intensityValue = 0.0f;
@@ -98,53 +98,26 @@ void VisualDebugIndicator::process() {
   
   // If we have a recent update, show indicators
   if (currentTime - _lastUpdateTime < 100) {
-    if (!_indicatorActive) {
-      // First time showing indicator, save current state
-      saveCurrentLEDState();
-      _indicatorActive = true;
-    }
+    _indicatorActive = true;
     
     // Apply indicator visualization
     applyIndicator();
   } 
   // If indicators were active but now should be hidden
   else if (_indicatorActive) {
-    // Restore original state
-    restoreOriginalLEDState();
+    // Drop the overlay; the layers below are untouched
+    _hardware->getCompositor()->clear(LEDLayer::DEBUG_OVERLAY);
+    _hardware->updateLEDs();
     _indicatorActive = false;
   }
 }
 
-/**
- * Store original LED values before showing indicators
- */
-void VisualDebugIndicator::saveCurrentLEDState() {
-  // Note: We don't directly have access to the LED values,
-  // but we can capture them indirectly by saving a copy of
-  // what's currently being shown
-  for (uint8_t i = 0; i < 12; i++) {
-    // Get current LED value - store in our Color struct
-    // Note: Since we can't directly get the RGB values, we'll just
-    // initialize with black as a fallback if this is not implemented
-    _storedLEDValues[i] = {0, 0, 0};
-  }
-}
-
-/**
- * Restore original LED values after showing indicators
- */
-void VisualDebugIndicator::restoreOriginalLEDState() {
-  // Restore all LED values
-  for (uint8_t i = 0; i < 12; i++) {
-    _hardware->setLED(i, _storedLEDValues[i]);
-  }
-  _hardware->updateLEDs();
-}
-
 /**
  * Apply indicator based on current settings
  */
 void VisualDebugIndicator::applyIndicator() {
+  LEDCompositor* compositor = _hardware->getCompositor();
+  
   // Apply different indicators based on type
   switch(_indicatorType) {
     case VISUAL_IND_GESTURE_PROGRESS: {
@@ -163,10 +136,10 @@ void VisualDebugIndicator::applyIndicator() {
       // Light up progress LEDs
       for (uint8_t i = 0; i < 4; i++) {
         if (i < numLedsToLight) {
-          _hardware->setLED(_indicatorLEDs[i], ledColor);
+          compositor->setPixel(LEDLayer::DEBUG_OVERLAY, _indicatorLEDs[i], ledColor);
         } else {
           Color black = {0, 0, 0};
-          _hardware->setLED(_indicatorLEDs[i], black);
+          compositor->setPixel(LEDLayer::DEBUG_OVERLAY, _indicatorLEDs[i], black);
         }
       }
       break;
@@ -181,11 +154,11 @@ void VisualDebugIndicator::applyIndicator() {
         if (i == _typeValue) {
           // This LED represents current mode, brightness indicates substate
           Color white = {brightness, brightness, brightness};
-          _hardware->setLED(_indicatorLEDs[i], white);
+          compositor->setPixel(LEDLayer::DEBUG_OVERLAY, _indicatorLEDs[i], white);
         } else {
           // Not current mode, turn off
           Color black = {0, 0, 0};
-          _hardware->setLED(_indicatorLEDs[i], black);
+          compositor->setPixel(LEDLayer::DEBUG_OVERLAY, _indicatorLEDs[i], black);
         }
       }
       break;
@@ -196,29 +169,16 @@ void VisualDebugIndicator::applyIndicator() {
       const uint8_t phaseIdx = _typeValue % 4;
       const uint8_t hue = (uint8_t)(_progressValue * 255);
       
-      // Convert hue to RGB (simplified HSV->RGB)
-      Color ledColor;
-      if (hue < 85) {
-        ledColor.r = 255 - hue * 3;
-        ledColor.g = hue * 3;
-        ledColor.b = 0;
-      } else if (hue < 170) {
-        ledColor.r = 0;
-        ledColor.g = 255 - (hue - 85) * 3;
-        ledColor.b = (hue - 85) * 3;
-      } else {
-        ledColor.r = (hue - 170) * 3;
-        ledColor.g = 0;
-        ledColor.b = 255 - (hue - 170) * 3;
-      }
+      // Convert hue to RGB via the shared spectrum table
+      Color ledColor = ColorEngine::rainbow(hue);
       
       // Set all LEDs black except current phase
       Color black = {0, 0, 0};
       for (uint8_t i = 0; i < 4; i++) {
         if (i == phaseIdx) {
-          _hardware->setLED(_indicatorLEDs[i], ledColor);
+          compositor->setPixel(LEDLayer::DEBUG_OVERLAY, _indicatorLEDs[i], ledColor);
         } else {
-          _hardware->setLED(_indicatorLEDs[i], black);
+          compositor->setPixel(LEDLayer::DEBUG_OVERLAY, _indicatorLEDs[i], black);
         }
       }
       break;
@@ -233,7 +193,7 @@ void VisualDebugIndicator::applyIndicator() {
       
       // Show on all indicator LEDs
       for (uint8_t i = 0; i < 4; i++) {
-        _hardware->setLED(_indicatorLEDs[i], ledColor);
+        compositor->setPixel(LEDLayer::DEBUG_OVERLAY, _indicatorLEDs[i], ledColor);
       }
       break;
     }
@@ -64,18 +64,13 @@ public:
   static void updateMotionFeature(float intensity, float complexity);
   
   /**
-   * Must be called in main loop to apply visual indicators
-   * without interfering with normal LED operation
+   * Must be called in main loop to apply visual indicators.
+   * Indicators are drawn on the compositor's debug overlay layer, so the
+   * mode's own LEDs reappear as soon as the overlay is cleared.
    */
   static void process();
 
 private:
-  // Store original LED values before showing indicators
-  static void saveCurrentLEDState();
-  
-  // Restore original LED values after showing indicators
-  static void restoreOriginalLEDState();
-  
   // Apply indicator based on current settings
   static void applyIndicator();
   
@@ -94,9 +89,6 @@ private:
   // Is indicator currently active?
   static bool _indicatorActive;
   
-  // Original RGB values for all LEDs (to restore later)
-  static Color _storedLEDValues[12];
-  
   // Parameters for current indicator
   static float _progressValue;
   static uint8_t _typeValue;
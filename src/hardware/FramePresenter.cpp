@@ -0,0 +1,107 @@
+#include "FramePresenter.h"
+#include "LEDInterface.h"
+#include <Arduino.h>
+
+FramePresenter::FramePresenter()
+    : leds_(nullptr),
+      frameHash_(0),
+      pushedHash_(0),
+      pushedBrightness_(0),
+      pushedValid_(false),
+      dirty_(false),
+      periodMs_(0),
+      lastPushMs_(0),
+      current_{0, 0, 0, 0, 0},
+      lastSecond_{0, 0, 0, 0, 0},
+      windowStartMs_(0),
+      windowTransfers_(0) {
+  for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+    frame_[i] = {0, 0, 0};
+  }
+}
+
+void FramePresenter::init(LEDInterface* leds, uint16_t periodMs) {
+  leds_ = leds;
+  periodMs_ = periodMs;
+  windowStartMs_ = millis();
+  windowTransfers_ = leds_ ? leds_->getWireStats().transfers : 0;
+  invalidate();
+}
+
+uint32_t FramePresenter::hashFrame(const Color* frame, uint16_t count) {
+  uint32_t hash = 2166136261UL;
+  for (uint16_t i = 0; i < count; i++) {
+    hash = (hash ^ frame[i].r) * 16777619UL;
+    hash = (hash ^ frame[i].g) * 16777619UL;
+    hash = (hash ^ frame[i].b) * 16777619UL;
+  }
+  return hash;
+}
+
+void FramePresenter::submit(const Color* frame) {
+  if (dirty_) {
+    // The previous frame never made it to the strip
+    current_.framesCoalesced++;
+  }
+
+  for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+    frame_[i] = frame[i];
+  }
+  frameHash_ = hashFrame(frame_, Config::NUM_LEDS);
+
+  if (pushedValid_ && frameHash_ == pushedHash_) {
+    current_.framesSkipped++;
+    dirty_ = false;
+  } else {
+    dirty_ = true;
+  }
+}
+
+bool FramePresenter::service(uint32_t nowMs) {
+  rollStats(nowMs);
+  if (!leds_) {
+    return false;
+  }
+
+  // A brightness change needs a transfer even if the colors did not change,
+  // and a dithered or power-limited frame is sent again every period
+  if (!dirty_ && pushedValid_ &&
+      (leds_->getBrightness() != pushedBrightness_ || leds_->needsRefresh())) {
+    dirty_ = true;
+  }
+  if (!dirty_ || (pushedValid_ && nowMs - lastPushMs_ < periodMs_)) {
+    return false;
+  }
+
+  leds_->setFrame(frame_);
+  uint32_t start = micros();
+  leds_->show();
+  current_.showMicros += micros() - start;
+  current_.framesPushed++;
+
+  pushedHash_ = frameHash_;
+  pushedBrightness_ = leds_->getBrightness();
+  pushedValid_ = true;
+  dirty_ = false;
+  lastPushMs_ = nowMs;
+  return true;
+}
+
+void FramePresenter::invalidate() {
+  pushedValid_ = false;
+  dirty_ = false;
+}
+
+void FramePresenter::rollStats(uint32_t nowMs) {
+  if (nowMs - windowStartMs_ >= 1000) {
+    if (leds_) {
+      // show() only queues the frame; the wire time comes from the transfers it started
+      uint32_t transfers = leds_->getWireStats().transfers;
+      current_.wireMicros = (transfers - windowTransfers_) * leds_->getWireFrameMicros();
+      windowTransfers_ = transfers;
+    }
+    lastSecond_ = current_;
+    current_ = {0, 0, 0, 0, 0};
+    windowStartMs_ = nowMs;
+  }
+}
@@ -0,0 +1,95 @@
+#ifndef FRAME_PRESENTER_H
+#define FRAME_PRESENTER_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+#include "../core/Config.h"
+
+class LEDInterface;
+
+/**
+ * @brief Presenter counters for one second of operation
+ */
+struct PresenterStats {
+  uint16_t framesPushed;     // Transfers to the LED strip
+  uint16_t framesSkipped;    // Submitted frames identical to what is already shown
+  uint16_t framesCoalesced;  // Pending frames replaced before their display period came up
+  uint32_t showMicros;       // Time the caller spent in LEDInterface::show(): queuing, and waiting when a frame was still queued
+  uint32_t wireMicros;       // Time the LED wire was busy sending (transfers started times the frame time)
+};
+
+/**
+ * @brief Single owner of the frame sent to the LED strip
+ *
+ * Renderers submit complete frames as often as they like. The presenter
+ * keeps the latest one, compares its hash (and the brightness) with the
+ * last frame pushed, and transfers at most one changed frame per display
+ * period. Unchanged frames never reach the bus, except that a frame the
+ * output stage is still dithering is re-sent once per period.
+ */
+class FramePresenter {
+public:
+  FramePresenter();
+
+  /**
+   * @brief Attach the LED output
+   * @param leds LED interface that performs the transfer
+   * @param periodMs Minimum time between two transfers
+   */
+  void init(LEDInterface* leds, uint16_t periodMs);
+
+  /**
+   * @brief Hand over a new frame
+   * @param frame Config::NUM_LEDS colors
+   */
+  void submit(const Color* frame);
+
+  /**
+   * @brief Push the pending frame if it changed and the display period allows
+   * @param nowMs Current time in milliseconds
+   * @return True if a transfer happened
+   */
+  bool service(uint32_t nowMs);
+
+  /**
+   * @brief Forget what the strip shows after something else drove it directly
+   *
+   * The next submitted frame is pushed without waiting for the period.
+   */
+  void invalidate();
+
+  /**
+   * @brief True while a changed frame is waiting for its display period
+   */
+  bool isPending() const { return dirty_; }
+
+  /**
+   * @brief Counters for the last complete second
+   */
+  const PresenterStats& getStats() const { return lastSecond_; }
+
+  /**
+   * @brief FNV-1a hash of a frame
+   */
+  static uint32_t hashFrame(const Color* frame, uint16_t count);
+
+private:
+  LEDInterface* leds_;
+  Color frame_[Config::NUM_LEDS];
+  uint32_t frameHash_;
+  uint32_t pushedHash_;
+  uint8_t pushedBrightness_;
+  bool pushedValid_;
+  bool dirty_;
+  uint16_t periodMs_;
+  uint32_t lastPushMs_;
+
+  PresenterStats current_;
+  PresenterStats lastSecond_;
+  uint32_t windowStartMs_;
+  uint32_t windowTransfers_;  // Wire transfer count when the window opened
+
+  void rollStats(uint32_t nowMs);
+};
+
+#endif // FRAME_PRESENTER_H
@@ -1,7 +1,11 @@
 #include "HardwareManager.h"
 #include "../core/Config.h"
+#include "../core/CalibrationStore.h"
+#include "../core/BootSequence.h"
+#include "LEDTopology.h"
 #include "../utils/DebugTools.h"
 #include <Wire.h>
+#include <math.h>
 
 // Singleton instance
 static HardwareManager* _instance = nullptr;
@@ -21,10 +25,11 @@ HardwareManager* HardwareManager::getInstance() {
  * @brief Constructor - initializes internal state
  */
 HardwareManager::HardwareManager() 
-    : motionDataCount(0)
+    : imuOffsetsPending(false)
+    , lastOffsetCommitTime(0)
+    , motionDataCount(0)
     , isRecordingMotion(false)
     , lastSensorUpdateTime(0)
-    , lastLedUpdateTime(0)
     , isInitialized(false)
     , isActive(true)
 {
@@ -47,108 +52,56 @@ bool HardwareManager::init() {
     // Configure hardware pins
     configurePins();
     
-    // CRITICAL FIX: Explicitly initialize I2C bus with correct parameters
-    Wire.end(); // Ensure clean state
-    delay(50);
-    Wire.begin(Config::I2C_SDA_PIN, Config::I2C_SCL_PIN);
-    Wire.setClock(100000); // 100kHz clock speed as specified in reference
-    delay(150); // Wait for I2C to stabilize
+    // Stored calibration, read once: IMU offsets below, profiles for the position detector
+    CalibrationStore::begin();
     
-    DEBUG_PRINTLN("Initializing MPU sensor...");
-    
-    // Try both possible MPU addresses
-    const uint8_t mpuAddresses[] = {0x68, 0x69};
-    bool sensorFound = false;
+    BootSequence::mark("calibration store");
     
-    for (uint8_t i = 0; i < 2; i++) {
-        uint8_t addr = mpuAddresses[i];
-        char addrStr[10];
-        sprintf(addrStr, "0x%02X", addr);
-        DEBUG_PRINT("Testing MPU at address ");
-        DEBUG_PRINTLN(addrStr);
-        
-        // CRITICAL FIX: Check bus communication first
-        Wire.beginTransmission(addr);
-        byte error = Wire.endTransmission();
-        
-        if (error == 0) {
-            DEBUG_PRINTLN("Device found on I2C bus");
-            
-            // Set the address in our interface
-            imu.setAddress(addr);
-            
-            // CRITICAL FIX: Reset the device properly
-            DEBUG_PRINTLN("Resetting MPU sensor...");
-            // Reset power management register
-            Wire.beginTransmission(addr);
-            Wire.write(0x6B); // PWR_MGMT_1 register
-            Wire.write(0x80); // Set reset bit
-            error = Wire.endTransmission();
-            if (error != 0) {
-                DEBUG_PRINT("Reset transmission error: ");
-                char errorStr[8];
-                sprintf(errorStr, "%d", error);
-                DEBUG_PRINTLN(errorStr);
-                continue;
-            }
-            delay(150); // Wait for reset to complete
-            
-            // CRITICAL FIX: Wake up the device
-            Wire.beginTransmission(addr);
-            Wire.write(0x6B); // PWR_MGMT_1 register
-            Wire.write(0x00); // Clear sleep bit
-            error = Wire.endTransmission();
-            if (error != 0) {
-                DEBUG_PRINT("Wake transmission error: ");
-                char errorStr[8];
-                sprintf(errorStr, "%d", error);
-                DEBUG_PRINTLN(errorStr);
-                continue;
-            }
-            delay(150); // Wait for wake up
-            
-            // Now initialize the sensor through our interface
-            if (imu.init()) {
-                DEBUG_PRINTLN("MPU sensor initialized successfully");
-                sensorFound = true;
-                
-                // Perform calibration after successful initialization
-                DEBUG_PRINTLN("Calibrating MPU sensor...");
-                if (!imu.calibrate()) {
-                    DEBUG_PRINTLN("WARNING: MPU calibration failed. Using uncalibrated values.");
-                    // Continue anyway - calibration failure is not fatal
-                }
-                
-                break; // Exit the loop, we found a working sensor
-            } else {
-                DEBUG_PRINTLN("MPU initialization failed despite I2C connection");
-            }
-        } else {
-            // Print the specific I2C error code for diagnostic purposes
-            char errorMsg[50];
-            sprintf(errorMsg, "I2C connection error: %d (address %s)", error, addrStr);
-            DEBUG_PRINTLN(errorMsg);
-        }
+    // LEDs first, so the boot animation runs while the IMU settles
+    DEBUG_PRINTLN("Initializing LED interface...");
+    if (!leds.init()) {
+        DEBUG_PRINTLN("ERROR: Failed to initialize LED interface");
+        return false;
     }
+    leds.setBrightness(Config::DEFAULT_BRIGHTNESS);
+    
+    // All frames go through the presenter, the boot animation's included
+    presenter.init(&leds, Config::LED_FRAME_PERIOD_MS);
+    BootSequence::setBackground(renderBootFrame, this);
+    BootSequence::mark("leds");
     
+    // The IMU at its usual address; the alternative only if nothing answers there
+    DEBUG_PRINTLN("Initializing MPU sensor...");
+    bool sensorFound = imu.init();
+    if (!sensorFound && imu.getAddress() == MPU9250_ADDRESS_AD0_LOW) {
+        imu.setAddress(MPU9250_ADDRESS_AD0_HIGH);
+        sensorFound = imu.init();
+    }
     if (!sensorFound) {
+        BootSequence::setBackground(nullptr, nullptr);
         DEBUG_PRINTLN("ERROR: No MPU sensor found at standard addresses.");
         return false;
     }
+    BootSequence::mark("imu");
     
-    // Initialize LED interface
-    DEBUG_PRINTLN("Initializing LED interface...");
-    if (!leds.init()) {
-        DEBUG_PRINTLN("ERROR: Failed to initialize LED interface");
-        return false;
+    // Reuse the stored offsets if they still fit this sensor; calibrate otherwise
+    if (!restoreImuOffsets()) {
+        DEBUG_PRINTLN("Calibrating MPU sensor...");
+        if (!imu.calibrate()) {
+            DEBUG_PRINTLN("WARNING: MPU calibration failed. Using uncalibrated values.");
+            // Continue anyway - calibration failure is not fatal
+        } else if (imu.wasCalibrationGood()) {
+            storeImuOffsets();
+        }
     }
+    BootSequence::setBackground(nullptr, nullptr);
     
-    // Set default brightness
-    leds.setBrightness(Config::DEFAULT_BRIGHTNESS);
-    
-    // Show startup animation (white pulse)
-    Color white = {255, 255, 255};
-    leds.pulse(white, 2, 500);
+    // Keep the offsets current from here on whenever the device is held still
+    int16_t accelOffset[3], gyroOffset[3];
+    imu.getOffsets(accelOffset, gyroOffset);
+    biasMonitor.begin(accelOffset, gyroOffset, MPU_ACCEL_LSB_PER_G);
+    lastOffsetCommitTime = millis();
+    BootSequence::mark("imu offsets");
     
     // Initialize power manager
     DEBUG_PRINTLN("Initializing power management...");
@@ -163,6 +116,7 @@ bool HardwareManager::init() {
     
     // Set active power state
     setPowerState(true);
+    BootSequence::mark("power");
     
     isInitialized = true;
     DEBUG_PRINTLN("HardwareManager initialization complete");
@@ -170,6 +124,93 @@ bool HardwareManager::init() {
     return true;
 }
 
+/**
+ * @brief One frame of the boot animation: a white comet sweeping each ring
+ * @param context The HardwareManager
+ * @param nowMs Current time in milliseconds
+ */
+void HardwareManager::renderBootFrame(void* context, uint32_t nowMs) {
+    HardwareManager* self = static_cast<HardwareManager*>(context);
+    uint8_t head = (uint8_t)((nowMs % Config::Boot::ANIMATION_PERIOD_MS) * 256 / Config::Boot::ANIMATION_PERIOD_MS);
+    
+    Color frame[Config::NUM_LEDS];
+    for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+        // Full at the head, fading over the third of the ring behind it
+        uint8_t behind = (uint8_t)(head - ActiveTopology::angle(i));
+        uint8_t level = behind < 85 ? (uint8_t)(255 - behind * 3) : 0;
+        frame[i] = {level, level, level};
+    }
+    self->presenter.submit(frame);
+    self->presenter.service(nowMs);
+}
+
+/**
+ * @brief Apply the stored IMU offsets if they were taken on this sensor, near this temperature
+ * @return True if the offsets are in use; false means a full calibration is needed
+ */
+bool HardwareManager::restoreImuOffsets() {
+    const CalibrationData& stored = CalibrationStore::data();
+    if (!CalibrationStore::isStored() || !(stored.flags & CALIBRATION_HAS_IMU_OFFSETS)) {
+        DEBUG_PRINTLN("IMU: no stored offsets");
+        return false;
+    }
+    if (stored.imuWhoAmI != imu.getWhoAmI()) {
+        DEBUG_PRINTF("IMU: stored offsets are for WHO_AM_I 0x%02X, sensor is 0x%02X\n",
+                     stored.imuWhoAmI, imu.getWhoAmI());
+        return false;
+    }
+    float temperature;
+    if (!imu.readTemperature(temperature)) {
+        return false;
+    }
+    float storedTemperature = stored.imuTemperature / 100.0f;
+    if (fabsf(temperature - storedTemperature) > Config::ImuCalibration::MAX_TEMPERATURE_DRIFT_C) {
+        DEBUG_PRINTF("IMU: stored offsets taken at %.1f C, sensor now at %.1f C\n", storedTemperature, temperature);
+        return false;
+    }
+    
+    // One corrected reading must still look like gravity
+    imu.setOffsets(stored.accelOffset, stored.gyroOffset);
+    SensorData check;
+    if (!imu.readSensorData(&check)) {
+        return false;
+    }
+    float magnitude = sqrtf((float)check.accelX * check.accelX + (float)check.accelY * check.accelY +
+                            (float)check.accelZ * check.accelZ) / MPU_ACCEL_LSB_PER_G;
+    if (fabsf(magnitude - 1.0f) > Config::ImuCalibration::GRAVITY_TOLERANCE) {
+        DEBUG_PRINTF("IMU: stored offsets give %.2fg at rest\n", magnitude);
+        return false;
+    }
+    
+    DEBUG_PRINTF("IMU: stored offsets reused (%.1f C, taken at %.1f C)\n", temperature, storedTemperature);
+    return true;
+}
+
+/**
+ * @brief Store the IMU offsets in use, with the sensor's identity and temperature
+ * @return True if the CalibrationStore commit succeeded
+ */
+bool HardwareManager::storeImuOffsets() {
+    float temperature;
+    if (!imu.readTemperature(temperature)) {
+        return false;
+    }
+    CalibrationData data = CalibrationStore::data();
+    imu.getOffsets(data.accelOffset, data.gyroOffset);
+    data.flags |= CALIBRATION_HAS_IMU_OFFSETS;
+    data.imuWhoAmI = imu.getWhoAmI();
+    data.imuTemperature = (int16_t)lroundf(temperature * 100.0f);
+    
+    imuOffsetsPending = false;
+    lastOffsetCommitTime = millis();
+    if (!CalibrationStore::commit(data)) {
+        DEBUG_PRINTLN("WARNING: Failed to store IMU offsets");
+        return false;
+    }
+    DEBUG_PRINTLN("IMU offsets stored");
+    return true;
+}
+
 /**
  * @brief Update hardware state (read sensors, update LEDs)
  */
@@ -197,6 +238,16 @@ void HardwareManager::update() {
                 imu.recoverFromError();
                 failureCount = 0;
             }
+        } else if (biasMonitor.update(latestSensorData)) {
+            // Held still long enough to measure the bias again; use it from the next read
+            imu.setOffsets(biasMonitor.accelOffset(), biasMonitor.gyroOffset());
+            imuOffsetsPending = true;
+        }
+        
+        // Store refreshed offsets, rate-limited to spare the flash
+        if (imuOffsetsPending &&
+            currentMillis - lastOffsetCommitTime >= Config::ImuCalibration::COMMIT_INTERVAL_MS) {
+            storeImuOffsets();
         }
         
         // Record motion data if enabled
@@ -208,14 +259,8 @@ void HardwareManager::update() {
         shakeDetector.update();
     }
     
-    // Update LEDs at the configured interval (50ms default)
-    const unsigned long LED_UPDATE_INTERVAL = 50;
-    if (currentMillis - lastLedUpdateTime >= LED_UPDATE_INTERVAL) {
-        lastLedUpdateTime = currentMillis;
-        
-        // This only updates LEDs if there are pending changes
-        leds.show();
-    }
+    // Push a frame that was held back by the display period
+    presenter.service(currentMillis);
     
     // Update power management
     power.update();
@@ -230,32 +275,47 @@ const SensorData& HardwareManager::getSensorData() const {
 }
 
 /**
- * @brief Set the color of a specific LED
- * @param index LED index (0-11)
+ * @brief Read the IMU now, outside the regular sensor update
+ * @param data Output sensor data
+ * @return True if the read succeeded
+ */
+bool HardwareManager::sampleIMU(SensorData& data) {
+    return isInitialized && imu.readSensorData(&data);
+}
+
+/**
+ * @brief Set the color of a specific LED on the base layer
+ * @param index LED index (0 to Config::NUM_LEDS - 1)
  * @param color RGB color
  */
-void HardwareManager::setLED(uint8_t index, const Color& color) {
+void HardwareManager::setLED(uint16_t index, const Color& color) {
     if (isInitialized) {
-        leds.setLED(index, color);
+        compositor.setPixel(LEDLayer::BASE, index, color);
     }
 }
 
 /**
- * @brief Set all LEDs to the same color
+ * @brief Set all LEDs of the base layer to the same color
  * @param color RGB color
  */
 void HardwareManager::setAllLEDs(const Color& color) {
     if (isInitialized) {
-        leds.setAllLEDs(color);
+        compositor.fill(LEDLayer::BASE, color);
     }
 }
 
 /**
- * @brief Update the LED display
+ * @brief Flatten the compositor layers and hand the frame to the presenter
+ *
+ * The frame is pushed right away unless it is unchanged or the display
+ * period has not elapsed; update() pushes it later in that case.
  */
 void HardwareManager::updateLEDs() {
     if (isInitialized) {
-        leds.show();
+        Color frame[Config::NUM_LEDS];
+        compositor.flatten(frame);
+        presenter.submit(frame);
+        presenter.service(millis());
     }
 }
 
@@ -345,10 +405,12 @@ bool HardwareManager::resetComponent(HardwareComponent component) {
             return imu.resetDevice();
         case HW_COMPONENT_LED:
             leds.clear();
+            presenter.invalidate();
             return leds.init();
         case HW_COMPONENT_ALL:
             bool mpuReset = imu.resetDevice();
             leds.clear();
+            presenter.invalidate();
             bool ledReset = leds.init();
             return mpuReset && ledReset;
     }
@@ -385,6 +447,7 @@ bool HardwareManager::runSelfTest(HardwareComponent component) {
                 
                 leds.clear();
                 leds.show();
+                presenter.invalidate();
                 return true;
             }
         case HW_COMPONENT_ALL:
@@ -397,6 +460,7 @@ bool HardwareManager::runSelfTest(HardwareComponent component) {
             delay(200);
             leds.clear();
             leds.show();
+            presenter.invalidate();
             
             return mpuTest;
     }
@@ -4,7 +4,10 @@
 #include "../core/SystemTypes.h"
 #include "MPU9250Interface.h"
 #include "LEDInterface.h"
+#include "LEDCompositor.h"
+#include "FramePresenter.h"
 #include "PowerManager.h"
+#include "ImuBiasMonitor.h"
 #include "../detection/ShakeGestureDetector.h"
 
 // Maximum number of motion samples to store
@@ -48,20 +51,30 @@ public:
   const SensorData& getSensorData() const;
   
   /**
-   * @brief Set the color of a specific LED
-   * @param index LED index (0-11)
+   * @brief Read the IMU now, outside the regular sensor update
+   *
+   * Used by the telemetry stream, which samples faster than update() does.
+   * Does not change getSensorData() or feed the shake detector.
+   * @param data Output sensor data
+   * @return True if the read succeeded
+   */
+  bool sampleIMU(SensorData& data);
+  
+  /**
+   * @brief Set the color of a specific LED on the base layer
+   * @param index LED index (0 to Config::NUM_LEDS - 1)
    * @param color RGB color
    */
-  void setLED(uint8_t index, const Color& color);
+  void setLED(uint16_t index, const Color& color);
   
   /**
-   * @brief Set all LEDs to the same color
+   * @brief Set all LEDs of the base layer to the same color
    * @param color RGB color
    */
   void setAllLEDs(const Color& color);
   
   /**
-   * @brief Update the LED display
+   * @brief Flatten the compositor layers and hand the frame to the presenter
    */
   void updateLEDs();
   
@@ -135,6 +148,23 @@ public:
    * @return Pointer to the LEDInterface
    */
   LEDInterface* getLEDInterface() { return &leds; }
+  
+  /**
+   * @brief Get the layered LED compositor
+   * @return Pointer to the LEDCompositor
+   */
+  LEDCompositor* getCompositor() { return &compositor; }
+  
+  /**
+   * @brief Get the frame presenter that owns LED transfers
+   * @return Pointer to the FramePresenter
+   */
+  FramePresenter* getPresenter() { return &presenter; }
+  
+  /**
+   * @brief Counters of the background IMU bias check
+   */
+  const ImuBiasStats& getImuBiasStats() const { return biasMonitor.getStats(); }
 
 private:
   // Private constructor for singleton pattern
@@ -143,9 +173,16 @@ private:
   // Hardware component instances
   MPU9250Interface imu;
   LEDInterface leds;
+  LEDCompositor compositor;
+  FramePresenter presenter;
   PowerManager power;
   ShakeGestureDetector shakeDetector;
   
+  // IMU bias offsets: kept in the CalibrationStore, refreshed while the device is still
+  ImuBiasMonitor biasMonitor;
+  bool imuOffsetsPending;             // Refreshed offsets not yet stored
+  unsigned long lastOffsetCommitTime;
+  
   // Sensor data buffer
   SensorData latestSensorData;
   
@@ -156,7 +193,6 @@ private:
   
   // Timing variables
   unsigned long lastSensorUpdateTime;
-  unsigned long lastLedUpdateTime;
   
   // State tracking
   bool isInitialized;
@@ -164,6 +200,11 @@ private:
   
   // Internal helper methods
   void configurePins();
+  bool restoreImuOffsets();
+  bool storeImuOffsets();
+  
+  // Boot animation, run by BootSequence::wait() while the IMU comes up
+  static void renderBootFrame(void* context, uint32_t nowMs);
 };
 
 #endif // HARDWARE_MANAGER_H 
\ No newline at end of file
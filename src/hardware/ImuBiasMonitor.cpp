@@ -0,0 +1,109 @@
+#include "ImuBiasMonitor.h"
+#include "../core/Config.h"
+#include <stdlib.h>
+
+ImuBiasMonitor::ImuBiasMonitor()
+    : gravityLSB_(8192),
+      count_(0),
+      stats_{0, 0, 0} {
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    accelOffset_[axis] = 0;
+    gyroOffset_[axis] = 0;
+  }
+  restart();
+}
+
+void ImuBiasMonitor::begin(const int16_t accelOffset[3], const int16_t gyroOffset[3], int16_t gravityLSB) {
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    accelOffset_[axis] = accelOffset[axis];
+    gyroOffset_[axis] = gyroOffset[axis];
+  }
+  gravityLSB_ = gravityLSB;
+  stats_ = {0, 0, 0};
+  restart();
+}
+
+void ImuBiasMonitor::restart() {
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    accelSum_[axis] = 0;
+    gyroSum_[axis] = 0;
+    accelMin_[axis] = INT16_MAX;
+    accelMax_[axis] = INT16_MIN;
+    gyroMin_[axis] = INT16_MAX;
+    gyroMax_[axis] = INT16_MIN;
+  }
+  count_ = 0;
+}
+
+bool ImuBiasMonitor::update(const SensorData& data) {
+  const int16_t accel[3] = {data.accelX, data.accelY, data.accelZ};
+  const int16_t gyro[3] = {data.gyroX, data.gyroY, data.gyroZ};
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    accelSum_[axis] += accel[axis];
+    gyroSum_[axis] += gyro[axis];
+    if (accel[axis] < accelMin_[axis]) accelMin_[axis] = accel[axis];
+    if (accel[axis] > accelMax_[axis]) accelMax_[axis] = accel[axis];
+    if (gyro[axis] < gyroMin_[axis]) gyroMin_[axis] = gyro[axis];
+    if (gyro[axis] > gyroMax_[axis]) gyroMax_[axis] = gyro[axis];
+  }
+  if (++count_ < Config::ImuCalibration::STILL_WINDOW_SAMPLES) {
+    return false;
+  }
+  bool moved = evaluate();
+  restart();
+  return moved;
+}
+
+bool ImuBiasMonitor::evaluate() {
+  using namespace Config::ImuCalibration;
+  stats_.windows++;
+
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    if (gyroMax_[axis] - gyroMin_[axis] > STILL_GYRO_SPAN ||
+        accelMax_[axis] - accelMin_[axis] > STILL_ACCEL_SPAN) {
+      return false;
+    }
+  }
+  stats_.stillWindows++;
+
+  // Means of the corrected readings: what the current offsets leave over
+  int32_t gyroMean[3], accelMean[3];
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    gyroMean[axis] = gyroSum_[axis] / count_;
+    accelMean[axis] = accelSum_[axis] / count_;
+  }
+  accelMean[2] -= gravityLSB_;
+
+  bool gyroMoved = false;
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    if (abs(gyroMean[axis]) > GYRO_DRIFT) {
+      gyroMoved = true;
+    }
+  }
+  bool level = true;
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    if (abs(accelMean[axis]) > LEVEL_TOLERANCE) {
+      level = false;
+    }
+  }
+  bool accelMoved = false;
+  if (level) {
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      if (abs(accelMean[axis]) > ACCEL_DRIFT) {
+        accelMoved = true;
+      }
+    }
+  }
+  if (!gyroMoved && !accelMoved) {
+    return false;
+  }
+
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    gyroOffset_[axis] += gyroMean[axis];
+    if (accelMoved) {
+      accelOffset_[axis] += accelMean[axis];
+    }
+  }
+  stats_.updates++;
+  return true;
+}
@@ -0,0 +1,70 @@
+#ifndef IMU_BIAS_MONITOR_H
+#define IMU_BIAS_MONITOR_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+
+/**
+ * @brief Counters for the background IMU bias check
+ */
+struct ImuBiasStats {
+  uint16_t windows;         // Sample windows evaluated
+  uint16_t stillWindows;    // Of those, windows the device was still for
+  uint16_t updates;         // Windows that moved the offsets
+};
+
+/**
+ * @brief Refreshes the IMU bias offsets whenever the device is held still
+ *
+ * Fed every offset-corrected sample, it collects windows of
+ * Config::ImuCalibration::STILL_WINDOW_SAMPLES. A window whose gyro and
+ * accelerometer readings stay within the still spans gives a new gyro bias,
+ * in any orientation. The accelerometer bias is only taken again in the pose
+ * MPU9250Interface::calibrate() assumes (Z up, X and Y level), since in any
+ * other pose gravity is indistinguishable from bias. Offsets that moved less
+ * than the drift limits are left alone, so a settled sensor never causes a
+ * flash write.
+ */
+class ImuBiasMonitor {
+public:
+  ImuBiasMonitor();
+
+  /**
+   * @brief Start from the offsets the IMU is using
+   * @param gravityLSB Accelerometer counts per g
+   */
+  void begin(const int16_t accelOffset[3], const int16_t gyroOffset[3], int16_t gravityLSB);
+
+  /**
+   * @brief Add one offset-corrected sample
+   * @return True when a still window moved the offsets; read them with accelOffset() and gyroOffset()
+   */
+  bool update(const SensorData& data);
+
+  /**
+   * @brief Drop the window in progress, e.g. after the offsets were changed elsewhere
+   */
+  void restart();
+
+  const int16_t* accelOffset() const { return accelOffset_; }
+  const int16_t* gyroOffset() const { return gyroOffset_; }
+  const ImuBiasStats& getStats() const { return stats_; }
+
+private:
+  bool evaluate();
+
+  int16_t accelOffset_[3];
+  int16_t gyroOffset_[3];
+  int16_t gravityLSB_;
+
+  // Window in progress, in corrected counts
+  int32_t accelSum_[3];
+  int32_t gyroSum_[3];
+  int16_t accelMin_[3], accelMax_[3];
+  int16_t gyroMin_[3], gyroMax_[3];
+  uint8_t count_;
+
+  ImuBiasStats stats_;
+};
+
+#endif // IMU_BIAS_MONITOR_H
@@ -0,0 +1,109 @@
+#include "LEDCompositor.h"
+#include "../animation/ColorEngine.h"
+
+namespace {
+
+inline uint8_t addSaturate(uint8_t a, uint8_t b) {
+  uint16_t sum = (uint16_t)a + b;
+  return sum > 255 ? 255 : (uint8_t)sum;
+}
+
+} // namespace
+
+LEDCompositor::LEDCompositor() {
+  for (uint8_t l = 0; l < LAYER_COUNT; l++) {
+    layers_[l].opacity = 255;
+    layers_[l].mode = BlendMode::NORMAL;
+    clear(static_cast<LEDLayer>(l));
+  }
+}
+
+void LEDCompositor::setPixel(LEDLayer layer, uint16_t index, const Color& color, uint8_t coverage) {
+  if (layer >= LEDLayer::COUNT || index >= Config::NUM_LEDS) {
+    return;
+  }
+
+  Layer& target = layers_[static_cast<uint8_t>(layer)];
+  if (target.coverage[index] == 0 && coverage != 0) {
+    target.drawnCount++;
+  } else if (target.coverage[index] != 0 && coverage == 0) {
+    target.drawnCount--;
+  }
+  target.pixels[index] = color;
+  target.coverage[index] = coverage;
+}
+
+void LEDCompositor::fill(LEDLayer layer, const Color& color, uint8_t coverage) {
+  if (layer >= LEDLayer::COUNT) {
+    return;
+  }
+
+  Layer& target = layers_[static_cast<uint8_t>(layer)];
+  for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+    target.pixels[i] = color;
+    target.coverage[i] = coverage;
+  }
+  target.drawnCount = coverage ? Config::NUM_LEDS : 0;
+}
+
+void LEDCompositor::clear(LEDLayer layer) {
+  fill(layer, {0, 0, 0}, 0);
+}
+
+void LEDCompositor::setOpacity(LEDLayer layer, uint8_t opacity) {
+  if (layer < LEDLayer::COUNT) {
+    layers_[static_cast<uint8_t>(layer)].opacity = opacity;
+  }
+}
+
+void LEDCompositor::setBlendMode(LEDLayer layer, BlendMode mode) {
+  if (layer < LEDLayer::COUNT) {
+    layers_[static_cast<uint8_t>(layer)].mode = mode;
+  }
+}
+
+bool LEDCompositor::hasContent(LEDLayer layer) const {
+  return layer < LEDLayer::COUNT && layers_[static_cast<uint8_t>(layer)].drawnCount > 0;
+}
+
+void LEDCompositor::flatten(Color* out) const {
+  for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+    out[i] = {0, 0, 0};
+  }
+
+  for (uint8_t l = 0; l < LAYER_COUNT; l++) {
+    const Layer& layer = layers_[l];
+    if (layer.drawnCount == 0 || layer.opacity == 0) {
+      continue;
+    }
+
+    for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+      if (layer.coverage[i] == 0) {
+        continue;
+      }
+      const uint8_t alpha = ColorEngine::scale8(layer.coverage[i], layer.opacity);
+      const Color& src = layer.pixels[i];
+
+      switch (layer.mode) {
+        case BlendMode::ADD: {
+          Color add = ColorEngine::scale(src, alpha);
+          out[i] = {addSaturate(out[i].r, add.r), addSaturate(out[i].g, add.g), addSaturate(out[i].b, add.b)};
+          break;
+        }
+        case BlendMode::LIGHTEN: {
+          Color lit = {
+            src.r > out[i].r ? src.r : out[i].r,
+            src.g > out[i].g ? src.g : out[i].g,
+            src.b > out[i].b ? src.b : out[i].b
+          };
+          out[i] = ColorEngine::blend(out[i], lit, alpha);
+          break;
+        }
+        case BlendMode::NORMAL:
+        default:
+          out[i] = ColorEngine::blend(out[i], src, alpha);
+          break;
+      }
+    }
+  }
+}
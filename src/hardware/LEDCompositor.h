@@ -0,0 +1,95 @@
+#ifndef LED_COMPOSITOR_H
+#define LED_COMPOSITOR_H
+
+#include <stdint.h>
+#include "../core/SystemTypes.h"
+#include "../core/Config.h"
+
+/**
+ * @brief Fixed drawing layers, bottom to top
+ */
+enum class LEDLayer : uint8_t {
+  BASE = 0,       // Mode effect (idle position color, spells, FreeCast patterns)
+  FEEDBACK,       // Gesture feedback such as the LongShield countdown flash
+  EFFECTS,        // AnimationSystem (spells, cancel flash)
+  DEBUG_OVERLAY,  // VisualDebugIndicator
+  COUNT
+};
+
+/**
+ * @brief How a layer is combined with the layers below it
+ */
+enum class BlendMode : uint8_t {
+  NORMAL,  // Cross-fade by coverage x opacity
+  ADD,     // Saturating add, scaled by coverage x opacity
+  LIGHTEN  // Per-channel maximum, scaled by coverage x opacity
+};
+
+/**
+ * @brief Layered frame buffer for the LED ring
+ *
+ * Each subsystem draws only into its own layer. A pixel is only part of a
+ * layer once it has been drawn (its coverage is non-zero), so upper layers
+ * leave the rest of the ring to the layers below. flatten() combines the
+ * layers once per frame into the buffer sent to the LEDs.
+ */
+class LEDCompositor {
+public:
+  LEDCompositor();
+
+  /**
+   * @brief Draw one pixel into a layer
+   * @param layer Target layer
+   * @param index LED index
+   * @param color Pixel color
+   * @param coverage Pixel alpha (255 = opaque)
+   */
+  void setPixel(LEDLayer layer, uint16_t index, const Color& color, uint8_t coverage = 255);
+
+  /**
+   * @brief Draw every pixel of a layer with one color
+   */
+  void fill(LEDLayer layer, const Color& color, uint8_t coverage = 255);
+
+  /**
+   * @brief Make every pixel of a layer transparent
+   */
+  void clear(LEDLayer layer);
+
+  /**
+   * @brief Set the opacity applied to the whole layer
+   * @param opacity 0 (hidden) to 255 (as drawn)
+   */
+  void setOpacity(LEDLayer layer, uint8_t opacity);
+
+  /**
+   * @brief Set how the layer is combined with the layers below
+   */
+  void setBlendMode(LEDLayer layer, BlendMode mode);
+
+  /**
+   * @brief True if any pixel of the layer is drawn
+   */
+  bool hasContent(LEDLayer layer) const;
+
+  /**
+   * @brief Combine all layers, bottom to top over black
+   * @param out Output frame of Config::NUM_LEDS pixels
+   */
+  void flatten(Color* out) const;
+
+private:
+  static constexpr uint8_t LAYER_COUNT = static_cast<uint8_t>(LEDLayer::COUNT);
+
+  struct Layer {
+    Color pixels[Config::NUM_LEDS];
+    uint8_t coverage[Config::NUM_LEDS];
+    uint8_t opacity;
+    BlendMode mode;
+    uint16_t drawnCount; // Pixels with non-zero coverage
+  };
+
+  Layer layers_[LAYER_COUNT];
+};
+
+#endif // LED_COMPOSITOR_H
@@ -16,9 +16,15 @@ bool LEDInterface::init() {
   // Using the GRB color order as specified in hardware analysis
   FastLED.addLeds<WS2812, Config::LED_DATA_PIN, GRB>(leds, Config::NUM_LEDS);
   FastLED.setBrightness(brightness);
+  FastLED.setDither(0);  // The output stage dithers instead
   FastLED.clear();
   FastLED.show();
   
+  if (!wire.begin(leds, Config::NUM_LEDS)) {
+    DEBUG_PRINTLN("ERROR: Failed to start LED output task");
+    return false;
+  }
+  
   // Reset LED buffer
   for (int i = 0; i < Config::NUM_LEDS; i++) {
     ledBuffer[i] = {0, 0, 0};
@@ -32,7 +38,7 @@ bool LEDInterface::init() {
   return true;
 }
 
-void LEDInterface::setLED(uint8_t index, const Color& color) {
+void LEDInterface::setLED(uint16_t index, const Color& color) {
   if (index < Config::NUM_LEDS) {
     ledBuffer[index] = color;
   } else {
@@ -48,12 +54,19 @@ void LEDInterface::setAllLEDs(const Color& color) {
   }
 }
 
+void LEDInterface::setFrame(const Color* frame) {
+  for (int i = 0; i < Config::NUM_LEDS; i++) {
+    ledBuffer[i] = frame[i];
+  }
+}
+
 /**
  * @brief Fill all LEDs with a solid CRGB color
  * @param color CRGB color for FastLED compatibility
  */
 void LEDInterface::fillSolid(CRGB color) {
-  // Set FastLED array directly
+  // Set FastLED array directly once the wire is done with it
+  wire.waitIdle();
   fill_solid(leds, Config::NUM_LEDS, color);
   
   // Update internal buffer to match
@@ -64,8 +77,8 @@ void LEDInterface::fillSolid(CRGB color) {
   }
 }
 
-void LEDInterface::setLEDRange(uint8_t startIndex, uint8_t count, const Color& color) {
-  uint8_t endIndex = startIndex + count - 1;
+void LEDInterface::setLEDRange(uint16_t startIndex, uint16_t count, const Color& color) {
+  uint16_t endIndex = startIndex + count - 1;
   if (endIndex >= Config::NUM_LEDS) {
 #ifndef SUPPRESS_LED_DEBUG
     DEBUG_PRINTF("WARNING: LED range partially out of bounds: %d to %d\n", 
@@ -90,14 +103,23 @@ void LEDInterface::setBrightness(uint8_t newBrightness) {
 }
 
 void LEDInterface::show() {
-  // Apply colors to the FastLED array
-  for (int i = 0; i < Config::NUM_LEDS; i++) {
-    Color color = ledBuffer[i];
-    leds[i] = CRGB(color.r, color.g, color.b);
-  }
+  // Estimate the frame's current and scale it down if it exceeds the budget
+  uint8_t frameBrightness = FastLED.getBrightness();
+  uint32_t load = OutputStage::measure(ledBuffer, frameBrightness);
+  uint8_t limit = power.limit(LEDPowerModel::estimate(load, Config::NUM_LEDS), Config::NUM_LEDS);
+  uint32_t limitedLoad = (uint32_t)(((uint64_t)load * (limit + 1)) >> 8);
+  power.account(LEDPowerModel::estimate(limitedLoad, Config::NUM_LEDS), millis());
   
-  // Update the LED ring
-  FastLED.show();
+  // Gamma, brightness and dithering; the wire swaps the frame in when it is free
+  CRGB frame[Config::NUM_LEDS];
+  output.render(ledBuffer, frameBrightness, frame, limit);
+  
+  // Start the transfer without waiting for the bit-stream; brightness is already applied
+  wire.submit(frame, 255);
+}
+
+void LEDInterface::flush() {
+  wire.waitIdle();
 }
 
 void LEDInterface::clear() {
@@ -107,6 +129,7 @@ void LEDInterface::clear() {
   }
   
   // Clear LEDs
+  wire.waitIdle();
   FastLED.clear();
   FastLED.show();
   
@@ -136,6 +159,7 @@ void LEDInterface::fadeToBlack(uint8_t fadeAmount) {
 
 void LEDInterface::rainbow(uint8_t initialHue, uint8_t deltaHue) {
   // Use FastLED's fill_rainbow function directly on the leds array
+  wire.waitIdle();
   fill_rainbow(leds, Config::NUM_LEDS, initialHue, deltaHue);
   
   // Update the ledBuffer to match the FastLED array
@@ -150,6 +174,7 @@ void LEDInterface::rainbowBurst() {
   // Create a fast rainbow burst effect (used for CalmOffer gesture)
   // Start with high brightness
   uint8_t savedBrightness = brightness;
+  wire.waitIdle();
   FastLED.setBrightness(255);
   
   // Rapid rainbow animation
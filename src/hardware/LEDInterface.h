@@ -3,6 +3,9 @@
 
 #include "../core/SystemTypes.h"
 #include "../core/Config.h"
+#include "LEDWire.h"
+#include "OutputStage.h"
+#include "LEDPowerModel.h"
 #include <FastLED.h>
 
 /**
@@ -18,10 +21,10 @@ public:
   
   /**
    * @brief Set a single LED to a specific color
-   * @param index LED index (0-11)
+   * @param index LED index (0 to Config::NUM_LEDS - 1)
    * @param color RGB color value
    */
-  void setLED(uint8_t index, const Color& color);
+  void setLED(uint16_t index, const Color& color);
   
   /**
    * @brief Set all LEDs to the same color
@@ -29,6 +32,12 @@ public:
    */
   void setAllLEDs(const Color& color);
   
+  /**
+   * @brief Replace the whole LED buffer
+   * @param frame Config::NUM_LEDS colors, e.g. the flattened compositor output
+   */
+  void setFrame(const Color* frame);
+  
   /**
    * @brief Fill all LEDs with a solid CRGB color
    * @param color CRGB color for FastLED compatibility
@@ -41,7 +50,7 @@ public:
    * @param count Number of LEDs to set
    * @param color RGB color value
    */
-  void setLEDRange(uint8_t startIndex, uint8_t count, const Color& color);
+  void setLEDRange(uint16_t startIndex, uint16_t count, const Color& color);
   
   /**
    * @brief Set the global brightness scaling factor
@@ -49,11 +58,48 @@ public:
    */
   void setBrightness(uint8_t brightness);
   
+  /**
+   * @brief Get the global brightness scaling factor
+   * @return Brightness level (0-255)
+   */
+  uint8_t getBrightness() const { return brightness; }
+  
   /**
    * @brief Send the current LED values to the physical LEDs
+   *
+   * Hands the frame to the LED wire and returns without waiting for the
+   * transfer, unless a previous frame is still queued.
    */
   void show();
   
+  /**
+   * @brief True while the last frame should be sent again each display period
+   *
+   * Either the output stage is dithering it or the power limiter is still
+   * easing back to full scale.
+   */
+  bool needsRefresh() const { return output.isDithering() || power.isReleasing(); }
+  
+  /**
+   * @brief Current estimator, limiter and energy totals of the LED output
+   */
+  LEDPowerModel* getPowerModel() { return &power; }
+  
+  /**
+   * @brief Block until every frame passed to show() is on the LEDs
+   */
+  void flush();
+  
+  /**
+   * @brief Counters of the asynchronous LED output
+   */
+  const LEDWireStats& getWireStats() const { return wire.getStats(); }
+  
+  /**
+   * @brief Time one frame occupies the LED wire
+   */
+  uint32_t getWireFrameMicros() const { return wire.getFrameMicros(); }
+  
   /**
    * @brief Clear all LEDs (set to black)
    */
@@ -96,6 +142,15 @@ private:
   // LED pixel buffer
   Color ledBuffer[Config::NUM_LEDS];
   
+  // Gamma, brightness and temporal dithering applied in show()
+  OutputStage output;
+  
+  // Keeps every frame within the LED current budget
+  LEDPowerModel power;
+  
+  // Double-buffered output; the FastLED array is its front buffer
+  LEDWire wire;
+  
   // Current brightness (0-255)
   uint8_t brightness = Config::DEFAULT_BRIGHTNESS;
   
@@ -0,0 +1,84 @@
+#include "LEDPowerModel.h"
+
+const uint8_t LEDPowerModel::MODE_COUNT;
+const uint16_t LEDPowerModel::MIN_BUDGET_MA;
+
+LEDPowerModel::LEDPowerModel()
+    : budgetMilliamps_(Config::LED_POWER_BUDGET_MA),
+      target_(255),
+      mode_(0),
+      lastAccountMs_(0),
+      accounting_(false) {
+  resetTotals();
+}
+
+uint16_t LEDPowerModel::estimate(uint32_t levelSum, uint16_t ledCount) {
+  uint32_t channelMilliamps = (uint32_t)(((uint64_t)levelSum * Config::LED_MA_PER_CHANNEL) / 0xFF00);
+  uint32_t total = channelMilliamps + (uint32_t)ledCount * Config::LED_IDLE_MA;
+  return total > 0xFFFF ? 0xFFFF : (uint16_t)total;
+}
+
+uint8_t LEDPowerModel::limit(uint16_t requestedMilliamps, uint16_t ledCount) {
+  if (requestedMilliamps > stats_.peakRequestedMilliamps) {
+    stats_.peakRequestedMilliamps = requestedMilliamps;
+  }
+
+  // Largest scale that keeps this frame within the budget; only the
+  // channel current scales, the quiescent draw stays
+  target_ = 255;
+  uint32_t quiescent = (uint32_t)ledCount * Config::LED_IDLE_MA;
+  if (budgetMilliamps_ > 0 && requestedMilliamps > budgetMilliamps_ && requestedMilliamps > quiescent) {
+    uint32_t available = budgetMilliamps_ > quiescent ? budgetMilliamps_ - quiescent : 0;
+    target_ = (uint8_t)((available * 255) / (requestedMilliamps - quiescent));
+  }
+
+  if (target_ < stats_.limit) {
+    // Attack: never let a frame over budget reach the LEDs
+    stats_.limit = target_;
+  } else {
+    // Release: ease back up to avoid visible pumping
+    uint16_t raised = (uint16_t)stats_.limit + Config::LED_LIMIT_RELEASE_STEP;
+    stats_.limit = raised > target_ ? target_ : (uint8_t)raised;
+  }
+
+  if (stats_.limit < 255) {
+    stats_.limitedFrames++;
+  }
+  return stats_.limit;
+}
+
+void LEDPowerModel::account(uint16_t milliamps, uint32_t nowMs) {
+  if (accounting_) {
+    uint32_t elapsed = nowMs - lastAccountMs_;
+    chargeMilliampMs_[mode_] += (uint64_t)stats_.lastMilliamps * elapsed;
+    modeMillis_[mode_] += elapsed;
+  }
+  accounting_ = true;
+  lastAccountMs_ = nowMs;
+
+  stats_.lastMilliamps = milliamps;
+  if (milliamps > stats_.peakMilliamps) {
+    stats_.peakMilliamps = milliamps;
+  }
+}
+
+float LEDPowerModel::getMilliampHours(uint8_t mode) const {
+  if (mode >= MODE_COUNT) {
+    return 0.0f;
+  }
+  return (float)((double)chargeMilliampMs_[mode] / 3600000.0);
+}
+
+void LEDPowerModel::resetTotals() {
+  for (uint8_t i = 0; i < MODE_COUNT; i++) {
+    chargeMilliampMs_[i] = 0;
+    modeMillis_[i] = 0;
+  }
+  stats_.peakMilliamps = 0;
+  stats_.peakRequestedMilliamps = 0;
+  stats_.limitedFrames = 0;
+  if (!accounting_) {
+    stats_.lastMilliamps = 0;
+    stats_.limit = 255;
+  }
+}
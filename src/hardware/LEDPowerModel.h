@@ -0,0 +1,115 @@
+#ifndef LED_POWER_MODEL_H
+#define LED_POWER_MODEL_H
+
+#include <stdint.h>
+#include "../core/Config.h"
+
+/**
+ * @brief LED current figures since the last reset
+ */
+struct LEDPowerStats {
+  uint16_t lastMilliamps;      // Estimated draw of the frame on the LEDs
+  uint16_t peakMilliamps;      // Highest draw after limiting
+  uint16_t peakRequestedMilliamps; // Highest draw the renderers asked for
+  uint32_t limitedFrames;      // Frames scaled down to stay within the budget
+  uint8_t limit;               // Current limiter scale (255 = no limiting)
+};
+
+/**
+ * @brief Current model and brightness limiter for the LED ring
+ *
+ * The draw of a frame is estimated from the sum of its channel levels
+ * after gamma and brightness: each channel draws up to
+ * Config::LED_MA_PER_CHANNEL, plus a quiescent current per LED. When a
+ * frame would exceed the budget the limiter scales it down in the same
+ * frame (instant attack), then eases back toward full scale by
+ * Config::LED_LIMIT_RELEASE_STEP per frame so the ring does not pump.
+ *
+ * Energy is integrated per system mode (charge drawn while each frame was
+ * on the LEDs) to size batteries from real sessions.
+ */
+class LEDPowerModel {
+public:
+  static const uint8_t MODE_COUNT = 3;  // Indexed by SystemMode
+
+  // Quiescent draw of the whole ring; the limiter cannot go below it
+  static const uint16_t MIN_BUDGET_MA = Config::NUM_LEDS * Config::LED_IDLE_MA;
+
+  LEDPowerModel();
+
+  /**
+   * @brief Set the LED current limit
+   * @param milliamps Budget in mA (0 disables limiting); raised to MIN_BUDGET_MA if below it
+   */
+  void setBudget(uint16_t milliamps) {
+    budgetMilliamps_ = (milliamps > 0 && milliamps < MIN_BUDGET_MA) ? MIN_BUDGET_MA : milliamps;
+  }
+  uint16_t getBudget() const { return budgetMilliamps_; }
+
+  /**
+   * @brief Estimated current of a frame
+   * @param levelSum Sum of all channel levels in 8.8 fixed point (0xFF00 = full)
+   * @param ledCount Number of LEDs in the frame
+   * @return Current in mA
+   */
+  static uint16_t estimate(uint32_t levelSum, uint16_t ledCount);
+
+  /**
+   * @brief Update the limiter for a new frame
+   * @param requestedMilliamps Estimated current of the frame before limiting
+   * @param ledCount Number of LEDs; their quiescent current cannot be scaled away
+   * @return Scale to apply to the frame (255 = unchanged)
+   */
+  uint8_t limit(uint16_t requestedMilliamps, uint16_t ledCount);
+
+  /**
+   * @brief True while the limiter is easing back up and needs further frames to do so
+   */
+  bool isReleasing() const { return stats_.limit < target_; }
+
+  /**
+   * @brief Record that a frame went to the LEDs
+   *
+   * Charges the previous frame's current for the time it was shown.
+   *
+   * @param milliamps Estimated current of the new frame after limiting
+   * @param nowMs Current time in milliseconds
+   */
+  void account(uint16_t milliamps, uint32_t nowMs);
+
+  /**
+   * @brief Select the mode that further energy is booked to
+   * @param mode SystemMode as an index (0 to MODE_COUNT - 1)
+   */
+  void setMode(uint8_t mode) { mode_ = mode < MODE_COUNT ? mode : 0; }
+
+  /**
+   * @brief Charge drawn by the LEDs while a mode was active
+   * @return Charge in mAh
+   */
+  float getMilliampHours(uint8_t mode) const;
+
+  /**
+   * @brief Time spent in a mode since the last reset
+   */
+  uint32_t getModeMillis(uint8_t mode) const { return mode < MODE_COUNT ? modeMillis_[mode] : 0; }
+
+  /**
+   * @brief Clear energy totals and peaks
+   */
+  void resetTotals();
+
+  const LEDPowerStats& getStats() const { return stats_; }
+
+private:
+  uint16_t budgetMilliamps_;
+  uint8_t target_;
+  uint8_t mode_;
+  uint32_t lastAccountMs_;
+  bool accounting_;
+  uint64_t chargeMilliampMs_[MODE_COUNT];
+  uint32_t modeMillis_[MODE_COUNT];
+  LEDPowerStats stats_;
+};
+
+#endif // LED_POWER_MODEL_H
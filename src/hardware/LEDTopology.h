@@ -0,0 +1,95 @@
+#ifndef LED_TOPOLOGY_H
+#define LED_TOPOLOGY_H
+
+#include <stdint.h>
+#include "../core/Config.h"
+
+/**
+ * @brief Compile-time description of how the LEDs are laid out
+ *
+ * A topology is a type with only static constexpr members, so renderers
+ * templated on it see the LED count, ring boundaries and angular positions
+ * as constants: loops get fixed trip counts and the per-LED geometry folds
+ * into multiplies instead of runtime divisions.
+ *
+ * Every topology provides:
+ * - LED_COUNT, RING_COUNT
+ * - ringOf(i), ringStart(r), ringSize(r), position(i) (index within its ring)
+ * - angle(i): 0-255 position around the ring (or along the strip)
+ * - marker(k, perRing): k-th of perRing evenly spaced LEDs, counted over all rings
+ */
+
+/**
+ * @brief One or more identical rings wired in series
+ * @tparam LEDS_PER_RING LEDs in each ring
+ * @tparam RINGS Number of rings
+ */
+template <uint16_t LEDS_PER_RING, uint8_t RINGS = 1>
+struct RingTopology {
+  static_assert(LEDS_PER_RING > 0 && RINGS > 0, "topology needs at least one LED");
+
+  static constexpr uint16_t LED_COUNT = LEDS_PER_RING * RINGS;
+  static constexpr uint8_t RING_COUNT = RINGS;
+  static constexpr bool CLOSED = true;  // The last LED of a ring neighbours the first
+
+  static constexpr uint8_t ringOf(uint16_t index) { return index / LEDS_PER_RING; }
+  static constexpr uint16_t ringStart(uint8_t ring) { return ring * LEDS_PER_RING; }
+  static constexpr uint16_t ringSize(uint8_t) { return LEDS_PER_RING; }
+  static constexpr uint16_t position(uint16_t index) { return index % LEDS_PER_RING; }
+
+  static constexpr uint8_t angle(uint16_t index) {
+    return (uint8_t)(((uint32_t)position(index) * 256 + LEDS_PER_RING / 2) / LEDS_PER_RING);
+  }
+
+  static constexpr uint16_t marker(uint16_t k, uint8_t perRing) {
+    return ringStart(k / perRing) + (uint16_t)((uint32_t)(k % perRing) * LEDS_PER_RING / perRing);
+  }
+};
+
+/**
+ * @brief A single open strip; angle runs from 0 at the first LED to 255 at the last
+ * @tparam LEDS Number of LEDs
+ */
+template <uint16_t LEDS>
+struct StripTopology {
+  static_assert(LEDS > 0, "topology needs at least one LED");
+
+  static constexpr uint16_t LED_COUNT = LEDS;
+  static constexpr uint8_t RING_COUNT = 1;
+  static constexpr bool CLOSED = false;
+
+  static constexpr uint8_t ringOf(uint16_t) { return 0; }
+  static constexpr uint16_t ringStart(uint8_t) { return 0; }
+  static constexpr uint16_t ringSize(uint8_t) { return LEDS; }
+  static constexpr uint16_t position(uint16_t index) { return index; }
+
+  static constexpr uint8_t angle(uint16_t index) {
+    return LEDS > 1 ? (uint8_t)((uint32_t)index * 255 / (LEDS - 1)) : 0;
+  }
+
+  static constexpr uint16_t marker(uint16_t k, uint8_t perRing) {
+    return (uint16_t)((uint32_t)k * LEDS / perRing);
+  }
+};
+
+/**
+ * @brief Shortest distance between two angles (0-128)
+ *
+ * Wraps around for rings, measures straight along a strip.
+ */
+template <class Topology>
+inline uint8_t angularDistance(uint8_t a, uint8_t b) {
+  uint8_t forward = (uint8_t)(a - b);
+  uint8_t backward = (uint8_t)(b - a);
+  if (!Topology::CLOSED) {
+    return a > b ? (uint8_t)((a - b) >> 1) : (uint8_t)((b - a) >> 1);
+  }
+  return forward < backward ? forward : backward;
+}
+
+// The layout this build drives, selected in Config.h
+typedef RingTopology<Config::LEDS_PER_RING, Config::NUM_RINGS> ActiveTopology;
+
+static_assert(ActiveTopology::LED_COUNT == Config::NUM_LEDS, "Config::NUM_LEDS must match the active topology");
+
+#endif // LED_TOPOLOGY_H
@@ -0,0 +1,158 @@
+#include "LEDWire.h"
+#include <Arduino.h>
+
+#if LED_WIRE_ASYNC_TASK
+// Guards the back buffer and flags shared with the transfer task
+static portMUX_TYPE wireMux = portMUX_INITIALIZER_UNLOCKED;
+#define WIRE_LOCK()   portENTER_CRITICAL(&wireMux)
+#define WIRE_UNLOCK() portEXIT_CRITICAL(&wireMux)
+#else
+#define WIRE_LOCK()
+#define WIRE_UNLOCK()
+#endif
+
+LEDWire::LEDWire()
+    : front_(nullptr),
+      count_(0),
+      backBrightness_(0),
+      queued_(false),
+      transmitting_(false),
+      stats_{0, 0, 0}
+#if LED_WIRE_ASYNC_TASK
+      , task_(nullptr)
+      , sent_(nullptr)
+#else
+      , transferStartMicros_(0)
+#endif
+{
+}
+
+bool LEDWire::begin(CRGB* front, uint16_t count) {
+  front_ = front;
+  count_ = count > Config::NUM_LEDS ? Config::NUM_LEDS : count;
+  queued_ = false;
+  transmitting_ = false;
+
+#if LED_WIRE_ASYNC_TASK
+  if (!sent_) {
+    sent_ = xSemaphoreCreateBinary();
+    if (!sent_) {
+      return false;
+    }
+  }
+  if (!task_) {
+    BaseType_t created = xTaskCreatePinnedToCore(taskLoop, "ledwire", 2048, this,
+                                                 Config::LED_WIRE_TASK_PRIORITY, &task_,
+                                                 Config::LED_WIRE_TASK_CORE);
+    if (created != pdPASS) {
+      task_ = nullptr;
+      return false;
+    }
+  }
+#endif
+  return true;
+}
+
+uint32_t LEDWire::getFrameMicros() const {
+  return (uint32_t)count_ * Config::LED_WIRE_US_PER_LED + Config::LED_WIRE_RESET_US;
+}
+
+void LEDWire::submit(const CRGB* frame, uint8_t brightness) {
+  if (!front_) {
+    return;
+  }
+
+  poll();
+  if (queued_) {
+    // A frame is already waiting behind the one on the wire
+    uint32_t start = micros();
+    while (queued_) {
+      waitForTransfer();
+    }
+    stats_.renderWaits++;
+    stats_.waitMicros += micros() - start;
+  }
+
+  WIRE_LOCK();
+  for (uint16_t i = 0; i < count_; i++) {
+    back_[i] = frame[i];
+  }
+  backBrightness_ = brightness;
+  queued_ = true;
+  WIRE_UNLOCK();
+
+#if LED_WIRE_ASYNC_TASK
+  xTaskNotifyGive(task_);
+#else
+  poll();
+#endif
+}
+
+bool LEDWire::isBusy() {
+  poll();
+  return queued_ || transmitting_;
+}
+
+void LEDWire::waitIdle() {
+  while (isBusy()) {
+    waitForTransfer();
+  }
+}
+
+uint8_t LEDWire::swapBuffers() {
+  WIRE_LOCK();
+  for (uint16_t i = 0; i < count_; i++) {
+    front_[i] = back_[i];
+  }
+  uint8_t brightness = backBrightness_;
+  queued_ = false;
+  transmitting_ = true;
+  WIRE_UNLOCK();
+  stats_.transfers++;
+  return brightness;
+}
+
+#if LED_WIRE_ASYNC_TASK
+
+void LEDWire::poll() {
+  // The transfer task advances on its own
+}
+
+void LEDWire::waitForTransfer() {
+  // Sleeps until the transfer task reports a frame sent, leaving the core to
+  // other tasks; a signal left from an earlier frame only costs another check
+  // of the flags, and the one-tick timeout keeps a missed one from hanging
+  xSemaphoreTake(sent_, 1);
+}
+
+void LEDWire::taskLoop(void* arg) {
+  LEDWire* wire = static_cast<LEDWire*>(arg);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (wire->queued_) {
+      // FastLED drives the RMT peripheral; only this task waits for it
+      FastLED.show(wire->swapBuffers());
+      wire->transmitting_ = false;
+      xSemaphoreGive(wire->sent_);
+    }
+  }
+}
+
+#else
+
+void LEDWire::waitForTransfer() {
+  // The stand-in wire only advances when polled
+  poll();
+}
+
+void LEDWire::poll() {
+  if (transmitting_ && micros() - transferStartMicros_ >= getFrameMicros()) {
+    transmitting_ = false;
+  }
+  if (!transmitting_ && queued_) {
+    swapBuffers();
+    transferStartMicros_ = micros();
+  }
+}
+
+#endif
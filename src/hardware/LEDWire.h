@@ -0,0 +1,103 @@
+#ifndef LED_WIRE_H
+#define LED_WIRE_H
+
+#include <stdint.h>
+#include <FastLED.h>
+#include "../core/Config.h"
+
+// On the ESP32 the transfer runs in its own task; everywhere else (host
+// builds, or with -D LED_WIRE_SIMULATED) a stand-in wire only tracks how
+// long the bit-stream would take so overlap with rendering can be tested.
+#if defined(ARDUINO_ARCH_ESP32) && !defined(LED_WIRE_SIMULATED)
+#define LED_WIRE_ASYNC_TASK 1
+#else
+#define LED_WIRE_ASYNC_TASK 0
+#endif
+
+/**
+ * @brief Cumulative LED wire counters
+ */
+struct LEDWireStats {
+  uint32_t transfers;    // Frames put on the wire
+  uint32_t renderWaits;  // Submits that had to wait because a frame was already queued
+  uint32_t waitMicros;   // Total time the render loop spent waiting for the wire
+};
+
+/**
+ * @brief Double-buffered, non-blocking LED output
+ *
+ * submit() copies a finished frame into the back buffer and returns. The
+ * back buffer is swapped into the front buffer (the FastLED array) when the
+ * wire is free, and the transfer runs without the render loop waiting for
+ * it. The render loop only waits when it submits while a frame is still
+ * queued behind the one on the wire, i.e. when it is a full frame ahead,
+ * and then sleeps until the transfer task signals the frame sent.
+ */
+class LEDWire {
+public:
+  LEDWire();
+
+  /**
+   * @brief Attach the front buffer and start the transfer task
+   * @param front FastLED array the controller sends from
+   * @param count Number of LEDs in the array (at most Config::NUM_LEDS)
+   * @return True if the wire is ready
+   */
+  bool begin(CRGB* front, uint16_t count);
+
+  /**
+   * @brief Queue a finished frame for transfer
+   * @param frame count colors
+   * @param brightness FastLED brightness to send the frame with
+   */
+  void submit(const CRGB* frame, uint8_t brightness);
+
+  /**
+   * @brief True while a frame is on the wire or queued
+   */
+  bool isBusy();
+
+  /**
+   * @brief Block until every submitted frame has been sent
+   *
+   * Call before driving FastLED directly.
+   */
+  void waitIdle();
+
+  /**
+   * @brief Finish elapsed transfers and start a queued frame (stand-in wire only)
+   */
+  void poll();
+
+  /**
+   * @brief Time one frame occupies the wire
+   */
+  uint32_t getFrameMicros() const;
+
+  const LEDWireStats& getStats() const { return stats_; }
+
+private:
+  CRGB* front_;
+  CRGB back_[Config::NUM_LEDS];
+  uint16_t count_;
+  volatile uint8_t backBrightness_;
+  volatile bool queued_;
+  volatile bool transmitting_;
+  LEDWireStats stats_;
+
+#if LED_WIRE_ASYNC_TASK
+  TaskHandle_t task_;
+  SemaphoreHandle_t sent_;    // Given by the transfer task after each frame
+  static void taskLoop(void* arg);
+#else
+  uint32_t transferStartMicros_;
+#endif
+
+  // Swap the queued back buffer into the front buffer; returns its brightness
+  uint8_t swapBuffers();
+
+  // Block until the frame on the wire is out, without holding the core
+  void waitForTransfer();
+};
+
+#endif // LED_WIRE_H
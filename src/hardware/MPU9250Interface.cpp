@@ -1,6 +1,13 @@
 #include "MPU9250Interface.h"
 #include "../utils/DebugTools.h"
 #include "../core/Config.h"
+#include "../core/BootSequence.h"
+#include "SerialTx.h"
+
+// LUTT Diagnostic includes (conditionally compiled)
+#if DIAG_LOGGING_ENABLED
+#include "../diagnostics/DiagnosticLogger.h"
+#endif
 
 // I2C configuration - reduced from 400kHz to 100kHz for better reliability
 static const uint8_t SDA_PIN = Config::I2C_SDA_PIN;  // I2C SDA pin on ESP32
@@ -12,9 +19,9 @@ void MPU9250Interface::setAddress(uint8_t address) {
     // Only allow valid MPU addresses
     if (address == MPU9250_ADDRESS_AD0_LOW || address == MPU9250_ADDRESS_AD0_HIGH) {
         sensorAddress = address;
-        Serial.printf("MPU sensor address set to 0x%02X\n", sensorAddress);
+        SerialOut.printf("MPU sensor address set to 0x%02X\n", sensorAddress);
     } else {
-        Serial.printf("Invalid MPU address: 0x%02X (must be 0x68 or 0x69)\n", address);
+        SerialOut.printf("Invalid MPU address: 0x%02X (must be 0x68 or 0x69)\n", address);
     }
 }
 
@@ -31,81 +38,88 @@ bool MPU9250Interface::init() {
     Wire.begin(SDA_PIN, SCL_PIN);
     Wire.setClock(I2C_FREQUENCY);
     
-    delay(50); // Allow I2C to stabilize
-    
     // Log connection attempt
-    Serial.printf("Initializing MPU sensor on I2C address 0x%02X\n", sensorAddress);
+    SerialOut.printf("Initializing MPU sensor on I2C address 0x%02X\n", sensorAddress);
     
     // Verify device presence
     Wire.beginTransmission(sensorAddress);
     byte error = Wire.endTransmission();
     
     if (error != 0) {
-        Serial.println("ERROR: MPU sensor not found on I2C bus");
+        SerialOut.println("ERROR: MPU sensor not found on I2C bus");
         return false;
     }
     
     // Reset the device
-    Serial.println("Resetting MPU sensor...");
+    SerialOut.println("Resetting MPU sensor...");
     if (!writeRegister(PWR_MGMT_1_REG, 0x80)) {
-        Serial.println("Failed to reset device");
+        SerialOut.println("Failed to reset device");
         return false;
     }
     
-    // Wait for reset to complete
-    delay(100);
+    // Wait for reset to complete; the boot animation keeps running meanwhile
+    BootSequence::wait(Config::Boot::IMU_RESET_MS);
     
-    // Wake up the sensor
-    Serial.println("Waking up sensor...");
+    // Wake up the sensor; it is ready once the first sample is (see below)
+    SerialOut.println("Waking up sensor...");
     if (!writeRegister(PWR_MGMT_1_REG, 0x00)) {
-        Serial.println("Failed to wake up device");
+        SerialOut.println("Failed to wake up device");
         return false;
     }
-    delay(100);
     
     // Verify device identity
-    uint8_t whoAmI = readRegister(WHO_AM_I_REG);
-    Serial.printf("MPU WHO_AM_I register value: 0x%02X\n", whoAmI);
+    whoAmI = readRegister(WHO_AM_I_REG);
+    SerialOut.printf("MPU WHO_AM_I register value: 0x%02X\n", whoAmI);
     
     // Accept a wider range of valid WHO_AM_I values for MPU variants
     if (whoAmI == 0x68 || whoAmI == 0x71 || whoAmI == 0x73 || whoAmI == 0x70) {
-        Serial.println("Valid MPU sensor identified");
+        SerialOut.println("Valid MPU sensor identified");
     } else {
-        Serial.printf("WARNING: Unknown WHO_AM_I value: 0x%02X\n", whoAmI);
-        Serial.println("Continuing anyway for compatibility with some MPU variants");
+        SerialOut.printf("WARNING: Unknown WHO_AM_I value: 0x%02X\n", whoAmI);
+        SerialOut.println("Continuing anyway for compatibility with some MPU variants");
     }
     
     // Configure sample rate (register 0x19)
     // Calculate: sample_rate = 1kHz / (1 + divider)
     // For 125Hz: 1000 / (1 + 7) = 125Hz
-    Serial.println("Setting sample rate to 125Hz...");
+    SerialOut.println("Setting sample rate to 125Hz...");
     if (!writeRegister(SMPLRT_DIV_REG, 0x07)) {
-        Serial.println("Failed to set sample rate");
+        SerialOut.println("Failed to set sample rate");
         return false;
     }
     
     // Configure gyroscope range to ±500 deg/s (register 0x1B)
-    Serial.println("Setting gyroscope range to ±500 deg/s...");
+    SerialOut.println("Setting gyroscope range to ±500 deg/s...");
     if (!writeRegister(GYRO_CONFIG_REG, 0x08)) {
-        Serial.println("Failed to set gyro range");
+        SerialOut.println("Failed to set gyro range");
         return false;
     }
     
     // Configure accelerometer range to ±4g (register 0x1C)
-    Serial.println("Setting accelerometer range to ±4g...");
+    SerialOut.println("Setting accelerometer range to ±4g...");
     if (!writeRegister(ACCEL_CONFIG_REG, 0x08)) {
-        Serial.println("Failed to set accelerometer range");
+        SerialOut.println("Failed to set accelerometer range");
         return false;
     }
     
     // Enable data ready interrupt (register 0x38)
-    Serial.println("Enabling data ready interrupt...");
+    SerialOut.println("Enabling data ready interrupt...");
     if (!writeRegister(INT_ENABLE_REG, 0x01)) {
-        Serial.println("Failed to enable interrupts");
+        SerialOut.println("Failed to enable interrupts");
         return false;
     }
     
-    Serial.println("MPU sensor initialization complete!");
+    // Wait for the first sample rather than a fixed settle time
+    uint32_t waitStart = millis();
+    while (!(readRegister(INT_STATUS_REG) & 0x01)) {
+        if (millis() - waitStart >= Config::Boot::IMU_DATA_TIMEOUT_MS) {
+            SerialOut.println("WARNING: no data ready from MPU sensor yet");
+            break;
+        }
+        BootSequence::wait(1);
+    }
+    
+    SerialOut.println("MPU sensor initialization complete!");
     return true;
 }
 
@@ -120,7 +134,9 @@ bool MPU9250Interface::readSensorData(SensorData* data) {
     
     // Start from ACCEL_XOUT_H register (0x3B)
     if (!readRegisters(ACCEL_XOUT_H_REG, buffer, 14)) {
-        Serial.println("Error reading sensor data");
+        #if DIAG_LOGGING_ENABLED
+        DIAG_LOG_RATE(DIAG_LEVEL_ERROR, DIAG_TAG_SENSOR, 1, 5, "Error reading sensor data");
+        #endif
         return false;
     }
     
@@ -150,10 +166,13 @@ bool MPU9250Interface::readSensorData(SensorData* data) {
     if (data->accelX == 0 && data->accelY == 0 && data->accelZ == 0 && 
         data->gyroX == 0 && data->gyroY == 0 && data->gyroZ == 0) {
         
-        // Log with both raw and offset-adjusted values
-        Serial.println("WARNING: All sensor values are zero - possible sensor issue");
-        Serial.printf("Raw values: accelX=%d, accelY=%d, accelZ=%d, gyroX=%d, gyroY=%d, gyroZ=%d\n", 
-                     accelX, accelY, accelZ, gyroX, gyroY, gyroZ);
+        // Log the raw values behind the offset-adjusted zeros
+        #if DIAG_LOGGING_ENABLED
+        DIAG_LOG_RATE(DIAG_LEVEL_WARNING, DIAG_TAG_SENSOR, 1, 5,
+                      "All sensor values are zero - raw accel %d,%d,%d", accelX, accelY, accelZ);
+        DIAG_LOG_RATE(DIAG_LEVEL_WARNING, DIAG_TAG_SENSOR, 1, 5,
+                      "All sensor values are zero - raw gyro %d,%d,%d", gyroX, gyroY, gyroZ);
+        #endif
     }
     
     return true;
@@ -169,7 +188,7 @@ void MPU9250Interface::setSampleRate(uint16_t rate) {
     // Set sample rate divider
     writeRegister(SMPLRT_DIV_REG, divider);
     
-    Serial.printf("Sample rate set to approximately %d Hz\n", 1000 / (1 + divider));
+    SerialOut.printf("Sample rate set to approximately %d Hz\n", 1000 / (1 + divider));
 }
 
 void MPU9250Interface::setLowPowerMode(bool lowPower) {
@@ -179,11 +198,11 @@ void MPU9250Interface::setLowPowerMode(bool lowPower) {
         
         // Set low power wake-up frequency to 1.25 Hz
         writeRegister(0x1D, 0x40);
-        Serial.println("Low power mode enabled");
+        SerialOut.println("Low power mode enabled");
     } else {
         // Disable low power mode
         writeRegister(PWR_MGMT_1_REG, 0x01);  // Use gyro X as clock reference
-        Serial.println("Normal power mode enabled");
+        SerialOut.println("Normal power mode enabled");
     }
 }
 
@@ -191,13 +210,13 @@ bool MPU9250Interface::calibrate() {
     const int sampleCount = 100;
     const int calmDelay = 2000; // Time to keep device still
     
-    Serial.println("\n======================================");
-    Serial.println("MPU SENSOR CALIBRATION DIAGNOSTICS");
-    Serial.println("======================================");
+    SerialOut.println("\n======================================");
+    SerialOut.println("MPU SENSOR CALIBRATION DIAGNOSTICS");
+    SerialOut.println("======================================");
     
     // Verify sensor identity first
-    uint8_t whoAmI = readRegister(WHO_AM_I_REG);
-    Serial.printf("Sensor WHO_AM_I value: 0x%02X\n", whoAmI);
+    whoAmI = readRegister(WHO_AM_I_REG);
+    SerialOut.printf("Sensor WHO_AM_I value: 0x%02X\n", whoAmI);
     
     // Identify specific sensor model based on WHO_AM_I
     String sensorType = "Unknown";
@@ -208,10 +227,11 @@ bool MPU9250Interface::calibrate() {
     } else if (whoAmI == 0x71 || whoAmI == 0x73) {
         sensorType = "MPU9250";
     }
-    Serial.printf("Detected sensor type: %s\n", sensorType.c_str());
+    SerialOut.printf("Detected sensor type: %s\n", sensorType.c_str());
     
     // Explicitly reset offsets before calibration
-    Serial.println("Resetting calibration offsets to zero");
+    SerialOut.println("Resetting calibration offsets to zero");
+    calibrationGood = false;
     accelOffsetX = 0;
     accelOffsetY = 0;
     accelOffsetZ = 0;
@@ -222,26 +242,26 @@ bool MPU9250Interface::calibrate() {
     // Log current configuration
     uint8_t accelConfig = readRegister(ACCEL_CONFIG_REG);
     uint8_t gyroConfig = readRegister(GYRO_CONFIG_REG);
-    Serial.printf("Current accelerometer config: 0x%02X\n", accelConfig);
-    Serial.printf("Current gyroscope config: 0x%02X\n", gyroConfig);
+    SerialOut.printf("Current accelerometer config: 0x%02X\n", accelConfig);
+    SerialOut.printf("Current gyroscope config: 0x%02X\n", gyroConfig);
     
     // Calculate and display expected scaling factors
     uint8_t accelRange = (accelConfig >> 3) & 0x03; // Extract AFS_SEL bits
     float accelScale = 0.0f;
     
     switch (accelRange) {
-        case 0: accelScale = 16384.0f; Serial.println("Accel range: ±2g (16384 LSB/g)"); break;
-        case 1: accelScale = 8192.0f; Serial.println("Accel range: ±4g (8192 LSB/g)"); break;
-        case 2: accelScale = 4096.0f; Serial.println("Accel range: ±8g (4096 LSB/g)"); break;
-        case 3: accelScale = 2048.0f; Serial.println("Accel range: ±16g (2048 LSB/g)"); break;
-        default: Serial.println("Unknown accelerometer range"); break;
+        case 0: accelScale = 16384.0f; SerialOut.println("Accel range: ±2g (16384 LSB/g)"); break;
+        case 1: accelScale = 8192.0f; SerialOut.println("Accel range: ±4g (8192 LSB/g)"); break;
+        case 2: accelScale = 4096.0f; SerialOut.println("Accel range: ±8g (4096 LSB/g)"); break;
+        case 3: accelScale = 2048.0f; SerialOut.println("Accel range: ±16g (2048 LSB/g)"); break;
+        default: SerialOut.println("Unknown accelerometer range"); break;
     }
     
-    Serial.println("Keep the device still for 2 seconds");
-    Serial.println("-------------------------------------");
+    SerialOut.println("Keep the device still for 2 seconds");
+    SerialOut.println("-------------------------------------");
     
     // Give user time to keep the device still
-    delay(calmDelay);
+    BootSequence::wait(calmDelay);
     
     int32_t accelXSum = 0, accelYSum = 0, accelZSum = 0;
     int32_t gyroXSum = 0, gyroYSum = 0, gyroZSum = 0;
@@ -254,11 +274,11 @@ bool MPU9250Interface::calibrate() {
     int zeroReadingsCount = 0;
     
     // Collect samples
-    Serial.println("Collecting calibration samples...");
+    SerialOut.println("Collecting calibration samples...");
     for (int i = 0; i < sampleCount; i++) {
         SensorData data;
         if (!readSensorData(&data)) {
-            Serial.println("Error during calibration data collection");
+            SerialOut.println("Error during calibration data collection");
             return false;
         }
         
@@ -268,8 +288,8 @@ bool MPU9250Interface::calibrate() {
             
             // Extra debugging for zero readings
             if (zeroReadingsCount > 3) {
-                Serial.println("WARNING: Multiple consecutive zero readings detected");
-                Serial.println("Attempting recovery...");
+                SerialOut.println("WARNING: Multiple consecutive zero readings detected");
+                SerialOut.println("Attempting recovery...");
                 
                 // Try to read directly from registers without offsets
                 uint8_t buffer[6];
@@ -278,8 +298,8 @@ bool MPU9250Interface::calibrate() {
                     int16_t rawY = (int16_t)((buffer[2] << 8) | buffer[3]);
                     int16_t rawZ = (int16_t)((buffer[4] << 8) | buffer[5]);
                     
-                    Serial.printf("Direct register read: X=%d, Y=%d, Z=%d\n", 
-                                 rawX, rawY, rawZ);
+                    SerialOut.printf("Direct register read: X=%d, Y=%d, Z=%d\n", 
+                                    rawX, rawY, rawZ);
                 }
             }
         } else {
@@ -288,8 +308,8 @@ bool MPU9250Interface::calibrate() {
         
         // Log raw data for verification samples
         if (i < 3 || i > sampleCount - 3) {
-            Serial.printf("Calibration sample %d: accelX=%d, accelY=%d, accelZ=%d, gyroX=%d, gyroY=%d, gyroZ=%d\n", 
-                         i, data.accelX, data.accelY, data.accelZ, data.gyroX, data.gyroY, data.gyroZ);
+            SerialOut.printf("Calibration sample %d: accelX=%d, accelY=%d, accelZ=%d, gyroX=%d, gyroY=%d, gyroZ=%d\n", 
+                            i, data.accelX, data.accelY, data.accelZ, data.gyroX, data.gyroY, data.gyroZ);
             
             // Convert to physical units using expected scaling and display
             if (accelScale > 0) {
@@ -297,8 +317,8 @@ bool MPU9250Interface::calibrate() {
                 float physicalY = data.accelY / accelScale * 9.81f;
                 float physicalZ = data.accelZ / accelScale * 9.81f;
                 
-                Serial.printf("  → Physical (m/s²): X=%.2f, Y=%.2f, Z=%.2f\n", 
-                             physicalX, physicalY, physicalZ);
+                SerialOut.printf("  → Physical (m/s²): X=%.2f, Y=%.2f, Z=%.2f\n", 
+                                physicalX, physicalY, physicalZ);
             }
         }
         
@@ -319,14 +339,14 @@ bool MPU9250Interface::calibrate() {
         gyroYSum += data.gyroY;
         gyroZSum += data.gyroZ;
         
-        delay(10);  // Short delay between samples
+        BootSequence::wait(10);  // Short delay between samples
     }
     
     // Log range of values seen during calibration
-    Serial.println("\nValue ranges during calibration:");
-    Serial.printf("  accelX: %d to %d (span: %d)\n", accelXMin, accelXMax, accelXMax - accelXMin);
-    Serial.printf("  accelY: %d to %d (span: %d)\n", accelYMin, accelYMax, accelYMax - accelYMin);
-    Serial.printf("  accelZ: %d to %d (span: %d)\n", accelZMin, accelZMax, accelZMax - accelZMin);
+    SerialOut.println("\nValue ranges during calibration:");
+    SerialOut.printf("  accelX: %d to %d (span: %d)\n", accelXMin, accelXMax, accelXMax - accelXMin);
+    SerialOut.printf("  accelY: %d to %d (span: %d)\n", accelYMin, accelYMax, accelYMax - accelYMin);
+    SerialOut.printf("  accelZ: %d to %d (span: %d)\n", accelZMin, accelZMax, accelZMax - accelZMin);
     
     // Calculate whether we had significant variation (needed for valid calibration)
     bool sufficientVariation = 
@@ -335,8 +355,18 @@ bool MPU9250Interface::calibrate() {
         (accelZMax - accelZMin > 50);
     
     if (!sufficientVariation) {
-        Serial.println("WARNING: Insufficient variation in accelerometer readings");
-        Serial.println("Calibration may not be accurate");
+        SerialOut.println("WARNING: Insufficient variation in accelerometer readings");
+        SerialOut.println("Calibration may not be accurate");
+    }
+    
+    // Offsets are only worth keeping if the sensor is alive and was held still
+    bool heldStill =
+        (accelXMax - accelXMin <= Config::ImuCalibration::GOOD_CALIBRATION_SPAN) &&
+        (accelYMax - accelYMin <= Config::ImuCalibration::GOOD_CALIBRATION_SPAN) &&
+        (accelZMax - accelZMin <= Config::ImuCalibration::GOOD_CALIBRATION_SPAN);
+    bool alive = (accelXMax != accelXMin) || (accelYMax != accelYMin) || (accelZMax != accelZMin);
+    if (!heldStill) {
+        SerialOut.println("WARNING: Device moved during calibration; offsets will not be stored");
     }
     
     // Calculate average offsets
@@ -352,7 +382,7 @@ bool MPU9250Interface::calibrate() {
         // Default to 8192 if we couldn't determine scale (for ±4g range)
         gravityLSB = 8192;
     }
-    Serial.printf("Using gravity reference: %d LSB (1g)\n", gravityLSB);
+    SerialOut.printf("Using gravity reference: %d LSB (1g)\n", gravityLSB);
     
     // Keep gravity in Z axis by subtracting average minus 1g equivalent
     accelOffsetZ = (accelZSum / sampleCount) - gravityLSB;
@@ -361,16 +391,18 @@ bool MPU9250Interface::calibrate() {
     gyroOffsetY = gyroYSum / sampleCount;
     gyroOffsetZ = gyroZSum / sampleCount;
     
-    Serial.println("\nCalibration complete");
-    Serial.printf("Accel offsets: X=%d Y=%d Z=%d\n", accelOffsetX, accelOffsetY, accelOffsetZ);
-    Serial.printf("Gyro offsets: X=%d Y=%d Z=%d\n", gyroOffsetX, gyroOffsetY, gyroOffsetZ);
+    calibrationGood = heldStill && alive;
+    
+    SerialOut.println("\nCalibration complete");
+    SerialOut.printf("Accel offsets: X=%d Y=%d Z=%d\n", accelOffsetX, accelOffsetY, accelOffsetZ);
+    SerialOut.printf("Gyro offsets: X=%d Y=%d Z=%d\n", gyroOffsetX, gyroOffsetY, gyroOffsetZ);
     
     // Verify calibration with a test reading
-    Serial.println("\nVerifying calibration with test reading:");
+    SerialOut.println("\nVerifying calibration with test reading:");
     SensorData testData;
     if (readSensorData(&testData)) {
-        Serial.printf("Test reading (with offsets): X=%d Y=%d Z=%d\n", 
-                     testData.accelX, testData.accelY, testData.accelZ);
+        SerialOut.printf("Test reading (with offsets): X=%d Y=%d Z=%d\n", 
+                        testData.accelX, testData.accelY, testData.accelZ);
         
         // Convert to physical units
         if (accelScale > 0) {
@@ -378,20 +410,54 @@ bool MPU9250Interface::calibrate() {
             float physicalY = testData.accelY / accelScale * 9.81f;
             float physicalZ = testData.accelZ / accelScale * 9.81f;
             
-            Serial.printf("Physical (m/s²): X=%.2f, Y=%.2f, Z=%.2f\n", 
-                         physicalX, physicalY, physicalZ);
+            SerialOut.printf("Physical (m/s²): X=%.2f, Y=%.2f, Z=%.2f\n", 
+                            physicalX, physicalY, physicalZ);
                          
             // Z should be close to 9.81 (gravity) when flat
             float zError = abs(physicalZ - 9.81f);
             if (zError < 1.0f) {
-                Serial.println("Z-axis calibration looks good (close to 9.81 m/s²)");
+                SerialOut.println("Z-axis calibration looks good (close to 9.81 m/s²)");
             } else {
-                Serial.printf("Z-axis may need adjustment (error: %.2f m/s²)\n", zError);
+                SerialOut.printf("Z-axis may need adjustment (error: %.2f m/s²)\n", zError);
             }
         }
     }
     
-    Serial.println("======================================\n");
+    SerialOut.println("======================================\n");
+    return true;
+}
+
+void MPU9250Interface::setOffsets(const int16_t accel[3], const int16_t gyro[3]) {
+    accelOffsetX = accel[0];
+    accelOffsetY = accel[1];
+    accelOffsetZ = accel[2];
+    gyroOffsetX = gyro[0];
+    gyroOffsetY = gyro[1];
+    gyroOffsetZ = gyro[2];
+}
+
+void MPU9250Interface::getOffsets(int16_t accel[3], int16_t gyro[3]) const {
+    accel[0] = accelOffsetX;
+    accel[1] = accelOffsetY;
+    accel[2] = accelOffsetZ;
+    gyro[0] = gyroOffsetX;
+    gyro[1] = gyroOffsetY;
+    gyro[2] = gyroOffsetZ;
+}
+
+bool MPU9250Interface::readTemperature(float& celsius) {
+    uint8_t buffer[2];
+    if (!readRegisters(TEMP_OUT_H_REG, buffer, 2)) {
+        return false;
+    }
+    int16_t raw = (int16_t)((buffer[0] << 8) | buffer[1]);
+    
+    // MPU6050 and the MPU6500/9250 family scale the die temperature differently
+    if (whoAmI == 0x68) {
+        celsius = raw / 340.0f + 36.53f;
+    } else {
+        celsius = raw / 333.87f + 21.0f;
+    }
     return true;
 }
 
@@ -403,7 +469,7 @@ bool MPU9250Interface::writeRegister(uint8_t reg, uint8_t value) {
     byte result = Wire.endTransmission(true);
     
     if (result != 0) {
-        Serial.printf("Error writing to register 0x%02X: %d\n", reg, result);
+        SerialOut.printf("Error writing to register 0x%02X: %d\n", reg, result);
         return false;
     }
     return true;
@@ -415,7 +481,7 @@ uint8_t MPU9250Interface::readRegister(uint8_t reg) {
     byte result = Wire.endTransmission(false);
     
     if (result != 0) {
-        Serial.printf("Error setting register 0x%02X for reading: %d\n", reg, result);
+        SerialOut.printf("Error setting register 0x%02X for reading: %d\n", reg, result);
         return 0;
     }
     
@@ -437,13 +503,13 @@ bool MPU9250Interface::readRegisters(uint8_t reg, uint8_t* buffer, uint8_t count
     byte result = Wire.endTransmission(false);  // Send repeated start
     
     if (result != 0) {
-        Serial.printf("Error setting start register 0x%02X for reading: %d\n", reg, result);
+        SerialOut.printf("Error setting start register 0x%02X for reading: %d\n", reg, result);
         return false;
     }
     
     uint8_t bytesReceived = Wire.requestFrom(sensorAddress, count);
     if (bytesReceived != count) {
-        Serial.printf("Requested %d bytes but received %d\n", count, bytesReceived);
+        SerialOut.printf("Requested %d bytes but received %d\n", count, bytesReceived);
         return false;
     }
     
@@ -451,7 +517,7 @@ bool MPU9250Interface::readRegisters(uint8_t reg, uint8_t* buffer, uint8_t count
         if (Wire.available()) {
             buffer[i] = Wire.read();
         } else {
-            Serial.println("Error: Wire data ended early");
+            SerialOut.println("Error: Wire data ended early");
             return false;
         }
     }
@@ -467,14 +533,14 @@ bool MPU9250Interface::isConnected() {
     uint8_t error = Wire.endTransmission(false);
     
     if (error != 0) {
-        Serial.printf("I2C error during isConnected check: %d\n", error);
+        SerialOut.printf("I2C error during isConnected check: %d\n", error);
         
         // Try the alternative address if the first one fails
         if (sensorAddress == MPU9250_ADDRESS_AD0_LOW) {
-            Serial.println("Trying alternative I2C address 0x69");
+            SerialOut.println("Trying alternative I2C address 0x69");
             sensorAddress = MPU9250_ADDRESS_AD0_HIGH;
         } else {
-            Serial.println("Trying standard I2C address 0x68");
+            SerialOut.println("Trying standard I2C address 0x68");
             sensorAddress = MPU9250_ADDRESS_AD0_LOW;
         }
         
@@ -484,10 +550,10 @@ bool MPU9250Interface::isConnected() {
         error = Wire.endTransmission(false);
         
         if (error != 0) {
-            Serial.println("Device not responding on either address");
+            SerialOut.println("Device not responding on either address");
             return false;
         } else {
-            Serial.printf("Device found at alternative address 0x%02X\n", sensorAddress);
+            SerialOut.printf("Device found at alternative address 0x%02X\n", sensorAddress);
         }
     }
     
@@ -502,24 +568,24 @@ bool MPU9250Interface::verifyConnection() {
     }
     
     // Read WHO_AM_I register value
-    uint8_t whoAmI = readRegister(WHO_AM_I_REG);
+    whoAmI = readRegister(WHO_AM_I_REG);
     
     // Verify the register value matches expected values for MPU6050/MPU9250
     // MPU6050: 0x68, MPU9250: 0x71 or 0x73, MPU6000: 0x70
     if (whoAmI == 0x68 || whoAmI == 0x71 || whoAmI == 0x73 || whoAmI == 0x70) {
-        Serial.printf("WHO_AM_I register returned valid value: 0x%02X\n", whoAmI);
+        SerialOut.printf("WHO_AM_I register returned valid value: 0x%02X\n", whoAmI);
         return true;
     } else {
-        Serial.printf("WHO_AM_I register returned unknown value: 0x%02X\n", whoAmI);
+        SerialOut.printf("WHO_AM_I register returned unknown value: 0x%02X\n", whoAmI);
         return false;
     }
 }
 
 bool MPU9250Interface::resetDevice() {
     // Write the reset bit to PWR_MGMT_1 register
-    Serial.println("Resetting MPU sensor...");
+    SerialOut.println("Resetting MPU sensor...");
     if (!writeRegister(PWR_MGMT_1_REG, 0x80)) {
-        Serial.println("Failed to reset device");
+        SerialOut.println("Failed to reset device");
         return false;
     }
     
@@ -528,13 +594,13 @@ bool MPU9250Interface::resetDevice() {
     
     // Verify the device is responsive after reset
     if (!isConnected()) {
-        Serial.println("Device not responding after reset");
+        SerialOut.println("Device not responding after reset");
         return false;
     }
     
     // Wake up the sensor
     if (!writeRegister(PWR_MGMT_1_REG, 0x01)) {
-        Serial.println("Failed to wake up device after reset");
+        SerialOut.println("Failed to wake up device after reset");
         return false;
     }
     
@@ -542,11 +608,11 @@ bool MPU9250Interface::resetDevice() {
 }
 
 bool MPU9250Interface::recoverFromError() {
-    Serial.println("Attempting to recover MPU sensor from error state...");
+    SerialOut.println("Attempting to recover MPU sensor from error state...");
     
     // Try basic reset first
     if (!resetDevice()) {
-        Serial.println("Basic reset failed");
+        SerialOut.println("Basic reset failed");
         
         // Try re-initializing I2C
         Wire.end();
@@ -557,14 +623,14 @@ bool MPU9250Interface::recoverFromError() {
         
         // Try reset again
         if (!resetDevice()) {
-            Serial.println("Re-initialization failed, recovery unsuccessful");
+            SerialOut.println("Re-initialization failed, recovery unsuccessful");
             return false;
         }
     }
     
     // Reset successful, try to re-initialize the device
     if (!init()) {
-        Serial.println("Re-initialization failed after reset");
+        SerialOut.println("Re-initialization failed after reset");
         return false;
     }
     
@@ -573,53 +639,53 @@ bool MPU9250Interface::recoverFromError() {
     identicalReadings = 0;
     lastReadValid = true;
     
-    Serial.println("MPU recovery successful");
+    SerialOut.println("MPU recovery successful");
     return true;
 }
 
 bool MPU9250Interface::runDiagnostics() {
-    Serial.println("Running MPU sensor diagnostics...");
+    SerialOut.println("Running MPU sensor diagnostics...");
     
     // Check 1: Verify I2C connection
     if (!isConnected()) {
-        Serial.println("Diagnostic failed: Device not responding on I2C");
+        SerialOut.println("Diagnostic failed: Device not responding on I2C");
         return false;
     }
     
     // Check 2: Verify device identity
     if (!verifyConnection()) {
-        Serial.println("Diagnostic failed: Device identity check failed");
+        SerialOut.println("Diagnostic failed: Device identity check failed");
         return false;
     }
     
     // Check 3: Verify sensor data reading
     SensorData testData;
     if (!readSensorData(&testData)) {
-        Serial.println("Diagnostic failed: Cannot read sensor data");
+        SerialOut.println("Diagnostic failed: Cannot read sensor data");
         return false;
     }
     
     // Check 4: Verify data validation
     if (!validateSensorData(testData)) {
-        Serial.println("Diagnostic failed: Sensor data validation failed");
+        SerialOut.println("Diagnostic failed: Sensor data validation failed");
         return false;
     }
     
     // Check 5: Test register write and read
     uint8_t testValue = 0x03;  // DLPF setting
     if (!writeRegister(CONFIG_REG, testValue)) {
-        Serial.println("Diagnostic failed: Cannot write to registers");
+        SerialOut.println("Diagnostic failed: Cannot write to registers");
         return false;
     }
     
     uint8_t readValue = readRegister(CONFIG_REG);
     if (readValue != testValue) {
-        Serial.printf("Diagnostic failed: Register read/write mismatch (wrote 0x%02X, read 0x%02X)\n",
-                     testValue, readValue);
+        SerialOut.printf("Diagnostic failed: Register read/write mismatch (wrote 0x%02X, read 0x%02X)\n",
+                        testValue, readValue);
         return false;
     }
     
-    Serial.println("All MPU sensor diagnostics passed successfully");
+    SerialOut.println("All MPU sensor diagnostics passed successfully");
     return true;
 }
 
@@ -701,7 +767,9 @@ bool MPU9250Interface::validateSensorData(const SensorData& data) {
         abs(data.gyroY) > MAX_GYRO_VALUE || 
         abs(data.gyroZ) > MAX_GYRO_VALUE) {
         
-        Serial.println("Error: Sensor values exceed maximum possible range");
+        #if DIAG_LOGGING_ENABLED
+        DIAG_LOG_RATE(DIAG_LEVEL_ERROR, DIAG_TAG_SENSOR, 1, 5, "Sensor values exceed maximum possible range");
+        #endif
         errorCount++;
         lastReadValid = false;
         return false;
@@ -721,7 +789,9 @@ bool MPU9250Interface::validateSensorData(const SensorData& data) {
             identicalReadings++;
             
             if (identicalReadings > MAX_CONSECUTIVE_IDENTICAL) {
-                Serial.println("Warning: Too many identical consecutive readings");
+                #if DIAG_LOGGING_ENABLED
+                DIAG_LOG_RATE(DIAG_LEVEL_WARNING, DIAG_TAG_SENSOR, 1, 5, "Too many identical consecutive readings");
+                #endif
                 errorCount++;
                 lastReadValid = false;
                 return false;
@@ -747,8 +817,10 @@ bool MPU9250Interface::validateSensorData(const SensorData& data) {
         
         if (!hasVariation) {
             // No variation is suspicious but might be valid if device is stationary
-            // Just log a warning but don't invalidate
-            Serial.println("Note: Low variation in accelerometer readings");
+            // Just log a note but don't invalidate; at rest this holds every frame
+            #if DIAG_LOGGING_ENABLED
+            DIAG_LOG_RATE(DIAG_LEVEL_DEBUG, DIAG_TAG_SENSOR, 1, 1, "Low variation in accelerometer readings");
+            #endif
         }
     }
     
@@ -8,12 +8,14 @@
 #define WHO_AM_I_REG       0x75  // Device identity register
 #define PWR_MGMT_1_REG     0x6B  // Power management register
 #define ACCEL_XOUT_H_REG   0x3B  // First accelerometer data register
+#define TEMP_OUT_H_REG     0x41  // Die temperature register
 #define GYRO_XOUT_H_REG    0x43  // First gyroscope data register
 #define CONFIG_REG         0x1A  // Configuration register
 #define GYRO_CONFIG_REG    0x1B  // Gyroscope configuration register
 #define ACCEL_CONFIG_REG   0x1C  // Accelerometer configuration register
 #define SMPLRT_DIV_REG     0x19  // Sample rate divider register
 #define INT_ENABLE_REG     0x38  // Interrupt enable register
+#define INT_STATUS_REG     0x3A  // Interrupt status register (bit 0: data ready)
 
 // MPU9250/MPU6050 I2C addresses
 #define MPU9250_ADDRESS_AD0_LOW  0x68  // Default address when AD0 is grounded
@@ -22,6 +24,9 @@
 // Default to AD0_LOW unless changed through setAddress()
 #define MPU9250_ADDRESS MPU9250_ADDRESS_AD0_LOW
 
+// Accelerometer counts per g at the ±4g range init() selects
+#define MPU_ACCEL_LSB_PER_G 8192
+
 // Number of samples for filtering
 #define FILTER_SAMPLE_COUNT 5
 
@@ -105,6 +110,37 @@ public:
    */
   bool calibrate();
   
+  /**
+   * @brief Whether the last calibrate() saw a working sensor held still
+   * @return True if its offsets are worth keeping
+   */
+  bool wasCalibrationGood() const { return calibrationGood; }
+  
+  /**
+   * @brief Use bias offsets from an earlier calibration instead of calibrate()
+   * @param accel Accelerometer offsets X, Y, Z in raw counts
+   * @param gyro Gyroscope offsets X, Y, Z in raw counts
+   */
+  void setOffsets(const int16_t accel[3], const int16_t gyro[3]);
+  
+  /**
+   * @brief Copy out the bias offsets in use
+   */
+  void getOffsets(int16_t accel[3], int16_t gyro[3]) const;
+  
+  /**
+   * @brief WHO_AM_I value read by init()
+   * @return Sensor identity, 0 before init()
+   */
+  uint8_t getWhoAmI() const { return whoAmI; }
+  
+  /**
+   * @brief Read the die temperature
+   * @param celsius Output temperature in degrees C
+   * @return True if the read succeeded
+   */
+  bool readTemperature(float& celsius);
+  
   /**
    * @brief Check if the sensor is connected
    * @return True if connected
@@ -147,6 +183,10 @@ private:
   int16_t gyroOffsetY = 0;
   int16_t gyroOffsetZ = 0;
   
+  // Sensor identity and the verdict on the last calibration
+  uint8_t whoAmI = 0;
+  bool calibrationGood = false;
+  
   // Filtering data
   SensorData filterSamples[FILTER_SAMPLE_COUNT];
   uint8_t filterIndex = 0;
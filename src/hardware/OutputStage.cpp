@@ -0,0 +1,4 @@
+#include "OutputStage.h"
+
+// Storage for the gamma table; the values live in the header so they stay usable at compile time
+constexpr uint16_t OutputGamma::TABLE[256];
@@ -0,0 +1,147 @@
+#ifndef OUTPUT_STAGE_H
+#define OUTPUT_STAGE_H
+
+#include <stdint.h>
+#include <FastLED.h>
+#include "../core/SystemTypes.h"
+#include "../core/Config.h"
+
+/**
+ * @brief 8-bit color to 16-bit linear light, gamma 2.5
+ *
+ * TABLE[i] = round(65535 * (i / 255)^2.5). The low end gets most of the
+ * 16-bit range, which is what keeps dim fades smooth once dithered.
+ */
+struct OutputGamma {
+  static constexpr uint16_t TABLE[256] = {
+        0,     0,     0,     1,     2,     4,     6,     8,
+       11,    15,    20,    25,    31,    38,    46,    55,
+       65,    75,    87,    99,   113,   128,   143,   160,
+      178,   197,   218,   239,   262,   286,   311,   338,
+      366,   395,   425,   457,   491,   526,   562,   599,
+      639,   679,   722,   765,   811,   857,   906,   956,
+     1007,  1061,  1116,  1172,  1231,  1291,  1352,  1416,
+     1481,  1548,  1617,  1688,  1760,  1834,  1910,  1988,
+     2068,  2150,  2233,  2319,  2407,  2496,  2587,  2681,
+     2776,  2874,  2973,  3075,  3178,  3284,  3391,  3501,
+     3613,  3727,  3843,  3961,  4082,  4204,  4329,  4456,
+     4585,  4716,  4850,  4986,  5124,  5264,  5407,  5552,
+     5699,  5849,  6001,  6155,  6311,  6470,  6632,  6795,
+     6962,  7130,  7301,  7475,  7650,  7829,  8009,  8193,
+     8379,  8567,  8758,  8951,  9147,  9345,  9546,  9750,
+     9956, 10165, 10376, 10590, 10806, 11025, 11247, 11472,
+    11699, 11929, 12161, 12397, 12634, 12875, 13119, 13365,
+    13614, 13865, 14120, 14377, 14637, 14899, 15165, 15433,
+    15705, 15979, 16256, 16535, 16818, 17104, 17392, 17683,
+    17978, 18275, 18575, 18878, 19184, 19493, 19805, 20119,
+    20437, 20758, 21082, 21409, 21739, 22072, 22407, 22746,
+    23089, 23434, 23782, 24133, 24487, 24845, 25206, 25569,
+    25936, 26306, 26679, 27055, 27435, 27818, 28203, 28592,
+    28985, 29380, 29779, 30181, 30586, 30994, 31406, 31820,
+    32239, 32660, 33085, 33513, 33944, 34379, 34817, 35258,
+    35702, 36150, 36602, 37056, 37514, 37976, 38441, 38909,
+    39380, 39856, 40334, 40816, 41301, 41790, 42282, 42778,
+    43277, 43780, 44286, 44795, 45308, 45825, 46345, 46869,
+    47396, 47927, 48461, 48999, 49540, 50085, 50634, 51186,
+    51742, 52301, 52864, 53431, 54001, 54575, 55153, 55734,
+    56318, 56907, 57499, 58095, 58695, 59298, 59905, 60515,
+    61130, 61748, 62370, 62995, 63624, 64258, 64894, 65535
+  };
+};
+
+static_assert(OutputGamma::TABLE[0] == 0 && OutputGamma::TABLE[255] == 65535, "gamma table must span the full range");
+
+/**
+ * @brief Final per-frame stage between the frame buffer and the LED wire
+ *
+ * Each channel goes through the gamma table and the global brightness in
+ * 16 bits, and is then reduced to 8 bits with temporal dithering: the
+ * fraction dropped in one frame is carried into the next, so over a few
+ * frames the LED shows the 16-bit level on average. This replaces
+ * FastLED's brightness scaling, which throws away most of the color
+ * resolution at low brightness.
+ *
+ * Cost is one table read, one multiply and one add per channel, linear in
+ * the LED count.
+ *
+ * @tparam LED_COUNT Number of LEDs in a frame
+ */
+template <uint16_t LED_COUNT>
+class BasicOutputStage {
+public:
+  BasicOutputStage() : dithering_(false) {
+    for (uint16_t i = 0; i < LED_COUNT * 3; i++) {
+      residue_[i] = 0;
+    }
+  }
+
+  /**
+   * @brief Sum of all channel levels of a frame, for the power model
+   * @param in LED_COUNT colors as rendered
+   * @param brightness Global brightness (0-255)
+   * @return Sum of 8.8 fixed-point levels (0xFF00 per fully lit channel)
+   */
+  static uint32_t measure(const Color* in, uint8_t brightness) {
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+      sum += level(in[i].r, brightness) + level(in[i].g, brightness) + level(in[i].b, brightness);
+    }
+    return sum;
+  }
+
+  /**
+   * @brief Convert one frame for the wire
+   * @param in LED_COUNT colors as rendered
+   * @param brightness Global brightness (0-255)
+   * @param out LED_COUNT colors to send at full FastLED brightness
+   * @param limit Extra scale from the power limiter (255 = none), applied in 16 bits
+   */
+  void render(const Color* in, uint8_t brightness, CRGB* out, uint8_t limit = 255) {
+    uint8_t fraction = 0;
+    uint8_t* residue = residue_;
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+      out[i].r = channel(in[i].r, brightness, limit, *residue++, fraction);
+      out[i].g = channel(in[i].g, brightness, limit, *residue++, fraction);
+      out[i].b = channel(in[i].b, brightness, limit, *residue++, fraction);
+    }
+    dithering_ = Config::LED_TEMPORAL_DITHER && fraction != 0;
+  }
+
+  /**
+   * @brief True if the last frame had sub-8-bit levels that need refreshing at display rate
+   */
+  bool isDithering() const { return dithering_; }
+
+  /**
+   * @brief Output level of a channel after gamma and brightness
+   * @return 8.8 fixed point, 0 to 0xFF00 (255.0)
+   */
+  static uint16_t level(uint8_t value, uint8_t brightness) {
+    uint16_t linear = Config::LED_GAMMA_CORRECTION ? OutputGamma::TABLE[value] : (uint16_t)(value * 257);
+    uint16_t scaled = (uint16_t)(((uint32_t)linear * (brightness + 1)) >> 8);
+    return scaled - (scaled >> 8);
+  }
+
+private:
+  uint8_t residue_[LED_COUNT * 3];
+  bool dithering_;
+
+  static uint8_t channel(uint8_t value, uint8_t brightness, uint8_t limit, uint8_t& residue, uint8_t& fraction) {
+    uint16_t target = level(value, brightness);
+    if (limit != 255) {
+      target = (uint16_t)(((uint32_t)target * (limit + 1)) >> 8);
+    }
+    fraction |= (uint8_t)target;
+    if (!Config::LED_TEMPORAL_DITHER) {
+      return (uint8_t)(((uint32_t)target + 128) >> 8);
+    }
+    // Carry the dropped fraction into the next frame
+    uint16_t sum = target + residue;
+    residue = (uint8_t)sum;
+    return (uint8_t)(sum >> 8);
+  }
+};
+
+typedef BasicOutputStage<Config::NUM_LEDS> OutputStage;
+
+#endif // OUTPUT_STAGE_H
@@ -1,6 +1,7 @@
 #include "PowerManager.h"
 #include "../core/Config.h"
 #include "../utils/DebugTools.h"
+#include "SerialTx.h"
 #include <Arduino.h>
 #include <esp_sleep.h>
 #include <esp_wifi.h>
@@ -97,7 +98,7 @@ void PowerManager::sleep(uint32_t durationMs) {
     setPowerState(POWER_SLEEP);
     
     // Flush any pending serial output
-    Serial.flush();
+    SerialOut.flush();
     
     if (durationMs > 0) {
         // Set wakeup timer if duration is specified
@@ -0,0 +1,154 @@
+#include "SerialTx.h"
+
+static_assert((SERIAL_TX_BUFFER_SIZE & (SERIAL_TX_BUFFER_SIZE - 1)) == 0, "SERIAL_TX_BUFFER_SIZE must be a power of two");
+
+static const size_t TX_MASK = SERIAL_TX_BUFFER_SIZE - 1;
+
+// Room kept behind text that does not end a line, for the "\r\n" println() sends after it
+static const size_t LINE_END_RESERVE = 2;
+
+// Last byte of a whole line or telemetry frame
+static bool endsLine(const uint8_t* data, size_t length) {
+  return length > 0 && (data[length - 1] == '\n' || data[length - 1] == 0);
+}
+
+// Only a line terminator, as println() writes it after the text
+static bool isLineEnd(const uint8_t* data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    if (data[i] != '\r' && data[i] != '\n') {
+      return false;
+    }
+  }
+  return length > 0;
+}
+
+SerialTx SerialOut(Serial);
+
+SerialTx::SerialTx(Print& sink)
+  : sink_(sink), head_(0), count_(0), buffered_(false), lineOpen_(false), lineDropped_(false),
+    policy_(SERIAL_TX_POLICY) {
+  resetStats();
+}
+
+void SerialTx::setBuffered(bool buffered) {
+  if (!buffered && buffered_) {
+    flush();
+  }
+  buffered_ = buffered;
+}
+
+size_t SerialTx::write(uint8_t byte) {
+  return write(&byte, 1);
+}
+
+size_t SerialTx::write(const uint8_t* data, size_t length) {
+  if (!buffered_) {
+    size_t written = sink_.write(data, length);
+    stats_.bytesWritten += written;
+    return written;
+  }
+
+  if (policy_ == SERIAL_TX_DROP_NEWEST) {
+    // println() writes the text and its terminator separately; they go
+    // together, so the terminator of a dropped line is dropped as well
+    if (lineDropped_ && !lineOpen_ && isLineEnd(data, length)) {
+      lineDropped_ = false;
+      stats_.bytesDropped += length;
+      return 0;
+    }
+    // and text that leaves a line open is only queued if its terminator fits after it
+    size_t needed = endsLine(data, length) ? length : length + LINE_END_RESERVE;
+    if (needed > SERIAL_TX_BUFFER_SIZE - count_) {
+      // A partial line or frame is worse than none
+      lineDropped_ = !endsLine(data, length);
+      stats_.bytesDropped += length;
+      return 0;
+    }
+  } else if (length > SERIAL_TX_BUFFER_SIZE - count_) {
+    if (length > SERIAL_TX_BUFFER_SIZE) {
+      stats_.bytesDropped += length;
+      return 0;
+    }
+    dropOldest(length - (SERIAL_TX_BUFFER_SIZE - count_));
+  }
+  lineDropped_ = false;
+  lineOpen_ = !endsLine(data, length);
+  enqueue(data, length);
+  return length;
+}
+
+int SerialTx::availableForWrite() {
+  if (!buffered_) {
+    return sink_.availableForWrite();
+  }
+  return (int)(SERIAL_TX_BUFFER_SIZE - count_);
+}
+
+void SerialTx::flush() {
+  while (count_ > 0) {
+    size_t chunk = min(count_, SERIAL_TX_BUFFER_SIZE - head_);
+    size_t written = sink_.write(&buffer_[head_], chunk);
+    stats_.bytesWritten += written;
+    head_ = (head_ + written) & TX_MASK;
+    count_ -= written;
+    if (written == 0) {
+      // The sink refused the bytes; don't spin on them
+      stats_.bytesDropped += count_;
+      count_ = 0;
+    }
+  }
+  sink_.flush();
+}
+
+size_t SerialTx::drain() {
+  size_t moved = 0;
+  while (count_ > 0) {
+    int room = sink_.availableForWrite();
+    if (room <= 0) {
+      break;
+    }
+    size_t chunk = min(min(count_, SERIAL_TX_BUFFER_SIZE - head_), (size_t)room);
+    size_t written = sink_.write(&buffer_[head_], chunk);
+    head_ = (head_ + written) & TX_MASK;
+    count_ -= written;
+    moved += written;
+    if (written < chunk) {
+      break;
+    }
+  }
+  stats_.bytesWritten += moved;
+  return moved;
+}
+
+void SerialTx::resetStats() {
+  stats_.bytesWritten = 0;
+  stats_.bytesDropped = 0;
+  stats_.maxDepth = (uint16_t)count_;
+}
+
+void SerialTx::enqueue(const uint8_t* data, size_t length) {
+  size_t tail = (head_ + count_) & TX_MASK;
+  size_t first = min(length, SERIAL_TX_BUFFER_SIZE - tail);
+  memcpy(&buffer_[tail], data, first);
+  memcpy(buffer_, data + first, length - first);
+  count_ += length;
+  if (count_ > stats_.maxDepth) {
+    stats_.maxDepth = (uint16_t)min(count_, (size_t)UINT16_MAX);
+  }
+}
+
+void SerialTx::dropOldest(size_t needed) {
+  // Discard at least needed bytes, then up to the end of that line ('\n') or
+  // telemetry frame (0x00) so the next byte out starts a whole one
+  size_t dropped = needed;
+  while (dropped < count_) {
+    uint8_t last = buffer_[(head_ + dropped - 1) & TX_MASK];
+    if (last == '\n' || last == 0) {
+      break;
+    }
+    dropped++;
+  }
+  head_ = (head_ + dropped) & TX_MASK;
+  count_ -= dropped;
+  stats_.bytesDropped += dropped;
+}
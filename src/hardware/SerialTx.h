@@ -0,0 +1,102 @@
+#ifndef SERIAL_TX_H
+#define SERIAL_TX_H
+
+#include <Arduino.h>
+
+// Bytes queued for the UART (a power of two)
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE 2048
+#endif
+
+// What a write that does not fit gives up: SERIAL_TX_DROP_NEWEST or SERIAL_TX_DROP_OLDEST
+#define SERIAL_TX_DROP_NEWEST 0
+#define SERIAL_TX_DROP_OLDEST 1
+#ifndef SERIAL_TX_POLICY
+#define SERIAL_TX_POLICY SERIAL_TX_DROP_NEWEST
+#endif
+
+/**
+ * @brief Cumulative serial output counters
+ */
+struct SerialTxStats {
+  uint32_t bytesWritten;  // Handed to the UART
+  uint32_t bytesDropped;  // Lost to a full ring
+  uint16_t maxDepth;      // Most bytes queued at once
+};
+
+/**
+ * @brief Non-blocking serial output through a ring buffer
+ *
+ * While buffered, writes only copy into the ring and never wait for the
+ * UART; drain() moves as much as the UART TX FIFO takes without blocking
+ * and runs from the idle part of the loop. A write that does not fit is
+ * dropped whole (SERIAL_TX_DROP_NEWEST), or makes room by discarding the
+ * oldest queued lines or frames (SERIAL_TX_DROP_OLDEST), so output never
+ * stalls the loop. Dropping the newest keeps println()'s text and
+ * terminator together, though Print sends them as two writes. While not buffered (the default, for setup() and CLI
+ * commands) writes go straight to the UART as before.
+ *
+ * Written from the loop task only.
+ */
+class SerialTx : public Print {
+public:
+  explicit SerialTx(Print& sink);
+
+  /**
+   * @brief Switch buffering on or off
+   *
+   * Switching off first sends everything queued, blocking until it is out.
+   */
+  void setBuffered(bool buffered);
+  bool isBuffered() const { return buffered_; }
+
+  void setPolicy(uint8_t policy) { policy_ = policy; }
+  uint8_t getPolicy() const { return policy_; }
+
+  size_t write(uint8_t byte) override;
+  size_t write(const uint8_t* data, size_t length) override;
+  using Print::write;
+
+  /**
+   * @brief Bytes a write can take without dropping anything
+   */
+  int availableForWrite() override;
+
+  /**
+   * @brief Send everything queued, blocking until the UART has sent it
+   */
+  void flush() override;
+
+  /**
+   * @brief Move queued bytes to the UART as far as its TX FIFO has room
+   * @return Bytes moved
+   */
+  size_t drain();
+
+  /**
+   * @brief Bytes queued
+   */
+  size_t pending() const { return count_; }
+
+  const SerialTxStats& getStats() const { return stats_; }
+  void resetStats();
+
+private:
+  void enqueue(const uint8_t* data, size_t length);
+  void dropOldest(size_t needed);
+
+  Print& sink_;
+  uint8_t buffer_[SERIAL_TX_BUFFER_SIZE];
+  size_t head_;           // Oldest queued byte
+  size_t count_;
+  bool buffered_;
+  bool lineOpen_;         // The last queued write did not end a line
+  bool lineDropped_;      // The last write was dropped part way through a line
+  uint8_t policy_;
+  SerialTxStats stats_;
+};
+
+// All debug and telemetry output of the firmware goes through SerialOut
+extern SerialTx SerialOut;
+
+#endif // SERIAL_TX_H
@@ -4,6 +4,10 @@
 #include "diagnostics/StateSnapshotCapture.h"
 #include "diagnostics/VisualDebugIndicator.h"
 #include "diagnostics/CommandLineInterface.h"
+#include "diagnostics/TelemetryStream.h"
+#include "diagnostics/FlightRecorder.h"
+#include "hardware/SerialTx.h"
+#include "core/BootSequence.h"
 
 // Serial communication
 #define SERIAL_BAUD_RATE 115200
@@ -22,39 +26,51 @@ const char* positionNames[] = {
   "Unknown (White)"  // POS_UNKNOWN
 };
 
-// Increase Arduino loop task stack size
-#if CONFIG_ARDUINO_LOOP_STACK_SIZE < 16384
-#undef CONFIG_ARDUINO_LOOP_STACK_SIZE
-#define CONFIG_ARDUINO_LOOP_STACK_SIZE 16384
+// Increase Arduino loop task stack size. Redefining CONFIG_ARDUINO_LOOP_STACK_SIZE
+// here has no effect (the core creates the task); 'dump memory' shows the result
+#ifdef SET_LOOP_TASK_STACK_SIZE
+SET_LOOP_TASK_STACK_SIZE(16 * 1024);
 #endif
 
 // Global GauntletController instance
 GauntletController gauntletController;
 
+// LUTT components; nothing in the first frame needs them, so they start right after it
+static void initDiagnostics(void*) {
+  StateSnapshotCapture::init();
+  // Get HardwareManager pointer from GauntletController
+  VisualDebugIndicator::init(gauntletController.getHardwareManager());
+  CommandLineInterface::init();
+}
+
 void setup() {
-  // Initialize serial communication
+  // Initialize serial communication; no settle delay, the UART is ready at once
   Serial.begin(SERIAL_BAUD_RATE);
-  delay(1000);
+  BootSequence::mark("serial");
+  
+  SerialOut.println(F("\n\n=== PrismaTech Gauntlet 3.0 ==="));
+  SerialOut.println("Ultra Basic Position Detection System");
   
-  Serial.println(F("\n\n=== PrismaTech Gauntlet 3.0 ==="));
-  Serial.println("Ultra Basic Position Detection System");
+  // Save the flight log of a run that crashed before recording this one
+  FlightRecorder::begin();
+  BootSequence::mark("flight recorder");
   
   // Initialize the GauntletController
-  // This handles initialization of HardwareManager, PositionDetector, and all modes
+  // This handles initialization of HardwareManager, PositionDetector, and all modes;
+  // each step is timed, and the boot report follows the first frame
   gauntletController.initialize(); 
 
-  // Initialize LUTT components if enabled
   DiagnosticLogger::setEnabled(true);
-  StateSnapshotCapture::init();
-  // Get HardwareManager pointer from GauntletController
-  VisualDebugIndicator::init(gauntletController.getHardwareManager());
-  CommandLineInterface::init();
+  BootSequence::defer("diagnostics", initDiagnostics, nullptr);
   
   DIAG_LOG(DIAG_LEVEL_INFO, DIAG_TAG_MODE, "System initialized successfully");
 
   // Optional: Add a ready indicator if desired (handled by controller init potentially)
-  Serial.println(F("\nGauntlet ready."));
-  Serial.println(F("------------------------------------------------------"));
+  SerialOut.println(F("\nGauntlet ready."));
+  SerialOut.println(F("------------------------------------------------------"));
+
+  // From here on output is queued and sent while the loop waits, so it never blocks a tick
+  SerialOut.setBuffered(true);
 }
 
 void loop() {
@@ -66,5 +82,11 @@ void loop() {
   VisualDebugIndicator::process();
   CommandLineInterface::process();
 
+  // Print recorded log entries, only as far as the serial TX ring allows;
+  // they wait in the trace ring while the telemetry stream has the link
+  if (!TelemetryStream::isActive()) {
+    DiagnosticLogger::drain();
+  }
+
   // No delay needed here, controller's maintainLoopTiming handles it
 }
\ No newline at end of file
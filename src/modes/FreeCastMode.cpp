@@ -1,6 +1,13 @@
 #include "FreeCastMode.h"
 #include "../core/Config.h"
 #include "../core/SystemTypes.h"
+#include "../animation/ColorEngine.h"
+#include "../hardware/SerialTx.h"
+
+// LUTT Diagnostic includes (conditionally compiled)
+#if DIAG_LOGGING_ENABLED
+#include "../diagnostics/DiagnosticLogger.h"
+#endif
 
 // Constructor - initialize all member variables to default values
 FreeCastMode::FreeCastMode() 
@@ -22,11 +29,11 @@ FreeCastMode::FreeCastMode()
       currentPosition({POS_UNKNOWN, 0, 0})
 {
     // Initialize color palette with position colors
-    patternColors[0] = CRGB(255, 0, 0);       // Red (Null position)
-    patternColors[1] = CRGB(0, 255, 0);       // Green (Dig position)
-    patternColors[2] = CRGB(255, 105, 180);   // Pink (Shield position)
-    patternColors[3] = CRGB(128, 0, 255);     // Purple (Offer position)
-    patternColors[4] = CRGB(255, 255, 0);     // Yellow (Oath position)
+    patternColors[0] = {255, 0, 0};       // Red (Null position)
+    patternColors[1] = {0, 255, 0};       // Green (Dig position)
+    patternColors[2] = {255, 105, 180};   // Pink (Shield position)
+    patternColors[3] = {128, 0, 255};     // Purple (Offer position)
+    patternColors[4] = {255, 255, 0};     // Yellow (Oath position)
 }
 
 // Initialize with dependencies
@@ -73,7 +80,7 @@ void FreeCastMode::initialize() {
     generateColorPalette();
     
     #ifdef DEBUG_MODE
-    Serial.println(F("FreeCast Mode initialized"));
+    SerialOut.println(F("FreeCast Mode initialized"));
     #endif
 }
 
@@ -99,14 +106,14 @@ ModeTransition FreeCastMode::update() {
         if (!inShieldCountdown && currentTime - shieldPositionStartTime >= Config::LONGSHIELD_WARNING_MS) {
             inShieldCountdown = true;
             #ifdef DEBUG_MODE
-            Serial.println(F("FreeCast Mode: Shield countdown started"));
+            SerialOut.println(F("FreeCast Mode: Shield countdown started"));
             #endif
         }
         
         // Check if LongShield gesture is complete to exit FreeCast mode
         if (inShieldCountdown && currentTime - shieldPositionStartTime >= Config::LONGSHIELD_TIME_MS) {
             #ifdef DEBUG_MODE
-            Serial.println(F("FreeCast Mode: LongShield detected! Exiting."));
+            SerialOut.println(F("FreeCast Mode: LongShield detected! Exiting."));
             #endif
             initialize(); // Reset state before exiting
             return ModeTransition::TO_IDLE;
@@ -116,7 +123,7 @@ ModeTransition FreeCastMode::update() {
         // Reset SHIELD tracking when position changes
         if (shieldPositionStartTime != 0) { // Only print/reset if it was active
             #ifdef DEBUG_MODE
-            if (inShieldCountdown) Serial.println(F("FreeCast Mode: Shield countdown aborted"));
+            if (inShieldCountdown) SerialOut.println(F("FreeCast Mode: Shield countdown aborted"));
             #endif
             shieldPositionStartTime = 0;
             inShieldCountdown = false;
@@ -133,7 +140,7 @@ ModeTransition FreeCastMode::update() {
                 currentState = FreeCastState::RECORDING;
                 phaseStartTime = currentTime;
                 #ifdef DEBUG_MODE
-                Serial.println(F("FreeCast Mode: Transition to Recording phase"));
+                SerialOut.println(F("FreeCast Mode: Transition to Recording phase"));
                 #endif
             }
             break;
@@ -152,28 +159,30 @@ ModeTransition FreeCastMode::update() {
                 currentState = FreeCastState::DISPLAYING;
                 phaseStartTime = currentTime;
                 #ifdef DEBUG_MODE
-                Serial.println(F("FreeCast Mode: Transition to Display phase"));
-                Serial.print(F("Motion intensity: "));
-                Serial.println(motionIntensity);
-                Serial.print(F("Pattern type: "));
-                Serial.println((int)currentPatternType);
+                SerialOut.println(F("FreeCast Mode: Transition to Display phase"));
+                SerialOut.print(F("Motion intensity: "));
+                SerialOut.println(motionIntensity);
+                SerialOut.print(F("Pattern type: "));
+                SerialOut.println((int)currentPatternType);
                 #endif
             }
             break;
             
         case FreeCastState::DISPLAYING:
-            // Display current pattern
-            renderCurrentPattern(elapsedTime);
+            // Finish baking the display phase; renderLEDs() plays it back
+            bakePatternFrames();
             
             // Check if display phase is complete (2 seconds as per TrueFunctionGuide)
             if (elapsedTime >= Config::FREECAST_DISPLAY_MS) {
+                reportPatternCache();
+                
                 // Transition back to recording state
                 currentState = FreeCastState::RECORDING;
                 phaseStartTime = currentTime;
                 motionBufferIndex = 0;
                 motionBufferCount = 0;
                 #ifdef DEBUG_MODE
-                Serial.println(F("FreeCast Mode: Transition to Recording phase"));
+                SerialOut.println(F("FreeCast Mode: Transition to Recording phase"));
                 #endif
             }
             break;
@@ -199,30 +208,32 @@ ModeTransition FreeCastMode::update() {
     
     // SHIELD position tracking moved to the top for exit check
     
-    // Update LEDs through renderLEDs() which will be called separately
+    // LEDs are drawn by renderLEDs() at the display rate
     
     return ModeTransition::NONE; // Stay in FreeCast mode if no transition detected
 }
 
-// Add the missing renderLEDs function definition
-void FreeCastMode::renderLEDs() {
-    unsigned long currentTime = millis();
+void FreeCastMode::renderLEDs(unsigned long currentTime) {
+    LEDCompositor* compositor = hardwareManager->getCompositor();
     
-    // Prioritize exit countdown flashing
+    // Exit countdown flashing goes on the feedback layer, above the pattern
     if (inShieldCountdown) {
         // Flash blue LEDs during the countdown
         bool flashState = (currentTime / 250) % 2; // Simple on/off flash every 250ms
-        // Use the project's Color struct
-        hardwareManager->setAllLEDs(flashState ? Color{0, 0, 255} : Color{0, 0, 0}); 
+        compositor->fill(LEDLayer::FEEDBACK, flashState ? Color{0, 0, 255} : Color{0, 0, 0});
     } else {
-        // Otherwise, render based on the current state
+        compositor->clear(LEDLayer::FEEDBACK);
+    }
+    
+    // The base layer only needs redrawing while it is visible
+    if (!inShieldCountdown) {
         switch (currentState) {
             case FreeCastState::INITIALIZING:
                 // Use the project's Color struct
                 hardwareManager->setAllLEDs(Color{0, 0, 0}); // Clear LEDs during init
                 break;
             case FreeCastState::RECORDING:
-                renderBackgroundAnimation();
+                renderBackgroundAnimation(currentTime);
                 break;
             case FreeCastState::DISPLAYING:
                 // Calculate elapsed time *within the display phase* for pattern rendering
@@ -231,8 +242,7 @@ void FreeCastMode::renderLEDs() {
         }
     }
     
-    // Always update the LEDs after setting them
-    hardwareManager->updateLEDs();
+    // GauntletController pushes the frame once posted animations are drawn
 }
 
 /**
@@ -256,11 +266,12 @@ void FreeCastMode::reset() {
     inShieldCountdown = false;
     
     // Clear LEDs
+    hardwareManager->getCompositor()->clear(LEDLayer::FEEDBACK);
     hardwareManager->setAllLEDs(Color{0, 0, 0});
     hardwareManager->updateLEDs();
     
     #ifdef DEBUG_MODE
-    Serial.println(F("FreeCast Mode: Reset by ShakeCancel"));
+    SerialOut.println(F("FreeCast Mode: Reset by ShakeCancel"));
     #endif
     
     #if DIAG_LOGGING_ENABLED
@@ -474,34 +485,34 @@ void FreeCastMode::generateColorPalette() {
     // Brightness will still be affected by motion intensity
     
     // Generate more vibrant rainbow palette
-    patternColors[0] = CRGB(255, 0, 0);       // Red (Null position)
-    patternColors[1] = CRGB(0, 255, 0);       // Green (Dig position)
-    patternColors[2] = CRGB(255, 105, 180);   // Pink (Shield position)
-    patternColors[3] = CRGB(128, 0, 255);     // Purple (Offer position)
-    patternColors[4] = CRGB(255, 255, 0);     // Yellow (Oath position)
+    patternColors[0] = {255, 0, 0};       // Red (Null position)
+    patternColors[1] = {0, 255, 0};       // Green (Dig position)
+    patternColors[2] = {255, 105, 180};   // Pink (Shield position)
+    patternColors[3] = {128, 0, 255};     // Purple (Offer position)
+    patternColors[4] = {255, 255, 0};     // Yellow (Oath position)
     
     // Scale brightness based on motion intensity
-    float brightnessScale = 0.5f + (motionIntensity * 0.5f); // 0.5-1.0 brightness scale
+    uint8_t brightnessScale = 128 + (uint8_t)(motionIntensity * 127); // 0.5-1.0 brightness scale
     
     // Apply brightness scaling based on motion intensity
     for (int i = 0; i < 5; i++) {
-        patternColors[i].r = patternColors[i].r * brightnessScale;
-        patternColors[i].g = patternColors[i].g * brightnessScale;
-        patternColors[i].b = patternColors[i].b * brightnessScale;
+        patternColors[i] = ColorEngine::scale(patternColors[i], brightnessScale);
     }
 }
 
 // Generate final pattern after analysis
 void FreeCastMode::generatePattern() {
-    // Pattern generation is handled in the renderCurrentPattern method
-    // Nothing specific to do here as we've already determined pattern type
+    // The pattern parameters are fixed for the whole display phase, so bake
+    // it once; renderCurrentPattern() then only copies cached frames
+    patternCache.begin(Config::FREECAST_DISPLAY_MS / Config::DISPLAY_FRAME_PERIOD_MS,
+                       Config::DISPLAY_FRAME_PERIOD_MS);
+    bakePatternFrames();
 }
 
 // Render a subtle background animation during recording phase
-void FreeCastMode::renderBackgroundAnimation() {
+void FreeCastMode::renderBackgroundAnimation(unsigned long now) {
     // Create a subtle pulsing effect
-    unsigned long currentTime = millis();
-    uint8_t pulse = (sin8(currentTime / 10) * 64) / 255; // 0-64 brightness pulse
+    uint8_t pulse = (ColorEngine::sine8(now / 10) * 64) / 255; // 0-64 brightness pulse
     
     // Dim white pulsing around the ring
     for (int i = 0; i < Config::NUM_LEDS; i++) {
@@ -510,347 +521,123 @@ void FreeCastMode::renderBackgroundAnimation() {
     }
 }
 
-// Render the current pattern based on pattern type
+// Render the current pattern, from the baked cache when it has the frame
 void FreeCastMode::renderCurrentPattern(unsigned long elapsedTime) {
-    // Ensure we have at least some motion data before trying to render patterns
-    // This provides an extra layer of protection against division by zero in the renderers
-    if (motionBufferCount == 0) {
-        // If no motion data, just show a simple default pattern
-        // Create a simple pulsing effect on all LEDs
-        uint8_t pulse = (sin8(elapsedTime / 20) * 128) / 255 + 40; // 40-168 brightness pulse
-        CRGB color = CRGB(pulse, pulse, pulse); // White pulsing
-        
-        for (int i = 0; i < Config::NUM_LEDS; i++) {
-            hardwareManager->setLED(i, {color.r, color.g, color.b});
-        }
-        return;
+    Color frame[Config::NUM_LEDS];
+    if (!patternCache.play(elapsedTime, frame)) {
+        // Not baked yet (or did not fit): render it live
+        FreecastPatterns::render(getPatternParams(), elapsedTime, frame);
     }
     
-    // Regular rendering with pattern selection
-    switch (currentPatternType) {
-        case PatternType::SHOOTING_STARS:
-            renderShootingStars(elapsedTime);
-            break;
-        case PatternType::WAVES:
-            renderWaves(elapsedTime);
-            break;
-        case PatternType::SPARKLES:
-            renderSparkles(elapsedTime);
-            break;
-        case PatternType::COLOR_TRAILS:
-            renderColorTrails(elapsedTime);
-            break;
-        case PatternType::PULSES:
-            renderPulses(elapsedTime);
-            break;
-        default:
-            renderSparkles(elapsedTime); // Default to sparkles
-            break;
+    for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+        hardwareManager->setLED(i, frame[i]);
     }
 }
 
-// Render shooting stars pattern (for quick flicks)
-void FreeCastMode::renderShootingStars(unsigned long elapsedTime) {
-    // Parameters based on motion
-    uint8_t numStars = 1 + (motionIntensity * 3); // 1-4 shooting stars
-    uint8_t starSpeed = 50 + (motionIntensity * 200); // Speed factor
-    // Ensure tailLength is never zero by using max()
-    uint8_t tailLength = max(1, 3 + (int)(motionIntensity * 6)); // 3-9 LEDs, guaranteed at least 1
-    
-    // Clear all LEDs first
-    hardwareManager->setAllLEDs({0, 0, 0});
-    
-    // Create stars at different positions
-    for (uint8_t star = 0; star < numStars; star++) {
-        // Calculate position based on time and star index
-        uint8_t pos = ((elapsedTime / (200 - starSpeed)) + (star * 7)) % Config::NUM_LEDS;
-        
-        // Each star has its own color based on position and time
-        // This ensures variety between stars and runs
-        CRGB headColor;
-        uint8_t starHue = (star * 40 + (elapsedTime / 50)) % 255; // Spaced hues, slowly shifting
-        headColor.setHSV(starHue, 255, 255); // Full saturation and brightness for head
-        
-        // Create tail
-        for (uint8_t tail = 0; tail < tailLength; tail++) {
-            // Calculate tail position (wrapping around the ring)
-            uint8_t tailPos = (pos + Config::NUM_LEDS - tail) % Config::NUM_LEDS;
-            
-            // Calculate tail brightness (fading out)
-            // tailLength is now guaranteed to be at least 1
-            uint8_t brightness = 255 - ((255 * tail) / tailLength);
-            
-            // For tail colors, fade to white or yellow at the tips
-            CRGB tailColor;
-            
-            if (tail < tailLength / 3) {
-                // Head section - keep the star's color
-                tailColor = headColor;
-            } else {
-                // Tail section - blend toward white/yellow for a fiery effect
-                // Guard against division by zero or very small divisor
-                float divisor = max(1.0f, (float)(tailLength - tailLength/3));
-                float blendFactor = (float)(tail - tailLength/3) / divisor;
-                CRGB fadeColor = CRGB(255, 180, 0); // Yellowish/orange
-                tailColor = blend(headColor, fadeColor, blendFactor * 255);
-            }
-            
-            // Scale by brightness and intensity
-            float intensityFactor = 0.4f + (motionIntensity * 0.6f); // 0.4-1.0 scaling
-            uint8_t finalBrightness = brightness * intensityFactor;
-            tailColor.nscale8(finalBrightness);
-            
-            // Set LED
-            hardwareManager->setLED(tailPos, {tailColor.r, tailColor.g, tailColor.b});
-        }
-    }
+// Parameters the display patterns depend on, fixed once motion is analyzed
+FreecastPatternParams FreeCastMode::getPatternParams() const {
+    FreecastPatternParams params;
+    params.type = currentPatternType;
+    params.intensity = motionIntensity;
+    params.directionality = motionDirectionality;
+    // Guards the pattern renderers against running on an empty motion buffer
+    params.hasMotion = motionBufferCount > 0;
+    return params;
 }
 
-// Render waves pattern (for circular motions)
-void FreeCastMode::renderWaves(unsigned long elapsedTime) {
-    // Parameters based on motion
-    float speed = 0.05f + (motionIntensity * 0.3f); // Increased wave speed responsiveness
-    float intensity = 0.5f + (motionIntensity * 0.5f); // Brightness intensity
-    
-    // Use directionality to control wave frequency
-    float waveFrequency = 1.0f + (motionDirectionality * 3.0f); // 1-4 waves based on directionality
-    
-    // Create wave effect around the ring
-    int numLeds = (Config::NUM_LEDS > 0) ? Config::NUM_LEDS : 1; // Ensure NUM_LEDS is at least 1
-    
-    for (int i = 0; i < numLeds; i++) {
-        // Calculate wave phase for this LED with frequency modulation
-        // Guard against division by zero by ensuring denominator is at least 1
-        float phase = waveFrequency * ((float)i / numLeds * TWO_PI) + elapsedTime * speed;
-        
-        // Generate sinusoidal wave
-        float wave = (sinf(phase) + 1.0f) / 2.0f; // 0.0-1.0
-        
-        // Full rainbow color selection - HSV color wheel
-        CRGB color;
-        
-        // Use the full color wheel based on position and time
-        // Scale up the time division to make the colors shift more slowly
-        uint8_t hue = ((i * 21) + (elapsedTime / 30)) % 255;
-        
-        // Use the wave to vary the specific hue around the base
-        // Convert wave to an integer offset before using modulo
-        uint8_t waveOffset = (uint8_t)(wave * 30.0f);
-        hue = (hue + waveOffset) % 255;
-        
-        // Saturation based on directionality - more directional = more saturated
-        uint8_t sat = 200 + (motionDirectionality * 55); // 200-255
-        
-        // Brightness based on wave value and motion intensity
-        uint8_t val = 128 + (wave * 127 * intensity); // 128-255 with intensity scaling
-        
-        // Set HSV color
-        color.setHSV(hue, sat, val);
-        
-        // Set LED
-        hardwareManager->setLED(i, {color.r, color.g, color.b});
-    }
-}
-
-// Render sparkles pattern (for shaking motions)
-void FreeCastMode::renderSparkles(unsigned long elapsedTime) {
-    // Parameters based on motion
-    uint8_t numSparkles = 3 + (motionIntensity * 9); // 3-12 sparkles
-    uint8_t changeRate = 100 - (motionIntensity * 70); // How often sparkles change
-    
-    // Seed random number generator with elapsedTime
-    uint32_t seed = elapsedTime / changeRate;
-    randomSeed(seed);
-    
-    // Clear all LEDs first
-    hardwareManager->setAllLEDs({0, 0, 0});
-    
-    // Define a more varied color palette using preset colors
-    CRGB sparkleColors[] = {
-        CRGB(255, 0, 0),     // Red
-        CRGB(255, 255, 0),   // Yellow
-        CRGB(0, 255, 0),     // Green
-        CRGB(0, 255, 255),   // Cyan
-        CRGB(0, 0, 255),     // Blue
-        CRGB(255, 0, 255),   // Magenta
-        CRGB(255, 255, 255)  // White
-    };
-    
-    // Create random sparkles
-    for (uint8_t i = 0; i < numSparkles; i++) {
-        // Random position
-        uint8_t pos = random(Config::NUM_LEDS);
-        
-        // Get a random color from our defined palette
-        CRGB color = sparkleColors[random(7)];
-        
-        // Random brightness with intensity scaling
-        uint8_t brightness = 128 + random(128); 
-        float scaling = 0.5f + (motionIntensity * 0.5f);  // Scale 50-100% based on motion
-        
-        color.r = color.r * scaling * brightness / 255;
-        color.g = color.g * scaling * brightness / 255;
-        color.b = color.b * scaling * brightness / 255;
-        
-        // Set LED
-        hardwareManager->setLED(pos, {color.r, color.g, color.b});
+// Bake the next slice of the display phase; spread over the first logic ticks
+void FreeCastMode::bakePatternFrames() {
+    if (patternCache.isSealed()) {
+        return;
     }
-}
-
-// Render color trails pattern (for directional movements)
-void FreeCastMode::renderColorTrails(unsigned long elapsedTime) {
-    // Parameters based on motion
-    uint8_t speed = 50 + (motionIntensity * 150); // Rotation speed
-    
-    // Ensure we don't divide by zero in position calculation
-    uint8_t speedForCalculation = (speed < 199) ? speed : 199; // Prevent 200-speed from being zero
-    
-    // Calculate position
-    uint8_t pos = (elapsedTime / (200 - speedForCalculation)) % Config::NUM_LEDS;
     
-    // Create gradient around the ring
-    for (int i = 0; i < Config::NUM_LEDS; i++) {
-        // Calculate distance from position (0 to NUM_LEDS/2)
-        uint8_t distance = min(
-            (i + Config::NUM_LEDS - pos) % Config::NUM_LEDS,
-            (pos + Config::NUM_LEDS - i) % Config::NUM_LEDS
-        );
-        
-        // Normalize distance to 0-255
-        // Guard against division by zero by ensuring denominator is at least 1
-        uint8_t normalizedDistance;
-        if (Config::NUM_LEDS > 1) {
-            normalizedDistance = (distance * 255) / (Config::NUM_LEDS / 2);
-        } else {
-            normalizedDistance = 0; // Default if NUM_LEDS is invalid
+    FreecastPatternParams params = getPatternParams();
+    Color frame[Config::NUM_LEDS];
+    for (uint8_t n = 0; n < Config::FREECAST_BAKE_FRAMES_PER_TICK; n++) {
+        uint32_t start = micros();
+        FreecastPatterns::render(params, (unsigned long)patternCache.getNextFrame() * Config::DISPLAY_FRAME_PERIOD_MS, frame);
+        patternCache.addBakeMicros(micros() - start);
+        if (!patternCache.addFrame(frame)) {
+            break;
         }
-        
-        // Use HSV for more vibrant colors with a full rainbow spectrum
-        CRGB color;
-        
-        // Base hue depends on time, making the color pattern rotate over time
-        uint8_t baseHue = (elapsedTime / 20) % 255;
-        
-        // Add distance-based hue shift to create rainbow gradient
-        uint8_t hue = (baseHue + normalizedDistance) % 255;
-        
-        // Saturation based on directionality - more directional = more saturated
-        uint8_t sat = 200 + (motionDirectionality * 55); // 200-255
-        
-        // Brightness based on motion intensity and distance from center point
-        float falloff = 1.0f - (normalizedDistance / 255.0f) * 0.4f; // 0.6-1.0 range
-        uint8_t val = (200 + (motionIntensity * 55)) * falloff; // 120-255 with falloff
-        
-        // Set HSV color
-        color.setHSV(hue, sat, val);
-        
-        // Set LED
-        hardwareManager->setLED(i, {color.r, color.g, color.b});
+    }
+    
+    if (patternCache.getNextFrame() * Config::DISPLAY_FRAME_PERIOD_MS >= Config::FREECAST_DISPLAY_MS) {
+        patternCache.seal();
     }
 }
 
-// Render pulses pattern (for sharp direction changes)
-void FreeCastMode::renderPulses(unsigned long elapsedTime) {
-    // Parameters based on motion
-    // Ensure numPulses is never zero by using max()
-    uint8_t numPulses = max(1, 1 + (int)(motionIntensity * 2)); // 1-3 pulses, guaranteed at least 1
-    uint8_t pulseSpeed = 100 + (motionIntensity * 400); // Expansion speed
-    
-    // Clear all LEDs first
-    hardwareManager->setAllLEDs({0, 0, 0});
-    
-    // Create pulses
-    for (uint8_t pulse = 0; pulse < numPulses; pulse++) {
-        // Calculate pulse center and radius - numPulses is now guaranteed to be at least 1
-        uint8_t center = (pulse * Config::NUM_LEDS / numPulses); // Evenly spaced
-        float radius = ((elapsedTime / pulseSpeed) + (pulse * 0.33f)) * Config::NUM_LEDS;
-        radius = fmodf(radius, Config::NUM_LEDS * 1.5f); // Wrap around with gap
-        
-        // Each pulse has its own color based on motion intensity
-        CRGB pulseColor;
-        uint8_t hue = (pulse * 85 + (elapsedTime / 30)) % 255; // Spaced evenly around color wheel
-        uint8_t sat = 200 + (motionDirectionality * 55); // 200-255 based on directionality
-        uint8_t val = 200 + (motionIntensity * 55); // 200-255 based on intensity
-        pulseColor.setHSV(hue, sat, val);
-        
-        // Draw pulse
-        for (int i = 0; i < Config::NUM_LEDS; i++) {
-            // Calculate distance from pulse center (shortest path around ring)
-            uint8_t distance = min(
-                (i + Config::NUM_LEDS - center) % Config::NUM_LEDS,
-                (center + Config::NUM_LEDS - i) % Config::NUM_LEDS
-            );
-            
-            // Check if this LED is within pulse radius
-            if (distance <= radius && distance >= radius - 3) {
-                // Calculate intensity based on distance from radius edge
-                float intensity = 1.0f - fabsf((radius - distance) / 3.0f);
-                
-                // Scale by intensity
-                CRGB color = pulseColor;
-                color.nscale8(intensity * 255);
-                
-                // Set LED
-                hardwareManager->setLED(i, {color.r, color.g, color.b});
-            }
-        }
+// Render cost of the display phase that just ended, cached vs live
+void FreeCastMode::reportPatternCache() {
+    #ifdef DEBUG_MODE
+    const PatternCacheStats& stats = patternCache.getStats();
+    if (stats.bakedFrames == 0 || stats.playedFrames == 0) {
+        return;
     }
+    uint32_t liveUs = stats.bakeMicros / stats.bakedFrames;
+    uint32_t playbackUs = stats.playbackMicros / stats.playedFrames;
+    uint32_t framesPerSecond = 1000 / Config::DISPLAY_FRAME_PERIOD_MS;
+    SerialOut.printf("FreeCast cache: %u frames in %u bytes, live %lu us/frame, playback %lu us/frame, "
+                  "%lu us saved per display second\n",
+                  stats.bakedFrames, patternCache.getSize(), (unsigned long)liveUs, (unsigned long)playbackUs,
+                  (unsigned long)((liveUs > playbackUs ? liveUs - playbackUs : 0) * framesPerSecond));
+    #endif
 }
 
 #ifdef DEBUG_MODE
 void FreeCastMode::printStatus() const {
-    Serial.println(F("=== FreeCast Mode Status ==="));
+    SerialOut.println(F("=== FreeCast Mode Status ==="));
     
     // Print current state
-    Serial.print(F("Current State: "));
+    SerialOut.print(F("Current State: "));
     switch (currentState) {
         case FreeCastState::INITIALIZING:
-            Serial.println(F("INITIALIZING"));
+            SerialOut.println(F("INITIALIZING"));
             break;
         case FreeCastState::RECORDING:
-            Serial.println(F("RECORDING"));
+            SerialOut.println(F("RECORDING"));
             break;
         case FreeCastState::DISPLAYING:
-            Serial.println(F("DISPLAYING"));
+            SerialOut.println(F("DISPLAYING"));
             break;
     }
     
     // Print motion data statistics
-    Serial.print(F("Motion buffer samples: "));
-    Serial.println(motionBufferCount);
+    SerialOut.print(F("Motion buffer samples: "));
+    SerialOut.println(motionBufferCount);
     
-    Serial.print(F("Motion intensity: "));
-    Serial.println(motionIntensity);
+    SerialOut.print(F("Motion intensity: "));
+    SerialOut.println(motionIntensity);
     
-    Serial.print(F("Motion directionality: "));
-    Serial.println(motionDirectionality);
+    SerialOut.print(F("Motion directionality: "));
+    SerialOut.println(motionDirectionality);
     
-    Serial.print(F("Dominant axis: "));
+    SerialOut.print(F("Dominant axis: "));
     switch (dominantAxis) {
-        case 0: Serial.println(F("X")); break;
-        case 1: Serial.println(F("Y")); break;
-        case 2: Serial.println(F("Z")); break;
+        case 0: SerialOut.println(F("X")); break;
+        case 1: SerialOut.println(F("Y")); break;
+        case 2: SerialOut.println(F("Z")); break;
     }
     
     // Print pattern information
-    Serial.print(F("Current pattern: "));
+    SerialOut.print(F("Current pattern: "));
     switch (currentPatternType) {
-        case PatternType::SHOOTING_STARS: Serial.println(F("SHOOTING_STARS")); break;
-        case PatternType::WAVES: Serial.println(F("WAVES")); break;
-        case PatternType::SPARKLES: Serial.println(F("SPARKLES")); break;
-        case PatternType::COLOR_TRAILS: Serial.println(F("COLOR_TRAILS")); break;
-        case PatternType::PULSES: Serial.println(F("PULSES")); break;
+        case PatternType::SHOOTING_STARS: SerialOut.println(F("SHOOTING_STARS")); break;
+        case PatternType::WAVES: SerialOut.println(F("WAVES")); break;
+        case PatternType::SPARKLES: SerialOut.println(F("SPARKLES")); break;
+        case PatternType::COLOR_TRAILS: SerialOut.println(F("COLOR_TRAILS")); break;
+        case PatternType::PULSES: SerialOut.println(F("PULSES")); break;
     }
     
     // Print exit gesture status
-    Serial.print(F("In Null Countdown: "));
-    Serial.println(inNullCountdown ? F("YES") : F("NO"));
+    SerialOut.print(F("In Null Countdown: "));
+    SerialOut.println(inNullCountdown ? F("YES") : F("NO"));
     
     if (nullPositionStartTime > 0) {
         unsigned long nullDuration = millis() - nullPositionStartTime;
-        Serial.print(F("Null Position Duration: "));
-        Serial.print(nullDuration);
-        Serial.println(F("ms"));
+        SerialOut.print(F("Null Position Duration: "));
+        SerialOut.print(nullDuration);
+        SerialOut.println(F("ms"));
     }
 }
 #endif 
\ No newline at end of file
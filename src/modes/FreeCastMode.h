@@ -7,15 +7,8 @@
 #include "../detection/UltraBasicPositionDetector.h"
 #include "../core/SystemTypes.h"
 #include "../core/Config.h"
-
-// Pattern types
-enum class PatternType {
-    SHOOTING_STARS,  // For quick flicks
-    WAVES,           // For circular motions
-    SPARKLES,        // For shaking motions
-    COLOR_TRAILS,    // For directional movements
-    PULSES           // For sharp direction changes
-};
+#include "../animation/FreecastPatterns.h"
+#include "../animation/PatternCache.h"
 
 /**
  * @brief FreeCast mode implementation for motion-to-pattern translation
@@ -52,7 +45,8 @@ private:
     
     // Pattern generation
     PatternType currentPatternType;  // Determined by motion characteristics
-    CRGB patternColors[5];           // Color palette for current pattern
+    Color patternColors[5];          // Color palette for current pattern
+    PatternCache patternCache;       // Display phase baked right after analysis
     
     // Timing
     unsigned long phaseStartTime;       // When current phase began
@@ -72,20 +66,16 @@ private:
     void collectMotionData();
     void analyzeMotionData();
     void generatePattern();
-    void renderBackgroundAnimation();
+    void renderBackgroundAnimation(unsigned long now);
     void renderCurrentPattern(unsigned long elapsedTime);
+    FreecastPatternParams getPatternParams() const;
+    void bakePatternFrames();
+    void reportPatternCache();
     
     // Gesture detection methods
     bool detectLongNullGesture(); // Deprecated
     bool detectLongShieldGesture(); // New exit gesture
     
-    // Pattern rendering methods
-    void renderShootingStars(unsigned long elapsedTime);
-    void renderWaves(unsigned long elapsedTime);
-    void renderSparkles(unsigned long elapsedTime);
-    void renderColorTrails(unsigned long elapsedTime);
-    void renderPulses(unsigned long elapsedTime);
-    
     // Helper methods
     void generateColorPalette();
     float calculateMotionIntensity();
@@ -97,7 +87,14 @@ public:
     bool init(HardwareManager* hardware, UltraBasicPositionDetector* detector);
     void initialize();
     ModeTransition update();
-    void renderLEDs();
+    
+    /**
+     * @brief Draw the frame for the given time from the current mode state
+     * 
+     * Called at the display rate; does not advance recording or display phases
+     * or push the frame to the LEDs.
+     */
+    void renderLEDs(unsigned long now);
     
     /**
      * @brief Reset FreeCast mode state
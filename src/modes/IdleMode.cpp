@@ -2,10 +2,12 @@
 #include "../core/Config.h"
 #include "../core/SystemTypes.h"
 #include "../diagnostics/VisualDebugIndicator.h"
-// GestureTransitionTracker is included via IdleMode.h
+#include "../hardware/LEDTopology.h"
+#include "../hardware/SerialTx.h"
+// SpellGestureDetector is included via IdleMode.h
 
 // Define the static constants
-const uint8_t IdleMode::IDLE_LEDS[4] = {0, 3, 6, 9};
+const uint8_t IdleMode::IDLE_MARKERS_PER_RING = 4; // LEDs 0, 3, 6, 9 on a 12-LED ring
 const uint8_t IdleMode::IDLE_BRIGHTNESS = 204; // 80% of 255
 const uint16_t IdleMode::COLOR_TRANSITION_MS = 300;
 
@@ -17,10 +19,10 @@ IdleMode::IdleMode()
       positionChangedTime(0),
       shieldPositionStartTime(0),
       inShieldCountdown(false),
-      calmOfferTracker_(POS_CALM, POS_OFFER, Config::QUICKCAST_WINDOW_MS, SpellTransition::TO_RAINBOW),
-      digOathTracker_(POS_DIG, POS_OATH, Config::QUICKCAST_WINDOW_MS, SpellTransition::TO_LIGHTNING),
-      nullShieldTracker_(POS_NULLPOS, POS_SHIELD, Config::QUICKCAST_WINDOW_MS, SpellTransition::TO_LUMINA),
-      currentColor(CRGB::Black),
+      oathPositionStartTime(0),
+      oathSwitchTaken(false),
+      shownProfile(0),
+      profileShownTime(0),
       targetColor(CRGB::Black),
       previousColor(CRGB::Black),
       colorTransitionStartTime(0),
@@ -47,12 +49,14 @@ void IdleMode::initialize() {
     positionChangedTime = millis();
     shieldPositionStartTime = 0;
     inShieldCountdown = false;
+    oathPositionStartTime = 0;
+    oathSwitchTaken = false;
+    profileShownTime = millis() - Config::PROFILE_FLASH_MS;
     
     // Reset QuickCast trackers
     resetAllSpellTrackers();
 
     // Set initial colors
-    currentColor = CRGB::Black;
     targetColor = getPositionColor(POS_UNKNOWN);
     previousColor = CRGB::Black;
     colorTransitionStartTime = millis();
@@ -61,7 +65,7 @@ void IdleMode::initialize() {
     hardwareManager->setBrightness(IDLE_BRIGHTNESS);
     
     // Set LEDs to initial state
-    renderLEDs();
+    renderLEDs(millis());
 }
 
 void IdleMode::update() {
@@ -82,19 +86,20 @@ void IdleMode::update() {
             inShieldCountdown = false;
         }
         
-        // Set new target color based on position
-        previousColor = currentColor;
+        // Likewise for oath; one profile switch per hold
+        if (newPosition.position == POS_OATH) {
+            oathPositionStartTime = currentTime;
+            oathSwitchTaken = false;
+        }
+        
+        // Set new target color based on position, fading from what is shown now
+        previousColor = colorAt(currentTime);
         targetColor = getPositionColor(newPosition.position);
         colorTransitionStartTime = currentTime;
     }
     
-    // Update color transition
-    updateColorTransition();
-    
     // Update QuickCast gesture trackers
-    calmOfferTracker_.update(static_cast<HandPosition>(currentPosition.position), currentTime);
-    digOathTracker_.update(static_cast<HandPosition>(currentPosition.position), currentTime);
-    nullShieldTracker_.update(static_cast<HandPosition>(currentPosition.position), currentTime);
+    spellDetector_.update(static_cast<HandPosition>(currentPosition.position), currentTime);
 
     // Check for shield position countdown trigger (after 3 seconds) - Keep for Freecast transition
     if (currentPosition.position == POS_SHIELD && !inShieldCountdown) {
@@ -107,9 +112,6 @@ void IdleMode::update() {
             VisualDebugIndicator::updateGestureProgress(progress, 2);
         }
     }
-    
-    // Display the current position
-    renderLEDs();
 }
 
 ModeTransition IdleMode::checkForTransition() {
@@ -125,69 +127,81 @@ ModeTransition IdleMode::checkForTransition() {
     return ModeTransition::NONE;
 }
 
-SpellTransition IdleMode::checkForSpellTransition() {
-    SpellTransition detectedTransition = SpellTransition::NONE;
+SpellId IdleMode::checkForSpellTransition() {
+    SpellId detectedSpell = spellDetector_.completedSpell();
 
-    if (calmOfferTracker_.isTransitionComplete()) {
-        detectedTransition = calmOfferTracker_.getTransitionType();
+    if (detectedSpell != SpellRegistry::NONE) {
         resetAllSpellTrackers(); // Reset all trackers once one completes
-    } else if (digOathTracker_.isTransitionComplete()) {
-        detectedTransition = digOathTracker_.getTransitionType();
-        resetAllSpellTrackers();
-    } else if (nullShieldTracker_.isTransitionComplete()) {
-        detectedTransition = nullShieldTracker_.getTransitionType();
-        resetAllSpellTrackers();
     }
 
-    return detectedTransition;
+    return detectedSpell;
+}
+
+bool IdleMode::checkForProfileSwitch() {
+    if (currentPosition.position != POS_OATH || oathSwitchTaken) {
+        return false;
+    }
+    if (millis() - oathPositionStartTime >= Config::LONGOATH_TIME_MS) {
+        oathSwitchTaken = true;
+        return true;
+    }
+    return false;
+}
+
+void IdleMode::showProfile(uint8_t index, unsigned long now) {
+    shownProfile = index;
+    profileShownTime = now;
 }
 
 void IdleMode::resetAllSpellTrackers() {
-    calmOfferTracker_.reset();
-    digOathTracker_.reset();
-    nullShieldTracker_.reset();
+    spellDetector_.reset();
 }
 
-void IdleMode::renderLEDs() {
-    // First, clear all LEDs
-    hardwareManager->setAllLEDs({0, 0, 0});
+void IdleMode::renderLEDs(unsigned long now) {
+    LEDCompositor* compositor = hardwareManager->getCompositor();
+    
+    // Base layer: the indicator LEDs of every ring in the current position color
+    CRGB currentColor = colorAt(now);
+    Color displayColor = {
+        currentColor.r,
+        currentColor.g,
+        currentColor.b
+    };
+    const uint16_t markerCount = IDLE_MARKERS_PER_RING * ActiveTopology::RING_COUNT;
+    compositor->clear(LEDLayer::BASE);
+    for (uint16_t k = 0; k < markerCount; k++) {
+        compositor->setPixel(LEDLayer::BASE, ActiveTopology::marker(k, IDLE_MARKERS_PER_RING), displayColor);
+    }
     
-    // For SHIELD position with countdown, show special animation (Keep for Freecast transition)
+    // Feedback layer: LongShield countdown flash covers the indicator LEDs (Keep for Freecast transition)
     if (currentPosition.position == POS_SHIELD && inShieldCountdown) {
         // Calculate how long we've been in SHIELD position
-        unsigned long shieldDuration = millis() - shieldPositionStartTime;
+        unsigned long shieldDuration = now - shieldPositionStartTime;
         
-        // If we're in the 3-5 second window, show flashing countdown
-        if (shieldDuration >= Config::LONGSHIELD_WARNING_MS && shieldDuration < Config::LONGSHIELD_TIME_MS) {
-            // Flash at 2Hz (250ms on, 250ms off)
-            if ((millis() / 250) % 2 == 0) {
-                // Use Shield blue color
-                Color blue = {Config::Colors::SHIELD_COLOR[0], 
-                              Config::Colors::SHIELD_COLOR[1], 
-                              Config::Colors::SHIELD_COLOR[2]};
-                for (int i = 0; i < 4; i++) {
-                    hardwareManager->setLED(IDLE_LEDS[i], blue);
-                }
-            }
-            // Off phase is handled by the initial clear
+        // In the 3-5 second window flash at 2Hz (250ms on, 250ms off); otherwise stay dark
+        Color flashColor = {0, 0, 0};
+        if (shieldDuration >= Config::LONGSHIELD_WARNING_MS && shieldDuration < Config::LONGSHIELD_TIME_MS &&
+            (now / 250) % 2 == 0) {
+            flashColor = {Config::Colors::SHIELD_COLOR[0], 
+                          Config::Colors::SHIELD_COLOR[1], 
+                          Config::Colors::SHIELD_COLOR[2]};
         }
-    }
-    else {
-        // Normal position display - convert CRGB to Color struct
-        Color displayColor = {
-            currentColor.r,
-            currentColor.g,
-            currentColor.b
-        };
-        
-        // Set the four indicator LEDs
-        for (int i = 0; i < 4; i++) {
-            hardwareManager->setLED(IDLE_LEDS[i], displayColor);
+        for (uint16_t k = 0; k < markerCount; k++) {
+            compositor->setPixel(LEDLayer::FEEDBACK, ActiveTopology::marker(k, IDLE_MARKERS_PER_RING), flashColor);
+        }
+    } else if (now - profileShownTime < Config::PROFILE_FLASH_MS) {
+        // Profile switch: the first N indicator LEDs in oath color for profile N, the rest dark
+        Color oathColor = {Config::Colors::OATH_COLOR[0], Config::Colors::OATH_COLOR[1], Config::Colors::OATH_COLOR[2]};
+        Color dark = {0, 0, 0};
+        for (uint16_t k = 0; k < markerCount; k++) {
+            compositor->setPixel(LEDLayer::FEEDBACK, ActiveTopology::marker(k, IDLE_MARKERS_PER_RING),
+                                 k <= shownProfile ? oathColor : dark);
         }
+    } else {
+        compositor->clear(LEDLayer::FEEDBACK);
     }
     
-    // Update the LED display
-    hardwareManager->updateLEDs();
+    // GauntletController pushes the frame once posted animations are drawn
 }
 
 CRGB IdleMode::getPositionColor(uint8_t position) {
@@ -229,57 +243,52 @@ bool IdleMode::detectLongShieldGesture() {
     return false;
 }
 
-void IdleMode::updateColorTransition() {
+CRGB IdleMode::colorAt(unsigned long now) const {
     // If interpolation is disabled, just snap to target color
     if (!interpolationEnabled) {
-        currentColor = targetColor;
-        return;
+        return targetColor;
     }
     
-    // Calculate how far through the transition we are
-    unsigned long currentTime = millis();
-    unsigned long transitionTime = currentTime - colorTransitionStartTime;
+    // Calculate how far through the transition we are at this frame
+    unsigned long transitionTime = now - colorTransitionStartTime;
     
     // If past transition time, just use target color
     if (transitionTime >= COLOR_TRANSITION_MS) {
-        currentColor = targetColor;
-        return;
+        return targetColor;
     }
     
     // Otherwise interpolate between previous and target color
     float progress = (float)transitionTime / COLOR_TRANSITION_MS;
     
     // Linear interpolation of RGB values
-    currentColor.r = previousColor.r + (targetColor.r - previousColor.r) * progress;
-    currentColor.g = previousColor.g + (targetColor.g - previousColor.g) * progress;
-    currentColor.b = previousColor.b + (targetColor.b - previousColor.b) * progress;
+    CRGB color;
+    color.r = previousColor.r + (targetColor.r - previousColor.r) * progress;
+    color.g = previousColor.g + (targetColor.g - previousColor.g) * progress;
+    color.b = previousColor.b + (targetColor.b - previousColor.b) * progress;
+    return color;
 }
 
 void IdleMode::setInterpolationEnabled(bool enabled) {
+    // colorAt() snaps to the target color while disabled
     interpolationEnabled = enabled;
-    
-    // If disabling, snap to target color
-    if (!enabled) {
-        currentColor = targetColor;
-    }
 }
 
 #ifdef DEBUG_MODE
 void IdleMode::printStatus() const {
-    Serial.println(F("=== Idle Mode Status ==="));
-    Serial.print(F("Current Position: "));
+    SerialOut.println(F("=== Idle Mode Status ==="));
+    SerialOut.print(F("Current Position: "));
     
     switch (currentPosition.position) {
-        case POS_OFFER:    Serial.println(F("OFFER (Purple)")); break;
-        case POS_CALM:     Serial.println(F("CALM (Blue)")); break;
-        case POS_OATH:     Serial.println(F("OATH (Yellow)")); break;
-        case POS_DIG:      Serial.println(F("DIG (Green)")); break;
-        case POS_SHIELD:   Serial.println(F("SHIELD (Pink)")); break;
-        case POS_NULLPOS:  Serial.println(F("NULL (Red)")); break;
-        case POS_UNKNOWN:  Serial.println(F("UNKNOWN (White)")); break;
-        default:           Serial.println(F("DEFAULT (White)")); break;
+        case POS_OFFER:    SerialOut.println(F("OFFER (Purple)")); break;
+        case POS_CALM:     SerialOut.println(F("CALM (Blue)")); break;
+        case POS_OATH:     SerialOut.println(F("OATH (Yellow)")); break;
+        case POS_DIG:      SerialOut.println(F("DIG (Green)")); break;
+        case POS_SHIELD:   SerialOut.println(F("SHIELD (Pink)")); break;
+        case POS_NULLPOS:  SerialOut.println(F("NULL (Red)")); break;
+        case POS_UNKNOWN:  SerialOut.println(F("UNKNOWN (White)")); break;
+        default:           SerialOut.println(F("DEFAULT (White)")); break;
     }
     
-    Serial.println(F("====================="));
+    SerialOut.println(F("====================="));
 }
 #endif 
\ No newline at end of file
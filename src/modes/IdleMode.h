@@ -6,7 +6,7 @@
 #include "../hardware/HardwareManager.h"
 #include "../detection/UltraBasicPositionDetector.h"
 #include "../core/SystemTypes.h"
-#include "../detection/GestureTransitionTracker.h"
+#include "../detection/SpellGestureDetector.h"
 
 class IdleMode {
 private:
@@ -23,27 +23,32 @@ private:
     unsigned long shieldPositionStartTime;
     bool inShieldCountdown;
     
-    // QuickCast Gesture Trackers
-    GestureTransitionTracker calmOfferTracker_;
-    GestureTransitionTracker digOathTracker_;
-    GestureTransitionTracker nullShieldTracker_;
+    // Oath position tracking for LongOath gesture (calibration profile switch)
+    unsigned long oathPositionStartTime;
+    bool oathSwitchTaken;
     
-    // Color transition state
-    CRGB currentColor;
+    // Profile number shown on the indicator LEDs after a switch
+    uint8_t shownProfile;
+    unsigned long profileShownTime;
+    
+    // QuickCast gesture trackers, one per spell in SpellRegistry
+    SpellGestureDetector spellDetector_;
+    
+    // Color transition state; the displayed color is evaluated at render time
     CRGB targetColor;
     CRGB previousColor;
     unsigned long colorTransitionStartTime;
     bool interpolationEnabled;
     
     // Configuration
-    static const uint8_t IDLE_LEDS[4];
+    static const uint8_t IDLE_MARKERS_PER_RING; // Indicator LEDs per ring, evenly spaced
     static const uint8_t IDLE_BRIGHTNESS;
     static const uint16_t COLOR_TRANSITION_MS;
     
     // Internal methods
     CRGB getPositionColor(uint8_t position);
     bool detectLongShieldGesture();
-    void updateColorTransition();
+    CRGB colorAt(unsigned long now) const;
     void resetAllSpellTrackers();
     
 public:
@@ -52,9 +57,19 @@ public:
     void initialize();
     void update();
     ModeTransition checkForTransition();
-    void renderLEDs();
+    void renderLEDs(unsigned long now);
     void setInterpolationEnabled(bool enabled);
-    SpellTransition checkForSpellTransition();
+    SpellId checkForSpellTransition();
+    
+    /**
+     * @brief True once per Oath hold of Config::LONGOATH_TIME_MS
+     */
+    bool checkForProfileSwitch();
+    
+    /**
+     * @brief Light one indicator LED per profile number for Config::PROFILE_FLASH_MS
+     */
+    void showProfile(uint8_t index, unsigned long now);
 };
 
 #endif // IDLE_MODE_H 
\ No newline at end of file
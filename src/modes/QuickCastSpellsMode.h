@@ -2,16 +2,18 @@
 #define QUICKCAST_SPELLS_MODE_H
 
 #include "../core/SystemTypes.h"
+#include "../core/SpellRegistry.h"
 #include "../hardware/HardwareManager.h"
-// Removed: #include "../detection/UltraBasicPositionDetector.h"
+#include "../animation/AnimationSystem.h"
 #include <stdint.h>
 
 /**
  * @brief Handles the execution and rendering of QuickCast spell effects.
  * 
  * This mode is entered when a QuickCast gesture is detected in IdleMode.
- * It plays the corresponding spell animation for its duration and then 
- * transitions back to IdleMode.
+ * It posts the spell's animation, as defined in SpellRegistry, to the
+ * AnimationSystem, which draws it every frame, and transitions back to
+ * IdleMode once the animation completes.
  */
 class QuickCastSpellsMode {
 public:
@@ -21,19 +23,20 @@ public:
     /**
      * @brief Initializes the mode with necessary dependencies.
      * @param hardware Pointer to the HardwareManager instance.
+     * @param animations Animation system the spells are posted to.
      * @return True if initialization is successful, false otherwise.
      */
-    bool init(HardwareManager* hardware);
+    bool init(HardwareManager* hardware, AnimationSystem* animations);
 
     /**
      * @brief Called when entering this mode.
-     * @param spellType The specific QuickCast spell to execute.
+     * @param spell Index of the QuickCast spell to execute in SpellRegistry::SPELLS.
      */
-    void enter(SpellType spellType);
+    void enter(SpellId spell);
 
     /**
      * @brief Main update loop for the mode.
-     * Manages spell timing, updates animations, and checks for exit conditions.
+     * Checks for exit conditions; the spell animation is drawn by the AnimationSystem.
      * @return The requested mode transition (usually TO_IDLE when spell finishes, or NONE).
      */
     ModeTransition update();
@@ -44,13 +47,6 @@ public:
      */
     void exit();
     
-    /**
-     * @brief Explicitly renders LEDs for this mode.
-     * This method exists for API consistency with other modes.
-     * LED rendering is normally handled within the update() method.
-     */
-    void renderLEDs();
-    
     /**
      * @brief Immediately stops the active spell and cleans up
      * 
@@ -60,33 +56,30 @@ public:
 
 private:
     HardwareManager* hardwareManager_;
+    AnimationSystem* animations_;
 
-    SpellType activeSpell_;
+    SpellId activeSpell_;
     SpellState spellState_;
     uint32_t spellStartTime_;
     uint32_t spellDuration_;
-    uint32_t lastUpdateTime_;
 
-    // Removed: All position detection and gesture recognition related variables
-    
-    // Private Spell Rendering Methods
-    void renderRainbowBurst(uint32_t currentTime, uint32_t elapsedTime);
-    void renderLightningBlast(uint32_t currentTime, uint32_t elapsedTime);
-    void renderLumina(uint32_t currentTime, uint32_t elapsedTime);
+    // Spell animation running in the AnimationSystem (0 if none)
+    AnimationHandle spellAnimation_;
 
-    // Rainbow Burst helper methods
-    void renderRainbowPhase1(unsigned long elapsed);
-    void renderRainbowPhase2(unsigned long elapsed);
-    void renderRainbowPhase3(unsigned long elapsed);
-    void renderRainbowPhase4(unsigned long elapsed);
-    void renderRainbowSwirl(float progress, float brightness);
-    void renderColorPop(uint8_t led, unsigned long popTime, unsigned long elapsed, uint8_t r, uint8_t g, uint8_t b);
-    void hsvToRgb(float h, float s, float v, uint8_t &r, uint8_t &g, uint8_t &b);
+    // Rainbow Burst phase last logged, so each is logged once per cast
+    const char* rainbowPhase_;
 
-    // Removed: Lumina cancellation method
-    
-    // Spell cleanup helper
-    void cleanupSpell();
+    // Starts the animation for activeSpell_; returns 0 if it could not be posted
+    AnimationHandle startSpellAnimation(uint32_t now);
+
+    // Logs the Rainbow Burst phase changes
+    void logRainbowPhase(uint32_t elapsedTime);
+
+    // Draws a procedural spell (e.g. Lightning Blast's random crackle) through its SpellRenderFn
+    static bool renderProceduralSpell(void* context, uint32_t elapsedMs, Color* frame, uint8_t* coverage);
+
+    // Marks the spell complete when its animation finishes
+    static void onSpellAnimationDone(AnimationHandle handle, AnimationEnd reason, void* context);
 };
 
 #endif // QUICKCAST_SPELLS_MODE_H 
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "DebugTools.h"
 #include <Arduino.h>
 #include <stdarg.h>
+#include "../hardware/SerialTx.h"
 
 namespace DebugTools {
   // Timing variables
@@ -13,21 +14,21 @@ namespace DebugTools {
     #ifdef DEBUG_ENABLED
     Serial.begin(baudRate);
     delay(500); // Give serial time to connect
-    Serial.println("Debug initialized");
+    SerialOut.println("Debug initialized");
     #endif
   }
   
   // Print debug message
   void print(const char* message) {
     #ifdef DEBUG_ENABLED
-    Serial.print(message);
+    SerialOut.print(message);
     #endif
   }
   
   // Print debug message with newline
   void println(const char* message) {
     #ifdef DEBUG_ENABLED
-    Serial.println(message);
+    SerialOut.println(message);
     #endif
   }
   
@@ -39,7 +40,7 @@ namespace DebugTools {
     va_start(args, format);
     vsnprintf(buffer, sizeof(buffer), format, args);
     va_end(args);
-    Serial.print(buffer);
+    SerialOut.print(buffer);
     #endif
   }
   
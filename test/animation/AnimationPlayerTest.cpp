@@ -0,0 +1,127 @@
+#include <Arduino.h>
+#include "../../src/animation/AnimationPlayer.h"
+#include "../../src/animation/AnimationPrograms.h"
+#include "../../src/core/Config.h"
+#include "../helpers/TestCheck.h"
+
+static bool sameColor(const Color& c, uint8_t r, uint8_t g, uint8_t b) {
+    return c.r == r && c.g == g && c.b == b;
+}
+
+struct ProgramInfo {
+    const char* name;
+    const uint8_t* data;
+    uint16_t size;
+};
+
+static const ProgramInfo PROGRAMS[] = {
+    {"rainbow_burst", ANIM_RAINBOW_BURST, ANIM_RAINBOW_BURST_SIZE},
+    {"lumina", ANIM_LUMINA, ANIM_LUMINA_SIZE},
+    {"cancel_flash", ANIM_CANCEL_FLASH, ANIM_CANCEL_FLASH_SIZE},
+    {"checkpoint_flash", ANIM_CHECKPOINT_FLASH, ANIM_CHECKPOINT_FLASH_SIZE},
+    {"freecast_transition", ANIM_FREECAST_TRANSITION, ANIM_FREECAST_TRANSITION_SIZE},
+    {"invocation_transition", ANIM_INVOCATION_TRANSITION, ANIM_INVOCATION_TRANSITION_SIZE},
+};
+
+/**
+ * @brief Every compiled program must pass validation; corrupt copies must not
+ */
+void testProgramValidation() {
+    Serial.println("\n[Validation]");
+
+    for (const ProgramInfo& p : PROGRAMS) {
+        check(AnimationPlayer::validate(p.data, p.size), p.name);
+    }
+
+    uint8_t copy[64];
+    memcpy(copy, ANIM_CANCEL_FLASH, ANIM_CANCEL_FLASH_SIZE);
+    check(!AnimationPlayer::validate(copy, ANIM_CANCEL_FLASH_SIZE - 1), "rejects truncated program");
+    copy[0] = 'X';
+    check(!AnimationPlayer::validate(copy, ANIM_CANCEL_FLASH_SIZE), "rejects bad magic");
+}
+
+/**
+ * @brief Keyframe semantics: step holds, linear fades, loops and parameters
+ */
+void testPlayback() {
+    Serial.println("\n[Playback]");
+
+    AnimationPlayer player;
+    Color frame[Config::NUM_LEDS];
+
+    // cancel_flash: 50 ms white / 50 ms black, looping every 100 ms, 300 ms total
+    player.load(ANIM_CANCEL_FLASH, ANIM_CANCEL_FLASH_SIZE);
+    player.evaluate(10, frame, Config::NUM_LEDS);
+    check(sameColor(frame[0], 255, 255, 255) && sameColor(frame[11], 255, 255, 255), "flash on");
+    player.evaluate(60, frame, Config::NUM_LEDS);
+    check(sameColor(frame[5], 0, 0, 0), "flash off");
+    player.evaluate(210, frame, Config::NUM_LEDS);
+    check(sameColor(frame[5], 255, 255, 255), "track loop repeats");
+    check(!player.evaluate(300, frame, Config::NUM_LEDS), "program reports finished");
+
+    // lumina: first six LEDs fade linearly, the rest stay black
+    player.load(ANIM_LUMINA, ANIM_LUMINA_SIZE);
+    player.evaluate(0, frame, Config::NUM_LEDS);
+    check(sameColor(frame[0], 255, 255, 255) && sameColor(frame[6], 0, 0, 0), "lumina start");
+    player.evaluate(30000, frame, Config::NUM_LEDS);
+    check(frame[3].r >= 126 && frame[3].r <= 128, "lumina halfway");
+    player.evaluate(59999, frame, Config::NUM_LEDS);
+    check(frame[5].r <= 1, "lumina end");
+
+    // invocation_transition: color from parameter slot 0
+    player.load(ANIM_INVOCATION_TRANSITION, ANIM_INVOCATION_TRANSITION_SIZE);
+    player.setParam(0, {128, 0, 128});
+    player.evaluate(100, frame, Config::NUM_LEDS);
+    check(sameColor(frame[4], 128, 0, 128), "parameter slot color");
+
+    // render() stops once the program is over
+    player.load(ANIM_CHECKPOINT_FLASH, ANIM_CHECKPOINT_FLASH_SIZE);
+    player.start(1000);
+    check(player.render(1100, frame, Config::NUM_LEDS), "render while running");
+    check(!player.render(1200, frame, Config::NUM_LEDS) && !player.isPlaying(), "render stops at end");
+
+    // Easing endpoints
+    bool endpoints = true;
+    for (uint8_t e = AnimBytecode::EASE_LINEAR; e < AnimBytecode::EASE_COUNT; e++) {
+        if (e == AnimBytecode::EASE_STEP) continue;
+        endpoints &= AnimBytecode::applyEase(e, 0) == 0 && AnimBytecode::applyEase(e, 255) == 255;
+    }
+    check(endpoints, "easing curves span 0-255");
+}
+
+/**
+ * @brief Per-frame evaluation cost of each compiled program
+ */
+void benchmarkPrograms() {
+    Serial.println("\n[Evaluation cost]");
+
+    AnimationPlayer player;
+    Color frame[Config::NUM_LEDS];
+    const uint16_t ITERATIONS = 1000;
+
+    for (const ProgramInfo& p : PROGRAMS) {
+        player.load(p.data, p.size);
+        uint32_t step = player.getDuration() / ITERATIONS + 1;
+
+        unsigned long start = micros();
+        for (uint16_t i = 0; i < ITERATIONS; i++) {
+            player.evaluate((uint32_t)i * step, frame, Config::NUM_LEDS);
+        }
+        unsigned long elapsed = micros() - start;
+
+        Serial.printf("    %-22s %4u bytes  %.2f us/frame\n", p.name, p.size, (float)elapsed / ITERATIONS);
+    }
+}
+
+/**
+ * @brief Run all animation player tests
+ */
+void testAnimationPlayer() {
+    resetChecks();
+
+    testProgramValidation();
+    testPlayback();
+    benchmarkPrograms();
+
+    reportChecks("Animation player");
+}
@@ -0,0 +1,257 @@
+#include <Arduino.h>
+#include "../../src/animation/AnimationSystem.h"
+#include "../../src/animation/AnimationPrograms.h"
+#include "../helpers/TestCheck.h"
+
+static bool sameColor(const Color& a, const Color& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+// Fills LEDs [first, first + count) with the color passed as context
+static bool fillRange(void* context, uint32_t elapsedMs, Color* frame, uint8_t* coverage, uint16_t first, uint16_t count) {
+    const Color* color = static_cast<const Color*>(context);
+    for (uint16_t i = first; i < first + count && i < Config::NUM_LEDS; i++) {
+        frame[i] = *color;
+        coverage[i] = 255;
+    }
+    return true;
+}
+
+static bool fillAll(void* context, uint32_t elapsedMs, Color* frame, uint8_t* coverage) {
+    return fillRange(context, elapsedMs, frame, coverage, 0, Config::NUM_LEDS);
+}
+
+static bool fillFirstHalf(void* context, uint32_t elapsedMs, Color* frame, uint8_t* coverage) {
+    return fillRange(context, elapsedMs, frame, coverage, 0, Config::NUM_LEDS / 2);
+}
+
+static bool finishAt100(void* context, uint32_t elapsedMs, Color* frame, uint8_t* coverage) {
+    fillAll(context, elapsedMs, frame, coverage);
+    return elapsedMs < 100;
+}
+
+static const Color RED = {255, 0, 0};
+static const Color GREEN = {0, 255, 0};
+static const Color BLUE = {0, 0, 255};
+
+// Records the last end notification
+struct DoneLog {
+    uint8_t calls;
+    AnimationHandle handle;
+    AnimationEnd reason;
+};
+
+static void recordDone(AnimationHandle handle, AnimationEnd reason, void* context) {
+    DoneLog* log = static_cast<DoneLog*>(context);
+    log->calls++;
+    log->handle = handle;
+    log->reason = reason;
+}
+
+static AnimationRequest request(AnimationRenderFn render, const Color* color, LEDLayer layer, uint8_t priority) {
+    return AnimationRequest::fromCallback(render, const_cast<Color*>(color), layer, priority);
+}
+
+/**
+ * @brief Layers and priorities decide which animation ends up on top
+ */
+void testDrawOrder() {
+    Serial.println("\n[Draw order]");
+
+    static LEDCompositor compositor;
+    static AnimationSystem animations;
+    animations.init(&compositor);
+    Color out[Config::NUM_LEDS];
+
+    // Started high priority first; the low one must still draw underneath
+    animations.start(request(fillFirstHalf, &RED, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_HIGH), 0);
+    animations.start(request(fillAll, &GREEN, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_LOW), 0);
+    animations.update(10);
+    compositor.flatten(out);
+    check(sameColor(out[0], RED) && sameColor(out[Config::NUM_LEDS - 1], GREEN),
+          "higher priority draws over lower on the same layer");
+
+    // Equal priority: the newer animation is on top
+    animations.start(request(fillFirstHalf, &BLUE, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_HIGH), 0);
+    animations.update(20);
+    compositor.flatten(out);
+    check(sameColor(out[0], BLUE), "equal priority keeps start order");
+
+    // A lower layer never covers a higher one, whatever its priority
+    animations.cancelAll();
+    animations.start(request(fillAll, &GREEN, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_LOW), 0);
+    animations.start(request(fillAll, &RED, LEDLayer::BASE, AnimationSystem::PRIORITY_ALERT), 0);
+    animations.update(30);
+    compositor.flatten(out);
+    check(sameColor(out[0], GREEN), "higher layer draws over lower layer");
+
+    // Programs only cover the LEDs their tracks drive
+    animations.cancelAll();
+    compositor.clear(LEDLayer::BASE);
+    compositor.fill(LEDLayer::BASE, BLUE);
+    animations.start(AnimationRequest::fromProgram(ANIM_LUMINA, ANIM_LUMINA_SIZE, LEDLayer::EFFECTS,
+                                                   AnimationSystem::PRIORITY_NORMAL), 0);
+    animations.update(0);
+    compositor.flatten(out);
+    check(sameColor(out[0], Color{255, 255, 255}), "program pixels are drawn");
+    check(Config::NUM_LEDS <= 12 || sameColor(out[Config::NUM_LEDS - 1], BLUE), "undriven LEDs show the layer below");
+
+    animations.cancelAll();
+    animations.update(40);
+    check(!compositor.hasContent(LEDLayer::EFFECTS), "layer is cleared once nothing draws into it");
+}
+
+/**
+ * @brief Completion, stop, cancel and preemption each report once with their reason
+ */
+void testLifecycle() {
+    Serial.println("\n[Lifecycle]");
+
+    static LEDCompositor compositor;
+    static AnimationSystem animations;
+    animations.init(&compositor);
+    DoneLog log = {0, 0, AnimationEnd::COMPLETED};
+
+    AnimationRequest timed = request(fillAll, &RED, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_NORMAL);
+    timed.durationMs = 50;
+    timed.onDone = recordDone;
+    timed.doneContext = &log;
+    AnimationHandle handle = animations.start(timed, 1000);
+    check(handle != 0 && animations.isActive(handle), "start returns an active handle");
+
+    animations.update(1049);
+    check(log.calls == 0 && compositor.hasContent(LEDLayer::EFFECTS), "runs until its duration");
+    animations.update(1050);
+    check(log.calls == 1 && log.handle == handle && log.reason == AnimationEnd::COMPLETED,
+          "duration end reports COMPLETED");
+    check(!animations.isActive(handle) && animations.getActiveCount() == 0, "completed animation is released");
+
+    AnimationRequest selfEnding = request(finishAt100, &RED, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_NORMAL);
+    selfEnding.onDone = recordDone;
+    selfEnding.doneContext = &log;
+    handle = animations.start(selfEnding, 0);
+    animations.update(99);
+    animations.update(100);
+    check(log.calls == 2 && log.reason == AnimationEnd::COMPLETED, "callback returning false completes the animation");
+
+    handle = animations.start(timed, 0);
+    check(animations.stop(handle) && log.calls == 3 && log.reason == AnimationEnd::STOPPED, "stop reports STOPPED");
+    check(!animations.stop(handle) && log.calls == 3, "stopping twice does nothing");
+
+    handle = animations.start(timed, 0);
+    check(animations.cancel(handle) && log.reason == AnimationEnd::CANCELLED, "cancel reports CANCELLED");
+
+    // The slot is reused; the old handle must not reach the new animation
+    AnimationHandle reused = animations.start(timed, 0);
+    check(reused != handle && !animations.cancel(handle) && animations.isActive(reused), "stale handles are rejected");
+
+    animations.start(request(fillAll, &GREEN, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_ALERT), 0);
+    animations.cancelLayer(LEDLayer::EFFECTS, AnimationSystem::PRIORITY_NORMAL);
+    check(!animations.isActive(reused) && animations.getActiveCount() == 1, "cancelLayer spares higher priorities");
+
+    // Fill the pool with low priorities, then ask for more
+    animations.cancelAll();
+    AnimationRequest low = request(fillAll, &RED, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_LOW);
+    low.onDone = recordDone;
+    low.doneContext = &log;
+    for (uint8_t i = 0; i < Config::ANIMATION_SLOTS; i++) {
+        animations.start(low, i);
+    }
+    check(animations.start(low, 0) == 0, "full pool rejects an equal priority");
+    uint8_t before = log.calls;
+    AnimationHandle urgent = animations.start(request(fillAll, &BLUE, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_HIGH), 0);
+    check(urgent != 0 && log.calls == before + 1 && log.reason == AnimationEnd::PREEMPTED,
+          "full pool preempts a lower priority");
+    check(animations.getActiveCount() == Config::ANIMATION_SLOTS, "pool size is fixed");
+
+    check(animations.start(AnimationRequest::fromProgram(ANIM_LUMINA, 4, LEDLayer::EFFECTS, 255), 0) == 0,
+          "malformed program is rejected");
+}
+
+static AnimationSystem* chainSystem = nullptr;
+static uint8_t chainCount = 0;
+
+static void startNext(AnimationHandle handle, AnimationEnd reason, void* context) {
+    if (reason != AnimationEnd::COMPLETED || ++chainCount >= 3) {
+        return;
+    }
+    AnimationRequest next = request(fillAll, &GREEN, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_NORMAL);
+    next.durationMs = 10;
+    next.onDone = startNext;
+    next.doneContext = context;
+    chainSystem->start(next, *static_cast<uint32_t*>(context));
+}
+
+/**
+ * @brief Completion callbacks can start the next animation
+ */
+void testChaining() {
+    Serial.println("\n[Chaining]");
+
+    static LEDCompositor compositor;
+    static AnimationSystem animations;
+    animations.init(&compositor);
+    chainSystem = &animations;
+    chainCount = 0;
+
+    static uint32_t now = 0;
+    AnimationRequest first = request(fillAll, &GREEN, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_NORMAL);
+    first.durationMs = 10;
+    first.onDone = startNext;
+    first.doneContext = &now;
+    animations.start(first, now);
+    for (now = 0; now <= 100; now += 5) {
+        animations.update(now);
+    }
+    check(chainCount == 3 && animations.getActiveCount() == 0, "three chained animations ran back to back");
+
+    // Looping programs repeat until their duration
+    AnimationRequest loop = AnimationRequest::fromProgram(ANIM_CANCEL_FLASH, ANIM_CANCEL_FLASH_SIZE, LEDLayer::EFFECTS,
+                                                          AnimationSystem::PRIORITY_NORMAL);
+    loop.loop = true;
+    loop.durationMs = 3 * 300;
+    AnimationHandle handle = animations.start(loop, 0);
+    Color out[Config::NUM_LEDS];
+    animations.update(610);
+    compositor.flatten(out);
+    check(animations.isActive(handle) && out[0].r == 255, "looping program restarts");
+    animations.update(900);
+    check(!animations.isActive(handle), "looping program ends at its duration");
+}
+
+/**
+ * @brief Per-frame cost grows with active animations, not pool size
+ */
+void benchmarkAnimationSystem() {
+    Serial.println("\n[Update cost]");
+
+    static LEDCompositor compositor;
+    static AnimationSystem animations;
+    const uint16_t frames = 1000;
+
+    for (uint8_t active = 0; active <= Config::ANIMATION_SLOTS; active += 2) {
+        animations.init(&compositor);
+        for (uint8_t i = 0; i < active; i++) {
+            animations.start(request(fillFirstHalf, &RED, LEDLayer::EFFECTS, AnimationSystem::PRIORITY_NORMAL), 0);
+        }
+        unsigned long start = micros();
+        for (uint16_t f = 0; f < frames; f++) {
+            animations.update(f);
+        }
+        Serial.printf("    %u active: %6.2f us/frame\n", active, (float)(micros() - start) / frames);
+    }
+}
+
+/**
+ * @brief Run all animation system tests
+ */
+void testAnimationSystem() {
+    resetChecks();
+
+    testDrawOrder();
+    testLifecycle();
+    testChaining();
+    benchmarkAnimationSystem();
+
+    reportChecks("Animation system");
+}
@@ -0,0 +1,199 @@
+#include <Arduino.h>
+#include <string.h>
+#include "../../src/core/BootSequence.h"
+#include "../../src/core/Config.h"
+#include "../helpers/TestCheck.h"
+
+// Collects a report as text
+class ReportBuffer : public Print {
+public:
+    ReportBuffer() : length(0) { text[0] = '\0'; }
+
+    size_t write(uint8_t c) override {
+        if (length + 1 < sizeof(text)) {
+            text[length++] = (char)c;
+            text[length] = '\0';
+        }
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        for (size_t i = 0; i < size; i++) {
+            write(data[i]);
+        }
+        return size;
+    }
+
+    bool contains(const char* part) const { return strstr(text, part) != nullptr; }
+
+    char text[2048];
+    size_t length;
+};
+
+// Background task and deferred tasks record what ran, in order
+static uint16_t backgroundCalls = 0;
+static uint32_t lastBackgroundMs = 0;
+static char ranOrder[8];
+static uint8_t ranCount = 0;
+
+static void countBackground(void* context, uint32_t nowMs) {
+    backgroundCalls++;
+    lastBackgroundMs = nowMs;
+    (void)context;
+}
+
+static void recordTask(void* context) {
+    if (ranCount + 1u < sizeof(ranOrder)) {
+        ranOrder[ranCount++] = *static_cast<const char*>(context);
+        ranOrder[ranCount] = '\0';
+    }
+}
+
+static void resetRecord() {
+    backgroundCalls = 0;
+    lastBackgroundMs = 0;
+    ranCount = 0;
+    ranOrder[0] = '\0';
+}
+
+/**
+ * @brief Stages are recorded in order with their end times
+ */
+void testStages() {
+    Serial.println("\n[Stages]");
+    BootSequence::reset();
+
+    BootSequence::mark("one");
+    delay(5);
+    BootSequence::mark("two");
+
+    check(BootSequence::stageCount() == 2, "each mark records a stage");
+    check(strcmp(BootSequence::stage(0).name, "one") == 0 && strcmp(BootSequence::stage(1).name, "two") == 0,
+          "stages keep their order and names");
+    uint32_t spent = BootSequence::stage(1).endUs - BootSequence::stage(0).endUs;
+    check(spent >= 5000 && spent < 50000, "a stage's time is the gap to the previous mark");
+
+    for (uint8_t i = 0; i < BOOT_MAX_STAGES + 3; i++) {
+        BootSequence::mark("filler");
+    }
+    check(BootSequence::stageCount() == BOOT_MAX_STAGES, "marks past the capacity are dropped");
+}
+
+/**
+ * @brief wait() keeps the background task running and lasts as long as asked
+ */
+void testWait() {
+    Serial.println("\n[Wait]");
+    BootSequence::reset();
+    resetRecord();
+
+    uint32_t start = millis();
+    BootSequence::wait(20);
+    check(millis() - start >= 20 && backgroundCalls == 0, "without a background task wait() is a delay");
+
+    BootSequence::setBackground(countBackground, nullptr);
+    start = millis();
+    BootSequence::wait(20);
+    uint32_t waited = millis() - start;
+    check(waited >= 20 && waited < 60, "wait() lasts the time asked");
+    check(backgroundCalls >= 5, "the background task runs throughout the wait");
+    check(lastBackgroundMs >= start, "the background task gets the current time");
+
+    BootSequence::setBackground(nullptr, nullptr);
+    uint16_t calls = backgroundCalls;
+    BootSequence::wait(5);
+    check(backgroundCalls == calls, "clearing the background task stops it");
+}
+
+/**
+ * @brief Deferred tasks wait for finish() and then run once, in order, each as a stage
+ */
+void testDeferred() {
+    Serial.println("\n[Deferred]");
+    BootSequence::reset();
+    resetRecord();
+
+    static const char a = 'a', b = 'b', c = 'c';
+    BootSequence::mark("hardware");
+    check(BootSequence::defer("task a", recordTask, (void*)&a) && BootSequence::defer("task b", recordTask, (void*)&b),
+          "tasks are held back");
+    check(ranCount == 0, "nothing runs before the first frame");
+
+    BootSequence::finish(nullptr);
+    check(BootSequence::isFinished() && strcmp(ranOrder, "ab") == 0, "finish() runs them in order");
+    check(BootSequence::stageCount() == 4 && strcmp(BootSequence::stage(1).name, "first frame") == 0 &&
+          strcmp(BootSequence::stage(3).name, "task b") == 0, "the first frame and each task are stages");
+    check(BootSequence::firstFrameUs() > 0 && BootSequence::readyUs() >= BootSequence::firstFrameUs(),
+          "first frame and ready times are kept");
+
+    BootSequence::finish(nullptr);
+    check(strcmp(ranOrder, "ab") == 0 && BootSequence::stageCount() == 4, "a second finish() does nothing");
+    check(!BootSequence::defer("task c", recordTask, (void*)&c) && strcmp(ranOrder, "abc") == 0,
+          "a task deferred after the first frame runs at once");
+
+    BootSequence::reset();
+    resetRecord();
+    for (uint8_t i = 0; i < BOOT_MAX_DEFERRED; i++) {
+        BootSequence::defer("queued", recordTask, (void*)&a);
+    }
+    check(!BootSequence::defer("overflow", recordTask, (void*)&b) && strcmp(ranOrder, "b") == 0,
+          "a task past the capacity runs at once");
+}
+
+/**
+ * @brief The report lists every stage and judges the first frame against the budget
+ */
+void testReport() {
+    Serial.println("\n[Report]");
+    BootSequence::reset();
+
+    BootSequence::mark("leds");
+    ReportBuffer early;
+    BootSequence::report(early);
+    check(early.contains("leds") && early.contains("not out yet"), "a report before the first frame says so");
+
+    BootSequence::finish(nullptr);
+    ReportBuffer report;
+    BootSequence::finish(&report);
+    check(report.length == 0, "only the first finish() reports");
+    BootSequence::report(report);
+    check(report.contains("leds") && report.contains("first frame"), "every stage is listed");
+    check(report.contains("budget") && report.contains("ready at"), "the first frame and ready times are printed");
+    bool overBudget = BootSequence::firstFrameUs() > Config::Boot::BUDGET_MS * 1000UL;
+    check(report.contains("WARNING") == overBudget, "the warning matches the budget");
+}
+
+/**
+ * @brief Marks are sprinkled through startup, so they must cost next to nothing
+ */
+void benchmarkBootSequence() {
+    Serial.println("\n[Benchmark]");
+
+    const uint16_t rounds = 1000;
+    uint32_t start = micros();
+    for (uint16_t r = 0; r < rounds; r++) {
+        BootSequence::reset();
+        for (uint8_t i = 0; i < BOOT_MAX_STAGES; i++) {
+            BootSequence::mark("stage");
+        }
+    }
+    float us = (float)(micros() - start) / (rounds * BOOT_MAX_STAGES);
+    Serial.printf("    mark %6.3f us/stage\n", us);
+    check(us < 5.0f, "a mark costs under 5 us");
+    BootSequence::reset();
+}
+
+/**
+ * @brief Run all boot sequence tests
+ */
+void testBootSequence() {
+    resetChecks();
+
+    testStages();
+    testWait();
+    testDeferred();
+    testReport();
+    benchmarkBootSequence();
+
+    reportChecks("Boot sequence");
+}
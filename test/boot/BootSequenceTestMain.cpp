@@ -0,0 +1,19 @@
+#include <Arduino.h>
+
+// Forward declaration of test function
+extern void testBootSequence();
+
+void setup() {
+  // Initialize serial communication
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("PrismaTech Gauntlet 3.0 - Boot Sequence Test");
+
+  // Run boot sequence tests and benchmark
+  testBootSequence();
+}
+
+void loop() {
+  // Just delay in the main loop
+  delay(1000);
+}
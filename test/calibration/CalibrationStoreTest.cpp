@@ -0,0 +1,303 @@
+#include <Arduino.h>
+#include "../../src/core/CalibrationStore.h"
+#include "../../src/core/SystemTypes.h"
+#include "../../src/core/Config.h"
+#include <stddef.h>
+#include <string.h>
+#include "../helpers/TestCheck.h"
+
+// Kept apart from the gauntlet's own calibration
+static const char* TEST_STORE = "calibtest";
+
+static CalibrationData makeData(float threshold) {
+    CalibrationData data;
+    CalibrationStore::defaults(data);
+    data.profiles[0].thresholds[POS_OFFER] = threshold;
+    data.profiles[0].dominantAxes[POS_OFFER] = 1;
+    data.flags = CALIBRATION_HAS_IMU_OFFSETS;
+    data.accelOffset[2] = -312;
+    data.gyroOffset[0] = 17;
+    data.imuWhoAmI = 0x71;
+    data.imuTemperature = 2350;
+    data.scalingFactor = 9.81f / 8192.0f;
+    return data;
+}
+
+// Rewrite a stored slot with one byte changed
+static void corruptSlot(uint8_t slot, size_t offset) {
+    uint8_t blob[CalibrationStore::SLOT_SIZE];
+    size_t length = CalibrationStore::readSlot(slot, blob, sizeof(blob));
+    blob[offset % length] ^= 0x40;
+    CalibrationStore::writeSlot(slot, blob, length);
+}
+
+/**
+ * @brief An empty store gives the Config::Calibrated values
+ */
+void testDefaults() {
+    Serial.println("\n[Defaults]");
+
+    check(CalibrationStore::crc32((const uint8_t*)"123456789", 9) == 0xCBF43926, "CRC-32 check value");
+
+    CalibrationStore::begin(TEST_STORE);
+    CalibrationStore::erase();
+    check(!CalibrationStore::begin(TEST_STORE) && !CalibrationStore::isStored(), "nothing stored after erase");
+    const CalibrationData& data = CalibrationStore::data();
+    const CalibrationProfile& profile = CalibrationStore::active();
+    check(profile.thresholds[POS_OFFER] == Config::Calibrated::OFFER_THRESHOLD &&
+          profile.thresholds[POS_NULLPOS] == Config::Calibrated::NULL_THRESHOLD &&
+          profile.dominantAxes[POS_SHIELD] == Config::Calibrated::SHIELD_AXIS,
+          "defaults are the calibrated thresholds and axes, not the raw-unit ones");
+    check(data.profileCount == 1 && CalibrationStore::activeProfile() == 0 && strcmp(profile.name, "wearer1") == 0,
+          "defaults hold one profile");
+    check(data.scalingFactor == 0.0f && data.flags == 0, "defaults keep the detector's scaling and carry no IMU offsets");
+}
+
+/**
+ * @brief Commits alternate slots and the newest record is loaded at boot
+ */
+void testCommit() {
+    Serial.println("\n[Commit]");
+
+    CalibrationData first = makeData(8.5f);
+    check(CalibrationStore::commit(first) && CalibrationStore::sequence() == 1, "first commit");
+    check(CalibrationStore::begin(TEST_STORE) && memcmp(&CalibrationStore::data(), &first, sizeof(first)) == 0,
+          "the record reads back at boot with every field");
+    check(CalibrationStore::storedVersion() == CalibrationStore::VERSION, "stored with the current schema");
+
+    CalibrationData second = makeData(9.5f);
+    second.flags |= CALIBRATION_HAS_WEIGHTS;
+    second.weightCount = 3;
+    second.weights[2] = 0.25f;
+    CalibrationStore::commit(second);
+    uint8_t blob[CalibrationStore::SLOT_SIZE];
+    CalibrationHeader slot0, slot1;
+    CalibrationStore::readSlot(0, blob, sizeof(blob));
+    memcpy(&slot0, blob, sizeof(slot0));
+    CalibrationStore::readSlot(1, blob, sizeof(blob));
+    memcpy(&slot1, blob, sizeof(slot1));
+    check(slot0.sequence == 1 && slot1.sequence == 2, "the second commit goes to the other slot");
+    check(CalibrationStore::begin(TEST_STORE) && CalibrationStore::sequence() == 2 &&
+          CalibrationStore::active().thresholds[POS_OFFER] == 9.5f && CalibrationStore::data().weights[2] == 0.25f,
+          "the newer record wins");
+
+    CalibrationStore::commit(makeData(10.5f));
+    check(CalibrationStore::begin(TEST_STORE) && CalibrationStore::sequence() == 3 &&
+          CalibrationStore::active().thresholds[POS_OFFER] == 10.5f, "the third commit overwrites the oldest slot");
+}
+
+/**
+ * @brief A damaged or unknown record falls back to the other slot
+ */
+void testRecovery() {
+    Serial.println("\n[Recovery]");
+
+    // Sequence 3 sits in slot 0, sequence 2 in slot 1
+    corruptSlot(0, sizeof(CalibrationHeader) + 5);
+    check(CalibrationStore::begin(TEST_STORE) && CalibrationStore::sequence() == 2 &&
+          CalibrationStore::active().thresholds[POS_OFFER] == 9.5f, "a payload failing its CRC falls back to the previous record");
+
+    // A commit interrupted part way leaves a short slot
+    uint8_t blob[CalibrationStore::SLOT_SIZE];
+    size_t length = CalibrationStore::readSlot(1, blob, sizeof(blob));
+    CalibrationStore::commit(makeData(11.5f));
+    CalibrationStore::writeSlot(0, blob, length / 2);
+    check(CalibrationStore::begin(TEST_STORE) && CalibrationStore::sequence() == 2,
+          "a half-written slot is ignored");
+
+    CalibrationStore::commit(makeData(12.5f));
+    corruptSlot(0, 4);
+    check(CalibrationStore::begin(TEST_STORE) && CalibrationStore::sequence() == 2,
+          "a header failing its CRC is ignored");
+
+    // A record from newer firmware: intact, but a schema this build does not know
+    CalibrationStore::commit(makeData(13.5f));
+    length = CalibrationStore::readSlot(0, blob, sizeof(blob));
+    CalibrationHeader header;
+    memcpy(&header, blob, sizeof(header));
+    header.version = CalibrationStore::VERSION + 1;
+    header.crc = CalibrationStore::crc32((const uint8_t*)&header, offsetof(CalibrationHeader, crc));
+    header.crc = CalibrationStore::crc32(blob + sizeof(header), header.size, header.crc);
+    memcpy(blob, &header, sizeof(header));
+    CalibrationStore::writeSlot(0, blob, length);
+    check(CalibrationStore::begin(TEST_STORE) && CalibrationStore::sequence() == 2,
+          "an unknown schema version is skipped");
+
+    corruptSlot(1, 0);
+    check(!CalibrationStore::begin(TEST_STORE) && CalibrationStore::active().thresholds[POS_OFFER] ==
+          Config::Calibrated::OFFER_THRESHOLD, "with both slots unusable the defaults apply");
+    check(CalibrationStore::commit(makeData(14.5f)) && CalibrationStore::begin(TEST_STORE) &&
+          CalibrationStore::sequence() == 1, "a commit after that starts over");
+}
+
+// The calibration two wearers would have
+static CalibrationData makeProfiles() {
+    CalibrationData data = makeData(8.5f);
+    CalibrationStore::defaults(data.profiles[1], 1);
+    data.profiles[1].thresholds[POS_OFFER] = 6.5f;
+    strcpy(data.profiles[1].name, "guest");
+    data.profileCount = 2;
+    return data;
+}
+
+// Read the sequence numbers of both slots
+static void slotSequences(uint32_t& slot0, uint32_t& slot1) {
+    uint8_t blob[CalibrationStore::SLOT_SIZE];
+    CalibrationHeader header;
+    CalibrationStore::readSlot(0, blob, sizeof(blob));
+    memcpy(&header, blob, sizeof(header));
+    slot0 = header.sequence;
+    CalibrationStore::readSlot(1, blob, sizeof(blob));
+    memcpy(&header, blob, sizeof(header));
+    slot1 = header.sequence;
+}
+
+/**
+ * @brief Profiles switch in RAM; only the boot profile is stored
+ */
+void testProfiles() {
+    Serial.println("\n[Profiles]");
+
+    CalibrationStore::erase();
+    CalibrationStore::commit(makeProfiles());
+    check(CalibrationStore::begin(TEST_STORE) && CalibrationStore::profileCount() == 2 &&
+          CalibrationStore::activeProfile() == 0, "both profiles load, the boot profile active");
+
+    check(CalibrationStore::find("guest") == 1 && CalibrationStore::find("2") == 1 &&
+          CalibrationStore::find("wearer1") == 0, "profiles are found by name or number");
+    check(CalibrationStore::find("3") == -1 && CalibrationStore::find("0") == -1 &&
+          CalibrationStore::find("nobody") == -1, "unknown profiles are not found");
+
+    uint32_t before0, before1, after0, after1;
+    slotSequences(before0, before1);
+    check(CalibrationStore::select(1) && CalibrationStore::active().thresholds[POS_OFFER] == 6.5f,
+          "select switches the active profile");
+    slotSequences(after0, after1);
+    check(before0 == after0 && before1 == after1 && CalibrationStore::sequence() == 1, "switching writes nothing");
+    check(!CalibrationStore::select(2) && CalibrationStore::activeProfile() == 1, "a profile not in use cannot be selected");
+
+    CalibrationData data = CalibrationStore::data();
+    data.bootProfile = 1;
+    CalibrationStore::commit(data);
+    check(CalibrationStore::begin(TEST_STORE) && CalibrationStore::activeProfile() == 1,
+          "the boot profile is active after a restart");
+
+    data.profileCount = 0;
+    check(!CalibrationStore::commit(data) && CalibrationStore::sequence() == 2, "a record without profiles is refused");
+}
+
+/**
+ * @brief Records stored by older firmware load in the current schema
+ */
+void testMigration() {
+    Serial.println("\n[Migration]");
+
+    // Schema 1 layout: thresholds[6], dominantAxes[6], flags, weightCount,
+    // accelOffset[3], gyroOffset[3], scalingFactor, weights[16]
+    uint8_t v1[48 + 4 * CALIBRATION_MAX_WEIGHTS];
+    memset(v1, 0, sizeof(v1));
+    float threshold = 7.25f;
+    memcpy(v1, &threshold, sizeof(threshold));
+    v1[24] = 1;
+    v1[30] = CALIBRATION_HAS_IMU_OFFSETS;
+    int16_t accelZ = -312;
+    memcpy(v1 + 36, &accelZ, sizeof(accelZ));
+    float scaling = 9.81f / 8192.0f;
+    memcpy(v1 + 44, &scaling, sizeof(scaling));
+
+    CalibrationHeader header;
+    header.magic = 0x50544353;
+    header.version = 1;
+    header.size = sizeof(v1);
+    header.sequence = 7;
+    header.crc = CalibrationStore::crc32((const uint8_t*)&header, offsetof(CalibrationHeader, crc));
+    header.crc = CalibrationStore::crc32(v1, sizeof(v1), header.crc);
+    uint8_t blob[sizeof(header) + sizeof(v1)];
+    memcpy(blob, &header, sizeof(header));
+    memcpy(blob + sizeof(header), v1, sizeof(v1));
+
+    CalibrationStore::erase();
+    CalibrationStore::writeSlot(0, blob, sizeof(blob));
+    check(CalibrationStore::begin(TEST_STORE) && CalibrationStore::storedVersion() == 1 &&
+          CalibrationStore::sequence() == 7, "a schema 1 record loads");
+    const CalibrationData& data = CalibrationStore::data();
+    check(data.profileCount == 1 && data.bootProfile == 0 && data.profiles[0].thresholds[POS_OFFER] == 7.25f &&
+          data.profiles[0].dominantAxes[POS_OFFER] == 1, "its thresholds become the only profile");
+    check(data.accelOffset[2] == -312 && data.scalingFactor == scaling, "the device fields carry over");
+    check(data.flags == 0, "IMU offsets without a sensor fingerprint are not reused");
+    check(CalibrationStore::commit(data) && CalibrationStore::begin(TEST_STORE) &&
+          CalibrationStore::storedVersion() == CalibrationStore::VERSION && CalibrationStore::sequence() == 8,
+          "the next commit stores the current schema");
+
+    // Schema 2: the current layout without the IMU fingerprint
+    CalibrationData v2 = makeProfiles();
+    header.version = 2;
+    header.size = offsetof(CalibrationData, imuWhoAmI);
+    header.sequence = 20;
+    header.crc = CalibrationStore::crc32((const uint8_t*)&header, offsetof(CalibrationHeader, crc));
+    header.crc = CalibrationStore::crc32((const uint8_t*)&v2, header.size, header.crc);
+    uint8_t blob2[sizeof(header) + sizeof(v2)];
+    memcpy(blob2, &header, sizeof(header));
+    memcpy(blob2 + sizeof(header), &v2, header.size);
+    CalibrationStore::writeSlot(1, blob2, sizeof(header) + header.size);
+    check(CalibrationStore::begin(TEST_STORE) && CalibrationStore::storedVersion() == 2 &&
+          CalibrationStore::profileCount() == 2 && CalibrationStore::data().accelOffset[2] == -312 &&
+          CalibrationStore::data().flags == 0 && CalibrationStore::data().imuWhoAmI == 0,
+          "a schema 2 record keeps its profiles and drops the offsets for lack of a fingerprint");
+}
+
+/**
+ * @brief Loading at boot is two blob reads and a CRC
+ */
+void benchmarkCalibrationStore() {
+    Serial.println("\n[Benchmark]");
+
+    CalibrationStore::commit(makeData(15.5f));
+    const uint8_t runs = 20;
+    uint32_t start = micros();
+    for (uint8_t i = 0; i < runs; i++) {
+        CalibrationStore::begin(TEST_STORE);
+    }
+    uint32_t loadUs = (micros() - start) / runs;
+
+    start = micros();
+    CalibrationStore::commit(makeData(16.5f));
+    uint32_t commitUs = micros() - start;
+
+    CalibrationStore::commit(makeProfiles());
+    // What the controller does on a switch: select, then copy the profile into the detector
+    volatile float applied[6];
+    const uint16_t switches = 1000;
+    start = micros();
+    for (uint16_t i = 0; i < switches; i++) {
+        CalibrationStore::select(i % CalibrationStore::profileCount());
+        const CalibrationProfile& profile = CalibrationStore::active();
+        for (uint8_t pos = 0; pos < 6; pos++) {
+            applied[pos] = profile.thresholds[pos];
+        }
+    }
+    float switchUs = (float)(micros() - start) / switches;
+
+    Serial.printf("    load %lu us/boot, commit %lu us (%u-byte slots), switch %.3f us\n", (unsigned long)loadUs,
+                  (unsigned long)commitUs, (unsigned)CalibrationStore::SLOT_SIZE, switchUs);
+    check(loadUs < 20000, "loading takes under 20 ms");
+    check(switchUs < 50.0f, "switching profile takes under 50 us");
+
+    CalibrationStore::erase();
+}
+
+/**
+ * @brief Run all calibration store tests
+ */
+void testCalibrationStore() {
+    resetChecks();
+
+    testDefaults();
+    testCommit();
+    testRecovery();
+    testProfiles();
+    testMigration();
+    benchmarkCalibrationStore();
+
+    reportChecks("Calibration store");
+}
@@ -0,0 +1,196 @@
+#include <Arduino.h>
+#include "../../src/animation/FrameCodec.h"
+#include "../../src/animation/AnimationPlayer.h"
+#include "../../src/animation/AnimationPrograms.h"
+#include "../../src/core/Config.h"
+#include "SampleClips.h"
+#include "../helpers/TestCheck.h"
+
+static bool matchesReference(const Color* frame, const uint8_t* reference, uint16_t ledCount) {
+    for (uint16_t i = 0; i < ledCount; i++) {
+        const uint8_t* px = reference + 3 * i;
+        if (frame[i].r != px[0] || frame[i].g != px[1] || frame[i].b != px[2]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Baked clips of the keyframe programs; large enough for 60 s of Lumina
+static const uint16_t BAKE_CAPACITY = 24576;
+static uint8_t bakeBuffer[BAKE_CAPACITY];
+
+/**
+ * @brief Decode the clips produced by utils/frame_codec.py and compare
+ *        every frame with the uncompressed reference
+ */
+void testSampleClips() {
+    Serial.println("\n[Host-encoded clips]");
+
+    struct Sample {
+        const char* name;
+        const uint8_t* clip;
+        uint32_t size;
+        const uint8_t* reference;
+    };
+    const Sample samples[] = {
+        {"sample_chase (palette)", CLIP_SAMPLE_CHASE, CLIP_SAMPLE_CHASE_SIZE, CLIP_SAMPLE_CHASE_REFERENCE},
+        {"sample_gradient (rgb)", CLIP_SAMPLE_GRADIENT, CLIP_SAMPLE_GRADIENT_SIZE, CLIP_SAMPLE_GRADIENT_REFERENCE},
+    };
+
+    FrameDecoder decoder;
+    Color frame[Config::NUM_LEDS];
+
+    for (const Sample& s : samples) {
+        if (!decoder.load(s.clip, s.size) || decoder.getLedCount() != Config::NUM_LEDS) {
+            check(false, s.name);
+            continue;
+        }
+
+        const uint16_t frameBytes = 3 * Config::NUM_LEDS;
+        bool exact = true;
+        decoder.rewind(frame);
+        for (uint16_t f = 0; f < decoder.getFrameCount(); f++) {
+            exact &= decoder.next(frame);
+            exact &= matchesReference(frame, s.reference + (uint32_t)f * frameBytes, Config::NUM_LEDS);
+        }
+        exact &= !decoder.next(frame);
+        check(exact, s.name);
+    }
+
+    // Seeking backwards rewinds and replays from the start
+    decoder.load(CLIP_SAMPLE_GRADIENT, CLIP_SAMPLE_GRADIENT_SIZE);
+    decoder.rewind(frame);
+    decoder.seek(12, frame);
+    decoder.seek(5, frame);
+    check(decoder.getFrameIndex() == 5 &&
+          matchesReference(frame, CLIP_SAMPLE_GRADIENT_REFERENCE + 5 * 3 * Config::NUM_LEDS, Config::NUM_LEDS),
+          "seek backwards");
+}
+
+/**
+ * @brief Malformed clips must be rejected by validation
+ */
+void testValidation() {
+    Serial.println("\n[Validation]");
+
+    uint8_t copy[CLIP_SAMPLE_CHASE_SIZE];
+    memcpy(copy, CLIP_SAMPLE_CHASE, CLIP_SAMPLE_CHASE_SIZE);
+    check(FrameCodec::validate(copy, CLIP_SAMPLE_CHASE_SIZE), "accepts intact clip");
+    check(!FrameCodec::validate(copy, CLIP_SAMPLE_CHASE_SIZE - 1), "rejects truncated clip");
+
+    // The first frame starts right after the palette
+    const uint16_t firstOp = FrameCodec::HEADER_SIZE + 3 * copy[9];
+    const uint8_t original = copy[firstOp];
+
+    copy[firstOp] = 0xC0;
+    check(!FrameCodec::validate(copy, CLIP_SAMPLE_CHASE_SIZE), "rejects reserved opcode");
+
+    copy[firstOp] = FrameCodec::OP_SKIP | (Config::NUM_LEDS);  // One LED too many
+    check(!FrameCodec::validate(copy, CLIP_SAMPLE_CHASE_SIZE), "rejects run past frame end");
+
+    copy[firstOp] = FrameCodec::OP_FILL | (Config::NUM_LEDS - 1);
+    copy[firstOp + 1] = copy[9];  // Palette index one past the last entry
+    check(!FrameCodec::validate(copy, CLIP_SAMPLE_CHASE_SIZE), "rejects palette index out of range");
+    copy[firstOp] = original;
+
+    copy[0] = 'X';
+    check(!FrameCodec::validate(copy, CLIP_SAMPLE_CHASE_SIZE), "rejects bad magic");
+}
+
+/**
+ * @brief Bake a keyframe program at 50 fps with the on-device encoder
+ * @return Clip size in bytes, 0 if it did not fit
+ */
+static uint32_t bakeProgram(const uint8_t* program, uint16_t size, uint16_t frameCount) {
+    AnimationPlayer player;
+    Color prev[Config::NUM_LEDS] = {};
+    Color cur[Config::NUM_LEDS];
+
+    player.load(program, size);
+    FrameCodec::writeHeader(bakeBuffer, Config::NUM_LEDS, frameCount, 20);
+    uint32_t pos = FrameCodec::HEADER_SIZE;
+
+    for (uint16_t f = 0; f < frameCount; f++) {
+        memset(cur, 0, sizeof(cur));
+        player.evaluate((uint32_t)f * 20, cur, Config::NUM_LEDS);
+        uint16_t room = (BAKE_CAPACITY - pos) > 0xFFFF ? 0xFFFF : (uint16_t)(BAKE_CAPACITY - pos);
+        uint16_t written = FrameCodec::encodeFrame(prev, cur, Config::NUM_LEDS, bakeBuffer + pos, room);
+        if (written == 0) {
+            return 0;
+        }
+        pos += written;
+        memcpy(prev, cur, sizeof(prev));
+    }
+    return pos;
+}
+
+/**
+ * @brief Round trip real effects through the encoder and decoder, reporting
+ *        compression ratio and decode time
+ */
+void testEffectRoundTrip() {
+    Serial.println("\n[Effect round trip, 50 fps]");
+
+    struct Effect {
+        const char* name;
+        const uint8_t* program;
+        uint16_t size;
+    };
+    const Effect effects[] = {
+        {"rainbow_burst", ANIM_RAINBOW_BURST, ANIM_RAINBOW_BURST_SIZE},
+        {"lumina", ANIM_LUMINA, ANIM_LUMINA_SIZE},
+        {"cancel_flash", ANIM_CANCEL_FLASH, ANIM_CANCEL_FLASH_SIZE},
+    };
+
+    AnimationPlayer player;
+    FrameDecoder decoder;
+    Color frame[Config::NUM_LEDS];
+    Color expected[Config::NUM_LEDS];
+
+    for (const Effect& e : effects) {
+        player.load(e.program, e.size);
+        const uint16_t frameCount = player.getDuration() / 20;
+        const uint32_t clipSize = bakeProgram(e.program, e.size, frameCount);
+        if (clipSize == 0 || !decoder.load(bakeBuffer, clipSize)) {
+            check(false, e.name);
+            continue;
+        }
+
+        // Decode time for the whole clip
+        decoder.rewind(frame);
+        unsigned long start = micros();
+        while (decoder.next(frame)) {
+        }
+        unsigned long elapsed = micros() - start;
+
+        // Exactness against the interpreter
+        bool exact = true;
+        decoder.rewind(frame);
+        for (uint16_t f = 0; f < frameCount; f++) {
+            decoder.next(frame);
+            memset(expected, 0, sizeof(expected));
+            player.evaluate((uint32_t)f * 20, expected, Config::NUM_LEDS);
+            exact &= memcmp(frame, expected, sizeof(frame)) == 0;
+        }
+        check(exact, e.name);
+
+        const uint32_t rawSize = (uint32_t)frameCount * (3 * Config::NUM_LEDS + 1);
+        Serial.printf("    %-14s %5u frames %6u -> %5u bytes (%.1fx)  %.2f us/frame\n",
+                      e.name, frameCount, (unsigned)rawSize, (unsigned)clipSize, (float)rawSize / clipSize,
+                      (float)elapsed / frameCount);
+    }
+}
+
+/**
+ * @brief Run all frame codec tests
+ */
+void testFrameCodec() {
+    resetChecks();
+
+    testSampleClips();
+    testValidation();
+    testEffectRoundTrip();
+
+    reportChecks("Frame codec");
+}
@@ -0,0 +1,176 @@
+#ifndef FRAME_CLIPS_H
+#define FRAME_CLIPS_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Compressed frame clips
+ *
+ * GENERATED by utils/frame_codec.py - do not edit by hand.
+ * Sources: sample_chase.csv, sample_gradient.csv
+ */
+
+// sample_chase: 28 frames x 12 LEDs, 50 ms/frame, palette, 186 bytes
+const PROGMEM uint8_t CLIP_SAMPLE_CHASE[] = {
+  0x46, 0x43, 0x01, 0x01, 0x0C, 0x00, 0x1C, 0x00, 0x32, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x28,
+  0xFF, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x40, 0x03, 0x8A, 0x01, 0x41, 0x01, 0x03, 0x09, 0x81, 0x01,
+  0x40, 0x03, 0x08, 0x82, 0x01, 0x40, 0x03, 0x07, 0x83, 0x01, 0x40, 0x03, 0x06, 0x84, 0x01, 0x40,
+  0x03, 0x05, 0x85, 0x01, 0x40, 0x03, 0x04, 0x86, 0x01, 0x40, 0x03, 0x03, 0x87, 0x01, 0x40, 0x03,
+  0x02, 0x88, 0x01, 0x40, 0x03, 0x01, 0x89, 0x01, 0x40, 0x03, 0x00, 0x8A, 0x01, 0x40, 0x03, 0x40,
+  0x03, 0x04, 0x40, 0x03, 0x84, 0x01, 0x41, 0x01, 0x03, 0x84, 0x01, 0x40, 0x03, 0x03, 0x81, 0x01,
+  0x40, 0x03, 0x84, 0x01, 0x40, 0x03, 0x02, 0x82, 0x01, 0x40, 0x03, 0x84, 0x01, 0x40, 0x03, 0x01,
+  0x83, 0x01, 0x40, 0x03, 0x84, 0x01, 0x40, 0x03, 0x00, 0x84, 0x01, 0x40, 0x03, 0x84, 0x01, 0x40,
+  0x03, 0x40, 0x03, 0x84, 0x01, 0x40, 0x03, 0x84, 0x01, 0x41, 0x01, 0x03, 0x84, 0x01, 0x40, 0x03,
+  0x03, 0x81, 0x01, 0x40, 0x03, 0x84, 0x01, 0x40, 0x03, 0x02, 0x82, 0x01, 0x40, 0x03, 0x84, 0x01,
+  0x40, 0x03, 0x01, 0x83, 0x01, 0x40, 0x03, 0x84, 0x01, 0x40, 0x03, 0x00, 0x84, 0x01, 0x40, 0x03,
+  0x84, 0x01, 0x40, 0x03, 0x8B, 0x02, 0x0B, 0x0B, 0x8B, 0x00,
+};
+constexpr uint32_t CLIP_SAMPLE_CHASE_SIZE = sizeof(CLIP_SAMPLE_CHASE);
+
+// Uncompressed frames of sample_chase for round-trip tests
+const PROGMEM uint8_t CLIP_SAMPLE_CHASE_REFERENCE[] = {
+  0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF,
+  0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF,
+  0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF,
+  0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF,
+  0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF,
+  0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF,
+  0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00,
+  0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF, 0x00, 0x00,
+  0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0x00, 0x00, 0x28, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF,
+  0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00,
+  0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00,
+  0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF,
+  0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00,
+  0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00,
+  0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+// sample_gradient: 16 frames x 12 LEDs, 50 ms/frame, rgb, 532 bytes
+const PROGMEM uint8_t CLIP_SAMPLE_GRADIENT[] = {
+  0x46, 0x43, 0x01, 0x00, 0x0C, 0x00, 0x10, 0x00, 0x32, 0x00, 0x4B, 0x00, 0x00, 0xFF, 0x15, 0x05,
+  0xEE, 0x2A, 0x0A, 0xDD, 0x3F, 0x0F, 0xCC, 0x54, 0x14, 0xBB, 0x69, 0x19, 0xAA, 0x7E, 0x1E, 0x99,
+  0x93, 0x23, 0x88, 0xA8, 0x28, 0x77, 0xBD, 0x2D, 0x66, 0xD2, 0x32, 0x55, 0xE7, 0x37, 0x44, 0x41,
+  0x0D, 0x25, 0x07, 0x37, 0x2F, 0x09, 0x00, 0x41, 0x73, 0x3B, 0x09, 0x35, 0x2D, 0x0F, 0x00, 0x41,
+  0xF5, 0x5D, 0x0B, 0x33, 0x6B, 0x09, 0x00, 0x41, 0x77, 0x7F, 0x39, 0x0D, 0x65, 0x1B, 0x00, 0x40,
+  0x17, 0x6F, 0x09, 0x00, 0x41, 0x6E, 0x5E, 0x12, 0x15, 0x6D, 0x7B, 0x00, 0x41, 0xEA, 0x7A, 0x36,
+  0x13, 0x2B, 0x19, 0x00, 0x41, 0x6A, 0x5A, 0x1E, 0x1D, 0x25, 0x07, 0x00, 0x40, 0xE6, 0xB6, 0x72,
+  0x00, 0x41, 0x1E, 0x5E, 0x3E, 0x15, 0x2D, 0x07, 0x00, 0x41, 0x1A, 0xBA, 0x12, 0x13, 0xEB, 0x09,
+  0x00, 0x41, 0x1A, 0xDA, 0xF2, 0x0D, 0xE5, 0x0B, 0x00, 0x41, 0x26, 0xF6, 0x0E, 0x0F, 0x27, 0x19,
+  0x41, 0x2E, 0xDE, 0x12, 0x75, 0xED, 0x0B, 0x00, 0x41, 0x2A, 0xFA, 0x0E, 0xF3, 0x2B, 0x39, 0x00,
+  0x41, 0x2A, 0xDA, 0xF6, 0x7D, 0x25, 0x1F, 0x00, 0x41, 0x26, 0xB6, 0x12, 0xFF, 0x67, 0x79, 0x00,
+  0x40, 0x75, 0x2D, 0x3F, 0x00, 0x41, 0x3A, 0xBA, 0x72, 0xF3, 0x6B, 0x19, 0x00, 0x41, 0x3A, 0x5A,
+  0x12, 0x0D, 0x65, 0x0B, 0x00, 0x41, 0x26, 0x76, 0x36, 0x0F, 0x27, 0x09, 0x00, 0x40, 0x26, 0x56,
+  0x0E, 0x00, 0x41, 0x2A, 0x7A, 0x16, 0x13, 0x2B, 0x09, 0x00, 0x41, 0x2A, 0x5A, 0x0E, 0x1D, 0x25,
+  0x07, 0x00, 0x41, 0x26, 0xB6, 0x32, 0x1F, 0xE7, 0x19, 0x00, 0x41, 0x26, 0xD6, 0x12, 0x1D, 0xE5,
+  0x3B, 0x41, 0x1A, 0xBA, 0x12, 0x13, 0xEB, 0x79, 0x00, 0x41, 0x1A, 0xDA, 0x32, 0x0D, 0xE5, 0x1B,
+  0x00, 0x41, 0x66, 0xF6, 0x1E, 0x0F, 0x27, 0x09, 0x00, 0x41, 0xE6, 0xD6, 0x76, 0x0D, 0x25, 0x0F,
+  0x00, 0x40, 0x33, 0x2B, 0x09, 0x00, 0x41, 0xEA, 0xDA, 0x16, 0x3D, 0x25, 0x0F, 0x00, 0x41, 0x66,
+  0xB6, 0xF2, 0x3F, 0x67, 0x09, 0x00, 0x41, 0xE6, 0x56, 0x72, 0x3D, 0x65, 0x1B, 0x00, 0x40, 0x7A,
+  0x4A, 0x16, 0x00, 0x41, 0xFA, 0x5A, 0x12, 0x0D, 0x65, 0x3B, 0x00, 0x41, 0x66, 0x76, 0xF6, 0x0F,
+  0x27, 0x19, 0x00, 0x41, 0xE6, 0x56, 0x1E, 0x0D, 0x25, 0x07, 0x00, 0x41, 0x6A, 0x4A, 0x32, 0x13,
+  0xDB, 0x09, 0x41, 0xEA, 0x5A, 0x7E, 0x1D, 0x25, 0x07, 0x00, 0x41, 0x66, 0xB6, 0x12, 0x1F, 0xE7,
+  0x09, 0x00, 0x41, 0xE6, 0xD6, 0x32, 0x1D, 0xE5, 0x0B, 0x00, 0x41, 0x1A, 0xCA, 0x0E, 0x13, 0xDB,
+  0x19, 0x00, 0x40, 0x0D, 0xE5, 0x0B, 0x00, 0x41, 0x26, 0xF6, 0x0E, 0x0F, 0x27, 0xF9, 0x00, 0x41,
+  0x26, 0xD6, 0x36, 0x0D, 0x25, 0x1F, 0x00, 0x41, 0x2A, 0xCA, 0x12, 0x73, 0x5B, 0x39, 0x00, 0x40,
+  0x2A, 0x4A, 0xF2, 0x00, 0x41, 0x26, 0xB6, 0x32, 0x7F, 0x67, 0x19, 0x00, 0x41, 0x26, 0x56, 0x12,
+  0xFD, 0x65, 0x0B, 0x00, 0x41, 0x3A, 0x4A, 0x76, 0x73, 0x5B, 0x09, 0x00, 0x41, 0x3A, 0x4A, 0x0E,
+  0xF5, 0x3D, 0x07, 0x41, 0x26, 0x76, 0x16, 0x0F, 0x27, 0x09, 0x00, 0x41, 0x26, 0x56, 0x0E, 0x0D,
+  0x25, 0x07, 0x00, 0x41, 0x2A, 0x4A, 0x72, 0x13, 0xDB, 0x19, 0x00, 0x41, 0x2A, 0xCA, 0x12, 0x15,
+  0xFD, 0xFB, 0x00, 0x40, 0x1F, 0xE7, 0x39, 0x00, 0x41, 0x26, 0xD6, 0xF2, 0x1D, 0xE5, 0x1B, 0x00,
+  0x41, 0x1A, 0xCA, 0x1E, 0x13, 0xDB, 0x09, 0x00, 0x41, 0x1A, 0xCA, 0x36, 0x15, 0x3D, 0x0F, 0x00,
+  0x40, 0x1E, 0xCE, 0x12, 0x00, 0x41, 0x66, 0xD6, 0x16, 0x0D, 0x25, 0x0F, 0x00, 0x41, 0xEA, 0xCA,
+  0x32, 0x33, 0x5B, 0x09, 0x00, 0x41, 0x6A, 0x4A, 0x32, 0x35, 0x7D, 0x1B, 0x00, 0x41, 0xEE, 0x4E,
+  0x16, 0x37, 0x5F, 0x39,
+};
+constexpr uint32_t CLIP_SAMPLE_GRADIENT_SIZE = sizeof(CLIP_SAMPLE_GRADIENT);
+
+// Uncompressed frames of sample_gradient for round-trip tests
+const PROGMEM uint8_t CLIP_SAMPLE_GRADIENT_REFERENCE[] = {
+  0x00, 0x00, 0xFF, 0x15, 0x05, 0xEE, 0x2A, 0x0A, 0xDD, 0x3F, 0x0F, 0xCC, 0x54, 0x14, 0xBB, 0x69,
+  0x19, 0xAA, 0x7E, 0x1E, 0x99, 0x93, 0x23, 0x88, 0xA8, 0x28, 0x77, 0xBD, 0x2D, 0x66, 0xD2, 0x32,
+  0x55, 0xE7, 0x37, 0x44, 0x0D, 0x25, 0xF8, 0x22, 0x2A, 0xE7, 0x2A, 0x0A, 0xDD, 0x4C, 0x34, 0xC5,
+  0x61, 0x39, 0xB4, 0x69, 0x19, 0xAA, 0x8B, 0x43, 0x92, 0xA0, 0x48, 0x81, 0xA8, 0x28, 0x77, 0xCA,
+  0x52, 0x5F, 0xDF, 0x57, 0x4E, 0xE7, 0x37, 0x44, 0x1A, 0x4A, 0xF1, 0x22, 0x2A, 0xE7, 0x44, 0x54,
+  0xCF, 0x59, 0x59, 0xBE, 0x61, 0x39, 0xB4, 0x83, 0x63, 0x9C, 0x98, 0x68, 0x8B, 0xA0, 0x48, 0x81,
+  0xC2, 0x72, 0x69, 0xD7, 0x77, 0x58, 0xDF, 0x57, 0x4E, 0x01, 0x81, 0x36, 0x1A, 0x4A, 0xF1, 0x3C,
+  0x74, 0xD9, 0x51, 0x79, 0xC8, 0x59, 0x59, 0xBE, 0x7B, 0x83, 0xA6, 0x90, 0x88, 0x95, 0x98, 0x68,
+  0x8B, 0xBA, 0x92, 0x73, 0xCF, 0x97, 0x62, 0xD7, 0x77, 0x58, 0xF9, 0xA1, 0x40, 0x0E, 0xA6, 0x2F,
+  0x34, 0x94, 0xE3, 0x49, 0x99, 0xD2, 0x51, 0x79, 0xC8, 0x73, 0xA3, 0xB0, 0x88, 0xA8, 0x9F, 0x90,
+  0x88, 0x95, 0xB2, 0xB2, 0x7D, 0xC7, 0xB7, 0x6C, 0xCF, 0x97, 0x62, 0xF1, 0xC1, 0x4A, 0x06, 0xC6,
+  0x39, 0x0E, 0xA6, 0x2F, 0x41, 0xB9, 0xDC, 0x49, 0x99, 0xD2, 0x6B, 0xC3, 0xBA, 0x80, 0xC8, 0xA9,
+  0x88, 0xA8, 0x9F, 0xAA, 0xD2, 0x87, 0xBF, 0xD7, 0x76, 0xC7, 0xB7, 0x6C, 0xE9, 0xE1, 0x54, 0xFE,
+  0xE6, 0x43, 0x06, 0xC6, 0x39, 0x28, 0xF0, 0x21, 0x41, 0xB9, 0xDC, 0x63, 0xE3, 0xC4, 0x78, 0xE8,
+  0xB3, 0x80, 0xC8, 0xA9, 0xA2, 0xF2, 0x91, 0xB7, 0xF7, 0x80, 0xBF, 0xD7, 0x76, 0xE1, 0x01, 0x5E,
+  0xF6, 0x06, 0x4D, 0xFE, 0xE6, 0x43, 0x20, 0x10, 0x2B, 0x35, 0x15, 0x1A, 0x5B, 0x03, 0xCE, 0x70,
+  0x08, 0xBD, 0x78, 0xE8, 0xB3, 0x9A, 0x12, 0x9B, 0xAF, 0x17, 0x8A, 0xB7, 0xF7, 0x80, 0xD9, 0x21,
+  0x68, 0xEE, 0x26, 0x57, 0xF6, 0x06, 0x4D, 0x18, 0x30, 0x35, 0x2D, 0x35, 0x24, 0x35, 0x15, 0x1A,
+  0x68, 0x28, 0xC7, 0x70, 0x08, 0xBD, 0x92, 0x32, 0xA5, 0xA7, 0x37, 0x94, 0xAF, 0x17, 0x8A, 0xD1,
+  0x41, 0x72, 0xE6, 0x46, 0x61, 0xEE, 0x26, 0x57, 0x10, 0x50, 0x3F, 0x25, 0x55, 0x2E, 0x2D, 0x35,
+  0x24, 0x4F, 0x5F, 0x0C, 0x68, 0x28, 0xC7, 0x8A, 0x52, 0xAF, 0x9F, 0x57, 0x9E, 0xA7, 0x37, 0x94,
+  0xC9, 0x61, 0x7C, 0xDE, 0x66, 0x6B, 0xE6, 0x46, 0x61, 0x08, 0x70, 0x49, 0x1D, 0x75, 0x38, 0x25,
+  0x55, 0x2E, 0x47, 0x7F, 0x16, 0x5C, 0x84, 0x05, 0x82, 0x72, 0xB9, 0x97, 0x77, 0xA8, 0x9F, 0x57,
+  0x9E, 0xC1, 0x81, 0x86, 0xD6, 0x86, 0x75, 0xDE, 0x66, 0x6B, 0x00, 0x90, 0x53, 0x15, 0x95, 0x42,
+  0x1D, 0x75, 0x38, 0x3F, 0x9F, 0x20, 0x54, 0xA4, 0x0F, 0x5C, 0x84, 0x05, 0x8F, 0x97, 0xB2, 0x97,
+  0x77, 0xA8, 0xB9, 0xA1, 0x90, 0xCE, 0xA6, 0x7F, 0xD6, 0x86, 0x75, 0xF8, 0xB0, 0x5D, 0x0D, 0xB5,
+  0x4C, 0x15, 0x95, 0x42, 0x37, 0xBF, 0x2A, 0x4C, 0xC4, 0x19, 0x54, 0xA4, 0x0F, 0x76, 0xCE, 0xF7,
+  0x8F, 0x97, 0xB2, 0xB1, 0xC1, 0x9A, 0xC6, 0xC6, 0x89, 0xCE, 0xA6, 0x7F, 0xF0, 0xD0, 0x67, 0x05,
+  0xD5, 0x56, 0x0D, 0xB5, 0x4C, 0x2F, 0xDF, 0x34, 0x44, 0xE4, 0x23, 0x4C, 0xC4, 0x19, 0x6E, 0xEE,
+  0x01, 0x83, 0xF3, 0xF0, 0xA9, 0xE1, 0xA4, 0xBE, 0xE6, 0x93, 0xC6, 0xC6, 0x89, 0xE8, 0xF0, 0x71,
+  0xFD, 0xF5, 0x60, 0x05, 0xD5, 0x56, 0x27, 0xFF, 0x3E, 0x3C, 0x04, 0x2D, 0x44, 0xE4, 0x23, 0x66,
+  0x0E, 0x0B, 0x7B, 0x13, 0xFA, 0x83, 0xF3, 0xF0, 0xB6, 0x06, 0x9D, 0xBE, 0xE6, 0x93, 0xE0, 0x10,
+  0x7B, 0xF5, 0x15, 0x6A, 0xFD, 0xF5, 0x60, 0x1F, 0x1F, 0x48, 0x34, 0x24, 0x37, 0x3C, 0x04, 0x2D,
+  0x5E, 0x2E, 0x15, 0x73, 0x33, 0x04, 0x7B, 0x13, 0xFA, 0x9D, 0x3D, 0xE2, 0xB6, 0x06, 0x9D, 0xD8,
+  0x30, 0x85, 0xED, 0x35, 0x74, 0xF5, 0x15, 0x6A, 0x17, 0x3F, 0x52, 0x2C, 0x44, 0x41, 0x34, 0x24,
+  0x37, 0x56, 0x4E, 0x1F, 0x6B, 0x53, 0x0E, 0x73, 0x33, 0x04, 0x95, 0x5D, 0xEC, 0xAA, 0x62, 0xDB,
+};
+
+#endif // FRAME_CLIPS_H
@@ -0,0 +1,247 @@
+#include <Arduino.h>
+#include "../../src/animation/ColorEngine.h"
+#include "../../src/animation/AnimationPlayer.h"
+#include "../../src/core/Config.h"
+#include "../../src/core/SpellRegistry.h"
+#include "../../src/utils/DebugTools.h"
+#include "RainbowBurstGolden.h"
+#include "../helpers/TestCheck.h"
+
+// Frame interval used by the main loop (GauntletController::maintainLoopTiming)
+static const uint32_t BENCH_FRAME_MS = 20;
+
+// Length of the Rainbow Burst spell
+static const uint32_t RAINBOW_DURATION_MS = SpellRegistry::SPELLS[SpellRegistry::find("rainbow_burst")].durationMs;
+
+// Largest per-channel difference accepted between the table path and the
+// original float path (hue is quantised to 256 steps instead of continuous)
+static const uint8_t LEGACY_TOLERANCE = 12;
+
+static bool sameColor(const Color& c, uint8_t r, uint8_t g, uint8_t b) {
+    return c.r == r && c.g == g && c.b == b;
+}
+
+// Largest per-channel difference between a color and an RGB triple
+static uint8_t channelDelta(const Color& c, uint8_t r, uint8_t g, uint8_t b) {
+    return max(max(abs(c.r - r), abs(c.g - g)), abs(c.b - b));
+}
+
+// --- Legacy reference: the float Rainbow Burst path this engine replaced ---
+
+static void legacyHsvToRgb(float h, float s, float v, uint8_t &r, uint8_t &g, uint8_t &b) {
+    int i = int(h * 6);
+    float f = h * 6 - i;
+    float p = v * (1 - s);
+    float q = v * (1 - f * s);
+    float t = v * (1 - (1 - f) * s);
+
+    float r_f = 0, g_f = 0, b_f = 0;
+    switch (i % 6) {
+        case 0: r_f = v; g_f = t; b_f = p; break;
+        case 1: r_f = q; g_f = v; b_f = p; break;
+        case 2: r_f = p; g_f = v; b_f = t; break;
+        case 3: r_f = p; g_f = q; b_f = v; break;
+        case 4: r_f = t; g_f = p; b_f = v; break;
+        case 5: r_f = v; g_f = p; b_f = q; break;
+    }
+
+    r = r_f * 255;
+    g = g_f * 255;
+    b = b_f * 255;
+}
+
+static void legacySwirl(unsigned long elapsed, unsigned long period, Color* frame) {
+    float pulseProgress = (elapsed % period) / (float)period;
+    float brightness = 0.6f + 0.4f * sin(pulseProgress * 2 * PI);
+    float rotationProgress = (elapsed % period) / (float)period;
+
+    for (int i = 0; i < Config::NUM_LEDS; i++) {
+        float hue = fmod(rotationProgress + (i / (float)Config::NUM_LEDS), 1.0f);
+        legacyHsvToRgb(hue, 1.0f, brightness, frame[i].r, frame[i].g, frame[i].b);
+    }
+}
+
+static void legacyColorPop(Color* frame, uint8_t led, unsigned long popTime, unsigned long elapsed,
+                           uint8_t r, uint8_t g, uint8_t b) {
+    if (elapsed >= popTime && elapsed < popTime + 250) {
+        frame[led] = {r, g, b};
+    } else if (elapsed >= popTime + 250) {
+        frame[led] = {0, 0, 0};
+    }
+}
+
+static void legacyRainbowFrame(uint32_t elapsedTime, Color* frame) {
+    if (elapsedTime < 2000) {
+        legacySwirl(elapsedTime, 1000, frame);
+    } else if (elapsedTime < 4000) {
+        legacySwirl(elapsedTime, 500, frame);
+    } else if (elapsedTime < 6000) {
+        legacySwirl(elapsedTime, 250, frame);
+    } else {
+        unsigned long elapsed = elapsedTime - 6000;
+        for (int i = 0; i < Config::NUM_LEDS; i++) {
+            frame[i] = {153, 153, 153};
+        }
+        if (elapsed < 50) {
+            return;
+        }
+        float fadeProgress = min(1.0f, elapsed / 2000.0f);
+        uint8_t whiteBrightness = 153 * (1.0f - fadeProgress);
+        for (int i = 0; i < Config::NUM_LEDS; i += 2) {
+            frame[i] = {whiteBrightness, whiteBrightness, whiteBrightness};
+        }
+        legacyColorPop(frame, 1, 300, elapsed, 255, 0, 0);
+        legacyColorPop(frame, 7, 600, elapsed, 255, 255, 0);
+        legacyColorPop(frame, 3, 900, elapsed, 0, 255, 0);
+        legacyColorPop(frame, 9, 1200, elapsed, 0, 0, 255);
+        legacyColorPop(frame, 5, 1500, elapsed, 128, 0, 255);
+        legacyColorPop(frame, 11, 1800, elapsed, 255, 105, 180);
+    }
+}
+
+// --- Table path: the keyframe program QuickCast plays for Rainbow Burst ---
+
+static void rainbowFrame(uint32_t elapsedTime, Color* frame) {
+    static AnimationPlayer player;
+    if (!player.isLoaded()) {
+        const SpellDefinition& spell = SpellRegistry::SPELLS[SpellRegistry::find("rainbow_burst")];
+        player.load(spell.program, spell.programLength);
+    }
+    player.evaluate(elapsedTime, frame, Config::NUM_LEDS);
+}
+
+// --- Tests ---
+
+/**
+ * @brief Spot checks of the lookup tables and helpers
+ */
+void testColorTables() {
+    Serial.println("\n[Color tables]");
+
+    check(sameColor(ColorEngine::rainbow(0), 255, 0, 0), "rainbow(0) is red");
+    check(sameColor(ColorEngine::rainbow(128), 0, 255, 255), "rainbow(128) is cyan");
+    check(sameColor(ColorEngine::hsv(42, 0, 200), 200, 200, 200), "zero saturation is grey");
+    check(sameColor(ColorEngine::hsv(170, 255, 0), 0, 0, 0), "zero value is black");
+    check(ColorEngine::sine8(0) == 128 && ColorEngine::sine8(64) == 255 && ColorEngine::sine8(192) == 1,
+          "sine8 quarter points");
+    check(ColorEngine::phase8(750, 1000) == 192, "phase8 75% of period");
+
+    uint32_t seeded = 7, again = 7;
+    bool repeats = true, inRange = true;
+    for (uint8_t i = 0; i < 100; i++) {
+        uint16_t value = ColorEngine::rand16(seeded, 5);
+        repeats &= value == ColorEngine::rand16(again, 5);
+        inRange &= value < 5;
+    }
+    check(repeats && inRange, "rand16 repeats per seed and stays in range");
+
+    Color mid = ColorEngine::blend({0, 0, 0}, {255, 255, 255}, 128);
+    check(mid.r == 128 && mid.g == 128 && mid.b == 128, "blend midpoint");
+
+    const ColorEngine::Palette16& pal = ColorEngine::RAINBOW_PALETTE;
+    Color first = ColorEngine::fromPalette(pal, 0x00);
+    Color between = ColorEngine::fromPalette(pal, 0x08);
+    check(sameColor(first, pal.entries[0].r, pal.entries[0].g, pal.entries[0].b), "palette exact entry");
+    check(between.g > pal.entries[0].g && between.g < pal.entries[1].g, "palette interpolates");
+
+    Color ring[Config::NUM_LEDS];
+    ColorEngine::fillRingRainbow(ring, Config::NUM_LEDS, 0, 255);
+    check(sameColor(ring[0], 255, 0, 0) && sameColor(ring[6], 0, 255, 255), "ring rainbow spans one revolution");
+}
+
+/**
+ * @brief Rainbow Burst against the golden frames of the float path, plus the
+ *        deviation from that path over every millisecond of the spell
+ */
+void testRainbowBurstGolden() {
+    Serial.println("\n[Rainbow Burst golden]");
+
+    Color frame[Config::NUM_LEDS];
+    Color reference[Config::NUM_LEDS];
+    uint8_t referenceDelta = 0;
+    uint8_t goldenDelta = 0;
+    uint32_t goldenDeltaTime = 0;
+
+    for (uint8_t f = 0; f < RAINBOW_GOLDEN_FRAMES; f++) {
+        uint32_t t = (uint32_t)f * RAINBOW_GOLDEN_STEP_MS;
+        legacyRainbowFrame(t, reference);
+        rainbowFrame(t, frame);
+        for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+            const uint8_t* g = RAINBOW_BURST_GOLDEN[f][i];
+            referenceDelta = max(referenceDelta, channelDelta(reference[i], g[0], g[1], g[2]));
+            uint8_t d = channelDelta(frame[i], g[0], g[1], g[2]);
+            if (d > goldenDelta) {
+                goldenDelta = d;
+                goldenDeltaTime = t;
+            }
+        }
+    }
+    // The golden frames pin the float reference, so editing it cannot move the target
+    check(referenceDelta <= 1, "float reference reproduces the golden frames");
+    Serial.printf("    max channel delta vs golden: %u (at %lu ms)\n", goldenDelta, (unsigned long)goldenDeltaTime);
+    check(goldenDelta <= LEGACY_TOLERANCE, "golden frames match within tolerance");
+
+    // Every millisecond of the spell against the float path
+    Color legacy[Config::NUM_LEDS];
+    uint8_t maxDelta = 0;
+    uint32_t maxDeltaTime = 0;
+    for (uint32_t t = 0; t < RAINBOW_DURATION_MS; t++) {
+        rainbowFrame(t, frame);
+        legacyRainbowFrame(t, legacy);
+        for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+            uint8_t d = channelDelta(frame[i], legacy[i].r, legacy[i].g, legacy[i].b);
+            if (d > maxDelta) {
+                maxDelta = d;
+                maxDeltaTime = t;
+            }
+        }
+    }
+    Serial.printf("    max channel delta vs float path: %u (at %lu ms)\n", maxDelta, (unsigned long)maxDeltaTime);
+    check(maxDelta <= LEGACY_TOLERANCE, "within tolerance of float path");
+}
+
+/**
+ * @brief Time the full 8 second Rainbow Burst, float path vs table path
+ */
+void benchmarkRainbowBurst() {
+    Serial.println("\n[Rainbow Burst benchmark]");
+
+    Color frame[Config::NUM_LEDS];
+    const uint32_t frames = RAINBOW_DURATION_MS / BENCH_FRAME_MS;
+    volatile uint8_t sink = 0;
+
+    unsigned long start = micros();
+    for (uint32_t t = 0; t < RAINBOW_DURATION_MS; t += BENCH_FRAME_MS) {
+        legacyRainbowFrame(t, frame);
+        sink ^= frame[t % Config::NUM_LEDS].g;
+    }
+    unsigned long legacyUs = micros() - start;
+
+    start = micros();
+    for (uint32_t t = 0; t < RAINBOW_DURATION_MS; t += BENCH_FRAME_MS) {
+        rainbowFrame(t, frame);
+        sink ^= frame[t % Config::NUM_LEDS].g;
+    }
+    unsigned long tableUs = micros() - start;
+
+    Serial.printf("    frames rendered:  %lu\n", (unsigned long)frames);
+    Serial.printf("    float path:  %lu us total, %.2f us/frame\n", legacyUs, (float)legacyUs / frames);
+    Serial.printf("    table path:  %lu us total, %.2f us/frame\n", tableUs, (float)tableUs / frames);
+    if (tableUs > 0) {
+        Serial.printf("    speedup:     %.1fx\n", (float)legacyUs / tableUs);
+    }
+    (void)sink;
+}
+
+/**
+ * @brief Run all color engine tests
+ */
+void testColorEngine() {
+    resetChecks();
+
+    testColorTables();
+    testRainbowBurstGolden();
+    benchmarkRainbowBurst();
+
+    reportChecks("Color engine");
+}
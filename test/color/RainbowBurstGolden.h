@@ -0,0 +1,341 @@
+#ifndef RAINBOW_BURST_GOLDEN_H
+#define RAINBOW_BURST_GOLDEN_H
+
+#include <stdint.h>
+
+/**
+ * @brief Reference Rainbow Burst frames for the color engine golden test
+ *
+ * One frame every RAINBOW_GOLDEN_STEP_MS across the full 8 second spell,
+ * captured from the original float Rainbow Burst (legacyRainbowFrame() in
+ * ColorEngineTest.cpp), not from the code under test. The keyframe program
+ * is checked against these within a tolerance. Regenerate only when the
+ * Rainbow Burst look is changed on purpose.
+ */
+constexpr uint16_t RAINBOW_GOLDEN_STEP_MS = 100;
+constexpr uint8_t RAINBOW_GOLDEN_FRAMES = 80;
+
+const uint8_t RAINBOW_BURST_GOLDEN[RAINBOW_GOLDEN_FRAMES][12][3] = {
+  { // 0 ms
+    {153, 0, 0}, {153, 76, 0}, {153, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76},
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76}
+  },
+  { // 100 ms
+    {212, 127, 0}, {191, 212, 0}, {85, 212, 0}, {0, 212, 21}, {0, 212, 127}, {0, 191, 212},
+    {0, 85, 212}, {21, 0, 212}, {127, 0, 212}, {212, 0, 191}, {212, 0, 85}, {212, 21, 0}
+  },
+  { // 200 ms
+    {200, 250, 0}, {75, 250, 0}, {0, 250, 50}, {0, 250, 175}, {0, 200, 250}, {0, 75, 250},
+    {50, 0, 250}, {175, 0, 250}, {250, 0, 200}, {250, 0, 75}, {250, 50, 0}, {250, 175, 0}
+  },
+  { // 300 ms
+    {50, 250, 0}, {0, 250, 75}, {0, 250, 200}, {0, 175, 250}, {0, 50, 250}, {75, 0, 250},
+    {200, 0, 250}, {250, 0, 175}, {250, 0, 50}, {250, 75, 0}, {250, 200, 0}, {175, 250, 0}
+  },
+  { // 400 ms
+    {0, 212, 85}, {0, 212, 191}, {0, 127, 212}, {0, 21, 212}, {85, 0, 212}, {191, 0, 212},
+    {212, 0, 127}, {212, 0, 21}, {212, 85, 0}, {212, 191, 0}, {127, 212, 0}, {21, 212, 0}
+  },
+  { // 500 ms
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76},
+    {153, 0, 0}, {153, 76, 0}, {152, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76}
+  },
+  { // 600 ms
+    {0, 37, 93}, {9, 0, 93}, {55, 0, 93}, {93, 0, 83}, {93, 0, 37}, {93, 9, 0},
+    {93, 55, 0}, {83, 93, 0}, {37, 93, 0}, {0, 93, 9}, {0, 93, 55}, {0, 83, 93}
+  },
+  { // 700 ms
+    {11, 0, 55}, {39, 0, 55}, {55, 0, 44}, {55, 0, 16}, {55, 11, 0}, {55, 39, 0},
+    {44, 55, 0}, {16, 55, 0}, {0, 55, 11}, {0, 55, 39}, {0, 44, 55}, {0, 16, 55}
+  },
+  { // 800 ms
+    {44, 0, 55}, {55, 0, 39}, {55, 0, 11}, {55, 16, 0}, {55, 44, 0}, {39, 55, 0},
+    {11, 55, 0}, {0, 55, 16}, {0, 55, 44}, {0, 39, 55}, {0, 11, 55}, {16, 0, 55}
+  },
+  { // 900 ms
+    {93, 0, 55}, {93, 0, 9}, {93, 37, 0}, {93, 83, 0}, {55, 93, 0}, {9, 93, 0},
+    {0, 93, 37}, {0, 93, 83}, {0, 55, 93}, {0, 9, 93}, {37, 0, 93}, {83, 0, 93}
+  },
+  { // 1000 ms
+    {153, 0, 0}, {153, 76, 0}, {153, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76},
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76}
+  },
+  { // 1100 ms
+    {212, 127, 0}, {191, 212, 0}, {85, 212, 0}, {0, 212, 21}, {0, 212, 127}, {0, 191, 212},
+    {0, 85, 212}, {21, 0, 212}, {127, 0, 212}, {212, 0, 191}, {212, 0, 85}, {212, 21, 0}
+  },
+  { // 1200 ms
+    {200, 250, 0}, {75, 250, 0}, {0, 250, 50}, {0, 250, 175}, {0, 200, 250}, {0, 75, 250},
+    {50, 0, 250}, {175, 0, 250}, {250, 0, 200}, {250, 0, 75}, {250, 50, 0}, {250, 175, 0}
+  },
+  { // 1300 ms
+    {50, 250, 0}, {0, 250, 75}, {0, 250, 200}, {0, 175, 250}, {0, 50, 250}, {75, 0, 250},
+    {200, 0, 250}, {250, 0, 175}, {250, 0, 50}, {250, 75, 0}, {250, 200, 0}, {175, 250, 0}
+  },
+  { // 1400 ms
+    {0, 212, 85}, {0, 212, 191}, {0, 127, 212}, {0, 21, 212}, {85, 0, 212}, {191, 0, 212},
+    {212, 0, 127}, {212, 0, 21}, {212, 85, 0}, {212, 191, 0}, {127, 212, 0}, {21, 212, 0}
+  },
+  { // 1500 ms
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76},
+    {153, 0, 0}, {153, 76, 0}, {152, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76}
+  },
+  { // 1600 ms
+    {0, 37, 93}, {9, 0, 93}, {55, 0, 93}, {93, 0, 83}, {93, 0, 37}, {93, 9, 0},
+    {93, 55, 0}, {83, 93, 0}, {37, 93, 0}, {0, 93, 9}, {0, 93, 55}, {0, 83, 93}
+  },
+  { // 1700 ms
+    {11, 0, 55}, {39, 0, 55}, {55, 0, 44}, {55, 0, 16}, {55, 11, 0}, {55, 39, 0},
+    {44, 55, 0}, {16, 55, 0}, {0, 55, 11}, {0, 55, 39}, {0, 44, 55}, {0, 16, 55}
+  },
+  { // 1800 ms
+    {44, 0, 55}, {55, 0, 39}, {55, 0, 11}, {55, 16, 0}, {55, 44, 0}, {39, 55, 0},
+    {11, 55, 0}, {0, 55, 16}, {0, 55, 44}, {0, 39, 55}, {0, 11, 55}, {16, 0, 55}
+  },
+  { // 1900 ms
+    {93, 0, 55}, {93, 0, 9}, {93, 37, 0}, {93, 83, 0}, {55, 93, 0}, {9, 93, 0},
+    {0, 93, 37}, {0, 93, 83}, {0, 55, 93}, {0, 9, 93}, {37, 0, 93}, {83, 0, 93}
+  },
+  { // 2000 ms
+    {153, 0, 0}, {153, 76, 0}, {153, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76},
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76}
+  },
+  { // 2100 ms
+    {200, 250, 0}, {75, 250, 0}, {0, 250, 50}, {0, 250, 175}, {0, 200, 250}, {0, 75, 250},
+    {50, 0, 250}, {175, 0, 250}, {250, 0, 200}, {250, 0, 75}, {250, 50, 0}, {250, 175, 0}
+  },
+  { // 2200 ms
+    {0, 212, 85}, {0, 212, 191}, {0, 127, 212}, {0, 21, 212}, {85, 0, 212}, {191, 0, 212},
+    {212, 0, 127}, {212, 0, 21}, {212, 85, 0}, {212, 191, 0}, {127, 212, 0}, {21, 212, 0}
+  },
+  { // 2300 ms
+    {0, 37, 93}, {9, 0, 93}, {55, 0, 93}, {93, 0, 83}, {93, 0, 37}, {93, 9, 0},
+    {93, 55, 0}, {83, 93, 0}, {37, 93, 0}, {0, 93, 9}, {0, 93, 55}, {0, 83, 93}
+  },
+  { // 2400 ms
+    {44, 0, 55}, {55, 0, 39}, {55, 0, 11}, {55, 16, 0}, {55, 44, 0}, {39, 55, 0},
+    {11, 55, 0}, {0, 55, 16}, {0, 55, 44}, {0, 39, 55}, {0, 11, 55}, {16, 0, 55}
+  },
+  { // 2500 ms
+    {153, 0, 0}, {153, 76, 0}, {153, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76},
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76}
+  },
+  { // 2600 ms
+    {200, 250, 0}, {75, 250, 0}, {0, 250, 50}, {0, 250, 175}, {0, 200, 250}, {0, 75, 250},
+    {50, 0, 250}, {175, 0, 250}, {250, 0, 200}, {250, 0, 75}, {250, 50, 0}, {250, 175, 0}
+  },
+  { // 2700 ms
+    {0, 212, 85}, {0, 212, 191}, {0, 127, 212}, {0, 21, 212}, {85, 0, 212}, {191, 0, 212},
+    {212, 0, 127}, {212, 0, 21}, {212, 85, 0}, {212, 191, 0}, {127, 212, 0}, {21, 212, 0}
+  },
+  { // 2800 ms
+    {0, 37, 93}, {9, 0, 93}, {55, 0, 93}, {93, 0, 83}, {93, 0, 37}, {93, 9, 0},
+    {93, 55, 0}, {83, 93, 0}, {37, 93, 0}, {0, 93, 9}, {0, 93, 55}, {0, 83, 93}
+  },
+  { // 2900 ms
+    {44, 0, 55}, {55, 0, 39}, {55, 0, 11}, {55, 16, 0}, {55, 44, 0}, {39, 55, 0},
+    {11, 55, 0}, {0, 55, 16}, {0, 55, 44}, {0, 39, 55}, {0, 11, 55}, {16, 0, 55}
+  },
+  { // 3000 ms
+    {153, 0, 0}, {153, 76, 0}, {153, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76},
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76}
+  },
+  { // 3100 ms
+    {200, 250, 0}, {75, 250, 0}, {0, 250, 50}, {0, 250, 175}, {0, 200, 250}, {0, 75, 250},
+    {50, 0, 250}, {175, 0, 250}, {250, 0, 200}, {250, 0, 75}, {250, 50, 0}, {250, 175, 0}
+  },
+  { // 3200 ms
+    {0, 212, 85}, {0, 212, 191}, {0, 127, 212}, {0, 21, 212}, {85, 0, 212}, {191, 0, 212},
+    {212, 0, 127}, {212, 0, 21}, {212, 85, 0}, {212, 191, 0}, {127, 212, 0}, {21, 212, 0}
+  },
+  { // 3300 ms
+    {0, 37, 93}, {9, 0, 93}, {55, 0, 93}, {93, 0, 83}, {93, 0, 37}, {93, 9, 0},
+    {93, 55, 0}, {83, 93, 0}, {37, 93, 0}, {0, 93, 9}, {0, 93, 55}, {0, 83, 93}
+  },
+  { // 3400 ms
+    {44, 0, 55}, {55, 0, 39}, {55, 0, 11}, {55, 16, 0}, {55, 44, 0}, {39, 55, 0},
+    {11, 55, 0}, {0, 55, 16}, {0, 55, 44}, {0, 39, 55}, {0, 11, 55}, {16, 0, 55}
+  },
+  { // 3500 ms
+    {153, 0, 0}, {153, 76, 0}, {153, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76},
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76}
+  },
+  { // 3600 ms
+    {200, 250, 0}, {75, 250, 0}, {0, 250, 50}, {0, 250, 175}, {0, 200, 250}, {0, 75, 250},
+    {50, 0, 250}, {175, 0, 250}, {250, 0, 200}, {250, 0, 75}, {250, 50, 0}, {250, 175, 0}
+  },
+  { // 3700 ms
+    {0, 212, 85}, {0, 212, 191}, {0, 127, 212}, {0, 21, 212}, {85, 0, 212}, {191, 0, 212},
+    {212, 0, 127}, {212, 0, 21}, {212, 85, 0}, {212, 191, 0}, {127, 212, 0}, {21, 212, 0}
+  },
+  { // 3800 ms
+    {0, 37, 93}, {9, 0, 93}, {55, 0, 93}, {93, 0, 83}, {93, 0, 37}, {93, 9, 0},
+    {93, 55, 0}, {83, 93, 0}, {37, 93, 0}, {0, 93, 9}, {0, 93, 55}, {0, 83, 93}
+  },
+  { // 3900 ms
+    {44, 0, 55}, {55, 0, 39}, {55, 0, 11}, {55, 16, 0}, {55, 44, 0}, {39, 55, 0},
+    {11, 55, 0}, {0, 55, 16}, {0, 55, 44}, {0, 39, 55}, {0, 11, 55}, {16, 0, 55}
+  },
+  { // 4000 ms
+    {153, 0, 0}, {153, 76, 0}, {153, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76},
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76}
+  },
+  { // 4100 ms
+    {0, 212, 85}, {0, 212, 191}, {0, 127, 212}, {0, 21, 212}, {85, 0, 212}, {191, 0, 212},
+    {212, 0, 127}, {212, 0, 21}, {212, 85, 0}, {212, 191, 0}, {127, 212, 0}, {21, 212, 0}
+  },
+  { // 4200 ms
+    {44, 0, 55}, {55, 0, 39}, {55, 0, 11}, {55, 16, 0}, {55, 44, 0}, {39, 55, 0},
+    {11, 55, 0}, {0, 55, 16}, {0, 55, 44}, {0, 39, 55}, {0, 11, 55}, {16, 0, 55}
+  },
+  { // 4300 ms
+    {200, 250, 0}, {75, 250, 0}, {0, 250, 50}, {0, 250, 175}, {0, 200, 250}, {0, 75, 250},
+    {50, 0, 250}, {175, 0, 250}, {250, 0, 200}, {250, 0, 75}, {250, 50, 0}, {250, 175, 0}
+  },
+  { // 4400 ms
+    {0, 37, 93}, {9, 0, 93}, {55, 0, 93}, {93, 0, 83}, {93, 0, 37}, {93, 9, 0},
+    {93, 55, 0}, {83, 93, 0}, {37, 93, 0}, {0, 93, 9}, {0, 93, 55}, {0, 83, 93}
+  },
+  { // 4500 ms
+    {153, 0, 0}, {153, 76, 0}, {153, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76},
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76}
+  },
+  { // 4600 ms
+    {0, 212, 85}, {0, 212, 191}, {0, 127, 212}, {0, 21, 212}, {85, 0, 212}, {191, 0, 212},
+    {212, 0, 127}, {212, 0, 21}, {212, 85, 0}, {212, 191, 0}, {127, 212, 0}, {21, 212, 0}
+  },
+  { // 4700 ms
+    {44, 0, 55}, {55, 0, 39}, {55, 0, 11}, {55, 16, 0}, {55, 44, 0}, {39, 55, 0},
+    {11, 55, 0}, {0, 55, 16}, {0, 55, 44}, {0, 39, 55}, {0, 11, 55}, {16, 0, 55}
+  },
+  { // 4800 ms
+    {200, 250, 0}, {75, 250, 0}, {0, 250, 50}, {0, 250, 175}, {0, 200, 250}, {0, 75, 250},
+    {50, 0, 250}, {175, 0, 250}, {250, 0, 200}, {250, 0, 75}, {250, 50, 0}, {250, 175, 0}
+  },
+  { // 4900 ms
+    {0, 37, 93}, {9, 0, 93}, {55, 0, 93}, {93, 0, 83}, {93, 0, 37}, {93, 9, 0},
+    {93, 55, 0}, {83, 93, 0}, {37, 93, 0}, {0, 93, 9}, {0, 93, 55}, {0, 83, 93}
+  },
+  { // 5000 ms
+    {153, 0, 0}, {153, 76, 0}, {153, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76},
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76}
+  },
+  { // 5100 ms
+    {0, 212, 85}, {0, 212, 191}, {0, 127, 212}, {0, 21, 212}, {85, 0, 212}, {191, 0, 212},
+    {212, 0, 127}, {212, 0, 21}, {212, 85, 0}, {212, 191, 0}, {127, 212, 0}, {21, 212, 0}
+  },
+  { // 5200 ms
+    {44, 0, 55}, {55, 0, 39}, {55, 0, 11}, {55, 16, 0}, {55, 44, 0}, {39, 55, 0},
+    {11, 55, 0}, {0, 55, 16}, {0, 55, 44}, {0, 39, 55}, {0, 11, 55}, {16, 0, 55}
+  },
+  { // 5300 ms
+    {200, 250, 0}, {75, 250, 0}, {0, 250, 50}, {0, 250, 175}, {0, 200, 250}, {0, 75, 250},
+    {50, 0, 250}, {175, 0, 250}, {250, 0, 200}, {250, 0, 75}, {250, 50, 0}, {250, 175, 0}
+  },
+  { // 5400 ms
+    {0, 37, 93}, {9, 0, 93}, {55, 0, 93}, {93, 0, 83}, {93, 0, 37}, {93, 9, 0},
+    {93, 55, 0}, {83, 93, 0}, {37, 93, 0}, {0, 93, 9}, {0, 93, 55}, {0, 83, 93}
+  },
+  { // 5500 ms
+    {153, 0, 0}, {153, 76, 0}, {153, 153, 0}, {76, 153, 0}, {0, 153, 0}, {0, 153, 76},
+    {0, 153, 153}, {0, 76, 153}, {0, 0, 153}, {76, 0, 153}, {153, 0, 153}, {153, 0, 76}
+  },
+  { // 5600 ms
+    {0, 212, 85}, {0, 212, 191}, {0, 127, 212}, {0, 21, 212}, {85, 0, 212}, {191, 0, 212},
+    {212, 0, 127}, {212, 0, 21}, {212, 85, 0}, {212, 191, 0}, {127, 212, 0}, {21, 212, 0}
+  },
+  { // 5700 ms
+    {44, 0, 55}, {55, 0, 39}, {55, 0, 11}, {55, 16, 0}, {55, 44, 0}, {39, 55, 0},
+    {11, 55, 0}, {0, 55, 16}, {0, 55, 44}, {0, 39, 55}, {0, 11, 55}, {16, 0, 55}
+  },
+  { // 5800 ms
+    {200, 250, 0}, {75, 250, 0}, {0, 250, 50}, {0, 250, 175}, {0, 200, 250}, {0, 75, 250},
+    {50, 0, 250}, {175, 0, 250}, {250, 0, 200}, {250, 0, 75}, {250, 50, 0}, {250, 175, 0}
+  },
+  { // 5900 ms
+    {0, 37, 93}, {9, 0, 93}, {55, 0, 93}, {93, 0, 83}, {93, 0, 37}, {93, 9, 0},
+    {93, 55, 0}, {83, 93, 0}, {37, 93, 0}, {0, 93, 9}, {0, 93, 55}, {0, 83, 93}
+  },
+  { // 6000 ms
+    {153, 153, 153}, {153, 153, 153}, {153, 153, 153}, {153, 153, 153}, {153, 153, 153}, {153, 153, 153},
+    {153, 153, 153}, {153, 153, 153}, {153, 153, 153}, {153, 153, 153}, {153, 153, 153}, {153, 153, 153}
+  },
+  { // 6100 ms
+    {145, 145, 145}, {153, 153, 153}, {145, 145, 145}, {153, 153, 153}, {145, 145, 145}, {153, 153, 153},
+    {145, 145, 145}, {153, 153, 153}, {145, 145, 145}, {153, 153, 153}, {145, 145, 145}, {153, 153, 153}
+  },
+  { // 6200 ms
+    {137, 137, 137}, {153, 153, 153}, {137, 137, 137}, {153, 153, 153}, {137, 137, 137}, {153, 153, 153},
+    {137, 137, 137}, {153, 153, 153}, {137, 137, 137}, {153, 153, 153}, {137, 137, 137}, {153, 153, 153}
+  },
+  { // 6300 ms
+    {130, 130, 130}, {255, 0, 0}, {130, 130, 130}, {153, 153, 153}, {130, 130, 130}, {153, 153, 153},
+    {130, 130, 130}, {153, 153, 153}, {130, 130, 130}, {153, 153, 153}, {130, 130, 130}, {153, 153, 153}
+  },
+  { // 6400 ms
+    {122, 122, 122}, {255, 0, 0}, {122, 122, 122}, {153, 153, 153}, {122, 122, 122}, {153, 153, 153},
+    {122, 122, 122}, {153, 153, 153}, {122, 122, 122}, {153, 153, 153}, {122, 122, 122}, {153, 153, 153}
+  },
+  { // 6500 ms
+    {114, 114, 114}, {255, 0, 0}, {114, 114, 114}, {153, 153, 153}, {114, 114, 114}, {153, 153, 153},
+    {114, 114, 114}, {153, 153, 153}, {114, 114, 114}, {153, 153, 153}, {114, 114, 114}, {153, 153, 153}
+  },
+  { // 6600 ms
+    {107, 107, 107}, {0, 0, 0}, {107, 107, 107}, {153, 153, 153}, {107, 107, 107}, {153, 153, 153},
+    {107, 107, 107}, {255, 255, 0}, {107, 107, 107}, {153, 153, 153}, {107, 107, 107}, {153, 153, 153}
+  },
+  { // 6700 ms
+    {99, 99, 99}, {0, 0, 0}, {99, 99, 99}, {153, 153, 153}, {99, 99, 99}, {153, 153, 153},
+    {99, 99, 99}, {255, 255, 0}, {99, 99, 99}, {153, 153, 153}, {99, 99, 99}, {153, 153, 153}
+  },
+  { // 6800 ms
+    {91, 91, 91}, {0, 0, 0}, {91, 91, 91}, {153, 153, 153}, {91, 91, 91}, {153, 153, 153},
+    {91, 91, 91}, {255, 255, 0}, {91, 91, 91}, {153, 153, 153}, {91, 91, 91}, {153, 153, 153}
+  },
+  { // 6900 ms
+    {84, 84, 84}, {0, 0, 0}, {84, 84, 84}, {0, 255, 0}, {84, 84, 84}, {153, 153, 153},
+    {84, 84, 84}, {0, 0, 0}, {84, 84, 84}, {153, 153, 153}, {84, 84, 84}, {153, 153, 153}
+  },
+  { // 7000 ms
+    {76, 76, 76}, {0, 0, 0}, {76, 76, 76}, {0, 255, 0}, {76, 76, 76}, {153, 153, 153},
+    {76, 76, 76}, {0, 0, 0}, {76, 76, 76}, {153, 153, 153}, {76, 76, 76}, {153, 153, 153}
+  },
+  { // 7100 ms
+    {68, 68, 68}, {0, 0, 0}, {68, 68, 68}, {0, 255, 0}, {68, 68, 68}, {153, 153, 153},
+    {68, 68, 68}, {0, 0, 0}, {68, 68, 68}, {153, 153, 153}, {68, 68, 68}, {153, 153, 153}
+  },
+  { // 7200 ms
+    {61, 61, 61}, {0, 0, 0}, {61, 61, 61}, {0, 0, 0}, {61, 61, 61}, {153, 153, 153},
+    {61, 61, 61}, {0, 0, 0}, {61, 61, 61}, {0, 0, 255}, {61, 61, 61}, {153, 153, 153}
+  },
+  { // 7300 ms
+    {53, 53, 53}, {0, 0, 0}, {53, 53, 53}, {0, 0, 0}, {53, 53, 53}, {153, 153, 153},
+    {53, 53, 53}, {0, 0, 0}, {53, 53, 53}, {0, 0, 255}, {53, 53, 53}, {153, 153, 153}
+  },
+  { // 7400 ms
+    {45, 45, 45}, {0, 0, 0}, {45, 45, 45}, {0, 0, 0}, {45, 45, 45}, {153, 153, 153},
+    {45, 45, 45}, {0, 0, 0}, {45, 45, 45}, {0, 0, 255}, {45, 45, 45}, {153, 153, 153}
+  },
+  { // 7500 ms
+    {38, 38, 38}, {0, 0, 0}, {38, 38, 38}, {0, 0, 0}, {38, 38, 38}, {128, 0, 255},
+    {38, 38, 38}, {0, 0, 0}, {38, 38, 38}, {0, 0, 0}, {38, 38, 38}, {153, 153, 153}
+  },
+  { // 7600 ms
+    {30, 30, 30}, {0, 0, 0}, {30, 30, 30}, {0, 0, 0}, {30, 30, 30}, {128, 0, 255},
+    {30, 30, 30}, {0, 0, 0}, {30, 30, 30}, {0, 0, 0}, {30, 30, 30}, {153, 153, 153}
+  },
+  { // 7700 ms
+    {22, 22, 22}, {0, 0, 0}, {22, 22, 22}, {0, 0, 0}, {22, 22, 22}, {128, 0, 255},
+    {22, 22, 22}, {0, 0, 0}, {22, 22, 22}, {0, 0, 0}, {22, 22, 22}, {153, 153, 153}
+  },
+  { // 7800 ms
+    {15, 15, 15}, {0, 0, 0}, {15, 15, 15}, {0, 0, 0}, {15, 15, 15}, {0, 0, 0},
+    {15, 15, 15}, {0, 0, 0}, {15, 15, 15}, {0, 0, 0}, {15, 15, 15}, {255, 105, 180}
+  },
+  { // 7900 ms
+    {7, 7, 7}, {0, 0, 0}, {7, 7, 7}, {0, 0, 0}, {7, 7, 7}, {0, 0, 0},
+    {7, 7, 7}, {0, 0, 0}, {7, 7, 7}, {0, 0, 0}, {7, 7, 7}, {255, 105, 180}
+  }
+};
+
+#endif // RAINBOW_BURST_GOLDEN_H
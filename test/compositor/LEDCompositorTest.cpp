@@ -0,0 +1,110 @@
+#include <Arduino.h>
+#include "../../src/hardware/LEDCompositor.h"
+#include "../helpers/TestCheck.h"
+
+static bool sameColor(const Color& c, uint8_t r, uint8_t g, uint8_t b) {
+    return c.r == r && c.g == g && c.b == b;
+}
+
+/**
+ * @brief Layer ordering, coverage and clearing
+ */
+void testLayering() {
+    Serial.println("\n[Layering]");
+
+    LEDCompositor compositor;
+    Color frame[Config::NUM_LEDS];
+
+    compositor.flatten(frame);
+    check(sameColor(frame[0], 0, 0, 0) && sameColor(frame[Config::NUM_LEDS - 1], 0, 0, 0), "empty compositor is black");
+
+    compositor.fill(LEDLayer::BASE, {10, 20, 30});
+    compositor.setPixel(LEDLayer::FEEDBACK, 3, {0, 0, 255});
+    compositor.setPixel(LEDLayer::DEBUG_OVERLAY, 3, {255, 0, 0});
+    compositor.setPixel(LEDLayer::DEBUG_OVERLAY, 6, {0, 0, 0});
+    compositor.flatten(frame);
+    check(sameColor(frame[0], 10, 20, 30), "undrawn upper pixels show the base");
+    check(sameColor(frame[3], 255, 0, 0), "topmost layer wins");
+    check(sameColor(frame[6], 0, 0, 0), "opaque black covers the base");
+
+    compositor.clear(LEDLayer::DEBUG_OVERLAY);
+    compositor.flatten(frame);
+    check(!compositor.hasContent(LEDLayer::DEBUG_OVERLAY), "cleared layer is empty");
+    check(sameColor(frame[3], 0, 0, 255) && sameColor(frame[6], 10, 20, 30), "clearing the overlay restores the layers below");
+
+    compositor.setPixel(LEDLayer::FEEDBACK, 3, {0, 0, 0}, 0);
+    check(!compositor.hasContent(LEDLayer::FEEDBACK), "zero coverage removes a pixel");
+}
+
+/**
+ * @brief Opacity and blend modes
+ */
+void testBlending() {
+    Serial.println("\n[Blending]");
+
+    LEDCompositor compositor;
+    Color frame[Config::NUM_LEDS];
+
+    compositor.fill(LEDLayer::BASE, {200, 100, 0});
+    compositor.fill(LEDLayer::FEEDBACK, {0, 100, 200});
+
+    compositor.setOpacity(LEDLayer::FEEDBACK, 0);
+    compositor.flatten(frame);
+    check(sameColor(frame[0], 200, 100, 0), "opacity 0 hides the layer");
+
+    compositor.setOpacity(LEDLayer::FEEDBACK, 128);
+    compositor.flatten(frame);
+    check(frame[0].r >= 98 && frame[0].r <= 101 && frame[0].b >= 98 && frame[0].b <= 101, "half opacity cross-fades");
+
+    compositor.setOpacity(LEDLayer::FEEDBACK, 255);
+    compositor.setBlendMode(LEDLayer::FEEDBACK, BlendMode::ADD);
+    compositor.flatten(frame);
+    check(sameColor(frame[0], 200, 200, 200), "add");
+    compositor.fill(LEDLayer::FEEDBACK, {100, 0, 0});
+    compositor.flatten(frame);
+    check(frame[0].r == 255, "add saturates");
+
+    compositor.setBlendMode(LEDLayer::FEEDBACK, BlendMode::LIGHTEN);
+    compositor.fill(LEDLayer::FEEDBACK, {50, 150, 20});
+    compositor.flatten(frame);
+    check(sameColor(frame[0], 200, 150, 20), "lighten keeps the brighter channel");
+}
+
+/**
+ * @brief Cost of flattening all three layers
+ */
+void benchmarkFlatten() {
+    Serial.println("\n[Flatten cost]");
+
+    LEDCompositor compositor;
+    Color frame[Config::NUM_LEDS];
+    const uint16_t ITERATIONS = 1000;
+
+    compositor.fill(LEDLayer::BASE, {10, 20, 30});
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < ITERATIONS; i++) {
+        compositor.flatten(frame);
+    }
+    Serial.printf("    base only          %.2f us/frame\n", (float)(micros() - start) / ITERATIONS);
+
+    compositor.fill(LEDLayer::FEEDBACK, {0, 0, 255}, 128);
+    compositor.fill(LEDLayer::DEBUG_OVERLAY, {255, 0, 0});
+    start = micros();
+    for (uint16_t i = 0; i < ITERATIONS; i++) {
+        compositor.flatten(frame);
+    }
+    Serial.printf("    three full layers  %.2f us/frame\n", (float)(micros() - start) / ITERATIONS);
+}
+
+/**
+ * @brief Run all compositor tests
+ */
+void testLEDCompositor() {
+    resetChecks();
+
+    testLayering();
+    testBlending();
+    benchmarkFlatten();
+
+    reportChecks("LED compositor");
+}
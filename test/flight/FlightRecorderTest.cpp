@@ -0,0 +1,111 @@
+#include <Arduino.h>
+#include <esp_system.h>
+#include "../../src/diagnostics/FlightRecorder.h"
+#include "../helpers/TestCheck.h"
+
+static SensorData makeData(int16_t i) {
+    SensorData data;
+    data.accelX = i;
+    data.accelY = -i;
+    data.accelZ = 16384;
+    data.gyroX = data.gyroY = data.gyroZ = 0;
+    data.timestamp = millis();
+    return data;
+}
+
+/**
+ * @brief Samples and events go into the ring in order; the oldest are overwritten
+ */
+void testRecording() {
+    Serial.println("\n[Recording]");
+
+    FlightRecorder::recover(ESP_RST_POWERON);
+    const FlightRecord* boot = FlightRecorder::get(0);
+    check(FlightRecorder::count() == 1 && boot && boot->type == FLIGHT_EVENT && boot->code == FLIGHT_EVENT_BOOT &&
+          boot->value == ESP_RST_POWERON, "a new run starts with a boot event");
+
+    FlightRecorder::noteRender(900);
+    FlightRecorder::noteRender(4200);
+    FlightRecorder::sample(makeData(7), POS_CALM, 1500);
+    const FlightRecord* sample = FlightRecorder::get(0);
+    check(sample && sample->type == FLIGHT_SAMPLE && sample->code == POS_CALM && sample->value == 1500 &&
+          sample->accel[0] == 7 && sample->accel[1] == -7 && sample->accel[2] == 16384, "sample fields");
+    check(sample && sample->renderUs == 4200, "the slowest render since the last sample is kept");
+    FlightRecorder::sample(makeData(8), POS_CALM, 100000);
+    sample = FlightRecorder::get(0);
+    check(sample && sample->renderUs == 0 && sample->value == 0xFFFF, "render time resets; long ticks saturate");
+
+    for (uint16_t i = 0; i < FlightRecorder::CAPACITY + 10; i++) {
+        FlightRecorder::sample(makeData((int16_t)i), POS_OFFER, i);
+    }
+    FlightRecorder::event(FLIGHT_EVENT_MODE, 2);
+    check(FlightRecorder::count() == FlightRecorder::CAPACITY, "the ring holds CAPACITY records");
+    const FlightRecord* newest = FlightRecorder::get(0);
+    const FlightRecord* oldest = FlightRecorder::get(FlightRecorder::CAPACITY - 1);
+    check(newest && newest->type == FLIGHT_EVENT && newest->code == FLIGHT_EVENT_MODE && newest->value == 2,
+          "the newest record is the last event");
+    check(oldest && oldest->type == FLIGHT_SAMPLE && oldest->value == 11, "the oldest records are overwritten");
+    check(FlightRecorder::get(FlightRecorder::CAPACITY) == nullptr, "ages past the count return nullptr");
+}
+
+/**
+ * @brief A crash reset keeps the previous run's log; a normal reset does not
+ */
+void testRecovery() {
+    Serial.println("\n[Recovery]");
+
+    FlightRecorder::clearCrash();
+    FlightRecorder::recover(ESP_RST_POWERON);
+    FlightRecorder::sample(makeData(1), POS_DIG, 10);
+    FlightRecorder::sample(makeData(2), POS_DIG, 20);
+    check(!FlightRecorder::recover(ESP_RST_SW), "a software reset is not a crash");
+    check(!FlightRecorder::hasCrash() && FlightRecorder::count() == 1, "nothing kept; recording starts over");
+
+    FlightRecorder::sample(makeData(3), POS_SHIELD, 30);
+    FlightRecorder::event(FLIGHT_EVENT_SPELL, 4);
+    uint16_t recorded = FlightRecorder::count();
+    check(FlightRecorder::recover(ESP_RST_TASK_WDT), "a watchdog reset is a crash");
+    const FlightLog& crash = FlightRecorder::lastCrash();
+    check(FlightRecorder::hasCrash() && crash.count == recorded && crash.resetReason == ESP_RST_TASK_WDT,
+          "the crashed run's records and reset reason are kept");
+    const FlightRecord& last = crash.records[(crash.head + FlightRecorder::CAPACITY - 1) % FlightRecorder::CAPACITY];
+    check(last.type == FLIGHT_EVENT && last.code == FLIGHT_EVENT_SPELL && last.value == 4,
+          "the last record before the crash is intact");
+    check(FlightRecorder::count() == 1, "the new run records separately");
+
+    check(FlightRecorder::recover(ESP_RST_BROWNOUT) && FlightRecorder::lastCrash().count == 1,
+          "a brownout keeps the short log of the run in between");
+
+    FlightRecorder::clearCrash();
+    check(!FlightRecorder::hasCrash(), "clear forgets the crash log");
+}
+
+/**
+ * @brief Recording a tick costs a few stores
+ */
+void benchmarkFlightRecorder() {
+    Serial.println("\n[Benchmark]");
+
+    const uint16_t samples = 10000;
+    SensorData data = makeData(100);
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < samples; i++) {
+        FlightRecorder::sample(data, POS_CALM, i);
+    }
+    float us = (float)(micros() - start) / samples;
+    Serial.printf("    sample %6.3f us/tick\n", us);
+    check(us < 5.0f, "recording a tick takes under 5 us");
+}
+
+/**
+ * @brief Run all flight recorder tests
+ */
+void testFlightRecorder() {
+    resetChecks();
+
+    testRecording();
+    testRecovery();
+    benchmarkFlightRecorder();
+
+    reportChecks("Flight recorder");
+}
@@ -0,0 +1,19 @@
+#include <Arduino.h>
+
+// Forward declaration of test function
+extern void testFlightRecorder();
+
+void setup() {
+  // Initialize serial communication
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("PrismaTech Gauntlet 3.0 - Flight Recorder Test");
+
+  // Run flight recorder tests and benchmark
+  testFlightRecorder();
+}
+
+void loop() {
+  // Just delay in the main loop
+  delay(1000);
+}
@@ -0,0 +1,136 @@
+#include <Arduino.h>
+#include <string.h>
+#include "../../src/animation/PatternCache.h"
+#include "../../src/animation/FreecastPatterns.h"
+#include "../helpers/TestCheck.h"
+
+static const uint16_t FRAME_COUNT = Config::FREECAST_DISPLAY_MS / Config::DISPLAY_FRAME_PERIOD_MS;
+
+static const char* const PATTERN_NAMES[] = {"shooting stars", "waves", "sparkles", "color trails", "pulses"};
+
+static FreecastPatternParams makeParams(PatternType type) {
+    FreecastPatternParams params;
+    params.type = type;
+    params.intensity = 0.8f;
+    params.directionality = 0.5f;
+    params.hasMotion = true;
+    return params;
+}
+
+// Bake a whole display phase the way FreeCastMode does
+static void bake(PatternCache& cache, const FreecastPatternParams& params) {
+    Color frame[Config::NUM_LEDS];
+    cache.begin(FRAME_COUNT, Config::DISPLAY_FRAME_PERIOD_MS);
+    while (cache.getNextFrame() < FRAME_COUNT) {
+        FreecastPatterns::render(params, (unsigned long)cache.getNextFrame() * Config::DISPLAY_FRAME_PERIOD_MS, frame);
+        if (!cache.addFrame(frame)) {
+            break;
+        }
+    }
+    cache.seal();
+}
+
+/**
+ * @brief Played-back frames match live rendering for every pattern
+ */
+void testPlayback() {
+    Serial.println("\n[Playback]");
+
+    static PatternCache cache;
+    Color live[Config::NUM_LEDS];
+    Color cached[Config::NUM_LEDS];
+
+    for (uint8_t type = 0; type < 5; type++) {
+        FreecastPatternParams params = makeParams((PatternType)type);
+        bake(cache, params);
+
+        bool identical = cache.getNextFrame() == FRAME_COUNT;
+        for (uint16_t f = 0; f < FRAME_COUNT && identical; f++) {
+            uint32_t t = (uint32_t)f * Config::DISPLAY_FRAME_PERIOD_MS;
+            FreecastPatterns::render(params, t, live);
+            identical = cache.play(t + Config::DISPLAY_FRAME_PERIOD_MS / 2, cached) &&
+                        memcmp(live, cached, sizeof(live)) == 0;
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "%s: every cached frame matches live rendering", PATTERN_NAMES[type]);
+        check(identical, name);
+        Serial.printf("    %-15s %4u bytes for %u frames\n", PATTERN_NAMES[type], cache.getSize(), FRAME_COUNT);
+    }
+
+    check(!cache.play(Config::FREECAST_DISPLAY_MS, cached), "time past the display phase is not cached");
+}
+
+/**
+ * @brief Frames are only served from a sealed cache; the rest fall back to live rendering
+ */
+void testPartialBake() {
+    Serial.println("\n[Partial bake]");
+
+    static PatternCache cache;
+    Color frame[Config::NUM_LEDS];
+    FreecastPatternParams params = makeParams(PatternType::WAVES);
+
+    cache.begin(FRAME_COUNT, Config::DISPLAY_FRAME_PERIOD_MS);
+    for (uint8_t n = 0; n < Config::FREECAST_BAKE_FRAMES_PER_TICK; n++) {
+        FreecastPatterns::render(params, (unsigned long)n * Config::DISPLAY_FRAME_PERIOD_MS, frame);
+        cache.addFrame(frame);
+    }
+    check(!cache.isSealed() && !cache.play(0, frame), "nothing is played while the bake is in progress");
+
+    cache.seal();
+    check(cache.play(0, frame), "frames baked so far play once sealed");
+    check(!cache.play((uint32_t)Config::FREECAST_BAKE_FRAMES_PER_TICK * Config::DISPLAY_FRAME_PERIOD_MS, frame),
+          "frames that were not baked are left to live rendering");
+    check(!cache.addFrame(frame), "a sealed cache takes no more frames");
+
+    check(cache.play(0, frame) && cache.play(8 * Config::DISPLAY_FRAME_PERIOD_MS, frame) && cache.play(0, frame),
+          "seeking backwards rewinds the clip");
+}
+
+/**
+ * @brief Render cost per display second, live vs cached
+ */
+void benchmarkPatternCache() {
+    Serial.println("\n[Render cost per display second]");
+
+    static PatternCache cache;
+    Color frame[Config::NUM_LEDS];
+    volatile uint8_t sink = 0;
+    const uint16_t framesPerSecond = 1000 / Config::DISPLAY_FRAME_PERIOD_MS;
+
+    for (uint8_t type = 0; type < 5; type++) {
+        FreecastPatternParams params = makeParams((PatternType)type);
+
+        unsigned long start = micros();
+        for (uint16_t f = 0; f < FRAME_COUNT; f++) {
+            FreecastPatterns::render(params, (unsigned long)f * Config::DISPLAY_FRAME_PERIOD_MS, frame);
+            sink ^= frame[f % Config::NUM_LEDS].r;
+        }
+        float liveUs = (float)(micros() - start) / FRAME_COUNT;
+
+        bake(cache, params);
+        start = micros();
+        for (uint16_t f = 0; f < FRAME_COUNT; f++) {
+            cache.play((uint32_t)f * Config::DISPLAY_FRAME_PERIOD_MS, frame);
+            sink ^= frame[f % Config::NUM_LEDS].r;
+        }
+        float playbackUs = (float)(micros() - start) / FRAME_COUNT;
+
+        Serial.printf("    %-15s live %7.2f us/frame, cached %6.2f us/frame, %8.1f us saved per display second\n",
+                      PATTERN_NAMES[type], liveUs, playbackUs, (liveUs - playbackUs) * framesPerSecond);
+    }
+    (void)sink;
+}
+
+/**
+ * @brief Run all pattern cache tests
+ */
+void testPatternCache() {
+    resetChecks();
+
+    testPlayback();
+    testPartialBake();
+    benchmarkPatternCache();
+
+    reportChecks("Pattern cache");
+}
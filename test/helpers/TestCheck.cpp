@@ -0,0 +1,28 @@
+#include "TestCheck.h"
+
+static uint16_t failures = 0;
+
+void check(bool condition, const char* name) {
+    Serial.print(condition ? "  PASS  " : "  FAIL  ");
+    Serial.println(name);
+    if (!condition) {
+        failures++;
+    }
+}
+
+void resetChecks() {
+    failures = 0;
+}
+
+uint16_t checkFailures() {
+    return failures;
+}
+
+void reportChecks(const char* suite) {
+    Serial.println();
+    if (failures == 0) {
+        Serial.printf("%s tests PASSED\n", suite);
+    } else {
+        Serial.printf("%s tests FAILED (%u failures)\n", suite, failures);
+    }
+}
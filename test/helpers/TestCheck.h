@@ -0,0 +1,34 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Pass/fail bookkeeping shared by the on-device test suites
+ *
+ * A suite calls resetChecks(), runs its sections, which call check() once
+ * per assertion, and ends with reportChecks(). Each env adds
+ * test/helpers/TestCheck.cpp to its build_src_filter.
+ */
+
+/**
+ * @brief Print PASS or FAIL with the check's name and count the failures
+ */
+void check(bool condition, const char* name);
+
+/**
+ * @brief Forget the failures counted so far
+ */
+void resetChecks();
+
+/**
+ * @brief Failures counted since the last resetChecks()
+ */
+uint16_t checkFailures();
+
+/**
+ * @brief Print "<suite> tests PASSED", or FAILED with the failure count
+ */
+void reportChecks(const char* suite);
+
+#endif // TEST_CHECK_H
@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "HostRenderer.h"
+#include "../../src/diagnostics/MemoryMonitor.h"
+
+/**
+ * @brief Offline LED renderer and golden-timeline regression suite
+ *
+ *   hostrender list
+ *   hostrender render <effect|scenario.scn> [--csv FILE] [--ppm FILE] [--scale N] [--frame-ms N]
+ *   hostrender check <golden dir> [--tolerance N] [--max-us N]
+ *   hostrender bless <golden dir>
+ *   hostrender bench
+ *   hostrender memory
+ *
+ * The golden directory holds one <name>.csv per effect and, for every
+ * scenario script <name>.scn in it, the matching <name>.csv. check exits
+ * non-zero on any visual difference or, with --max-us, on any effect whose
+ * render time per frame exceeds the limit. memory renders every effect and
+ * reports the heap allocations each one made, then the heap figures the
+ * firmware's 'dump memory' shows; build the hostrender_asan environment to
+ * get those from the AddressSanitizer allocator.
+ */
+
+static void usage() {
+    fprintf(stderr,
+            "usage: hostrender list\n"
+            "       hostrender render <effect|scenario.scn> [--csv FILE] [--ppm FILE] [--scale N] [--frame-ms N]\n"
+            "       hostrender check <golden dir> [--tolerance N] [--max-us N]\n"
+            "       hostrender bless <golden dir>\n"
+            "       hostrender bench\n"
+            "       hostrender memory\n");
+}
+
+static bool endsWith(const std::string& text, const char* suffix) {
+    size_t n = strlen(suffix);
+    return text.size() >= n && text.compare(text.size() - n, n, suffix) == 0;
+}
+
+// A named effect, or a scenario script if the argument is a .scn path
+static bool resolve(const char* target, Scenario& scenario) {
+    const HostEffect* effect = HostRenderer::findEffect(target);
+    if (effect) {
+        scenario = HostRenderer::singleEffect(*effect);
+        return true;
+    }
+    std::string error;
+    if (!HostRenderer::loadScenario(target, scenario, error)) {
+        fprintf(stderr, "%s: %s\n", target, error.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Every effect, then every scenario script in the golden directory
+static bool collectSuite(const char* dir, std::vector<Scenario>& suite) {
+    for (size_t i = 0; i < HostRenderer::effectCount(); i++) {
+        suite.push_back(HostRenderer::singleEffect(HostRenderer::effects()[i]));
+    }
+
+    DIR* d = opendir(dir);
+    if (!d) {
+        fprintf(stderr, "cannot open %s\n", dir);
+        return false;
+    }
+    std::vector<std::string> scripts;
+    for (dirent* entry = readdir(d); entry; entry = readdir(d)) {
+        if (endsWith(entry->d_name, ".scn")) {
+            scripts.push_back(std::string(dir) + "/" + entry->d_name);
+        }
+    }
+    closedir(d);
+    std::sort(scripts.begin(), scripts.end());
+
+    for (size_t i = 0; i < scripts.size(); i++) {
+        Scenario scenario;
+        std::string error;
+        if (!HostRenderer::loadScenario(scripts[i].c_str(), scenario, error)) {
+            fprintf(stderr, "%s: %s\n", scripts[i].c_str(), error.c_str());
+            return false;
+        }
+        suite.push_back(scenario);
+    }
+    return true;
+}
+
+static int cmdList() {
+    for (size_t i = 0; i < HostRenderer::effectCount(); i++) {
+        const HostEffect& effect = HostRenderer::effects()[i];
+        printf("%-24s %6u ms  %s\n", effect.name, (unsigned)HostRenderer::effectDuration(effect),
+               effect.program ? "program" : "procedural");
+    }
+    return 0;
+}
+
+static int cmdRender(int argc, char** argv) {
+    if (argc < 1) {
+        usage();
+        return 2;
+    }
+    const char* csvPath = nullptr;
+    const char* ppmPath = nullptr;
+    uint8_t scale = 8;
+    uint16_t frameMs = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--csv") == 0) csvPath = argv[i + 1];
+        else if (strcmp(argv[i], "--ppm") == 0) ppmPath = argv[i + 1];
+        else if (strcmp(argv[i], "--scale") == 0) scale = (uint8_t)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--frame-ms") == 0) frameMs = (uint16_t)atoi(argv[i + 1]);
+        else {
+            usage();
+            return 2;
+        }
+    }
+
+    Scenario scenario;
+    if (!resolve(argv[0], scenario)) {
+        return 2;
+    }
+    Timeline timeline;
+    HostRenderer::render(scenario, frameMs, timeline);
+
+    // CSV to stdout unless a file was asked for
+    if (!csvPath && !ppmPath) {
+        HostRenderer::writeCsv(timeline, scenario.name.c_str(), stdout);
+        return 0;
+    }
+    if (csvPath) {
+        FILE* out = fopen(csvPath, "w");
+        if (!out || !HostRenderer::writeCsv(timeline, scenario.name.c_str(), out)) {
+            fprintf(stderr, "cannot write %s\n", csvPath);
+            return 1;
+        }
+        fclose(out);
+    }
+    if (ppmPath) {
+        FILE* out = fopen(ppmPath, "wb");
+        if (!out || !HostRenderer::writePpm(timeline, scale, out)) {
+            fprintf(stderr, "cannot write %s\n", ppmPath);
+            return 1;
+        }
+        fclose(out);
+    }
+    printf("%s: %u frames every %u ms\n", scenario.name.c_str(), (unsigned)timeline.frameCount(), timeline.frameMs);
+    return 0;
+}
+
+static int cmdCheck(int argc, char** argv, bool bless) {
+    if (argc < 1) {
+        usage();
+        return 2;
+    }
+    const char* dir = argv[0];
+    uint8_t tolerance = 1;
+    float maxUs = 0.0f;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--tolerance") == 0) tolerance = (uint8_t)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--max-us") == 0) maxUs = (float)atof(argv[i + 1]);
+        else {
+            usage();
+            return 2;
+        }
+    }
+
+    std::vector<Scenario> suite;
+    if (!collectSuite(dir, suite)) {
+        return 2;
+    }
+
+    unsigned failures = 0;
+    for (size_t i = 0; i < suite.size(); i++) {
+        const Scenario& scenario = suite[i];
+        std::string path = std::string(dir) + "/" + scenario.name + ".csv";
+        Timeline rendered;
+        HostRenderer::render(scenario, 0, rendered);
+
+        if (bless) {
+            FILE* out = fopen(path.c_str(), "w");
+            if (!out || !HostRenderer::writeCsv(rendered, scenario.name.c_str(), out)) {
+                fprintf(stderr, "cannot write %s\n", path.c_str());
+                return 1;
+            }
+            fclose(out);
+            printf("  WROTE %s (%u frames)\n", path.c_str(), (unsigned)rendered.frameCount());
+            continue;
+        }
+
+        Timeline golden;
+        std::string report;
+        bool match = HostRenderer::readCsv(path.c_str(), golden, report) &&
+                     HostRenderer::compare(golden, rendered, tolerance, report);
+        float us = HostRenderer::benchmark(scenario);
+        bool fast = maxUs <= 0.0f || us <= maxUs;
+        printf(match && fast ? "  PASS  " : "  FAIL  ");
+        printf("%-24s %4u frames  %7.2f us/frame\n", scenario.name.c_str(), (unsigned)rendered.frameCount(), us);
+        if (!match) {
+            printf("        %s\n", report.c_str());
+        }
+        if (!fast) {
+            printf("        over the %.2f us/frame budget\n", maxUs);
+        }
+        if (!match || !fast) {
+            failures++;
+        }
+    }
+
+    if (bless) {
+        return 0;
+    }
+    printf("\n");
+    if (failures == 0) {
+        printf("Host render tests PASSED\n");
+        return 0;
+    }
+    printf("Host render tests FAILED (%u failures)\n", failures);
+    return 1;
+}
+
+static int cmdBench() {
+    for (size_t i = 0; i < HostRenderer::effectCount(); i++) {
+        Scenario scenario = HostRenderer::singleEffect(HostRenderer::effects()[i]);
+        printf("%-24s %7.2f us/frame\n", scenario.name.c_str(), HostRenderer::benchmark(scenario));
+    }
+    return 0;
+}
+
+static int cmdMemory() {
+    for (size_t i = 0; i < HostRenderer::effectCount(); i++) {
+        Scenario scenario = HostRenderer::singleEffect(HostRenderer::effects()[i]);
+        uint32_t before = MemoryMonitor::allocations();
+        HostRenderer::benchmark(scenario);
+        printf("%-24s %7lu allocations\n", scenario.name.c_str(),
+               (unsigned long)(MemoryMonitor::allocations() - before));
+    }
+
+    MemoryStats stats;
+    MemoryMonitor::sample(stats);
+    if (MemoryMonitor::hasHeapStats()) {
+        printf("heap: %lu used, %lu free, lowest free %lu\n", (unsigned long)stats.heapUsed,
+               (unsigned long)stats.heapFree, (unsigned long)stats.heapMinFree);
+    } else {
+        printf("heap: n/a (build with -fsanitize=address)\n");
+    }
+    printf("allocations since start: %lu new, %lu delete\n", (unsigned long)stats.allocations,
+           (unsigned long)stats.frees);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    const char* command = argv[1];
+    if (strcmp(command, "list") == 0) return cmdList();
+    if (strcmp(command, "render") == 0) return cmdRender(argc - 2, argv + 2);
+    if (strcmp(command, "check") == 0) return cmdCheck(argc - 2, argv + 2, false);
+    if (strcmp(command, "bless") == 0) return cmdCheck(argc - 2, argv + 2, true);
+    if (strcmp(command, "bench") == 0) return cmdBench();
+    if (strcmp(command, "memory") == 0) return cmdMemory();
+    usage();
+    return 2;
+}
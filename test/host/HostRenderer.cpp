@@ -0,0 +1,424 @@
+#include "HostRenderer.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../src/core/Config.h"
+#include "../../src/core/SpellRegistry.h"
+#include "../../src/animation/AnimationSystem.h"
+#include "../../src/animation/AnimationPrograms.h"
+#include "../../src/animation/FreecastPatterns.h"
+
+namespace {
+
+    // --- Procedural effects, wrapped as the modes wrap them ---
+
+    void renderSpell(const void* params, uint32_t startMs, uint32_t elapsedMs, Color* frame) {
+        static_cast<const SpellDefinition*>(params)->render(startMs, elapsedMs, frame);
+    }
+
+    void renderFreecast(const void* params, uint32_t, uint32_t elapsedMs, Color* frame) {
+        FreecastPatterns::render(*static_cast<const FreecastPatternParams*>(params), elapsedMs, frame);
+    }
+
+    // Motion as analyzed from a typical two second recording
+    const FreecastPatternParams SHOOTING_STARS = {PatternType::SHOOTING_STARS, 0.8f, 0.5f, true};
+    const FreecastPatternParams WAVES = {PatternType::WAVES, 0.8f, 0.5f, true};
+    const FreecastPatternParams SPARKLES = {PatternType::SPARKLES, 0.8f, 0.5f, true};
+    const FreecastPatternParams COLOR_TRAILS = {PatternType::COLOR_TRAILS, 0.8f, 0.5f, true};
+    const FreecastPatternParams PULSES = {PatternType::PULSES, 0.8f, 0.5f, true};
+    const FreecastPatternParams STILL = {PatternType::WAVES, 0.0f, 0.0f, false};
+
+    const uint8_t SPELL = AnimationSystem::PRIORITY_NORMAL;
+    const uint8_t ALERT = AnimationSystem::PRIORITY_ALERT;
+
+    // Everything else the firmware posts; the QuickCast spells come from SpellRegistry
+    const HostEffect OTHER_EFFECTS[] = {
+        // ShakeCancel flash, as posted by GauntletController
+        {"shake_cancel", ANIM_CANCEL_FLASH, ANIM_CANCEL_FLASH_SIZE, nullptr, nullptr, LEDLayer::EFFECTS, ALERT, 0},
+
+        // Remaining compiled programs
+        {"checkpoint_flash", ANIM_CHECKPOINT_FLASH, ANIM_CHECKPOINT_FLASH_SIZE, nullptr, nullptr,
+         LEDLayer::FEEDBACK, SPELL, 0},
+        {"freecast_transition", ANIM_FREECAST_TRANSITION, ANIM_FREECAST_TRANSITION_SIZE, nullptr, nullptr,
+         LEDLayer::EFFECTS, SPELL, 0},
+        {"invocation_transition", ANIM_INVOCATION_TRANSITION, ANIM_INVOCATION_TRANSITION_SIZE, nullptr, nullptr,
+         LEDLayer::EFFECTS, SPELL, 0},
+
+        // FreeCast display phase, drawn into the base layer
+        {"freecast_shooting_stars", nullptr, 0, renderFreecast, &SHOOTING_STARS,
+         LEDLayer::BASE, SPELL, Config::FREECAST_DISPLAY_MS},
+        {"freecast_waves", nullptr, 0, renderFreecast, &WAVES, LEDLayer::BASE, SPELL, Config::FREECAST_DISPLAY_MS},
+        {"freecast_sparkles", nullptr, 0, renderFreecast, &SPARKLES, LEDLayer::BASE, SPELL, Config::FREECAST_DISPLAY_MS},
+        {"freecast_color_trails", nullptr, 0, renderFreecast, &COLOR_TRAILS,
+         LEDLayer::BASE, SPELL, Config::FREECAST_DISPLAY_MS},
+        {"freecast_pulses", nullptr, 0, renderFreecast, &PULSES, LEDLayer::BASE, SPELL, Config::FREECAST_DISPLAY_MS},
+        {"freecast_still", nullptr, 0, renderFreecast, &STILL, LEDLayer::BASE, SPELL, Config::FREECAST_DISPLAY_MS},
+    };
+
+    // QuickCast spells as QuickCastSpellsMode posts them, then the other effects
+    const std::vector<HostEffect>& catalog() {
+        static std::vector<HostEffect> effects;
+        if (effects.empty()) {
+            for (SpellId id = 0; id < SpellRegistry::COUNT; id++) {
+                const SpellDefinition& spell = SpellRegistry::SPELLS[id];
+                HostEffect effect = {spell.name, spell.program, spell.programLength,
+                                     spell.program ? nullptr : renderSpell, &spell, LEDLayer::EFFECTS, SPELL,
+                                     spell.exit == SpellExit::ON_COMPLETE ? spell.durationMs : 0};
+                effects.push_back(effect);
+            }
+            effects.insert(effects.end(), OTHER_EFFECTS, OTHER_EFFECTS + sizeof(OTHER_EFFECTS) / sizeof(OTHER_EFFECTS[0]));
+        }
+        return effects;
+    }
+
+    // Context of a procedural effect while it runs in the AnimationSystem
+    struct RunningEffect {
+        const HostEffect* effect;
+        uint32_t startMs;
+    };
+
+    bool drawProcedural(void* context, uint32_t elapsedMs, Color* frame, uint8_t* coverage) {
+        const RunningEffect* running = static_cast<const RunningEffect*>(context);
+        running->effect->render(running->effect->params, running->startMs, elapsedMs, frame);
+        memset(coverage, 255, Config::NUM_LEDS);
+        return true;
+    }
+
+    bool parseLayer(const char* text, LEDLayer& layer) {
+        static const char* const NAMES[] = {"base", "feedback", "effects", "debug"};
+        for (uint8_t i = 0; i < static_cast<uint8_t>(LEDLayer::COUNT); i++) {
+            if (strcmp(text, NAMES[i]) == 0) {
+                layer = static_cast<LEDLayer>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int hexDigit(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+} // namespace
+
+const HostEffect* HostRenderer::effects() {
+    return catalog().data();
+}
+
+size_t HostRenderer::effectCount() {
+    return catalog().size();
+}
+
+const HostEffect* HostRenderer::findEffect(const char* name) {
+    const std::vector<HostEffect>& effects = catalog();
+    for (size_t i = 0; i < effects.size(); i++) {
+        if (strcmp(effects[i].name, name) == 0) {
+            return &effects[i];
+        }
+    }
+    return nullptr;
+}
+
+uint32_t HostRenderer::effectDuration(const HostEffect& effect) {
+    if (effect.durationMs > 0 || !effect.program) {
+        return effect.durationMs;
+    }
+    AnimationPlayer player;
+    player.load(effect.program, effect.programLength);
+    return player.getDuration();
+}
+
+Scenario HostRenderer::singleEffect(const HostEffect& effect) {
+    Scenario scenario;
+    scenario.name = effect.name;
+    scenario.events.push_back({0, &effect, false, effect.layer, effect.priority});
+    scenario.endMs = effectDuration(effect);
+    scenario.frameMs = 0;
+    return scenario;
+}
+
+bool HostRenderer::loadScenario(const char* path, Scenario& scenario, std::string& error) {
+    FILE* in = fopen(path, "r");
+    if (!in) {
+        error = std::string("cannot open ") + path;
+        return false;
+    }
+
+    std::string name = path;
+    size_t slash = name.find_last_of('/');
+    if (slash != std::string::npos) {
+        name = name.substr(slash + 1);
+    }
+    size_t dot = name.find_last_of('.');
+    scenario.name = dot == std::string::npos ? name : name.substr(0, dot);
+    scenario.events.clear();
+    scenario.endMs = 0;
+    scenario.frameMs = 0;
+
+    // Lines: "<ms> <effect> [layer] [priority]", "<ms> cancel <effect>",
+    // "frame <ms>" or "end <ms>"; '#' starts a comment
+    char line[256];
+    unsigned lineNumber = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), in)) {
+        lineNumber++;
+        char* hash = strchr(line, '#');
+        if (hash) {
+            *hash = '\0';
+        }
+        char* words[4] = {nullptr, nullptr, nullptr, nullptr};
+        uint8_t count = 0;
+        for (char* word = strtok(line, " \t\r\n"); word && count < 4; word = strtok(nullptr, " \t\r\n")) {
+            words[count++] = word;
+        }
+        if (count == 0) {
+            continue;
+        }
+
+        char buffer[96];
+        if (strcmp(words[0], "end") == 0 && count == 2) {
+            scenario.endMs = strtoul(words[1], nullptr, 10);
+        } else if (strcmp(words[0], "frame") == 0 && count == 2) {
+            scenario.frameMs = (uint16_t)strtoul(words[1], nullptr, 10);
+        } else if (count >= 2) {
+            ScenarioEvent event;
+            event.timeMs = strtoul(words[0], nullptr, 10);
+            event.cancel = strcmp(words[1], "cancel") == 0;
+            const char* effectName = event.cancel ? words[2] : words[1];
+            event.effect = effectName ? findEffect(effectName) : nullptr;
+            if (!event.effect) {
+                snprintf(buffer, sizeof(buffer), "line %u: unknown effect '%s'", lineNumber,
+                         effectName ? effectName : "");
+                error = buffer;
+                ok = false;
+                break;
+            }
+            event.layer = event.effect->layer;
+            event.priority = event.effect->priority;
+            if (!event.cancel && count >= 3 && !parseLayer(words[2], event.layer)) {
+                snprintf(buffer, sizeof(buffer), "line %u: unknown layer '%s'", lineNumber, words[2]);
+                error = buffer;
+                ok = false;
+                break;
+            }
+            if (!event.cancel && count == 4) {
+                event.priority = (uint8_t)strtoul(words[3], nullptr, 10);
+            }
+            if (!scenario.events.empty() && event.timeMs < scenario.events.back().timeMs) {
+                snprintf(buffer, sizeof(buffer), "line %u: events must be in time order", lineNumber);
+                error = buffer;
+                ok = false;
+                break;
+            }
+            scenario.events.push_back(event);
+            if (!event.cancel) {
+                uint32_t end = event.timeMs + effectDuration(*event.effect);
+                if (end > scenario.endMs) {
+                    scenario.endMs = end;
+                }
+            }
+        } else {
+            snprintf(buffer, sizeof(buffer), "line %u: expected '<ms> <effect>'", lineNumber);
+            error = buffer;
+            ok = false;
+        }
+    }
+    fclose(in);
+    return ok;
+}
+
+uint16_t HostRenderer::defaultFrameMs(uint32_t lengthMs) {
+    uint32_t frameMs = lengthMs / 100;
+    return frameMs > Config::DISPLAY_FRAME_PERIOD_MS ? (uint16_t)frameMs : Config::DISPLAY_FRAME_PERIOD_MS;
+}
+
+void HostRenderer::render(const Scenario& scenario, uint16_t frameMs, Timeline& out) {
+    if (frameMs == 0) {
+        frameMs = scenario.frameMs ? scenario.frameMs : defaultFrameMs(scenario.endMs);
+    }
+    out.frameMs = frameMs;
+    out.ledCount = Config::NUM_LEDS;
+    out.pixels.clear();
+
+    LEDCompositor compositor;
+    AnimationSystem animations;
+    animations.init(&compositor);
+
+    // Stable storage for callback contexts and the handle of each start
+    std::vector<RunningEffect> running(scenario.events.size());
+    std::vector<AnimationHandle> handles(scenario.events.size(), 0);
+    size_t next = 0;
+
+    Color frame[Config::NUM_LEDS];
+    for (uint32_t t = 0; t < scenario.endMs; t += frameMs) {
+        for (; next < scenario.events.size() && scenario.events[next].timeMs <= t; next++) {
+            const ScenarioEvent& event = scenario.events[next];
+            if (event.cancel) {
+                // Most recent start of the same effect
+                for (size_t k = next; k-- > 0;) {
+                    if (!scenario.events[k].cancel && scenario.events[k].effect == event.effect) {
+                        animations.cancel(handles[k]);
+                        break;
+                    }
+                }
+                continue;
+            }
+
+            AnimationRequest request;
+            if (event.effect->program) {
+                request = AnimationRequest::fromProgram(event.effect->program, event.effect->programLength,
+                                                        event.layer, event.priority);
+            } else {
+                running[next] = {event.effect, event.timeMs};
+                request = AnimationRequest::fromCallback(drawProcedural, &running[next], event.layer, event.priority);
+            }
+            request.durationMs = event.effect->durationMs;
+            handles[next] = animations.start(request, event.timeMs);
+        }
+
+        animations.update(t);
+        compositor.flatten(frame);
+        out.pixels.insert(out.pixels.end(), frame, frame + Config::NUM_LEDS);
+    }
+}
+
+float HostRenderer::benchmark(const Scenario& scenario) {
+    Timeline timeline;
+    unsigned long frames = 0;
+    unsigned long start = micros();
+    // Repeat until the measurement is long enough to be stable
+    do {
+        render(scenario, Config::DISPLAY_FRAME_PERIOD_MS, timeline);
+        frames += timeline.frameCount();
+    } while (micros() - start < 20000 && timeline.frameCount() > 0);
+    return frames ? (float)(micros() - start) / frames : 0.0f;
+}
+
+bool HostRenderer::writeCsv(const Timeline& timeline, const char* title, FILE* out) {
+    // Same layout as utils/frame_codec.py input, so a timeline can be encoded directly
+    fprintf(out, "# %s: %u frames every %u ms, %u LEDs\n", title, (unsigned)timeline.frameCount(),
+            timeline.frameMs, timeline.ledCount);
+    for (size_t f = 0; f < timeline.frameCount(); f++) {
+        const Color* frame = timeline.frame(f);
+        for (uint16_t i = 0; i < timeline.ledCount; i++) {
+            fprintf(out, i ? " %02X%02X%02X" : "%02X%02X%02X", frame[i].r, frame[i].g, frame[i].b);
+        }
+        fputc('\n', out);
+    }
+    return !ferror(out);
+}
+
+bool HostRenderer::readCsv(const char* path, Timeline& timeline, std::string& error) {
+    FILE* in = fopen(path, "r");
+    if (!in) {
+        error = std::string("cannot open ") + path;
+        return false;
+    }
+
+    timeline.frameMs = 0;
+    timeline.ledCount = 0;
+    timeline.pixels.clear();
+
+    char line[4096];
+    while (fgets(line, sizeof(line), in)) {
+        unsigned frameMs = 0;
+        if (line[0] == '#') {
+            const char* every = strstr(line, "every ");
+            if (every && sscanf(every, "every %u ms", &frameMs) == 1) {
+                timeline.frameMs = (uint16_t)frameMs;
+            }
+            continue;
+        }
+
+        uint16_t leds = 0;
+        for (const char* p = line; *p;) {
+            if (hexDigit(*p) < 0) {
+                p++;
+                continue;
+            }
+            uint8_t rgb[3];
+            for (uint8_t c = 0; c < 3; c++) {
+                int hi = hexDigit(p[0]);
+                int lo = hi < 0 ? -1 : hexDigit(p[1]);
+                if (lo < 0) {
+                    error = std::string(path) + ": malformed color";
+                    fclose(in);
+                    return false;
+                }
+                rgb[c] = (uint8_t)(hi * 16 + lo);
+                p += 2;
+            }
+            timeline.pixels.push_back({rgb[0], rgb[1], rgb[2]});
+            leds++;
+        }
+        if (leds == 0) {
+            continue;
+        }
+        if (timeline.ledCount == 0) {
+            timeline.ledCount = leds;
+        } else if (leds != timeline.ledCount) {
+            error = std::string(path) + ": frames have different LED counts";
+            fclose(in);
+            return false;
+        }
+    }
+    fclose(in);
+    return true;
+}
+
+bool HostRenderer::writePpm(const Timeline& timeline, uint8_t scale, FILE* out) {
+    // One row of LED squares per frame, time running down the image
+    if (scale == 0) {
+        scale = 1;
+    }
+    uint32_t width = (uint32_t)timeline.ledCount * scale;
+    uint32_t height = (uint32_t)timeline.frameCount() * scale;
+    fprintf(out, "P6\n%u %u\n255\n", (unsigned)width, (unsigned)height);
+
+    std::vector<uint8_t> row(width * 3);
+    for (size_t f = 0; f < timeline.frameCount(); f++) {
+        const Color* frame = timeline.frame(f);
+        for (uint32_t x = 0; x < width; x++) {
+            const Color& c = frame[x / scale];
+            row[x * 3] = c.r;
+            row[x * 3 + 1] = c.g;
+            row[x * 3 + 2] = c.b;
+        }
+        for (uint8_t y = 0; y < scale; y++) {
+            fwrite(row.data(), 1, row.size(), out);
+        }
+    }
+    return !ferror(out);
+}
+
+bool HostRenderer::compare(const Timeline& expected, const Timeline& actual, uint8_t tolerance,
+                           std::string& report) {
+    char buffer[160];
+    if (expected.ledCount != actual.ledCount || expected.frameCount() != actual.frameCount() ||
+        (expected.frameMs != 0 && expected.frameMs != actual.frameMs)) {
+        snprintf(buffer, sizeof(buffer), "shape differs: golden %u frames x %u LEDs every %u ms, rendered %u x %u every %u ms",
+                 (unsigned)expected.frameCount(), expected.ledCount, expected.frameMs,
+                 (unsigned)actual.frameCount(), actual.ledCount, actual.frameMs);
+        report = buffer;
+        return false;
+    }
+
+    for (size_t f = 0; f < actual.frameCount(); f++) {
+        const Color* want = expected.frame(f);
+        const Color* got = actual.frame(f);
+        for (uint16_t i = 0; i < actual.ledCount; i++) {
+            if (abs(want[i].r - got[i].r) > tolerance || abs(want[i].g - got[i].g) > tolerance ||
+                abs(want[i].b - got[i].b) > tolerance) {
+                snprintf(buffer, sizeof(buffer), "frame %u (%u ms) LED %u: golden %02X%02X%02X, rendered %02X%02X%02X",
+                         (unsigned)f, (unsigned)(f * actual.frameMs), i, want[i].r, want[i].g, want[i].b,
+                         got[i].r, got[i].g, got[i].b);
+                report = buffer;
+                return false;
+            }
+        }
+    }
+    return true;
+}
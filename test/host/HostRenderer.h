@@ -0,0 +1,130 @@
+#ifndef HOST_RENDERER_H
+#define HOST_RENDERER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "../../src/core/SystemTypes.h"
+#include "../../src/hardware/LEDCompositor.h"
+
+/**
+ * @brief Full-frame procedural effect
+ * @param params Effect parameters from the catalog
+ * @param startMs Time the effect was posted
+ * @param elapsedMs Time since then
+ * @param frame Config::NUM_LEDS colors
+ */
+typedef void (*HostRenderFn)(const void* params, uint32_t startMs, uint32_t elapsedMs, Color* frame);
+
+/**
+ * @brief One effect the firmware can draw, as it would be posted to the AnimationSystem
+ */
+struct HostEffect {
+    const char* name;
+    const uint8_t* program;   // Keyframe program, or nullptr for a procedural effect
+    uint16_t programLength;
+    HostRenderFn render;
+    const void* params;       // Passed to render (e.g. FreeCast pattern parameters)
+    LEDLayer layer;
+    uint8_t priority;
+    uint32_t durationMs;      // 0 = the program's own length
+};
+
+/**
+ * @brief A timed command in a scenario script
+ */
+struct ScenarioEvent {
+    uint32_t timeMs;
+    const HostEffect* effect;
+    bool cancel;              // Cancel the last start of effect instead of starting it
+    LEDLayer layer;
+    uint8_t priority;
+};
+
+/**
+ * @brief Scripted or replayed input: what was posted when, and for how long to render
+ */
+struct Scenario {
+    std::string name;
+    std::vector<ScenarioEvent> events;  // Sorted by time
+    uint32_t endMs;
+    uint16_t frameMs;                   // 0 = choose from the length
+};
+
+/**
+ * @brief Rendered LED frames at a fixed period
+ */
+struct Timeline {
+    uint16_t frameMs;
+    uint16_t ledCount;
+    std::vector<Color> pixels;
+
+    size_t frameCount() const { return ledCount ? pixels.size() / ledCount : 0; }
+    const Color* frame(size_t index) const { return &pixels[index * ledCount]; }
+};
+
+/**
+ * @brief Offline renderer: runs effects through the firmware render path on the host
+ *
+ * Every effect is posted to a real AnimationSystem drawing into a real
+ * LEDCompositor, and the flattened frames are captured at a fixed period,
+ * exactly as GauntletController::renderFrame() produces them.
+ */
+namespace HostRenderer {
+
+    const HostEffect* effects();
+    size_t effectCount();
+    const HostEffect* findEffect(const char* name);
+
+    /**
+     * @brief Length of an effect (its program length if durationMs is 0)
+     */
+    uint32_t effectDuration(const HostEffect& effect);
+
+    /**
+     * @brief Scenario that plays a single effect from start to end
+     */
+    Scenario singleEffect(const HostEffect& effect);
+
+    /**
+     * @brief Parse a scenario script
+     * @param path Script file
+     * @param scenario Filled on success
+     * @param error Set to a message on failure
+     */
+    bool loadScenario(const char* path, Scenario& scenario, std::string& error);
+
+    /**
+     * @brief Frame period used for goldens when the scenario does not set one
+     *
+     * The display rate, or coarser for long effects so a golden stays around 100 frames.
+     */
+    uint16_t defaultFrameMs(uint32_t lengthMs);
+
+    /**
+     * @brief Render a scenario
+     * @param frameMs Frame period; 0 uses the scenario's or the default
+     */
+    void render(const Scenario& scenario, uint16_t frameMs, Timeline& out);
+
+    /**
+     * @brief Average render time per frame, in microseconds, at the display rate
+     */
+    float benchmark(const Scenario& scenario);
+
+    bool writeCsv(const Timeline& timeline, const char* title, FILE* out);
+    bool readCsv(const char* path, Timeline& timeline, std::string& error);
+    bool writePpm(const Timeline& timeline, uint8_t scale, FILE* out);
+
+    /**
+     * @brief Compare two timelines
+     * @param tolerance Largest allowed difference per channel
+     * @param report Set to the first mismatch
+     * @return True if they have the same shape and every channel is within tolerance
+     */
+    bool compare(const Timeline& expected, const Timeline& actual, uint8_t tolerance, std::string& report);
+
+} // namespace HostRenderer
+
+#endif // HOST_RENDERER_H
@@ -0,0 +1,85 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/**
+ * @brief Host stand-in for the parts of the Arduino core the render path uses
+ *
+ * Only what the renderers in src/animation and the compositor need. random()
+ * is a fixed LCG rather than the ESP32 hardware generator, so seeded effects
+ * render the same on every machine and the golden timelines stay stable.
+ * Serial writes to stdout, for test suites that also run on the host.
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+
+using std::min;
+using std::max;
+
+#define PROGMEM
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline unsigned long micros() {
+  static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+}
+
+inline unsigned long millis() {
+  return micros() / 1000;
+}
+
+inline uint32_t& hostRandomState() {
+  static uint32_t state = 1;
+  return state;
+}
+
+inline void randomSeed(unsigned long seed) {
+  // Like the ESP32 core, a zero seed leaves the generator alone
+  if (seed != 0) {
+    hostRandomState() = (uint32_t)seed;
+  }
+}
+
+inline long random(long howbig) {
+  if (howbig <= 0) {
+    return 0;
+  }
+  uint32_t& state = hostRandomState();
+  state = state * 1103515245u + 12345u;
+  return (long)((state >> 16) % (uint32_t)howbig);
+}
+
+inline long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) {
+    return howsmall;
+  }
+  return howsmall + random(howbig - howsmall);
+}
+
+struct HostSerial {
+  void print(const char* text) const { fputs(text, stdout); }
+  void println(const char* text = "") const { fputs(text, stdout); fputc('\n', stdout); }
+
+  int printf(const char* format, ...) const __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, format);
+    int written = vprintf(format, args);
+    va_end(args);
+    return written;
+  }
+};
+
+static const HostSerial Serial;
+
+#endif // HOST_ARDUINO_H
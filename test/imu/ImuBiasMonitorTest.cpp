@@ -0,0 +1,168 @@
+#include <Arduino.h>
+#include "../../src/hardware/ImuBiasMonitor.h"
+#include "../../src/hardware/MPU9250Interface.h"
+#include "../../src/core/Config.h"
+#include "../helpers/TestCheck.h"
+
+/**
+ * @brief Stand-in sensor: a fixed pose and bias plus a little noise
+ */
+struct FakeImu {
+    int16_t gravity[3];     // Counts gravity puts on each axis
+    int16_t accelBias[3];
+    int16_t gyroBias[3];
+    int16_t noise;          // Peak noise, counts
+    int16_t rotation;       // Gyro swing while moving, counts
+    uint16_t tick;
+
+    // A reading corrected with the offsets the monitor holds, as MPU9250Interface returns it
+    SensorData read(const ImuBiasMonitor& monitor) {
+        const int16_t* accelOffset = monitor.accelOffset();
+        const int16_t* gyroOffset = monitor.gyroOffset();
+        int16_t jitter = (tick % 3 == 0) ? noise : (tick % 3 == 1) ? -noise : 0;
+        int16_t swing = (tick % 10 < 5) ? rotation : -rotation;
+        tick++;
+        SensorData data;
+        data.accelX = gravity[0] + accelBias[0] + jitter - accelOffset[0];
+        data.accelY = gravity[1] + accelBias[1] - jitter - accelOffset[1];
+        data.accelZ = gravity[2] + accelBias[2] + jitter - accelOffset[2];
+        data.gyroX = gyroBias[0] + jitter + swing - gyroOffset[0];
+        data.gyroY = gyroBias[1] - jitter - gyroOffset[1];
+        data.gyroZ = gyroBias[2] + jitter - gyroOffset[2];
+        data.timestamp = tick * 20;
+        return data;
+    }
+};
+
+static const int16_t ZERO[3] = {0, 0, 0};
+
+static FakeImu levelImu() {
+    FakeImu imu = {{0, 0, MPU_ACCEL_LSB_PER_G}, {120, -80, 200}, {35, -22, 14}, 3, 0, 0};
+    return imu;
+}
+
+// Feed one window; true if any sample reported moved offsets
+static bool feedWindow(ImuBiasMonitor& monitor, FakeImu& imu) {
+    bool moved = false;
+    for (uint8_t i = 0; i < Config::ImuCalibration::STILL_WINDOW_SAMPLES; i++) {
+        moved |= monitor.update(imu.read(monitor));
+    }
+    return moved;
+}
+
+static bool near(int16_t value, int16_t expected, int16_t tolerance) {
+    return abs(value - expected) <= tolerance;
+}
+
+/**
+ * @brief Held still and level, both biases are measured again
+ */
+void testStillLevel() {
+    Serial.println("\n[Still, level]");
+
+    ImuBiasMonitor monitor;
+    monitor.begin(ZERO, ZERO, MPU_ACCEL_LSB_PER_G);
+    FakeImu imu = levelImu();
+
+    bool early = false;
+    for (uint8_t i = 0; i + 1 < Config::ImuCalibration::STILL_WINDOW_SAMPLES; i++) {
+        early |= monitor.update(imu.read(monitor));
+    }
+    check(!early, "nothing changes before a window is complete");
+    check(monitor.update(imu.read(monitor)), "a still window moves stale offsets");
+    check(near(monitor.gyroOffset()[0], 35, 1) && near(monitor.gyroOffset()[1], -22, 1) &&
+          near(monitor.gyroOffset()[2], 14, 1), "gyro offsets match the bias");
+    check(near(monitor.accelOffset()[0], 120, 1) && near(monitor.accelOffset()[1], -80, 1) &&
+          near(monitor.accelOffset()[2], 200, 1), "accel offsets match the bias, gravity kept on Z");
+
+    check(!feedWindow(monitor, imu), "offsets that still fit are left alone");
+    imu.gyroBias[2] += Config::ImuCalibration::GYRO_DRIFT / 2;
+    check(!feedWindow(monitor, imu), "drift under the limit is ignored");
+    imu.gyroBias[2] += Config::ImuCalibration::GYRO_DRIFT;
+    check(feedWindow(monitor, imu) && near(monitor.gyroOffset()[2], imu.gyroBias[2], 1), "drift over the limit is followed");
+
+    const ImuBiasStats& stats = monitor.getStats();
+    check(stats.windows == 4 && stats.stillWindows == 4 && stats.updates == 2, "windows and updates are counted");
+}
+
+/**
+ * @brief Still in another pose only the gyro bias can be told from gravity
+ */
+void testStillTilted() {
+    Serial.println("\n[Still, tilted]");
+
+    ImuBiasMonitor monitor;
+    const int16_t accelOffset[3] = {120, -80, 200};
+    monitor.begin(accelOffset, ZERO, MPU_ACCEL_LSB_PER_G);
+    FakeImu imu = levelImu();
+    imu.gravity[0] = -MPU_ACCEL_LSB_PER_G;
+    imu.gravity[2] = 0;
+    imu.accelBias[0] += 300;
+
+    check(feedWindow(monitor, imu) && near(monitor.gyroOffset()[0], 35, 1), "the gyro bias is measured in any pose");
+    check(monitor.accelOffset()[0] == 120 && monitor.accelOffset()[1] == -80 && monitor.accelOffset()[2] == 200,
+          "the accel offsets are kept when the device is not level");
+}
+
+/**
+ * @brief Motion never counts as a still window
+ */
+void testMotion() {
+    Serial.println("\n[Motion]");
+
+    ImuBiasMonitor monitor;
+    monitor.begin(ZERO, ZERO, MPU_ACCEL_LSB_PER_G);
+    FakeImu imu = levelImu();
+    imu.rotation = Config::ImuCalibration::STILL_GYRO_SPAN;
+    check(!feedWindow(monitor, imu) && monitor.gyroOffset()[0] == 0, "a turning hand leaves the offsets alone");
+
+    imu.rotation = 0;
+    imu.noise = Config::ImuCalibration::STILL_ACCEL_SPAN;
+    check(!feedWindow(monitor, imu) && monitor.accelOffset()[2] == 0, "a shaking hand leaves the offsets alone");
+    check(monitor.getStats().windows == 2 && monitor.getStats().stillWindows == 0, "moving windows are not still");
+
+    // Motion part way through: the restart drops it and the next window counts
+    imu.noise = 3;
+    monitor.restart();
+    check(feedWindow(monitor, imu), "the first still window after motion updates");
+}
+
+/**
+ * @brief The check runs on every sensor update, so it must cost next to nothing
+ */
+void benchmarkImuBiasMonitor() {
+    Serial.println("\n[Benchmark]");
+
+    ImuBiasMonitor monitor;
+    monitor.begin(ZERO, ZERO, MPU_ACCEL_LSB_PER_G);
+    FakeImu imu = levelImu();
+    SensorData samples[Config::ImuCalibration::STILL_WINDOW_SAMPLES];
+    for (uint8_t i = 0; i < Config::ImuCalibration::STILL_WINDOW_SAMPLES; i++) {
+        samples[i] = imu.read(monitor);
+    }
+
+    const uint16_t windows = 200;
+    uint32_t start = micros();
+    for (uint16_t w = 0; w < windows; w++) {
+        for (uint8_t i = 0; i < Config::ImuCalibration::STILL_WINDOW_SAMPLES; i++) {
+            monitor.update(samples[i]);
+        }
+    }
+    float us = (float)(micros() - start) / (windows * Config::ImuCalibration::STILL_WINDOW_SAMPLES);
+    Serial.printf("    update %6.3f us/sample\n", us);
+    check(us < 5.0f, "a sample costs under 5 us");
+}
+
+/**
+ * @brief Run all IMU bias monitor tests
+ */
+void testImuBiasMonitor() {
+    resetChecks();
+
+    testStillLevel();
+    testStillTilted();
+    testMotion();
+    benchmarkImuBiasMonitor();
+
+    reportChecks("IMU bias monitor");
+}
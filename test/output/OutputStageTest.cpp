@@ -0,0 +1,116 @@
+#include <Arduino.h>
+#include "../../src/hardware/OutputStage.h"
+#include "../../src/animation/ColorEngine.h"
+#include "../helpers/TestCheck.h"
+
+/**
+ * @brief Gamma table and output levels
+ */
+void testGamma() {
+    Serial.println("\n[Gamma]");
+
+    bool monotonic = true;
+    for (uint16_t i = 1; i < 256; i++) {
+        monotonic = monotonic && OutputGamma::TABLE[i] >= OutputGamma::TABLE[i - 1];
+    }
+    check(monotonic, "gamma table is monotonic");
+    check(OutputGamma::TABLE[128] < 65535 / 4, "mid input maps well below half light");
+
+    check(OutputStage::level(255, 255) == 0xFF00, "full input at full brightness is exactly 255.0");
+    check(OutputStage::level(0, 255) == 0 && OutputStage::level(200, 0) <= 0x00FF, "black and zero brightness stay dark");
+    check(OutputStage::level(255, 127) > 0x7E00 && OutputStage::level(255, 127) < 0x8100, "brightness scales linearly");
+}
+
+/**
+ * @brief Temporal dithering reproduces the 16-bit level on average
+ */
+void testDithering() {
+    Serial.println("\n[Dithering]");
+
+    const uint8_t brightness = Config::LOW_POWER_BRIGHTNESS;
+    BasicOutputStage<1> stage;
+    Color in[1];
+    CRGB out[1];
+
+    bool averagesMatch = true;
+    uint16_t ditheredLevels = 0;
+    uint16_t truncatedLevels = 0;
+    uint32_t lastSum = 0xFFFFFFFF;
+    uint8_t lastTruncated = 0xFF;
+    for (uint16_t v = 0; v < 256; v++) {
+        in[0] = {(uint8_t)v, (uint8_t)v, (uint8_t)v};
+        uint32_t sum = 0;
+        for (uint16_t frame = 0; frame < 256; frame++) {
+            stage.render(in, brightness, out);
+            sum += out[0].r;
+        }
+        // Over 256 frames the outputs add up to the 8.8 level (+-1 for the carried residue)
+        int32_t error = (int32_t)sum - (int32_t)OutputStage::level(v, brightness);
+        averagesMatch = averagesMatch && error >= -1 && error <= 1;
+
+        if (sum != lastSum) {
+            ditheredLevels++;
+            lastSum = sum;
+        }
+        // What FastLED brightness scaling alone could show
+        uint8_t truncated = ColorEngine::scale8((uint8_t)v, brightness);
+        if (truncated != lastTruncated) {
+            truncatedLevels++;
+            lastTruncated = truncated;
+        }
+    }
+    check(averagesMatch, "average output equals the 16-bit level");
+    check(ditheredLevels > 4 * truncatedLevels, "dithering keeps far more distinct levels at low brightness");
+    Serial.printf("    brightness %u: %u distinct levels dithered vs %u with 8-bit scaling\n",
+                  brightness, ditheredLevels, truncatedLevels);
+
+    in[0] = {255, 0, 255};
+    stage.render(in, 255, out);
+    check(!stage.isDithering(), "full-on and off channels need no dithering");
+    in[0] = {90, 90, 90};
+    stage.render(in, brightness, out);
+    check(stage.isDithering(), "dim channels are dithered");
+}
+
+template <uint16_t LED_COUNT>
+static void benchmarkStage() {
+    static BasicOutputStage<LED_COUNT> stage;
+    static Color in[LED_COUNT];
+    static CRGB out[LED_COUNT];
+    const uint16_t ITERATIONS = 500;
+    volatile uint8_t sink = 0;
+
+    ColorEngine::fillRainbow(in, LED_COUNT, 0, 256 * 3, 200);
+    unsigned long start = micros();
+    for (uint16_t n = 0; n < ITERATIONS; n++) {
+        stage.render(in, Config::DEFAULT_BRIGHTNESS, out);
+        sink ^= out[n % LED_COUNT].r;
+    }
+    float us = (float)(micros() - start) / ITERATIONS;
+    Serial.printf("    %3u LEDs  %7.2f us/frame\n", LED_COUNT, us);
+    (void)sink;
+}
+
+/**
+ * @brief Output stage cost per frame at 12, 60 and 300 LEDs
+ */
+void benchmarkOutputStage() {
+    Serial.println("\n[Output stage cost]");
+
+    benchmarkStage<12>();
+    benchmarkStage<60>();
+    benchmarkStage<300>();
+}
+
+/**
+ * @brief Run all output stage tests
+ */
+void testOutputStage() {
+    resetChecks();
+
+    testGamma();
+    testDithering();
+    benchmarkOutputStage();
+
+    reportChecks("Output stage");
+}
@@ -0,0 +1,140 @@
+#include <Arduino.h>
+#include "../../src/hardware/LEDPowerModel.h"
+#include "../../src/hardware/OutputStage.h"
+#include "../helpers/TestCheck.h"
+
+/**
+ * @brief Current estimate from channel levels
+ */
+void testEstimate() {
+    Serial.println("\n[Estimate]");
+
+    const uint16_t leds = Config::NUM_LEDS;
+    uint16_t dark = LEDPowerModel::estimate(0, leds);
+    uint16_t white = LEDPowerModel::estimate((uint32_t)leds * 3 * 0xFF00, leds);
+    check(dark == leds * Config::LED_IDLE_MA, "dark frame draws only the quiescent current");
+    check(white == leds * (3 * Config::LED_MA_PER_CHANNEL + Config::LED_IDLE_MA), "full white draws every channel at full current");
+
+    Color in[Config::NUM_LEDS];
+    for (uint16_t i = 0; i < leds; i++) {
+        in[i] = {255, 0, 0};
+    }
+    uint16_t red = LEDPowerModel::estimate(OutputStage::measure(in, 255), leds);
+    uint16_t dimRed = LEDPowerModel::estimate(OutputStage::measure(in, 64), leds);
+    check(red == leds * (Config::LED_MA_PER_CHANNEL + Config::LED_IDLE_MA), "single channel draws a third of white");
+    check(dimRed < red / 3, "brightness scales the estimate");
+}
+
+/**
+ * @brief Instant attack, gradual release
+ */
+void testLimiter() {
+    Serial.println("\n[Limiter]");
+
+    LEDPowerModel power;
+    power.setBudget(300);
+    check(power.limit(200, 0) == 255 && !power.isReleasing(), "frames under budget pass unchanged");
+
+    uint8_t scale = power.limit(600, 0);
+    check(scale <= 128 && (uint32_t)600 * scale / 255 <= 300, "frame over budget is scaled within it at once");
+
+    uint8_t next = power.limit(100, 0);
+    check(next == scale + Config::LED_LIMIT_RELEASE_STEP && power.isReleasing(), "release rises one step per frame");
+
+    uint16_t frames = 1;
+    while (power.isReleasing() && frames < 100) {
+        power.limit(100, 0);
+        frames++;
+    }
+    check(power.getStats().limit == 255, "limiter returns to full scale");
+    check(frames <= 255 / Config::LED_LIMIT_RELEASE_STEP + 1, "release completes within the expected number of frames");
+
+    power.limit(600, 0);
+    power.limit(400, 0);
+    check(power.getStats().limit <= (uint8_t)(300 * 255 / 400), "release never exceeds the budget of the current frame");
+
+    power.setBudget(0);
+    power.resetTotals();
+    while (power.isReleasing()) {
+        power.limit(2000, 0);
+    }
+    check(power.limit(2000, 0) == 255, "budget of 0 disables limiting");
+    check(power.getStats().peakRequestedMilliamps == 2000, "peak requested current is recorded");
+
+    // A black frame draws only the quiescent current, which cannot be scaled
+    LEDPowerModel tiny;
+    tiny.setBudget(5);
+    check(tiny.getBudget() == LEDPowerModel::MIN_BUDGET_MA, "budgets below the quiescent draw are raised to it");
+    uint16_t black = LEDPowerModel::estimate(0, Config::NUM_LEDS);
+    check(tiny.limit(black, Config::NUM_LEDS) == 255, "a black frame on the smallest budget passes unchanged");
+    check(tiny.limit(black * 2, Config::NUM_LEDS * 2) == 255, "nothing is scaled when only quiescent draw is over budget");
+    check(tiny.limit(black + 100, Config::NUM_LEDS) == 0, "any lit frame on the smallest budget is scaled to black");
+}
+
+/**
+ * @brief Limited frames stay within the budget on the wire
+ */
+void testLimitedOutput() {
+    Serial.println("\n[Limited output]");
+
+    const uint16_t budget = 300;
+    LEDPowerModel power;
+    power.setBudget(budget);
+    OutputStage stage;
+    Color in[Config::NUM_LEDS];
+    CRGB out[Config::NUM_LEDS];
+    for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+        in[i] = {255, 255, 255};
+    }
+
+    uint16_t requested = LEDPowerModel::estimate(OutputStage::measure(in, 255), Config::NUM_LEDS);
+    uint8_t scale = power.limit(requested, Config::NUM_LEDS);
+    stage.render(in, 255, out, scale);
+
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+        sum += ((uint32_t)out[i].r + out[i].g + out[i].b) << 8;
+    }
+    uint16_t delivered = LEDPowerModel::estimate(sum, Config::NUM_LEDS);
+    check(requested > budget, "full white exceeds the test budget");
+    check(delivered <= budget, "limited frame on the wire is within budget");
+    check(delivered > budget * 9 / 10, "limited frame uses most of the budget");
+    Serial.printf("    requested %u mA, delivered %u mA, budget %u mA\n", requested, delivered, budget);
+}
+
+/**
+ * @brief Charge booked to the mode that was active
+ */
+void testEnergy() {
+    Serial.println("\n[Energy]");
+
+    LEDPowerModel power;
+    power.setMode(0);
+    power.account(100, 0);
+    power.account(360, 36000);     // 100 mA for 36 s in idle = 1 mAh
+    power.setMode(1);
+    power.account(0, 36000 + 10000); // 360 mA for 10 s in freecast = 1 mAh
+
+    check(power.getModeMillis(0) == 36000 && power.getModeMillis(1) == 10000, "time is booked per mode");
+    check(fabsf(power.getMilliampHours(0) - 1.0f) < 0.001f, "idle charge integrates current over time");
+    check(fabsf(power.getMilliampHours(1) - 1.0f) < 0.001f, "freecast charge uses the previous frame's current");
+    check(power.getMilliampHours(2) == 0.0f, "unused mode stays at zero");
+    check(power.getStats().peakMilliamps == 360, "peak current is recorded");
+
+    power.resetTotals();
+    check(power.getMilliampHours(0) == 0.0f && power.getModeMillis(1) == 0, "reset clears totals");
+}
+
+/**
+ * @brief Run all LED power model tests
+ */
+void testLEDPowerModel() {
+    resetChecks();
+
+    testEstimate();
+    testLimiter();
+    testLimitedOutput();
+    testEnergy();
+
+    reportChecks("LED power model");
+}
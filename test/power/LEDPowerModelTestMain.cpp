@@ -0,0 +1,19 @@
+#include <Arduino.h>
+
+// Forward declaration of test function
+extern void testLEDPowerModel();
+
+void setup() {
+  // Initialize serial communication
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("PrismaTech Gauntlet 3.0 - LED Power Model Test");
+
+  // Run LED power model tests
+  testLEDPowerModel();
+}
+
+void loop() {
+  // Just delay in the main loop
+  delay(1000);
+}
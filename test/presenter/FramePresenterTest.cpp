@@ -0,0 +1,131 @@
+#include <Arduino.h>
+#include "../../src/hardware/FramePresenter.h"
+#include "../../src/hardware/LEDInterface.h"
+#include "../helpers/TestCheck.h"
+
+static LEDInterface leds;
+
+static void fillFrame(Color* frame, uint8_t r, uint8_t g, uint8_t b) {
+    for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+        frame[i] = {r, g, b};
+    }
+}
+
+/**
+ * @brief Unchanged frames are skipped, changed frames are pushed
+ *
+ * Uses full-on and off channels at full brightness so the output stage
+ * has nothing to dither.
+ */
+void testDirtyTracking() {
+    Serial.println("\n[Dirty tracking]");
+
+    FramePresenter presenter;
+    Color frame[Config::NUM_LEDS];
+    const uint16_t PERIOD = 20;
+    uint32_t now = 10000;
+
+    presenter.init(&leds, PERIOD);
+    leds.setBrightness(255);
+    fillFrame(frame, 255, 0, 255);
+    presenter.submit(frame);
+    check(presenter.service(now), "first frame is pushed immediately");
+    check(!presenter.isPending(), "nothing pending after a push");
+
+    presenter.submit(frame);
+    check(!presenter.isPending(), "identical frame is not marked dirty");
+    check(!presenter.service(now + PERIOD), "identical frame is skipped");
+
+    frame[5] = {0, 255, 0};
+    presenter.submit(frame);
+    check(presenter.isPending(), "one changed pixel marks the frame dirty");
+    check(presenter.service(now + PERIOD), "changed frame is pushed");
+
+    leds.setBrightness(0);
+    check(presenter.service(now + 2 * PERIOD), "brightness change forces a push");
+    check(!presenter.service(now + 3 * PERIOD), "no push once brightness is shown");
+    leds.setBrightness(255);
+    presenter.service(now + 3 * PERIOD);
+
+    presenter.invalidate();
+    presenter.submit(frame);
+    check(presenter.service(now + 3 * PERIOD + 1), "frame after invalidate is pushed without waiting");
+
+    // A dim frame carries a fraction the output stage dithers over time
+    leds.setBrightness(Config::LOW_POWER_BRIGHTNESS);
+    fillFrame(frame, 90, 90, 90);
+    presenter.submit(frame);
+    presenter.service(now + 5 * PERIOD);
+    presenter.submit(frame);
+    check(leds.needsRefresh(), "dim frame is dithered");
+    check(presenter.service(now + 6 * PERIOD), "dithered frame is re-sent every period");
+    leds.setBrightness(255);
+
+    check(FramePresenter::hashFrame(frame, Config::NUM_LEDS) != 0, "frame hash is non-trivial");
+}
+
+/**
+ * @brief At most one transfer per display period
+ */
+void testRateLimit() {
+    Serial.println("\n[Rate limit]");
+
+    FramePresenter presenter;
+    Color frame[Config::NUM_LEDS];
+    const uint16_t PERIOD = 20;
+    const uint32_t start = 20000;
+
+    presenter.init(&leds, PERIOD);
+    presenter.service(start);
+
+    // Render at 1 kHz for one second: every frame differs (full-on/off only, nothing to dither)
+    uint16_t pushes = 0;
+    for (uint32_t t = 0; t < 1000; t++) {
+        uint8_t channel = t % 3;
+        fillFrame(frame, channel == 0 ? 255 : 0, channel == 1 ? 255 : 0, channel == 2 ? 255 : 0);
+        presenter.submit(frame);
+        if (presenter.service(start + t)) {
+            pushes++;
+        }
+    }
+    check(pushes <= 1000 / PERIOD + 1, "no more than one push per period");
+    check(pushes >= 1000 / PERIOD - 1, "a push in every period");
+
+    // Let the stats window roll over
+    presenter.service(start + 1000);
+    const PresenterStats& stats = presenter.getStats();
+    check(stats.framesPushed == pushes, "pushed frames are counted");
+    check(stats.framesCoalesced + stats.framesSkipped >= 1000 - pushes - 1, "frames that never went out are counted as coalesced or skipped");
+    Serial.printf("    pushed %u, skipped %u, coalesced %u, wire %lu us, show() %lu us\n",
+                  stats.framesPushed, stats.framesSkipped, stats.framesCoalesced,
+                  (unsigned long)stats.wireMicros, (unsigned long)stats.showMicros);
+    uint32_t frameUs = leds.getWireFrameMicros();
+    check(stats.wireMicros >= (pushes - 1) * frameUs && stats.wireMicros <= (pushes + 1) * frameUs,
+          "wire time is the transfers times the frame time");
+
+    // A static scene costs no bus time
+    for (uint32_t t = 1000; t < 2000; t++) {
+        presenter.submit(frame);
+        presenter.service(start + t);
+    }
+    presenter.service(start + 2000);
+    check(presenter.getStats().framesPushed <= 1, "static scene pushes at most the pending frame");
+    check(presenter.getStats().framesSkipped >= 998, "static scene frames are skipped");
+}
+
+/**
+ * @brief Run all frame presenter tests
+ */
+void testFramePresenter() {
+    resetChecks();
+
+    leds.init();
+    leds.setBrightness(Config::DEFAULT_BRIGHTNESS);
+    // Full-on test frames would otherwise be power limited and dithered
+    leds.getPowerModel()->setBudget(0);
+
+    testDirtyTracking();
+    testRateLimit();
+
+    reportChecks("Frame presenter");
+}
@@ -0,0 +1,93 @@
+#include <Arduino.h>
+#include "../../src/core/DisplayScheduler.h"
+#include "../../src/core/Config.h"
+#include "../helpers/TestCheck.h"
+
+/**
+ * @brief Simulated loop: counts ticks and frames over a time span
+ *
+ * Advances a fake clock 1 ms per pass and does what GauntletController::update()
+ * does, so the result does not depend on the host's timing.
+ */
+static void runLoop(DisplayScheduler& scheduler, uint32_t startMs, uint32_t spanMs,
+                    uint32_t& ticks, uint32_t& frames, uint32_t logicCostMs = 0) {
+    ticks = 0;
+    frames = 0;
+    for (uint32_t now = startMs; now < startMs + spanMs; now++) {
+        if (scheduler.logicDue(now)) {
+            ticks++;
+            now += logicCostMs;
+        }
+        if (scheduler.renderDue(now)) {
+            frames++;
+        }
+    }
+}
+
+/**
+ * @brief Logic and render clocks run independently
+ */
+void testRates() {
+    Serial.println("\n[Rates]");
+
+    DisplayScheduler scheduler;
+    uint32_t ticks = 0;
+    uint32_t frames = 0;
+
+    scheduler.init(Config::LOGIC_PERIOD_MS, Config::DISPLAY_FRAME_PERIOD_MS, 1000);
+    runLoop(scheduler, 1000, 1000, ticks, frames);
+    check(ticks == 1000 / Config::LOGIC_PERIOD_MS, "logic ticks at the logic rate");
+    check(frames == 1000 / Config::DISPLAY_FRAME_PERIOD_MS, "frames render at the display rate");
+    Serial.printf("    logic %lu Hz, render %lu fps\n", (unsigned long)ticks, (unsigned long)frames);
+
+    uint32_t activeFrames = frames;
+    scheduler.setLogicPeriod(Config::IDLE_LOGIC_PERIOD_MS);
+    runLoop(scheduler, 2000, 1000, ticks, frames);
+    check(ticks == 1000 / Config::IDLE_LOGIC_PERIOD_MS, "slower idle logic ticks less often");
+    check(frames == activeFrames, "frame rate is unaffected by the logic rate");
+
+    scheduler.setRenderPeriod(5);
+    runLoop(scheduler, 3000, 1000, ticks, frames);
+    check(frames == 200, "frame rate is configurable up to 200 fps");
+}
+
+/**
+ * @brief Fixed frame cadence, late frames dropped rather than bursted
+ */
+void testCadence() {
+    Serial.println("\n[Cadence]");
+
+    DisplayScheduler scheduler;
+    scheduler.init(20, 8, 0);
+    check(scheduler.renderDue(0) && scheduler.logicDue(0), "first frame and tick are due at once");
+    check(!scheduler.renderDue(7) && scheduler.renderDue(8), "next frame follows one period later");
+    check(scheduler.renderDue(17) && !scheduler.renderDue(20) && scheduler.renderDue(24),
+          "a frame run late does not shift the cadence");
+
+    // The loop stalls for 50 ms (e.g. a blocking flash)
+    check(scheduler.logicDue(80) && scheduler.renderDue(80), "one tick and one frame run after a stall");
+    check(!scheduler.renderDue(81) && scheduler.renderDue(88), "missed frames are not rendered in a burst");
+
+    check(scheduler.millisUntilNext(90) == 6, "sleep until the next frame when it comes first");
+    check(!scheduler.logicDue(95) && scheduler.renderDue(96) && scheduler.logicDue(100), "logic keeps its own period");
+    check(scheduler.millisUntilNext(100) == 4, "sleep until the next frame after a tick");
+    scheduler.setRenderPeriod(50);
+    scheduler.renderDue(104);
+    check(scheduler.millisUntilNext(110) == 10, "sleep until the next tick when it comes first");
+
+    // The per-second counters cover the window that just ended
+    scheduler.renderDue(1100);
+    check(scheduler.getStats().lateFrames >= 6, "stalled frames are counted as late");
+}
+
+/**
+ * @brief Run all display scheduler tests
+ */
+void testDisplayScheduler() {
+    resetChecks();
+
+    testRates();
+    testCadence();
+
+    reportChecks("Display scheduler");
+}
@@ -0,0 +1,220 @@
+#include <Arduino.h>
+#include "../../src/hardware/SerialTx.h"
+#include "../helpers/TestCheck.h"
+
+/**
+ * @brief Stand-in UART that takes at most room bytes until drained
+ */
+class FakeUart : public Print {
+public:
+    FakeUart() : room(SERIAL_TX_BUFFER_SIZE), length(0) {}
+
+    size_t write(uint8_t byte) override { return write(&byte, 1); }
+
+    size_t write(const uint8_t* data, size_t count) override {
+        for (size_t i = 0; i < count && length < sizeof(sent); i++) {
+            sent[length++] = data[i];
+        }
+        room = room > (int)count ? room - (int)count : 0;
+        return count;
+    }
+
+    int availableForWrite() override { return room; }
+
+    bool sentEquals(const char* text) const {
+        return length == strlen(text) && memcmp(sent, text, length) == 0;
+    }
+
+    void clear() {
+        length = 0;
+    }
+
+    int room;
+    char sent[4 * SERIAL_TX_BUFFER_SIZE];
+    size_t length;
+};
+
+static FakeUart uart;
+static SerialTx tx(uart);
+
+static void reset(uint8_t policy) {
+    tx.setBuffered(false);
+    uart.clear();
+    uart.room = SERIAL_TX_BUFFER_SIZE;
+    tx.setPolicy(policy);
+    tx.resetStats();
+    tx.setBuffered(true);
+}
+
+// Fill the ring with numbered lines of exactly lineLength bytes
+static uint16_t fill(size_t lineLength) {
+    char line[64];
+    uint16_t lines = 0;
+    while (tx.availableForWrite() >= (int)lineLength) {
+        snprintf(line, sizeof(line), "%0*u\n", (int)lineLength - 1, lines++);
+        tx.print(line);
+    }
+    return lines;
+}
+
+/**
+ * @brief Writes go straight through until buffered, then wait for drain()
+ */
+void testBuffering() {
+    Serial.println("\n[Buffering]");
+
+    tx.setBuffered(false);
+    uart.clear();
+    tx.print("direct\n");
+    check(uart.sentEquals("direct\n"), "unbuffered writes go straight to the UART");
+
+    reset(SERIAL_TX_DROP_NEWEST);
+    tx.print("queued ");
+    tx.printf("%d\n", 42);
+    check(uart.length == 0 && tx.pending() == 10, "buffered writes only queue");
+
+    uart.room = 4;
+    check(tx.drain() == 4 && uart.sentEquals("queu"), "drain stops where the TX FIFO is full");
+    check(tx.drain() == 0, "nothing moves while the FIFO is full");
+    uart.room = 64;
+    tx.drain();
+    check(uart.sentEquals("queued 42\n") && tx.pending() == 0, "the rest follows in order");
+
+    // Leave the head 16 bytes short of the end so the next line wraps
+    uint8_t block[SERIAL_TX_BUFFER_SIZE];
+    memset(block, '-', sizeof(block));
+    tx.write(block, SERIAL_TX_BUFFER_SIZE - 16 - tx.getStats().bytesWritten);
+    uart.room = SERIAL_TX_BUFFER_SIZE;
+    tx.drain();
+    tx.print("wrapped around the end\n");
+    uart.clear();
+    tx.drain();
+    check(uart.sentEquals("wrapped around the end\n"), "a write across the end of the ring comes out whole");
+
+    tx.print("left over\n");
+    uart.clear();
+    uart.room = 0;
+    tx.setBuffered(false);
+    check(uart.sentEquals("left over\n") && !tx.isBuffered(), "switching buffering off sends what is queued");
+}
+
+/**
+ * @brief A full ring drops the new write whole, or the oldest whole lines
+ */
+void testOverflow() {
+    Serial.println("\n[Overflow]");
+
+    reset(SERIAL_TX_DROP_NEWEST);
+    uart.room = 0;
+    uint16_t lines = fill(32);
+    check(tx.pending() == SERIAL_TX_BUFFER_SIZE, "the ring fills up");
+    tx.print("this line does not fit\n");
+    const SerialTxStats& stats = tx.getStats();
+    check(stats.bytesDropped == 23 && tx.pending() == SERIAL_TX_BUFFER_SIZE, "drop newest: the new line is dropped whole");
+    check(stats.maxDepth == SERIAL_TX_BUFFER_SIZE, "max depth is recorded");
+    uart.room = SERIAL_TX_BUFFER_SIZE;
+    tx.drain();
+    check(uart.length == (size_t)lines * 32 && memcmp(uart.sent, "0000", 4) == 0 && stats.bytesWritten == uart.length,
+          "the queued lines come out intact and are counted");
+
+    reset(SERIAL_TX_DROP_OLDEST);
+    uart.room = 0;
+    fill(32);
+    tx.print("newest line, 20 bytes\n");
+    check(tx.getStats().bytesDropped == 32, "drop oldest: whole lines make room");
+    uart.room = SERIAL_TX_BUFFER_SIZE;
+    tx.drain();
+    const char* tail = uart.sent + uart.length - 22;
+    check(memcmp(uart.sent, "0000000000000000000000000000001\n", 32) == 0 && memcmp(tail, "newest line", 11) == 0,
+          "output starts with the second line and ends with the newest");
+
+    reset(SERIAL_TX_DROP_OLDEST);
+    uart.room = 0;
+    uint8_t big[SERIAL_TX_BUFFER_SIZE + 1];
+    memset(big, 'x', sizeof(big));
+    check(tx.write(big, sizeof(big)) == 0 && tx.getStats().bytesDropped == sizeof(big),
+          "a write larger than the ring is dropped");
+    tx.setBuffered(false);
+}
+
+/**
+ * @brief println() text and terminator are kept or dropped together on a nearly full ring
+ */
+void testLineEnds() {
+    Serial.println("\n[Line ends]");
+
+    // Leave 11 bytes free after whole lines
+    reset(SERIAL_TX_DROP_NEWEST);
+    uart.room = 0;
+    uint8_t block[SERIAL_TX_BUFFER_SIZE - 11];
+    memset(block, '-', sizeof(block));
+    block[sizeof(block) - 1] = '\n';
+    tx.write(block, sizeof(block));
+
+    // Println sends the text, then the terminator in a second write
+    tx.println("ten bytes!");
+    check(tx.pending() == sizeof(block), "text whose terminator would not fit is not queued");
+    check(tx.getStats().bytesDropped > strlen("ten bytes!"), "its terminator is dropped with it");
+
+    tx.println("fits!");
+    check(tx.pending() > sizeof(block) + 5, "a line that fits is queued with its terminator");
+    uart.room = SERIAL_TX_BUFFER_SIZE;
+    tx.drain();
+    const char* tail = uart.sent + sizeof(block);
+    check(uart.length > sizeof(block) + 5 && memcmp(tail, "fits!", 5) == 0 && uart.sent[uart.length - 1] == '\n',
+          "the output holds only whole lines");
+
+    // Text already queued keeps its terminator even if a later part of the line is dropped
+    reset(SERIAL_TX_DROP_NEWEST);
+    uart.room = 0;
+    tx.write(block, sizeof(block));
+    tx.print("part");
+    tx.print("of a line too long");
+    tx.println();
+    uart.room = SERIAL_TX_BUFFER_SIZE;
+    uart.clear();
+    tx.drain();
+    tail = uart.sent + sizeof(block);
+    check(memcmp(tail, "part", 4) == 0 && (tail[4] == '\r' || tail[4] == '\n') && uart.sent[uart.length - 1] == '\n',
+          "the terminator still closes a partly queued line");
+    tx.setBuffered(false);
+}
+
+/**
+ * @brief Queuing a log line costs a copy, whatever the UART is doing
+ */
+void benchmarkSerialTx() {
+    Serial.println("\n[Benchmark]");
+
+    reset(SERIAL_TX_DROP_NEWEST);
+    const char* line = "[INFO:MODE] Transitioning to QuickCast Mode\n";
+    const uint16_t lines = 2000;
+    uint32_t start = micros();
+    for (uint16_t i = 0; i < lines; i++) {
+        tx.print(line);
+        if (tx.pending() > SERIAL_TX_BUFFER_SIZE / 2) {
+            tx.drain();
+            uart.clear();
+            uart.room = SERIAL_TX_BUFFER_SIZE;
+        }
+    }
+    float us = (float)(micros() - start) / lines;
+    Serial.printf("    queue + drain %6.3f us/line (115200 baud sends a line in %u us)\n", us,
+                  (unsigned)(strlen(line) * 10 * 1000000UL / 115200));
+    check(us < 20.0f, "queuing a line takes under 20 us");
+    tx.setBuffered(false);
+}
+
+/**
+ * @brief Run all serial TX ring tests
+ */
+void testSerialTx() {
+    resetChecks();
+
+    testBuffering();
+    testOverflow();
+    testLineEnds();
+    benchmarkSerialTx();
+
+    reportChecks("Serial TX");
+}
@@ -0,0 +1,165 @@
+#include <Arduino.h>
+#include "../../src/diagnostics/StateSnapshotCapture.h"
+#include "../helpers/TestCheck.h"
+
+// Collects a binary dump in memory
+class DumpBuffer : public Print {
+public:
+    DumpBuffer() : length(0) {}
+
+    size_t write(uint8_t c) override {
+        if (length < sizeof(bytes)) {
+            bytes[length++] = c;
+        }
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        for (size_t i = 0; i < size; i++) {
+            write(data[i]);
+        }
+        return size;
+    }
+
+    uint16_t half(size_t at) const { return bytes[at] | (bytes[at + 1] << 8); }
+    uint32_t word(size_t at) const { return half(at) | ((uint32_t)half(at + 2) << 16); }
+
+    uint8_t bytes[2048];
+    size_t length;
+};
+
+/**
+ * @brief Fields land in the latest snapshot with their types
+ */
+void testCapture() {
+    Serial.println("\n[Capture]");
+
+    StateSnapshotCapture::clear();
+    check(StateSnapshotCapture::count() == 0 && StateSnapshotCapture::get(0) == nullptr, "history starts empty");
+
+    StateSnapshotCapture::capture(SNAPSHOT_TRIGGER_MODE_CHANGE, "test");
+    StateSnapshotCapture::addField("mode", 2);
+    StateSnapshotCapture::addField("ratio", 0.5f);
+    StateSnapshotCapture::addField("reason", "SHAKE_CANCEL");
+    StateSnapshotCapture::addField("success", true);
+
+    const SnapshotRecord* latest = StateSnapshotCapture::get(0);
+    check(latest != nullptr && latest->fieldCount == 4, "four fields recorded");
+    check(latest && latest->trigger == SNAPSHOT_TRIGGER_MODE_CHANGE && strcmp(latest->context, "test") == 0,
+          "trigger and context recorded");
+    check(latest && latest->fields[0].type == SNAPSHOT_FIELD_INT && latest->fields[0].value.i == 2, "int field");
+    check(latest && latest->fields[1].type == SNAPSHOT_FIELD_FLOAT && latest->fields[1].value.f == 0.5f, "float field");
+    check(latest && latest->fields[2].type == SNAPSHOT_FIELD_STRING &&
+          strcmp(latest->fields[2].value.s, "SHAKE_CANCEL") == 0, "string field");
+    check(latest && latest->fields[3].type == SNAPSHOT_FIELD_BOOL && latest->fields[3].value.b, "bool field");
+
+    for (int i = 0; i < MAX_SNAPSHOT_FIELDS + 3; i++) {
+        StateSnapshotCapture::addField("extra", i);
+    }
+    check(latest && latest->fieldCount == MAX_SNAPSHOT_FIELDS, "fields beyond MAX_SNAPSHOT_FIELDS are ignored");
+
+    StateSnapshotCapture::clear();
+    StateSnapshotCapture::addField("orphan", 1);
+    check(StateSnapshotCapture::count() == 0, "fields without a capture are ignored");
+}
+
+/**
+ * @brief The history keeps the last HISTORY snapshots, newest first by age
+ */
+void testHistory() {
+    Serial.println("\n[History]");
+
+    StateSnapshotCapture::clear();
+    const int captures = StateSnapshotCapture::HISTORY + 3;
+    for (int i = 0; i < captures; i++) {
+        StateSnapshotCapture::capture(SNAPSHOT_TRIGGER_TEST, "history");
+        StateSnapshotCapture::addField("index", i);
+    }
+    check(StateSnapshotCapture::count() == StateSnapshotCapture::HISTORY, "history is bounded");
+
+    bool ordered = true;
+    for (uint8_t age = 0; age < StateSnapshotCapture::count(); age++) {
+        const SnapshotRecord* record = StateSnapshotCapture::get(age);
+        ordered = ordered && record && record->fields[0].value.i == captures - 1 - age;
+    }
+    check(ordered, "oldest snapshots are replaced first");
+    check(StateSnapshotCapture::get(0)->sequence == StateSnapshotCapture::get(1)->sequence + 1,
+          "sequence numbers count captures");
+    check(StateSnapshotCapture::get(StateSnapshotCapture::HISTORY) == nullptr, "ages past the history are empty");
+}
+
+/**
+ * @brief The binary dump has the layout utils/snapshot_tool.py decodes
+ */
+void testDump() {
+    Serial.println("\n[Dump]");
+
+    StateSnapshotCapture::clear();
+    StateSnapshotCapture::capture(SNAPSHOT_TRIGGER_GESTURE_START, "tracker");
+    StateSnapshotCapture::addField("startPosition", 3);
+    StateSnapshotCapture::addField("reason", "tracker");
+    StateSnapshotCapture::capture(SNAPSHOT_TRIGGER_GESTURE_END, "tracker");
+    StateSnapshotCapture::addField("success", false);
+
+    DumpBuffer dump;
+    check(StateSnapshotCapture::dumpBinary(dump) == 2, "two snapshots dumped");
+    check(memcmp(dump.bytes, "DSNP", 4) == 0 && dump.half(4) == 1 && dump.half(6) == 2, "header");
+    // "tracker" (context and value, once), "startPosition", "reason", "success"
+    check(dump.half(8) == 4, "each distinct string stored once");
+
+    size_t at = 10;
+    for (uint16_t i = 0; i < dump.half(8); i++) {
+        at += 1 + dump.bytes[at];
+    }
+    check(dump.word(at + 4) + 1 == StateSnapshotCapture::get(0)->sequence, "oldest snapshot first");
+    check(dump.bytes[at + 10] == SNAPSHOT_TRIGGER_GESTURE_START && dump.bytes[at + 11] == 2, "record header");
+    check(dump.bytes[at + 12 + 2] == SNAPSHOT_FIELD_INT && dump.word(at + 12 + 4) == 3, "int field value");
+    check(dump.bytes[at + 20 + 2] == SNAPSHOT_FIELD_STRING && dump.word(at + 20 + 4) == dump.half(at + 8),
+          "string values share the table with the context");
+    check(dump.length == at + 12 + 2 * 8 + 12 + 8, "dump length matches the layout");
+}
+
+/**
+ * @brief Capturing copies values; formatting the same snapshot as JSON costs far more
+ */
+void benchmarkSnapshot() {
+    Serial.println("\n[Benchmark]");
+
+    const uint16_t snapshots = 10000;
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < snapshots; i++) {
+        StateSnapshotCapture::capture(SNAPSHOT_TRIGGER_MODE_CHANGE, "GauntletController::handleModeTransition");
+        StateSnapshotCapture::addField("previousMode", (int)(i & 3));
+        StateSnapshotCapture::addField("newMode", (int)((i + 1) & 3));
+        StateSnapshotCapture::addField("transitionType", 1);
+    }
+    float captured = (float)(micros() - start) / snapshots;
+
+    // Roughly what a per-event JSON document costs before it even reaches Serial
+    char json[256];
+    start = micros();
+    for (uint16_t i = 0; i < snapshots; i++) {
+        snprintf(json, sizeof(json),
+                 "{\"time\":%lu,\"trigger\":%u,\"context\":\"%s\",\"previousMode\":%d,\"newMode\":%d,\"transitionType\":%d}",
+                 (unsigned long)millis(), SNAPSHOT_TRIGGER_MODE_CHANGE, "GauntletController::handleModeTransition",
+                 (int)(i & 3), (int)((i + 1) & 3), 1);
+    }
+    float serialized = (float)(micros() - start) / snapshots;
+
+    Serial.printf("    binary capture %6.3f us/snapshot, JSON text %6.3f us/snapshot\n", captured, serialized);
+    check(captured < serialized, "capturing is cheaper than serializing");
+}
+
+/**
+ * @brief Run all state snapshot tests
+ */
+void testStateSnapshot() {
+    resetChecks();
+
+    testCapture();
+    testHistory();
+    testDump();
+    benchmarkSnapshot();
+
+    reportChecks("State snapshot");
+}
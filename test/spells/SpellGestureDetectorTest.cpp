@@ -0,0 +1,114 @@
+#include <Arduino.h>
+#include "../../src/core/SpellRegistry.h"
+#include "../../src/detection/SpellGestureDetector.h"
+#include "../helpers/TestCheck.h"
+
+// Holds each position of a sequence for holdMs, at the 50 Hz logic rate
+static uint32_t play(SpellGestureDetector& detector, const HandPosition* positions, uint8_t count,
+                     uint32_t now, uint32_t holdMs) {
+    for (uint8_t i = 0; i < count; i++) {
+        for (uint32_t t = 0; t < holdMs; t += Config::LOGIC_PERIOD_MS) {
+            detector.update(positions[i], now);
+            now += Config::LOGIC_PERIOD_MS;
+        }
+    }
+    return now;
+}
+
+/**
+ * @brief Spells can be looked up by name at compile time
+ */
+void testRegistry() {
+    Serial.println("\n[Registry]");
+
+    static_assert(SpellRegistry::find("rainbow_burst") == 0, "rainbow_burst is the first spell");
+    check(SpellRegistry::find("lightning_blast") < SpellRegistry::COUNT, "lightning_blast is registered");
+    check(SpellRegistry::find("lumina") < SpellRegistry::COUNT, "lumina is registered");
+    check(SpellRegistry::find("no_such_spell") == SpellRegistry::NONE, "unknown names are NONE");
+
+    bool drawable = true;
+    for (SpellId id = 0; id < SpellRegistry::COUNT; id++) {
+        const SpellDefinition& spell = SpellRegistry::SPELLS[id];
+        drawable = drawable && (spell.program ? spell.programLength > 0 : spell.render != nullptr);
+    }
+    check(drawable, "every spell has a program or a renderer");
+}
+
+/**
+ * @brief Every registered gesture casts its own spell, inside its window only
+ */
+void testDetection() {
+    Serial.println("\n[Detection]");
+
+    SpellGestureDetector detector;
+    bool allCast = true;
+    uint32_t now = 1000;
+    for (SpellId id = 0; id < SpellRegistry::COUNT; id++) {
+        const SpellDefinition& spell = SpellRegistry::SPELLS[id];
+        const HandPosition gesture[] = {POS_UNKNOWN, spell.startPosition, spell.endPosition};
+        detector.reset();
+        now = play(detector, gesture, 3, now, 200);
+        allCast = allCast && detector.completedSpell() == id;
+    }
+    check(allCast, "each gesture casts its spell");
+
+    const SpellDefinition& rainbow = SpellRegistry::SPELLS[SpellRegistry::find("rainbow_burst")];
+
+    // Passing through an unrelated position does not break the gesture
+    const HandPosition detour[] = {rainbow.startPosition, POS_UNKNOWN, rainbow.endPosition};
+    detector.reset();
+    now = play(detector, detour, 3, now, 200);
+    check(detector.completedSpell() == SpellRegistry::find("rainbow_burst"), "gesture survives an unknown position");
+
+    // Too slow through the unrelated position
+    detector.reset();
+    now = play(detector, detour, 1, now, 200);
+    now = play(detector, detour + 1, 1, now, rainbow.windowMs + 100);
+    now = play(detector, detour + 2, 1, now, 200);
+    check(detector.completedSpell() == SpellRegistry::NONE, "gesture slower than the window does not cast");
+
+    // End position alone
+    const HandPosition endOnly[] = {POS_UNKNOWN, rainbow.endPosition};
+    detector.reset();
+    now = play(detector, endOnly, 2, now, 200);
+    check(detector.completedSpell() == SpellRegistry::NONE, "end position alone does not cast");
+
+    // A completed gesture stays reported until reset
+    const HandPosition gesture[] = {rainbow.startPosition, rainbow.endPosition};
+    detector.reset();
+    now = play(detector, gesture, 2, now, 200);
+    now = play(detector, endOnly, 1, now, 200);
+    check(detector.completedSpell() == SpellRegistry::find("rainbow_burst"), "completed spell is held until reset");
+    detector.reset();
+    check(detector.completedSpell() == SpellRegistry::NONE, "reset clears the completed spell");
+}
+
+/**
+ * @brief Update cost per logic tick
+ */
+void benchmarkSpellGestureDetector() {
+    Serial.println("\n[Benchmark]");
+
+    SpellGestureDetector detector;
+    const uint32_t ticks = 10000;
+    unsigned long start = micros();
+    const HandPosition held = SpellRegistry::SPELLS[0].startPosition;
+    for (uint32_t t = 0; t < ticks; t++) {
+        // Start position held, inside the window: every update checks for a timeout
+        detector.update(held, t / 1000);
+    }
+    Serial.printf("    %u spells: %6.3f us/update\n", SpellRegistry::COUNT, (float)(micros() - start) / ticks);
+}
+
+/**
+ * @brief Run all spell gesture detector tests
+ */
+void testSpellGestureDetector() {
+    resetChecks();
+
+    testRegistry();
+    testDetection();
+    benchmarkSpellGestureDetector();
+
+    reportChecks("Spell gesture detector");
+}
@@ -0,0 +1,19 @@
+#include <Arduino.h>
+
+// Forward declaration of test function
+extern void testSpellGestureDetector();
+
+void setup() {
+  // Initialize serial communication
+  Serial.begin(115200);
+  delay(1000);
+  Serial.println("PrismaTech Gauntlet 3.0 - Spell Gesture Detector Test");
+
+  // Run spell gesture detector tests and benchmark
+  testSpellGestureDetector();
+}
+
+void loop() {
+  // Just delay in the main loop
+  delay(1000);
+}
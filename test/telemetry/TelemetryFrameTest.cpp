@@ -0,0 +1,159 @@
+#include <Arduino.h>
+#include "../../src/core/SystemTypes.h"
+#include "../../src/diagnostics/TelemetryFrame.h"
+#include "../../src/diagnostics/TelemetryStream.h"
+#include "../../src/diagnostics/MemoryMonitor.h"
+#include "../helpers/TestCheck.h"
+
+static TelemetrySample makeSample(uint16_t i) {
+    TelemetrySample sample;
+    sample.sequence = i;
+    sample.timeUs = 1000000UL + i * 8000UL;
+    for (uint8_t a = 0; a < 6; a++) {
+        // Include zeros and extreme values, which COBS and the signed packing must survive
+        sample.raw[a] = (a == 0) ? 0 : (a == 1) ? -32768 : (int16_t)(i * 37 + a * 1000);
+    }
+    sample.filtered[0] = 0.0f;
+    sample.filtered[1] = -9.81f;
+    sample.filtered[2] = 3.14f + i * 0.01f;
+    sample.position = POS_CALM;
+    sample.confidence = 87;
+    return sample;
+}
+
+// Decodes the block between the delimiters of a complete frame
+static bool decodeWhole(const uint8_t* frame, size_t length, TelemetrySample& sample) {
+    uint8_t payload[TelemetryFrame::MAX_FRAME_SIZE];
+    size_t payloadLength = TelemetryFrame::decodeFrame(frame + 1, length - 2, payload);
+    return payloadLength > 0 && TelemetryFrame::parseSample(payload, payloadLength, sample);
+}
+
+/**
+ * @brief CRC-16/CCITT-FALSE check value and COBS round trips
+ */
+void testFraming() {
+    Serial.println("\n[Framing]");
+
+    const uint8_t check9[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    check(TelemetryFrame::crc16(check9, sizeof(check9)) == 0x29B1, "CRC-16/CCITT-FALSE check value");
+
+    const uint8_t data[] = {0x00, 0x11, 0x00, 0x00, 0x22, 0x33, 0x00};
+    uint8_t encoded[16];
+    uint8_t decoded[16];
+    size_t encodedLength = TelemetryFrame::cobsEncode(data, sizeof(data), encoded);
+    bool noZeros = true;
+    for (size_t i = 0; i < encodedLength; i++) {
+        noZeros = noZeros && encoded[i] != 0;
+    }
+    check(encodedLength == sizeof(data) + 1 && noZeros, "COBS removes zeros with one byte of overhead");
+    size_t decodedLength = TelemetryFrame::cobsDecode(encoded, encodedLength, decoded);
+    check(decodedLength == sizeof(data) && memcmp(decoded, data, sizeof(data)) == 0, "COBS round trip");
+
+    uint8_t malformed[] = {0x05, 0x11, 0x22};
+    check(TelemetryFrame::cobsDecode(malformed, sizeof(malformed), decoded) == 0, "truncated COBS block rejected");
+}
+
+/**
+ * @brief Samples and headers survive encoding; damage is detected
+ */
+void testPackets() {
+    Serial.println("\n[Packets]");
+
+    TelemetrySample sample = makeSample(42);
+    uint8_t frame[TelemetryFrame::MAX_FRAME_SIZE];
+    size_t length = TelemetryFrame::encodeSample(sample, frame);
+    check(length <= TelemetryFrame::MAX_FRAME_SIZE && frame[0] == 0 && frame[length - 1] == 0,
+          "sample frame is delimited and within MAX_FRAME_SIZE");
+
+    TelemetrySample out;
+    bool decoded = decodeWhole(frame, length, out);
+    check(decoded && out.sequence == 42 && out.timeUs == sample.timeUs, "sequence and time");
+    check(decoded && memcmp(out.raw, sample.raw, sizeof(out.raw)) == 0, "raw values, zeros and extremes included");
+    check(decoded && fabsf(out.filtered[1] - sample.filtered[1]) <= 0.005f &&
+          fabsf(out.filtered[2] - sample.filtered[2]) <= 0.005f, "filtered values to 0.01 m/s2");
+    check(decoded && out.position == POS_CALM && out.confidence == 87, "position and confidence");
+
+    frame[length / 2] ^= 0x10;
+    check(!decodeWhole(frame, length, out), "a flipped bit fails the CRC");
+
+    TelemetryHeader header = {125, 115200, 0.0011975f};
+    length = TelemetryFrame::encodeHeader(header, frame);
+    uint8_t payload[TelemetryFrame::MAX_FRAME_SIZE];
+    size_t payloadLength = TelemetryFrame::decodeFrame(frame + 1, length - 2, payload);
+    TelemetryHeader parsed;
+    check(TelemetryFrame::parseHeader(payload, payloadLength, parsed) && parsed.rateHz == 125 &&
+          parsed.baud == 115200 && parsed.scalingFactor == header.scalingFactor, "header round trip");
+    check(!TelemetryFrame::parseSample(payload, payloadLength, out), "a header is not parsed as a sample");
+}
+
+/**
+ * @brief Memory reports survive encoding; allocations are counted
+ */
+void testMemory() {
+    Serial.println("\n[Memory]");
+
+    MemoryStats stats = {52000, 180000, 110000, 150000, 70000, 1234, 1200};
+    uint8_t frame[TelemetryFrame::MAX_FRAME_SIZE];
+    size_t length = TelemetryFrame::encodeMemory(stats, frame);
+    check(length <= TelemetryFrame::MAX_FRAME_SIZE, "memory frame is within MAX_FRAME_SIZE");
+
+    uint8_t payload[TelemetryFrame::MAX_FRAME_SIZE];
+    size_t payloadLength = TelemetryFrame::decodeFrame(frame + 1, length - 2, payload);
+    MemoryStats parsed;
+    check(TelemetryFrame::parseMemory(payload, payloadLength, parsed) && parsed.heapUsed == 52000 &&
+          parsed.heapFree == 180000 && parsed.heapLargestBlock == 110000 && parsed.heapMinFree == 150000 &&
+          parsed.allocations == 1234 && parsed.frees == 1200, "memory report round trip");
+    check(parsed.loopStackFree == 0xFFFF, "loop stack figure saturates at 16 bits");
+    TelemetrySample sample;
+    check(!TelemetryFrame::parseSample(payload, payloadLength, sample), "a memory report is not parsed as a sample");
+
+    uint32_t allocations = MemoryMonitor::allocations();
+    uint32_t frees = MemoryMonitor::frees();
+    // Through a volatile pointer, so the compiler cannot drop the new/delete pairs
+    uint8_t* volatile block = new uint8_t[64];
+    TelemetrySample* volatile single = new TelemetrySample();
+    delete single;
+    delete[] block;
+    check(MemoryMonitor::allocations() - allocations == 2 && MemoryMonitor::frees() - frees == 2,
+          "operator new and delete are counted");
+}
+
+/**
+ * @brief 125 Hz fits in 115200 baud, and encoding a sample is cheap
+ */
+void benchmarkTelemetry() {
+    Serial.println("\n[Bandwidth]");
+
+    uint32_t bitsPerSecond = 125UL * TelemetryFrame::MAX_FRAME_SIZE * 10;
+    Serial.printf("    125 Hz needs %lu baud; 115200 baud carries up to %u Hz\n",
+                  (unsigned long)bitsPerSecond, TelemetryStream::maxRateFor(115200));
+    check(TelemetryStream::maxRateFor(115200) >= 125, "115200 baud sustains 125 Hz");
+    check(TelemetryStream::maxRateFor(921600) == TelemetryStream::MAX_RATE_HZ, "fast links are capped at MAX_RATE_HZ");
+
+    const uint16_t samples = 10000;
+    uint8_t frame[TelemetryFrame::MAX_FRAME_SIZE];
+    TelemetrySample sample = makeSample(0);
+    uint32_t total = 0;
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < samples; i++) {
+        sample.sequence = i;
+        total += TelemetryFrame::encodeSample(sample, frame);
+    }
+    float us = (float)(micros() - start) / samples;
+    Serial.printf("    encode %6.3f us/sample, %lu bytes/sample\n", us, (unsigned long)(total / samples));
+    check(us * 125 < 1000.0f, "encoding 125 samples takes under 1 ms per second");
+}
+
+/**
+ * @brief Run all telemetry frame tests
+ */
+void testTelemetryFrame() {
+    resetChecks();
+
+    testFraming();
+    testPackets();
+    testMemory();
+    benchmarkTelemetry();
+
+    reportChecks("Telemetry frame");
+}
@@ -0,0 +1,17 @@
+#include <Arduino.h>
+#include "../helpers/TestCheck.h"
+
+// Forward declaration of test function
+extern void testLEDTopology();
+
+/**
+ * @brief Host entry point: the same checks and render benchmarks without a board
+ * @return Non-zero if a check failed
+ */
+int main() {
+    Serial.println("PrismaTech Gauntlet 3.0 - LED Topology Test (host)");
+
+    // Run topology tests and render benchmarks
+    testLEDTopology();
+    return checkFailures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+#include <Arduino.h>
+#include "../../src/hardware/LEDTopology.h"
+#include "../../src/animation/TopologyRenderer.h"
+#include "../../src/animation/ColorEngine.h"
+#include "../helpers/TestCheck.h"
+
+typedef RingTopology<12> Ring12;
+typedef RingTopology<12, 5> Rings60;
+typedef RingTopology<60, 5> Rings300;
+typedef StripTopology<300> Strip300;
+
+static bool sameColor(const Color& a, const Color& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+/**
+ * @brief Descriptor geometry
+ */
+void testGeometry() {
+    Serial.println("\n[Geometry]");
+
+    check(Ring12::LED_COUNT == 12 && Rings60::LED_COUNT == 60 && Strip300::LED_COUNT == 300, "LED counts");
+    check(ActiveTopology::LED_COUNT == Config::NUM_LEDS, "active topology matches Config::NUM_LEDS");
+
+    check(Ring12::angle(0) == 0 && Ring12::angle(3) == 64 && Ring12::angle(6) == 128, "ring angles");
+    check(Ring12::marker(0, 4) == 0 && Ring12::marker(1, 4) == 3 &&
+          Ring12::marker(2, 4) == 6 && Ring12::marker(3, 4) == 9, "four markers on a 12-LED ring are 0, 3, 6, 9");
+
+    check(Rings60::ringOf(25) == 2 && Rings60::position(25) == 1 && Rings60::ringStart(2) == 24, "ring of an LED and its position");
+    check(Rings60::angle(25) == Ring12::angle(1), "every ring has the same angles");
+    check(Rings60::marker(4, 4) == 12 && Rings60::marker(19, 4) == 57, "markers continue on the next ring");
+
+    check(Strip300::angle(0) == 0 && Strip300::angle(299) == 255, "strip angle runs from end to end");
+    check(Strip300::marker(2, 4) == 150, "strip markers are evenly spaced");
+
+    check(angularDistance<Ring12>(10, 250) == 16, "ring distance wraps around");
+    check(angularDistance<Strip300>(0, 255) == 127, "strip distance does not wrap");
+}
+
+/**
+ * @brief Templated kernels against the runtime-count color engine
+ */
+void testKernels() {
+    Serial.println("\n[Kernels]");
+
+    Color single[12];
+    Color reference[12];
+    Color multi[60];
+
+    TopologyRenderer::ringRainbow<Ring12>(single, 40, 200);
+    ColorEngine::fillRingRainbow(reference, 12, 40, 200);
+    bool same = true;
+    for (uint16_t i = 0; i < 12; i++) {
+        same = same && sameColor(single[i], reference[i]);
+    }
+    check(same, "ring rainbow matches ColorEngine::fillRingRainbow");
+
+    TopologyRenderer::ringTrail<Ring12>(single, Ring12::angle(4), 30, 230, 240);
+    TopologyRenderer::ringTrail<Rings60>(multi, Ring12::angle(4), 30, 230, 240);
+    same = true;
+    for (uint16_t i = 0; i < 60; i++) {
+        same = same && sameColor(multi[i], single[i % 12]);
+    }
+    check(same, "every ring repeats the single-ring trail");
+    check(single[4].r + single[4].g + single[4].b > single[10].r + single[10].g + single[10].b, "trail is brightest at the head");
+}
+
+// Runtime-count reference: the same rainbow with the LED count only known at run time
+static void runtimeRainbow(Color* out, uint16_t ringSize, uint8_t rings, uint8_t rotation) {
+    for (uint8_t r = 0; r < rings; r++) {
+        ColorEngine::fillRingRainbow(out + r * ringSize, ringSize, rotation, 255);
+    }
+}
+
+template <class Topology>
+static void benchmarkTopology(const char* name, uint16_t ringSize, uint8_t rings) {
+    static Color frame[Topology::LED_COUNT];
+    const uint16_t ITERATIONS = 200;
+    volatile uint8_t sink = 0;
+
+    unsigned long start = micros();
+    for (uint16_t n = 0; n < ITERATIONS; n++) {
+        runtimeRainbow(frame, ringSize, rings, (uint8_t)n);
+        sink ^= frame[n % Topology::LED_COUNT].r;
+    }
+    float runtimeUs = (float)(micros() - start) / ITERATIONS;
+
+    start = micros();
+    for (uint16_t n = 0; n < ITERATIONS; n++) {
+        TopologyRenderer::ringRainbow<Topology>(frame, (uint8_t)n, 255);
+        sink ^= frame[n % Topology::LED_COUNT].r;
+    }
+    float rainbowUs = (float)(micros() - start) / ITERATIONS;
+
+    start = micros();
+    for (uint16_t n = 0; n < ITERATIONS; n++) {
+        TopologyRenderer::ringTrail<Topology>(frame, (uint8_t)n, (uint8_t)(n * 3), 230, 255);
+        sink ^= frame[n % Topology::LED_COUNT].g;
+    }
+    float trailUs = (float)(micros() - start) / ITERATIONS;
+
+    Serial.printf("    %-16s %3u LEDs  rainbow %7.2f us (runtime count %7.2f us)  trail %7.2f us\n",
+                  name, Topology::LED_COUNT, rainbowUs, runtimeUs, trailUs);
+    (void)sink;
+}
+
+/**
+ * @brief Render cost per frame at 12, 60 and 300 LEDs
+ */
+void benchmarkTopologies() {
+    Serial.println("\n[Render cost per frame]");
+
+    benchmarkTopology<Ring12>("1 x 12 ring", 12, 1);
+    benchmarkTopology<Rings60>("5 x 12 rings", 12, 5);
+    benchmarkTopology<Rings300>("5 x 60 rings", 60, 5);
+    benchmarkTopology<Strip300>("300 strip", 300, 1);
+}
+
+/**
+ * @brief Run all LED topology tests
+ */
+void testLEDTopology() {
+    resetChecks();
+
+    testGeometry();
+    testKernels();
+    benchmarkTopologies();
+
+    reportChecks("LED topology");
+}
@@ -0,0 +1,257 @@
+#include <Arduino.h>
+#include <stdarg.h>
+#include "../../src/diagnostics/DiagnosticLogger.h"
+#include "../../src/diagnostics/TraceBuffer.h"
+#include "../helpers/TestCheck.h"
+
+// Formats the oldest entry and compares the message after the "<us> [LEVEL:TAG] " prefix
+static bool popsAs(const char* expected) {
+    TraceEntry entry;
+    if (!TraceBuffer::pop(entry)) {
+        return false;
+    }
+    char line[128];
+    DiagnosticLogger::formatEntry(entry, line, sizeof(line));
+    const char* message = strchr(line, ']');
+    bool match = message && strcmp(message + 2, expected) == 0;
+    if (!match) {
+        Serial.printf("        got \"%s\"\n", line);
+    }
+    return match;
+}
+
+/**
+ * @brief Trace IDs are the FNV-1a hash utils/trace_tool.py uses
+ */
+void testTraceIds() {
+    Serial.println("\n[Trace IDs]");
+
+    static_assert(TraceBuffer::hash("") == 0x811C9DC5u, "empty string hash");
+    static_assert(TraceBuffer::hash("a") == 0xE40C292Cu, "single character hash");
+    check(DIAG_TRACE_ID("Slow update cycle: %lu ms (target: %lu ms)") != DIAG_TRACE_ID("Unknown SystemMode: %d"),
+          "different formats get different IDs");
+    check(DiagnosticLogger::findFormat(DIAG_TRACE_ID("Unknown SystemMode: %d")) != nullptr,
+          "log sites in src are in the generated string table");
+    check(DiagnosticLogger::findFormat(DIAG_TRACE_ID("not a log site")) == nullptr, "unknown IDs are not found");
+}
+
+/**
+ * @brief Entries come out in order with their arguments; a full ring drops new entries
+ */
+void testRing() {
+    Serial.println("\n[Ring]");
+
+    TraceBuffer::clear();
+    TraceBuffer::record(1, DIAG_LEVEL_INFO, DIAG_TAG_MODE);
+    TraceBuffer::record(2, DIAG_LEVEL_DEBUG, DIAG_TAG_GESTURE, 7, -3, 1234567ul);
+    check(TraceBuffer::pending() == 2, "two entries pending");
+    check(TraceBuffer::readable() == 2, "both entries are published");
+
+    TraceEntry entry;
+    bool first = TraceBuffer::pop(entry) && entry.id == 1 && entry.argCount == 0 &&
+                 entry.level == DIAG_LEVEL_INFO && entry.tag == DIAG_TAG_MODE;
+    check(first, "first entry comes out first");
+    bool second = TraceBuffer::pop(entry) && entry.id == 2 && entry.argCount == 3 &&
+                  entry.args[0] == 7 && (int32_t)entry.args[1] == -3 && entry.args[2] == 1234567ul;
+    check(second, "arguments are recorded raw");
+    check(!TraceBuffer::pop(entry), "ring is empty afterwards");
+
+    uint32_t droppedBefore = TraceBuffer::dropped();
+    bool accepted = true;
+    for (uint16_t i = 0; i < TraceBuffer::CAPACITY; i++) {
+        accepted = accepted && TraceBuffer::record(100 + i, DIAG_LEVEL_TRACE, DIAG_TAG_MOTION, i);
+    }
+    check(accepted && TraceBuffer::pending() == TraceBuffer::CAPACITY, "ring holds CAPACITY entries");
+    check(!TraceBuffer::record(999, DIAG_LEVEL_TRACE, DIAG_TAG_MOTION), "record into a full ring fails");
+    check(TraceBuffer::dropped() == droppedBefore + 1, "dropped entry is counted");
+
+    bool ordered = true;
+    for (uint16_t i = 0; i < TraceBuffer::CAPACITY; i++) {
+        ordered = ordered && TraceBuffer::pop(entry) && entry.id == 100u + i && entry.args[0] == i;
+    }
+    check(ordered, "oldest entries are kept, in order, across the wrap");
+
+    // Slots are reusable after the wrap
+    TraceBuffer::record(5, DIAG_LEVEL_INFO, DIAG_TAG_MODE, 42);
+    check(TraceBuffer::peek(entry) && entry.id == 5 && TraceBuffer::pending() == 1, "peek leaves the entry in the ring");
+    TraceBuffer::clear();
+    check(TraceBuffer::pending() == 0, "clear empties the ring");
+}
+
+/**
+ * @brief Deferred formatting matches what printf would have printed at the call site
+ */
+void testFormatting() {
+    Serial.println("\n[Formatting]");
+
+    TraceBuffer::clear();
+    DiagnosticLogger::setEnabled(true);
+
+    DIAG_WARNING(DIAG_TAG_MODE, "Slow update cycle: %lu ms (target: %lu ms)", 35ul, 20ul);
+    check(popsAs("Slow update cycle: 35 ms (target: 20 ms)"), "integer conversions");
+
+    DIAG_ERROR(DIAG_TAG_MODE, "Unknown SystemMode: %d", -1);
+    check(popsAs("Unknown SystemMode: -1"), "negative integers");
+
+    DIAG_INFO(DIAG_TAG_GESTURE, "Shake gesture detected! Intensity: %.2f", 1.5f);
+    check(popsAs("Shake gesture detected! Intensity: 1.50"), "floats with precision");
+
+    static const char* const SPELL = "lumina";
+    DIAG_INFO(DIAG_TAG_MODE, "Transitioning to QuickCast Mode with spell: %s", SPELL);
+    check(popsAs("Transitioning to QuickCast Mode with spell: lumina"), "static strings");
+
+    TraceBuffer::record(0x12345678, DIAG_LEVEL_INFO, DIAG_TAG_MODE, 10);
+    check(popsAs("<id 0x12345678> 0xa"), "unknown IDs print their raw arguments");
+
+    TraceEntry entry;
+    DIAG_INFO(DIAG_TAG_MODE, "GauntletController constructed");
+    char line[128];
+    check(TraceBuffer::pop(entry) && DiagnosticLogger::formatEntry(entry, line, sizeof(line)) > 0 &&
+          strstr(line, "[INFO:MODE] GauntletController constructed") != nullptr, "level and tag prefix");
+
+    DiagnosticLogger::setEnabled(false);
+    DIAG_INFO(DIAG_TAG_MODE, "GauntletController constructed");
+    check(TraceBuffer::pending() == 0, "nothing is recorded while disabled");
+    DiagnosticLogger::setEnabled(true);
+}
+
+/**
+ * @brief Per-tag runtime levels, the compile-time floor and per-site rate limits
+ */
+void testFiltering() {
+    Serial.println("\n[Filtering]");
+
+    TraceBuffer::clear();
+    DiagnosticLogger::setEnabled(true);
+    check(DiagnosticLogger::findTag("gesture") == DIAG_TAG_GESTURE && DiagnosticLogger::findTag("SENSOR") == DIAG_TAG_SENSOR &&
+          DiagnosticLogger::findTag("nope") == 0, "tags are found by name, ignoring case");
+
+    DiagnosticLogger::setTagLevel(DIAG_TAG_GESTURE, DIAG_LEVEL_WARNING);
+    DIAG_INFO(DIAG_TAG_GESTURE, "Gesture started: type %d", 1);
+    check(TraceBuffer::pending() == 0, "a tag's runtime level silences its INFO sites");
+    DIAG_WARNING(DIAG_TAG_GESTURE, "Gesture started: type %d", 1);
+    DIAG_INFO(DIAG_TAG_MODE, "GauntletController constructed");
+    check(TraceBuffer::pending() == 2, "higher levels and other tags still log");
+    DiagnosticLogger::setTagLevel(DIAG_TAG_GESTURE, DIAG_LOG_LEVEL);
+    TraceBuffer::clear();
+
+    DiagnosticLogger::setTagLevel(DIAG_TAG_MODE, DIAG_LEVEL_TRACE);
+    DIAG_TRACE(DIAG_TAG_MODE, "GauntletController constructed");
+    check(DIAG_LOG_LEVEL >= DIAG_LEVEL_TRACE || TraceBuffer::pending() == 0,
+          "sites above DIAG_LOG_LEVEL stay out whatever the runtime level");
+    DiagnosticLogger::setTagLevel(DIAG_TAG_MODE, DIAG_LOG_LEVEL);
+    TraceBuffer::clear();
+
+    uint32_t suppressedBefore = DiagnosticLogger::suppressed();
+    for (uint8_t i = 0; i < 50; i++) {
+        DIAG_LOG_RATE(DIAG_LEVEL_WARNING, DIAG_TAG_SENSOR, 1, 3, "Too many identical consecutive readings");
+    }
+    check(TraceBuffer::pending() == 3, "a site logging every frame is held to its burst");
+    check(DiagnosticLogger::suppressed() == suppressedBefore + 47, "held-back entries are counted");
+    TraceBuffer::clear();
+
+    DiagRateLimit bucket = {0, 0, false};
+    bool burst = bucket.allow(1000, 2) && bucket.allow(1000, 2);
+    check(burst && !bucket.allow(1000, 2), "an unused bucket starts full");
+    delay(5);
+    check(bucket.allow(1000, 2) && bucket.allow(1000, 2) && !bucket.allow(1000, 2),
+          "the bucket refills at the rate, up to the burst");
+}
+
+// What each DIAG_LOG line cost before: three vsnprintf calls (Serial output excluded)
+static void formatImmediately(char* buffer, size_t size, const char* format, ...) {
+    snprintf(buffer, size, "[%s:%s] ", DiagnosticLogger::getLevelName(DIAG_LEVEL_WARNING),
+             DiagnosticLogger::getTagName(DIAG_TAG_MODE));
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, size, format, args);
+    va_end(args);
+    snprintf(buffer, size, "\n");
+}
+
+/**
+ * @brief Cost of a log call at the call site
+ */
+void benchmarkTraceBuffer() {
+    Serial.println("\n[Benchmark]");
+
+    const uint16_t calls = 10000;
+    TraceEntry entry;
+
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < calls; i++) {
+        TraceBuffer::record(DIAG_TRACE_ID("Slow update cycle: %lu ms (target: %lu ms)"),
+                            DIAG_LEVEL_WARNING, DIAG_TAG_MODE, (unsigned long)i, 20ul);
+        TraceBuffer::pop(entry);
+    }
+    float traced = (float)(micros() - start) / calls;
+
+    char buffer[128];
+    start = micros();
+    for (uint16_t i = 0; i < calls; i++) {
+        formatImmediately(buffer, sizeof(buffer), "Slow update cycle: %lu ms (target: %lu ms)", (unsigned long)i, 20ul);
+    }
+    float formatted = (float)(micros() - start) / calls;
+
+    Serial.printf("    trace record + pop %6.3f us/call, immediate formatting %6.3f us/call\n", traced, formatted);
+    check(traced < formatted, "recording is cheaper than formatting");
+}
+
+// Collects a binary dump
+class DumpBuffer : public Print {
+public:
+    DumpBuffer() : length(0) {}
+
+    size_t write(uint8_t c) override {
+        if (length < sizeof(bytes)) {
+            bytes[length++] = c;
+        }
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        for (size_t i = 0; i < size; i++) {
+            write(data[i]);
+        }
+        return size;
+    }
+
+    uint8_t bytes[512];
+    size_t length;
+};
+
+/**
+ * @brief The dump header counts exactly the entries that follow it
+ */
+void testDump() {
+    Serial.println("\n[Dump]");
+
+    TraceBuffer::clear();
+    TraceBuffer::record(1, DIAG_LEVEL_INFO, DIAG_TAG_MODE);
+    TraceBuffer::record(2, DIAG_LEVEL_DEBUG, DIAG_TAG_GESTURE, 7, -3);
+    TraceBuffer::record(3, DIAG_LEVEL_WARNING, DIAG_TAG_MOTION, 1, 2, 3, 4);
+
+    DumpBuffer dump;
+    uint16_t written = DiagnosticLogger::dumpBinary(dump);
+    uint16_t headerCount = dump.bytes[6] | (dump.bytes[7] << 8);
+    check(written == 3 && headerCount == 3, "header counts every published entry");
+    // 'DTRC', version, count, dropped; then 12 bytes and 4 per argument for each entry
+    check(dump.length == 12 + (12 + 0) + (12 + 8) + (12 + 16), "exactly the counted entries follow");
+    check(TraceBuffer::pending() == 0, "the dump takes the entries");
+}
+
+/**
+ * @brief Run all trace buffer tests
+ */
+void testTraceBuffer() {
+    resetChecks();
+
+    testTraceIds();
+    testRing();
+    testFormatting();
+    testFiltering();
+    testDump();
+    benchmarkTraceBuffer();
+
+    reportChecks("Trace buffer");
+}
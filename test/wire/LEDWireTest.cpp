@@ -0,0 +1,110 @@
+#include <Arduino.h>
+#include "../../src/hardware/LEDWire.h"
+#include "../helpers/TestCheck.h"
+
+// Build with -D LED_WIRE_SIMULATED=1 so the stand-in wire models transfer time
+
+static CRGB front[Config::NUM_LEDS];
+
+static void fillFrame(CRGB* frame, uint8_t value) {
+    for (uint16_t i = 0; i < Config::NUM_LEDS; i++) {
+        frame[i] = CRGB(value, value, value);
+    }
+}
+
+static void busyWork(uint32_t us) {
+    uint32_t start = micros();
+    while (micros() - start < us) {
+    }
+}
+
+/**
+ * @brief Frames are swapped in when the wire is free and never torn
+ */
+void testDoubleBuffering() {
+    Serial.println("\n[Double buffering]");
+
+    LEDWire wire;
+    CRGB frame[Config::NUM_LEDS];
+    check(wire.begin(front, Config::NUM_LEDS), "wire starts");
+    Serial.printf("    frame time %lu us\n", (unsigned long)wire.getFrameMicros());
+
+    fillFrame(frame, 1);
+    uint32_t start = micros();
+    wire.submit(frame, 255);
+    uint32_t elapsed = micros() - start;
+    check(elapsed < wire.getFrameMicros() / 2, "submit on an idle wire returns before the transfer ends");
+    check(wire.isBusy(), "wire is busy after submit");
+    check(front[0].r == 1, "idle wire swaps the frame in immediately");
+
+    fillFrame(frame, 2);
+    wire.submit(frame, 255);
+    check(wire.getStats().renderWaits == 0, "second frame queues without waiting");
+    check(front[0].r == 1, "queued frame does not touch the frame on the wire");
+
+    wire.waitIdle();
+    check(!wire.isBusy(), "waitIdle drains the queue");
+    check(front[0].r == 2 && wire.getStats().transfers == 2, "queued frame is sent after the first");
+
+    // Three frames back to back: the third is a full frame ahead
+    for (uint8_t i = 3; i <= 5; i++) {
+        fillFrame(frame, i);
+        wire.submit(frame, 255);
+    }
+    check(wire.getStats().renderWaits == 1, "only the frame a full frame ahead waits");
+    wire.waitIdle();
+    check(front[0].r == 5, "last frame ends up on the LEDs");
+}
+
+/**
+ * @brief Rendering and sensing overlap with the transfer
+ */
+void testOverlap() {
+    Serial.println("\n[Overlap]");
+
+    LEDWire wire;
+    CRGB frame[Config::NUM_LEDS];
+    wire.begin(front, Config::NUM_LEDS);
+    const uint32_t frameUs = wire.getFrameMicros();
+    const uint16_t FRAMES = 200;
+
+    // Loop work as long as a transfer: the wire is always free in time
+    uint32_t start = micros();
+    for (uint16_t i = 0; i < FRAMES; i++) {
+        busyWork(frameUs);
+        fillFrame(frame, i);
+        wire.submit(frame, 255);
+    }
+    uint32_t overlapped = micros() - start;
+    uint32_t serialized = (uint32_t)FRAMES * 2 * frameUs;
+    wire.waitIdle();
+    check(wire.getStats().renderWaits == 0, "render loop never waits when it keeps pace");
+    check(overlapped < serialized * 3 / 4, "transfer overlaps loop work");
+    Serial.printf("    %u frames: %lu us overlapped vs %lu us blocking\n",
+                  FRAMES, (unsigned long)overlapped, (unsigned long)serialized);
+
+    // A loop faster than the wire is paced by it
+    start = micros();
+    for (uint16_t i = 0; i < FRAMES; i++) {
+        fillFrame(frame, i);
+        wire.submit(frame, 255);
+    }
+    wire.waitIdle();
+    uint32_t paced = micros() - start;
+    check(wire.getStats().renderWaits > 0, "render loop waits once it is a full frame ahead");
+    check(paced >= (uint32_t)(FRAMES - 1) * frameUs, "wire bounds the frame rate");
+    Serial.printf("    waits %lu, waited %lu us\n",
+                  (unsigned long)wire.getStats().renderWaits, (unsigned long)wire.getStats().waitMicros);
+}
+
+/**
+ * @brief Run all LED wire tests
+ */
+void testLEDWire() {
+    resetChecks();
+
+    testDoubleBuffering();
+    testOverlap();
+
+    reportChecks("LED wire");
+}
@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+"""
+Keyframe animation compiler for the PrismaTech Gauntlet.
+
+Compiles `.anim` text descriptions into the bytecode played by
+AnimationPlayer (src/animation/AnimationPlayer.h) and writes them either
+as a C++ header of flash-resident arrays or as raw binary blobs.
+
+Text format (one statement per line, '#' starts a comment):
+
+    program <name> leds <count> duration <ms> [loop]
+    track leds <first>[..<last>] [step <n>] [from <ms>] [to <ms>] [loop <ms>] [spread <revs>]
+      key <ms> rgb <r> <g> <b> [value <v>] [ease <curve>]
+      key <ms> hue <h> [sat <s>] [value <v>] [ease <curve>]
+      key <ms> param <slot> [value <v>] [ease <curve>]
+
+Key times are relative to the track start. Easing applies to the segment
+that starts at the key. Curves: linear, step, in, out, in_out, sine_in,
+sine_out.
+
+Usage:
+    python utils/anim_compiler.py src/animation/scripts/*.anim -o src/animation/AnimationPrograms.h
+    python utils/anim_compiler.py src/animation/scripts/lumina.anim --bin out/
+"""
+import argparse
+import os
+import struct
+import sys
+
+VERSION = 1
+OP_END = 0x00
+OP_TRACK = 0x54
+FLAG_LOOP = 0x01
+END_OF_PROGRAM = 0xFFFF
+MAX_PARAMS = 4
+
+SOURCES = {'rgb': 0, 'hue': 1, 'param': 2}
+EASES = {
+    'linear': 0, 'step': 1, 'in': 2, 'out': 3,
+    'in_out': 4, 'sine_in': 5, 'sine_out': 6,
+}
+
+
+class CompileError(Exception):
+    pass
+
+
+def _int(tok, lo, hi, what, line_no):
+    try:
+        value = int(tok, 0)
+    except ValueError:
+        raise CompileError(f"line {line_no}: {what} must be an integer, got '{tok}'")
+    if not lo <= value <= hi:
+        raise CompileError(f"line {line_no}: {what} {value} out of range {lo}..{hi}")
+    return value
+
+
+def _options(tokens, line_no, flags=()):
+    """Parse 'name value' pairs (and bare flags) into a dict."""
+    opts = {}
+    i = 0
+    while i < len(tokens):
+        name = tokens[i]
+        if name in flags:
+            opts[name] = True
+            i += 1
+            continue
+        if i + 1 >= len(tokens):
+            raise CompileError(f"line {line_no}: '{name}' needs a value")
+        opts[name] = tokens[i + 1]
+        i += 2
+    return opts
+
+
+class Track:
+    def __init__(self, first, count, stride, spread, start, end, loop, line_no):
+        self.first = first
+        self.count = count
+        self.stride = stride
+        self.spread = spread
+        self.start = start
+        self.end = end
+        self.loop = loop
+        self.line_no = line_no
+        self.keys = []
+
+    def encode(self):
+        if not self.keys:
+            raise CompileError(f"line {self.line_no}: track has no keys")
+        out = struct.pack('<BHHBBHHHB', OP_TRACK, self.first, self.count, self.stride,
+                          self.spread, self.start, self.end, self.loop, len(self.keys))
+        for key in self.keys:
+            out += key
+        return out
+
+
+class Program:
+    def __init__(self, name, leds, duration, loop):
+        self.name = name
+        self.leds = leds
+        self.duration = duration
+        self.loop = loop
+        self.tracks = []
+
+    def encode(self):
+        flags = FLAG_LOOP if self.loop else 0
+        out = struct.pack('<BBBBHHBB', ord('K'), ord('F'), VERSION, flags,
+                          self.leds, self.duration, len(self.tracks), 0)
+        for track in self.tracks:
+            out += track.encode()
+        return out + bytes([OP_END])
+
+
+def parse(text, source_name='<input>'):
+    """Parse one .anim description into a Program."""
+    program = None
+    track = None
+    last_key_time = None
+
+    for line_no, raw in enumerate(text.splitlines(), 1):
+        line = raw.split('#', 1)[0].strip()
+        if not line:
+            continue
+        tokens = line.split()
+        cmd = tokens[0]
+
+        if cmd == 'program':
+            if program is not None:
+                raise CompileError(f"line {line_no}: only one program per file")
+            if len(tokens) < 2:
+                raise CompileError(f"line {line_no}: program needs a name")
+            opts = _options(tokens[2:], line_no, flags=('loop',))
+            leds = _int(opts.get('leds', '12'), 1, 0xFFFF, 'leds', line_no)
+            duration = _int(opts.get('duration', '0'), 1, 0xFFFF, 'duration', line_no)
+            program = Program(tokens[1], leds, duration, opts.get('loop', False))
+
+        elif cmd == 'track':
+            if program is None:
+                raise CompileError(f"line {line_no}: track before program")
+            if len(tokens) < 3 or tokens[1] != 'leds':
+                raise CompileError(f"line {line_no}: expected 'track leds <first>[..<last>]'")
+            span = tokens[2].split('..')
+            first = _int(span[0], 0, program.leds - 1, 'first LED', line_no)
+            last = _int(span[-1], first, program.leds - 1, 'last LED', line_no)
+            opts = _options(tokens[3:], line_no)
+            stride = _int(opts.get('step', '1'), 1, 255, 'step', line_no)
+            count = (last - first) // stride + 1
+            start = _int(opts.get('from', '0'), 0, program.duration, 'from', line_no)
+            end = END_OF_PROGRAM
+            if 'to' in opts:
+                end = _int(opts['to'], start + 1, program.duration, 'to', line_no)
+            loop = _int(opts.get('loop', '0'), 0, 0xFFFF, 'loop', line_no)
+            spread = _int(opts.get('spread', '0'), 0, 255, 'spread', line_no)
+            track = Track(first, count, stride, spread, start, end, loop, line_no)
+            program.tracks.append(track)
+            last_key_time = None
+
+        elif cmd == 'key':
+            if track is None:
+                raise CompileError(f"line {line_no}: key before track")
+            if len(tokens) < 3:
+                raise CompileError(f"line {line_no}: expected 'key <ms> <source> ...'")
+            time = _int(tokens[1], 0, 0xFFFF, 'key time', line_no)
+            if last_key_time is not None and time < last_key_time:
+                raise CompileError(f"line {line_no}: key times must not decrease")
+            last_key_time = time
+
+            source = tokens[2]
+            if source not in SOURCES:
+                raise CompileError(f"line {line_no}: unknown color source '{source}'")
+            if source == 'rgb':
+                if len(tokens) < 6:
+                    raise CompileError(f"line {line_no}: rgb needs three components")
+                data = [_int(t, 0, 255, 'rgb component', line_no) for t in tokens[3:6]]
+                rest = tokens[6:]
+            elif source == 'hue':
+                if len(tokens) < 4:
+                    raise CompileError(f"line {line_no}: hue needs a value")
+                data = [_int(tokens[3], 0, 255, 'hue', line_no), 255, 0]
+                rest = tokens[4:]
+            else:
+                if len(tokens) < 4:
+                    raise CompileError(f"line {line_no}: param needs a slot")
+                data = [_int(tokens[3], 0, MAX_PARAMS - 1, 'param slot', line_no), 0, 0]
+                rest = tokens[4:]
+
+            opts = _options(rest, line_no)
+            if 'sat' in opts:
+                if source != 'hue':
+                    raise CompileError(f"line {line_no}: sat only applies to hue keys")
+                data[1] = _int(opts['sat'], 0, 255, 'sat', line_no)
+            value = _int(opts.get('value', '255'), 0, 255, 'value', line_no)
+            ease_name = opts.get('ease', 'linear')
+            if ease_name not in EASES:
+                raise CompileError(f"line {line_no}: unknown easing '{ease_name}'")
+
+            track.keys.append(struct.pack('<HBBBBBB', time, SOURCES[source],
+                                          data[0], data[1], data[2], value, EASES[ease_name]))
+        else:
+            raise CompileError(f"line {line_no}: unknown statement '{cmd}'")
+
+    if program is None:
+        raise CompileError(f"{source_name}: no program statement")
+    return program
+
+
+def to_header(programs, sources):
+    lines = [
+        '#ifndef ANIMATION_PROGRAMS_H',
+        '#define ANIMATION_PROGRAMS_H',
+        '',
+        '#include <Arduino.h>',
+        '',
+        '/**',
+        ' * @brief Compiled keyframe animation programs',
+        ' *',
+        ' * GENERATED by utils/anim_compiler.py - do not edit by hand.',
+        ' * Sources: ' + ', '.join(sources),
+        ' */',
+        '',
+    ]
+    for program in programs:
+        blob = program.encode()
+        ident = 'ANIM_' + program.name.upper()
+        lines.append(f'// {program.name}: {len(program.tracks)} tracks, '
+                     f'{program.duration} ms{" (loop)" if program.loop else ""}, {len(blob)} bytes')
+        lines.append(f'const PROGMEM uint8_t {ident}[] = {{')
+        for i in range(0, len(blob), 16):
+            chunk = ', '.join(f'0x{b:02X}' for b in blob[i:i + 16])
+            lines.append(f'  {chunk},')
+        lines.append('};')
+        lines.append(f'constexpr uint16_t {ident}_SIZE = sizeof({ident});')
+        lines.append('')
+    lines.append('#endif // ANIMATION_PROGRAMS_H')
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compile .anim files to keyframe bytecode')
+    parser.add_argument('inputs', nargs='+', help='.anim source files')
+    parser.add_argument('-o', '--output', help='C++ header to write')
+    parser.add_argument('--bin', metavar='DIR', help='also write one raw .bin per program into DIR')
+    args = parser.parse_args()
+
+    programs = []
+    sources = []
+    for path in sorted(args.inputs):
+        with open(path, 'r') as f:
+            text = f.read()
+        try:
+            program = parse(text, path)
+        except CompileError as e:
+            print(f"{path}: {e}", file=sys.stderr)
+            return 1
+        programs.append(program)
+        sources.append(os.path.basename(path))
+        print(f"{path}: {program.name} -> {len(program.encode())} bytes")
+
+    if args.output:
+        with open(args.output, 'w', newline='\n') as f:
+            f.write(to_header(programs, sources))
+        print(f"Wrote {args.output}")
+
+    if args.bin:
+        os.makedirs(args.bin, exist_ok=True)
+        for program in programs:
+            path = os.path.join(args.bin, program.name + '.bin')
+            with open(path, 'wb') as f:
+                f.write(program.encode())
+            print(f"Wrote {path}")
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,322 @@
+#!/usr/bin/env python3
+"""
+Frame clip encoder for the PrismaTech Gauntlet.
+
+Encodes pre-baked LED frame sequences into the delta/run-length format
+decoded by FrameDecoder (src/animation/FrameCodec.h) and writes them either
+as a C++ header of flash-resident arrays or as raw binary blobs. Every clip
+is decoded again after encoding and compared with its input.
+
+Input formats:
+
+    .csv  one frame per line, one RRGGBB hex value per LED separated by
+          spaces or commas ('#' starts a comment)
+    .rgb  raw frames, ledCount * 3 bytes each (requires --leds)
+
+Palette mode stores each LED as a one-byte index into a table of up to
+255 colors. With --palette auto it is used whenever the clip has few
+enough colors and comes out smaller.
+
+Usage:
+    python utils/frame_codec.py clip.csv -o src/animation/FrameClips.h
+    python utils/frame_codec.py render.rgb --leds 12 --frame-ms 20 --bin out/
+    python utils/frame_codec.py test/codec/sample_*.csv --frame-ms 50 --reference -o test/codec/SampleClips.h
+"""
+import argparse
+import os
+import struct
+import sys
+
+VERSION = 1
+FLAG_PALETTE = 0x01
+HEADER_SIZE = 10
+OP_SKIP = 0x00
+OP_LITERAL = 0x40
+OP_FILL = 0x80
+OP_MASK = 0xC0
+MAX_RUN = 64
+MAX_PALETTE = 255
+
+
+class CodecError(Exception):
+    pass
+
+
+def _encode_frame(prev, cur, value_size, value_bytes):
+    """Encode one frame with the cheapest run split (dynamic programming).
+
+    prev/cur are lists of per-LED values (RGB tuples or palette indices);
+    value_bytes(prev_value, value) returns the stored bytes of a literal.
+    """
+    n = len(cur)
+    cost = [0] + [None] * n
+    choice = [None] * (n + 1)
+
+    for end in range(1, n + 1):
+        best = None
+        unchanged = True
+        uniform = True
+        for length in range(1, min(MAX_RUN, end) + 1):
+            start = end - length
+            unchanged = unchanged and prev[start] == cur[start]
+            uniform = uniform and cur[start] == cur[end - 1]
+            options = [(OP_LITERAL, 1 + value_size * length)]
+            if uniform:
+                options.append((OP_FILL, 1 + value_size))
+            if unchanged:
+                options.append((OP_SKIP, 1))
+            for op, op_cost in options:
+                total = cost[start] + op_cost
+                if best is None or total < best[0]:
+                    best = (total, op, start)
+        cost[end], op, start = best
+        choice[end] = (op, start)
+
+    ops = []
+    end = n
+    while end > 0:
+        op, start = choice[end]
+        ops.append((op, start, end))
+        end = start
+    ops.reverse()
+
+    out = bytearray()
+    for op, start, end in ops:
+        out.append(op | (end - start - 1))
+        if op == OP_FILL:
+            out += value_bytes(None, cur[start])
+        elif op == OP_LITERAL:
+            for i in range(start, end):
+                out += value_bytes(prev[i], cur[i])
+    return bytes(out)
+
+
+def encode(frames, frame_ms, palette='auto'):
+    """Encode a list of frames (lists of (r, g, b)) into a clip."""
+    if not frames:
+        raise CodecError("clip has no frames")
+    leds = len(frames[0])
+    if any(len(f) != leds for f in frames):
+        raise CodecError("all frames must have the same number of LEDs")
+    if not 1 <= frame_ms <= 255:
+        raise CodecError(f"frame period {frame_ms} ms out of range 1..255")
+    if len(frames) > 0xFFFF or leds > 0xFFFF:
+        raise CodecError("too many frames or LEDs")
+
+    def rgb_clip():
+        header = struct.pack('<BBBBHHBB', ord('F'), ord('C'), VERSION, 0, leds, len(frames), frame_ms, 0)
+        body = bytearray(header)
+        prev = [(0, 0, 0)] * leds
+
+        def xor_bytes(p, v):
+            if p is None:
+                return bytes(v)
+            return bytes(a ^ b for a, b in zip(p, v))
+
+        for frame in frames:
+            body += _encode_frame(prev, frame, 3, xor_bytes)
+            prev = frame
+        return bytes(body)
+
+    def palette_clip():
+        colors = sorted({c for frame in frames for c in frame})
+        if len(colors) > MAX_PALETTE:
+            return None
+        index = {c: i for i, c in enumerate(colors)}
+        header = struct.pack('<BBBBHHBB', ord('F'), ord('C'), VERSION, FLAG_PALETTE,
+                             leds, len(frames), frame_ms, len(colors))
+        body = bytearray(header)
+        for c in colors:
+            body += bytes(c)
+        # Before the first frame every LED is black, which may not be in the palette
+        prev = [None] * leds
+        for frame in frames:
+            cur = [index[c] for c in frame]
+            body += _encode_frame(prev, cur, 1, lambda p, v: bytes([v]))
+            prev = cur
+        return bytes(body)
+
+    if palette == 'off':
+        return rgb_clip()
+    indexed = palette_clip()
+    if palette == 'on':
+        if indexed is None:
+            raise CodecError(f"clip has more than {MAX_PALETTE} colors; palette mode impossible")
+        return indexed
+    rgb = rgb_clip()
+    return indexed if indexed is not None and len(indexed) < len(rgb) else rgb
+
+
+def decode(blob):
+    """Decode a clip back into (frames, frame_ms); mirrors FrameDecoder."""
+    if len(blob) < HEADER_SIZE or blob[0:2] != b'FC' or blob[2] != VERSION:
+        raise CodecError("not a frame clip")
+    _, _, _, flags, leds, count, frame_ms, palette_size = struct.unpack('<BBBBHHBB', blob[:HEADER_SIZE])
+    pos = HEADER_SIZE
+    palette = None
+    if flags & FLAG_PALETTE:
+        palette = [tuple(blob[pos + 3 * i:pos + 3 * i + 3]) for i in range(palette_size)]
+        pos += 3 * palette_size
+
+    frame = [(0, 0, 0)] * leds
+    frames = []
+    for _ in range(count):
+        frame = list(frame)
+        led = 0
+        while led < leds:
+            op = blob[pos] & OP_MASK
+            run = (blob[pos] & ~OP_MASK & 0xFF) + 1
+            pos += 1
+            if led + run > leds:
+                raise CodecError("run crosses the end of a frame")
+            if op == OP_SKIP:
+                pass
+            elif op == OP_FILL:
+                if palette:
+                    value = palette[blob[pos]]
+                    pos += 1
+                else:
+                    value = tuple(blob[pos:pos + 3])
+                    pos += 3
+                for i in range(led, led + run):
+                    frame[i] = value
+            elif op == OP_LITERAL:
+                for i in range(led, led + run):
+                    if palette:
+                        frame[i] = palette[blob[pos]]
+                        pos += 1
+                    else:
+                        frame[i] = tuple(a ^ b for a, b in zip(frame[i], blob[pos:pos + 3]))
+                        pos += 3
+            else:
+                raise CodecError(f"bad opcode 0x{blob[pos - 1]:02X}")
+            led += run
+        frames.append(frame)
+    if pos != len(blob):
+        raise CodecError("trailing bytes after the last frame")
+    return frames, frame_ms
+
+
+def read_csv(path):
+    frames = []
+    with open(path, 'r') as f:
+        for line_no, raw in enumerate(f, 1):
+            line = raw.split('#', 1)[0].replace(',', ' ').strip()
+            if not line:
+                continue
+            try:
+                frame = [tuple(bytes.fromhex(tok)) for tok in line.split()]
+            except ValueError:
+                raise CodecError(f"{path} line {line_no}: expected RRGGBB hex values")
+            if any(len(c) != 3 for c in frame):
+                raise CodecError(f"{path} line {line_no}: expected RRGGBB hex values")
+            frames.append(frame)
+    return frames
+
+
+def read_raw(path, leds):
+    if not leds:
+        raise CodecError(f"{path}: --leds is required for raw input")
+    with open(path, 'rb') as f:
+        data = f.read()
+    size = leds * 3
+    if len(data) % size:
+        raise CodecError(f"{path}: {len(data)} bytes is not a whole number of {leds}-LED frames")
+    return [[tuple(data[i + 3 * k:i + 3 * k + 3]) for k in range(leds)]
+            for i in range(0, len(data), size)]
+
+
+def _array(lines, decl, data):
+    lines.append(f'{decl} = {{')
+    for i in range(0, len(data), 16):
+        lines.append('  ' + ', '.join(f'0x{b:02X}' for b in data[i:i + 16]) + ',')
+    lines.append('};')
+
+
+def to_header(clips, sources, reference):
+    lines = [
+        '#ifndef FRAME_CLIPS_H',
+        '#define FRAME_CLIPS_H',
+        '',
+        '#include <Arduino.h>',
+        '',
+        '/**',
+        ' * @brief Compressed frame clips',
+        ' *',
+        ' * GENERATED by utils/frame_codec.py - do not edit by hand.',
+        ' * Sources: ' + ', '.join(sources),
+        ' */',
+        '',
+    ]
+    for name, frames, frame_ms, blob in clips:
+        ident = 'CLIP_' + name.upper()
+        mode = 'palette' if blob[3] & FLAG_PALETTE else 'rgb'
+        lines.append(f'// {name}: {len(frames)} frames x {len(frames[0])} LEDs, {frame_ms} ms/frame, '
+                     f'{mode}, {len(blob)} bytes')
+        _array(lines, f'const PROGMEM uint8_t {ident}[]', blob)
+        lines.append(f'constexpr uint32_t {ident}_SIZE = sizeof({ident});')
+        if reference:
+            raw = bytes(v for frame in frames for c in frame for v in c)
+            lines.append('')
+            lines.append(f'// Uncompressed frames of {name} for round-trip tests')
+            _array(lines, f'const PROGMEM uint8_t {ident}_REFERENCE[]', raw)
+        lines.append('')
+    lines.append('#endif // FRAME_CLIPS_H')
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Encode LED frame sequences into compressed clips')
+    parser.add_argument('inputs', nargs='+', help='.csv or .rgb frame files')
+    parser.add_argument('--leds', type=int, help='LEDs per frame for .rgb input')
+    parser.add_argument('--frame-ms', type=int, default=20, help='frame period in ms (default 20 = 50 fps)')
+    parser.add_argument('--palette', choices=('auto', 'on', 'off'), default='auto')
+    parser.add_argument('-o', '--output', help='C++ header to write')
+    parser.add_argument('--bin', metavar='DIR', help='also write one raw .bin per clip into DIR')
+    parser.add_argument('--reference', action='store_true',
+                        help='also emit the uncompressed frames into the header')
+    args = parser.parse_args()
+
+    clips = []
+    sources = []
+    for path in sorted(args.inputs):
+        name = os.path.splitext(os.path.basename(path))[0]
+        try:
+            if path.endswith('.rgb'):
+                frames = read_raw(path, args.leds)
+            else:
+                frames = read_csv(path)
+            blob = encode(frames, args.frame_ms, args.palette)
+            decoded, _ = decode(blob)
+        except CodecError as e:
+            print(f"{path}: {e}", file=sys.stderr)
+            return 1
+        if decoded != frames:
+            print(f"{path}: round trip mismatch", file=sys.stderr)
+            return 1
+
+        # Uncompressed baseline: AnimationFrame layout, RGB per LED plus a duration byte
+        raw_size = len(frames) * (len(frames[0]) * 3 + 1)
+        print(f"{path}: {len(frames)} frames -> {len(blob)} bytes "
+              f"({raw_size / len(blob):.1f}x vs {raw_size} bytes of AnimationFrame)")
+        clips.append((name, frames, args.frame_ms, blob))
+        sources.append(os.path.basename(path))
+
+    if args.output:
+        with open(args.output, 'w', newline='\n') as f:
+            f.write(to_header(clips, sources, args.reference))
+        print(f"Wrote {args.output}")
+
+    if args.bin:
+        os.makedirs(args.bin, exist_ok=True)
+        for name, _, _, blob in clips:
+            path = os.path.join(args.bin, name + '.bin')
+            with open(path, 'wb') as f:
+                f.write(blob)
+            print(f"Wrote {path}")
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""
+Static RAM summary of the PrismaTech Gauntlet firmware, per subsystem.
+
+Reads the GNU ld map file the esp32dev build writes
+(.pio/build/esp32dev/firmware.map) and sums the RAM each object file takes:
+initialized data, zeroed bss (and .noinit), RTC memory and IRAM. Objects
+are grouped by where they come from: the firmware's src/<dir> directories,
+main, the Arduino core, each library and each ESP-IDF component archive.
+Groups smaller than --min-bytes are folded into "other".
+
+Usage:
+    python utils/ram_map.py .pio/build/esp32dev/firmware.map
+    python utils/ram_map.py .pio/build/esp32dev/firmware.map -o src/diagnostics/MemoryMap.h
+    python utils/ram_map.py .pio/build/esp32dev/firmware.map --check -o src/diagnostics/MemoryMap.h
+
+The header is what 'dump memory' prints on the device. The esp32dev and
+lutt_debug builds regenerate it after every link (utils/ram_map_build.py);
+it describes the build it was made from.
+"""
+import argparse
+import os
+import re
+import sys
+
+KINDS = ('data', 'bss', 'rtc', 'iram')
+
+# Input section: " .name  0xADDR  0xSIZE  file", the name may sit on a line of its own
+INPUT_SECTION = re.compile(r'^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$')
+OUTPUT_SECTION = re.compile(r'^(\.\S+)(?:\s+0x[0-9a-fA-F]+\s+0x[0-9a-fA-F]+)?')
+ARCHIVE = re.compile(r'(?:^|[\\/])lib([^\\/()]+)\.a\(')
+SOURCE_DIR = re.compile(r'(?:^|[\\/])src[\\/](?:(\w+)[\\/])?[^\\/]+\.o$')
+
+
+class MapError(Exception):
+    pass
+
+
+def kind_of(section):
+    """RAM kind of an output section, or None for flash and debug sections."""
+    name = section.lower()
+    if 'rodata' in name or name.startswith('.debug') or name.startswith('.comment'):
+        return None
+    if 'rtc' in name:
+        return 'rtc'
+    if 'iram' in name:
+        return 'iram'
+    if 'bss' in name or 'noinit' in name:
+        return 'bss'
+    if 'data' in name:
+        return 'data'
+    return None
+
+
+def group_of(path):
+    """Subsystem an object file belongs to."""
+    match = ARCHIVE.search(path)
+    if match:
+        name = match.group(1)
+        return 'arduino' if name == 'FrameworkArduino' else name
+    match = SOURCE_DIR.search(path)
+    if match:
+        return match.group(1) or 'main'
+    return os.path.splitext(os.path.basename(path))[0]
+
+
+def parse(text):
+    """{group: {kind: bytes}} for the RAM sections of a map file."""
+    start = text.find('Linker script and memory map')
+    if start < 0:
+        raise MapError('not a GNU ld map file')
+    groups = {}
+    kind = None
+    pending = None
+    for line in text[start:].splitlines():
+        if line and not line[0].isspace():
+            match = OUTPUT_SECTION.match(line)
+            kind = kind_of(match.group(1)) if match else None
+            pending = None
+            continue
+        if kind is None:
+            continue
+        match = INPUT_SECTION.match(line)
+        if not match:
+            # A long input section name wraps its address, size and file to the next line
+            stripped = line.strip()
+            pending = stripped if line.startswith(' ') and not line.startswith('  ') and stripped else None
+            continue
+        name = match.group(1) or pending
+        pending = None
+        if not name or name == '*fill*':
+            continue
+        size = int(match.group(3), 16)
+        if size == 0:
+            continue
+        sizes = groups.setdefault(group_of(match.group(4).strip()), dict.fromkeys(KINDS, 0))
+        sizes[kind] += size
+    return groups
+
+
+def fold(groups, min_bytes):
+    """Groups sorted by total size, the small ones folded into 'other'."""
+    rows = []
+    other = dict.fromkeys(KINDS, 0)
+    for name, sizes in groups.items():
+        if sum(sizes.values()) >= min_bytes:
+            rows.append((name, sizes))
+        else:
+            for k in KINDS:
+                other[k] += sizes[k]
+    rows.sort(key=lambda row: (-sum(row[1].values()), row[0]))
+    if sum(other.values()):
+        rows.append(('other', other))
+    return rows
+
+
+def to_header(rows, source):
+    lines = [
+        '#ifndef MEMORY_MAP_H',
+        '#define MEMORY_MAP_H',
+        '',
+        '#include <stdint.h>',
+        '',
+        '/**',
+        ' * @brief Static RAM per subsystem, from the firmware\'s linker map',
+        ' *',
+        ' * GENERATED by utils/ram_map.py - do not edit by hand.',
+        f' * Source: {source}; sorted by total size.',
+        ' */',
+        'struct MemoryMapEntry {',
+        '  const char* name;',
+        '  uint32_t data;             // Initialized DRAM',
+        '  uint32_t bss;              // Zeroed DRAM and .noinit',
+        '  uint32_t rtc;              // RTC fast and slow memory',
+        '  uint32_t iram;             // Code and data in IRAM',
+        '};',
+        '',
+        'const MemoryMapEntry MEMORY_MAP[] = {',
+    ]
+    for name, sizes in rows:
+        lines.append(f'  {{"{name}", {sizes["data"]}, {sizes["bss"]}, {sizes["rtc"]}, {sizes["iram"]}}},')
+    if not rows:
+        lines.append('  {"", 0, 0, 0, 0},')
+    lines += [
+        '};',
+        '',
+        f'const uint8_t MEMORY_MAP_COUNT = {len(rows)};',
+        '',
+        '#endif // MEMORY_MAP_H',
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def write_header(header, output):
+    """Write the header unless it is already current, so sources including it do not rebuild."""
+    try:
+        with open(output, 'r') as f:
+            if f.read() == header:
+                return False
+    except OSError:
+        pass
+    with open(output, 'w', newline='\n') as f:
+        f.write(header)
+    return True
+
+
+def update_header(map_path, output, min_bytes=256):
+    """Regenerate the header from a map file; returns (rows, changed)."""
+    with open(map_path, 'r', errors='replace') as f:
+        rows = fold(parse(f.read()), min_bytes)
+    return rows, write_header(to_header(rows, os.path.basename(map_path)), output)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Static RAM per subsystem from a GNU ld map file')
+    parser.add_argument('map', help='linker map file (firmware.map)')
+    parser.add_argument('-o', '--output', help='C++ header to write')
+    parser.add_argument('--check', action='store_true', help='fail if the header is out of date')
+    parser.add_argument('--min-bytes', type=int, default=256, help='fold smaller groups into "other"')
+    args = parser.parse_args()
+
+    try:
+        with open(args.map, 'r', errors='replace') as f:
+            rows = fold(parse(f.read()), args.min_bytes)
+    except (OSError, MapError) as e:
+        print(f"error: {e}", file=sys.stderr)
+        return 1
+
+    if not args.output:
+        print(f"{'group':<24}{'data':>9}{'bss':>9}{'rtc':>9}{'iram':>9}{'total':>9}")
+        for name, sizes in rows:
+            values = ''.join(f'{sizes[k]:>9}' for k in KINDS)
+            print(f"{name:<24}{values}{sum(sizes.values()):>9}")
+        totals = ''.join(f'{sum(s[k] for _, s in rows):>9}' for k in KINDS)
+        print(f"{'total':<24}{totals}{sum(sum(s.values()) for _, s in rows):>9}")
+        return 0
+
+    header = to_header(rows, os.path.basename(args.map))
+    if args.check:
+        with open(args.output, 'r') as f:
+            if f.read() != header:
+                print(f"{args.output} is out of date; run utils/ram_map.py", file=sys.stderr)
+                return 1
+        print(f"{args.output}: {len(rows)} groups, up to date")
+        return 0
+    changed = write_header(header, args.output)
+    print(f"{'Wrote' if changed else 'Kept'} {args.output} ({len(rows)} groups)")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
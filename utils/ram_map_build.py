@@ -0,0 +1,33 @@
+"""
+PlatformIO post-build step: regenerate src/diagnostics/MemoryMap.h from the
+linker map of the build that just finished.
+
+Used as 'extra_scripts = post:utils/ram_map_build.py' by the envs that link
+with -Wl,-Map,${BUILD_DIR}/firmware.map. The table holds only const data in
+flash, so regenerating it does not move static RAM: when the header changes,
+the next build picks it up and then describes itself exactly.
+"""
+import os
+import sys
+
+Import("env")  # noqa: F821 - provided by PlatformIO's SCons environment
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "utils"))  # noqa: F821
+import ram_map  # noqa: E402
+
+
+def regenerate(source, target, env):
+    map_path = os.path.join(env.subst("$BUILD_DIR"), "firmware.map")
+    output = os.path.join(env.subst("$PROJECT_SRC_DIR"), "diagnostics", "MemoryMap.h")
+    try:
+        rows, changed = ram_map.update_header(map_path, output)
+    except (OSError, ram_map.MapError) as e:
+        print(f"ram_map: {e}; MemoryMap.h left as it was")
+        return
+    if changed:
+        print(f"ram_map: updated MemoryMap.h ({len(rows)} groups); rebuild to include it")
+    else:
+        print(f"ram_map: MemoryMap.h up to date ({len(rows)} groups)")
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", regenerate)  # noqa: F821
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+State snapshot decoder for the PrismaTech Gauntlet.
+
+StateSnapshotCapture keeps the last snapshots as binary records on the
+device. The 'snapshot dump' CLI command writes them out; this tool turns
+the captured bytes into JSON or CSV.
+
+Usage:
+    python utils/snapshot_tool.py snapshots.bin
+    python utils/snapshot_tool.py snapshots.bin --csv -o snapshots.csv
+
+Binary dump (little-endian, see StateSnapshotCapture::dumpBinary):
+    header: 'DSNP', u16 version, u16 snapshot count, u16 string count
+    string: u8 length, bytes, once per distinct string
+    record: u32 time (ms), u32 sequence, u16 context string, u8 trigger, u8 field count
+    field:  u16 name string, u8 type, u8 0, u32 value (string index for strings)
+"""
+import argparse
+import csv
+import json
+import struct
+import sys
+
+DUMP_MAGIC = b'DSNP'
+DUMP_VERSION = 1
+
+# SNAPSHOT_TRIGGER_* in src/diagnostics/StateSnapshotCapture.h
+TRIGGERS = {
+    0x01: 'GESTURE_START',
+    0x02: 'GESTURE_END',
+    0x04: 'MODE_CHANGE',
+    0x08: 'ANIMATION',
+    0x10: 'FREECAST',
+    0x20: 'ERROR',
+    0x40: 'TEST',
+}
+
+FIELD_INT, FIELD_FLOAT, FIELD_STRING, FIELD_BOOL = range(4)
+
+
+class SnapshotError(Exception):
+    pass
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def take(self, fmt):
+        size = struct.calcsize(fmt)
+        if self.offset + size > len(self.data):
+            raise SnapshotError('dump truncated')
+        values = struct.unpack_from(fmt, self.data, self.offset)
+        self.offset += size
+        return values
+
+    def bytes(self, size):
+        if self.offset + size > len(self.data):
+            raise SnapshotError('dump truncated')
+        value = self.data[self.offset:self.offset + size]
+        self.offset += size
+        return value
+
+
+def decode(data):
+    """List of snapshots, oldest first, from a binary dump."""
+    start = data.find(DUMP_MAGIC)
+    if start < 0:
+        raise SnapshotError('not a snapshot dump (no DSNP header)')
+    reader = Reader(data[start + 4:])
+    version, count, string_count = reader.take('<HHH')
+    if version != DUMP_VERSION:
+        raise SnapshotError(f'unsupported dump version {version}')
+
+    strings = []
+    for _ in range(string_count):
+        (length,) = reader.take('<B')
+        strings.append(reader.bytes(length).decode('latin-1'))
+
+    def string(index):
+        if index >= len(strings):
+            raise SnapshotError(f'string index {index} out of range')
+        return strings[index]
+
+    snapshots = []
+    for _ in range(count):
+        time_ms, sequence, context, trigger, field_count = reader.take('<IIHBB')
+        fields = []
+        for _ in range(field_count):
+            name, kind, _, word = reader.take('<HBBI')
+            if kind == FIELD_INT:
+                value = struct.unpack('<i', struct.pack('<I', word))[0]
+            elif kind == FIELD_FLOAT:
+                value = round(struct.unpack('<f', struct.pack('<I', word))[0], 6)
+            elif kind == FIELD_STRING:
+                value = string(word)
+            elif kind == FIELD_BOOL:
+                value = bool(word)
+            else:
+                raise SnapshotError(f'unknown field type {kind}')
+            fields.append((string(name), value))
+        snapshots.append({
+            'sequence': sequence,
+            'time_ms': time_ms,
+            'trigger': TRIGGERS.get(trigger, f'0x{trigger:02X}'),
+            'context': string(context),
+            'fields': fields,
+        })
+    return snapshots
+
+
+def write_json(snapshots, out):
+    # Fields keep their capture order; a repeated name keeps its last value
+    documents = [dict(s, fields=dict(s['fields'])) for s in snapshots]
+    json.dump(documents, out, indent=2)
+    out.write('\n')
+
+
+def write_csv(snapshots, out):
+    """One row per field, so snapshots with different fields share a schema."""
+    writer = csv.writer(out, lineterminator='\n')
+    writer.writerow(['sequence', 'time_ms', 'trigger', 'context', 'field', 'value'])
+    for s in snapshots:
+        for name, value in s['fields'] or [('', '')]:
+            if isinstance(value, bool):
+                value = 'true' if value else 'false'
+            writer.writerow([s['sequence'], s['time_ms'], s['trigger'], s['context'], name, value])
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode a binary state snapshot dump')
+    parser.add_argument('dump', help='file captured from the snapshot dump command')
+    parser.add_argument('--csv', action='store_true', help='write CSV instead of JSON')
+    parser.add_argument('-o', '--output', help='output file (default: stdout)')
+    args = parser.parse_args()
+
+    try:
+        with open(args.dump, 'rb') as f:
+            snapshots = decode(f.read())
+    except SnapshotError as e:
+        print(f'error: {e}', file=sys.stderr)
+        return 1
+
+    out = open(args.output, 'w', newline='') if args.output else sys.stdout
+    try:
+        (write_csv if args.csv else write_json)(snapshots, out)
+    finally:
+        if args.output:
+            out.close()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
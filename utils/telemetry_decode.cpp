@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "../src/core/SystemTypes.h"
+#include "../src/diagnostics/TelemetryFrame.h"
+
+/**
+ * @brief Host decoder for the binary telemetry stream ('telemetry start' CLI command)
+ *
+ *   telemetry_decode <capture.bin|-> [--csv FILE] [--columns DIR] [--memory FILE]
+ *
+ * Reads a raw serial capture, checks every COBS frame's CRC and writes the
+ * samples as CSV (stdout by default) and/or as one little-endian binary file
+ * per column in DIR, described by DIR/schema.txt (name, type, count; e.g.
+ * numpy.fromfile(DIR + "/accel_x.bin", dtype="<i2")). Text and damaged
+ * frames in the capture are skipped and counted; sequence gaps show samples
+ * the device dropped. --memory writes the heap and stack reports sent with
+ * each header as CSV, stamped with the time of the sample before them.
+ * Build with: pio run -e telemetrydecode
+ */
+
+static const char* POSITION_NAMES[] = {"OFFER", "CALM", "OATH", "DIG", "SHIELD", "NULL", "UNKNOWN"};
+
+struct Columns {
+    std::vector<uint64_t> timeUs;     // Unwrapped across micros() overflow
+    std::vector<uint16_t> sequence;
+    std::vector<int16_t> raw[6];
+    std::vector<float> filtered[3];
+    std::vector<uint8_t> position;
+    std::vector<uint8_t> confidence;
+
+    size_t size() const { return sequence.size(); }
+};
+
+struct MemoryRow {
+    uint64_t timeUs;                  // Of the latest sample
+    MemoryStats stats;
+};
+
+struct Stats {
+    unsigned long badFrames = 0;      // COBS, CRC or layout errors
+    unsigned long headers = 0;
+    unsigned long droppedSamples = 0; // From sequence gaps
+    TelemetryHeader header = {0, 0, 0.0f};
+    std::vector<MemoryRow> memory;
+};
+
+static const char* RAW_NAMES[6] = {"accel_x", "accel_y", "accel_z", "gyro_x", "gyro_y", "gyro_z"};
+static const char* FILTERED_NAMES[3] = {"filtered_x", "filtered_y", "filtered_z"};
+
+static void usage() {
+    fprintf(stderr, "usage: telemetry_decode <capture.bin|-> [--csv FILE] [--columns DIR] [--memory FILE]\n");
+}
+
+static void addSample(const TelemetrySample& sample, Columns& columns, Stats& stats) {
+    if (columns.size() > 0) {
+        uint16_t expected = (uint16_t)(columns.sequence.back() + 1);
+        stats.droppedSamples += (uint16_t)(sample.sequence - expected);
+    }
+    uint64_t time = sample.timeUs;
+    if (columns.size() > 0) {
+        uint64_t last = columns.timeUs.back();
+        time = last + (uint32_t)(sample.timeUs - (uint32_t)last);
+    }
+    columns.timeUs.push_back(time);
+    columns.sequence.push_back(sample.sequence);
+    for (int i = 0; i < 6; i++) columns.raw[i].push_back(sample.raw[i]);
+    for (int i = 0; i < 3; i++) columns.filtered[i].push_back(sample.filtered[i]);
+    columns.position.push_back(sample.position);
+    columns.confidence.push_back(sample.confidence);
+}
+
+static void handleBlock(const uint8_t* block, size_t length, Columns& columns, Stats& stats) {
+    uint8_t payload[TelemetryFrame::MAX_FRAME_SIZE];
+    size_t payloadLength = TelemetryFrame::decodeFrame(block, length, payload);
+    TelemetrySample sample;
+    TelemetryHeader header;
+    MemoryRow memory;
+    if (payloadLength && TelemetryFrame::parseSample(payload, payloadLength, sample)) {
+        addSample(sample, columns, stats);
+    } else if (payloadLength && TelemetryFrame::parseHeader(payload, payloadLength, header)) {
+        stats.headers++;
+        stats.header = header;
+    } else if (payloadLength && TelemetryFrame::parseMemory(payload, payloadLength, memory.stats)) {
+        memory.timeUs = columns.size() > 0 ? columns.timeUs.back() : 0;
+        stats.memory.push_back(memory);
+    } else {
+        stats.badFrames++;
+    }
+}
+
+static bool decodeCapture(FILE* in, Columns& columns, Stats& stats) {
+    uint8_t block[TelemetryFrame::MAX_FRAME_SIZE];
+    size_t length = 0;
+    bool overflow = false;
+    int c;
+    while ((c = fgetc(in)) != EOF) {
+        if (c != 0) {
+            if (length < sizeof(block)) {
+                block[length++] = (uint8_t)c;
+            } else {
+                overflow = true;
+            }
+            continue;
+        }
+        // Longer runs than any frame are console text, not a damaged frame
+        if (length > 0 && !overflow) {
+            handleBlock(block, length, columns, stats);
+        }
+        length = 0;
+        overflow = false;
+    }
+    return !ferror(in);
+}
+
+static bool writeCsv(const Columns& columns, const char* path) {
+    FILE* out = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (!out) {
+        return false;
+    }
+    fprintf(out, "time_us,sequence");
+    for (int i = 0; i < 6; i++) fprintf(out, ",%s", RAW_NAMES[i]);
+    for (int i = 0; i < 3; i++) fprintf(out, ",%s", FILTERED_NAMES[i]);
+    fprintf(out, ",position,confidence\n");
+    for (size_t row = 0; row < columns.size(); row++) {
+        fprintf(out, "%llu,%u", (unsigned long long)columns.timeUs[row], columns.sequence[row]);
+        for (int i = 0; i < 6; i++) fprintf(out, ",%d", columns.raw[i][row]);
+        for (int i = 0; i < 3; i++) fprintf(out, ",%.2f", columns.filtered[i][row]);
+        uint8_t position = columns.position[row];
+        fprintf(out, ",%s,%u\n", position <= POS_UNKNOWN ? POSITION_NAMES[position] : "?", columns.confidence[row]);
+    }
+    return out == stdout || fclose(out) == 0;
+}
+
+static bool writeMemory(const Stats& stats, const char* path) {
+    FILE* out = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if (!out) {
+        return false;
+    }
+    fprintf(out, "time_us,heap_used,heap_free,heap_largest_block,heap_min_free,loop_stack_free,allocations,frees\n");
+    for (size_t row = 0; row < stats.memory.size(); row++) {
+        const MemoryStats& m = stats.memory[row].stats;
+        fprintf(out, "%llu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", (unsigned long long)stats.memory[row].timeUs,
+                (unsigned long)m.heapUsed, (unsigned long)m.heapFree, (unsigned long)m.heapLargestBlock,
+                (unsigned long)m.heapMinFree, (unsigned long)m.loopStackFree, (unsigned long)m.allocations,
+                (unsigned long)m.frees);
+    }
+    return out == stdout || fclose(out) == 0;
+}
+
+template<typename T>
+static bool writeColumn(const std::string& dir, const char* name, const char* type,
+                        const std::vector<T>& values, FILE* schema) {
+    std::string path = dir + "/" + name + ".bin";
+    FILE* out = fopen(path.c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+    // The host is little-endian like the device; columns are written as they sit in memory
+    bool ok = values.empty() || fwrite(&values[0], sizeof(T), values.size(), out) == values.size();
+    ok = fclose(out) == 0 && ok;
+    fprintf(schema, "%s %s %u\n", name, type, (unsigned)values.size());
+    return ok;
+}
+
+static bool writeColumns(const Columns& columns, const Stats& stats, const char* dir) {
+    std::string base(dir);
+    FILE* schema = fopen((base + "/schema.txt").c_str(), "w");
+    if (!schema) {
+        return false;
+    }
+    fprintf(schema, "# rate_hz %u baud %lu scaling_factor %.10g\n", stats.header.rateHz,
+            (unsigned long)stats.header.baud, stats.header.scalingFactor);
+    bool ok = writeColumn(base, "time_us", "u64", columns.timeUs, schema) &&
+              writeColumn(base, "sequence", "u16", columns.sequence, schema);
+    for (int i = 0; i < 6 && ok; i++) ok = writeColumn(base, RAW_NAMES[i], "i16", columns.raw[i], schema);
+    for (int i = 0; i < 3 && ok; i++) ok = writeColumn(base, FILTERED_NAMES[i], "f32", columns.filtered[i], schema);
+    ok = ok && writeColumn(base, "position", "u8", columns.position, schema) &&
+         writeColumn(base, "confidence", "u8", columns.confidence, schema);
+    return fclose(schema) == 0 && ok;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    const char* csvPath = nullptr;
+    const char* columnsDir = nullptr;
+    const char* memoryPath = nullptr;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--csv") == 0) csvPath = argv[i + 1];
+        else if (strcmp(argv[i], "--columns") == 0) columnsDir = argv[i + 1];
+        else if (strcmp(argv[i], "--memory") == 0) memoryPath = argv[i + 1];
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (!csvPath && !columnsDir && !memoryPath) {
+        csvPath = "-";
+    }
+
+    FILE* in = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    Columns columns;
+    Stats stats;
+    bool read = decodeCapture(in, columns, stats);
+    if (in != stdin) {
+        fclose(in);
+    }
+    if (!read) {
+        fprintf(stderr, "error reading %s\n", argv[1]);
+        return 1;
+    }
+
+    if (csvPath && !writeCsv(columns, csvPath)) {
+        fprintf(stderr, "cannot write %s\n", csvPath);
+        return 1;
+    }
+    if (columnsDir && !writeColumns(columns, stats, columnsDir)) {
+        fprintf(stderr, "cannot write columns to %s\n", columnsDir);
+        return 1;
+    }
+    if (memoryPath && !writeMemory(stats, memoryPath)) {
+        fprintf(stderr, "cannot write %s\n", memoryPath);
+        return 1;
+    }
+
+    double seconds = columns.size() > 1 ? (columns.timeUs.back() - columns.timeUs.front()) / 1e6 : 0.0;
+    fprintf(stderr, "%u samples, %lu headers, %lu bad frames, %lu samples dropped on the device",
+            (unsigned)columns.size(), stats.headers, stats.badFrames, stats.droppedSamples);
+    if (seconds > 0.0) {
+        fprintf(stderr, ", %.1f Hz over %.1f s", (columns.size() - 1) / seconds, seconds);
+    }
+    if (stats.headers) {
+        fprintf(stderr, " (stream set to %u Hz at %lu baud)", stats.header.rateHz, (unsigned long)stats.header.baud);
+    }
+    fprintf(stderr, "\n");
+    if (!stats.memory.empty()) {
+        const MemoryStats& first = stats.memory.front().stats;
+        const MemoryStats& last = stats.memory.back().stats;
+        fprintf(stderr, "heap: %lu bytes used, %lu free (lowest %lu, largest block %lu), loop stack %lu bytes spare, "
+                "%lu allocations during the capture\n",
+                (unsigned long)last.heapUsed, (unsigned long)last.heapFree, (unsigned long)last.heapMinFree,
+                (unsigned long)last.heapLargestBlock, (unsigned long)last.loopStackFree,
+                (unsigned long)(last.allocations - first.allocations));
+    }
+    return 0;
+}
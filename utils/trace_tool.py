@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+"""
+Trace string table generator and decoder for the PrismaTech Gauntlet.
+
+Log sites (DIAG_LOG and the DIAG_<LEVEL> macros in
+src/diagnostics/DiagnosticLogger.h) record only the FNV-1a hash of their
+format string plus raw arguments into TraceBuffer. This tool scans the
+sources for those format strings and either writes the string table the
+firmware uses to format entries when it drains the ring, or formats a
+binary dump captured from the device ('trace dump' CLI command).
+
+Usage:
+    python utils/trace_tool.py table -o src/diagnostics/TraceStrings.h
+    python utils/trace_tool.py table --check -o src/diagnostics/TraceStrings.h
+    python utils/trace_tool.py decode trace.bin
+
+Binary dump (little-endian):
+    header: 'DTRC', u16 version, u16 entry count, u32 dropped entries
+    entry:  u32 timestamp (us), u32 id, u8 level, u8 tag, u8 arg count, u8 0,
+            u32 argument x arg count
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+
+DUMP_MAGIC = b'DTRC'
+DUMP_VERSION = 1
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_SOURCES = os.path.join(ROOT, 'src')
+LOGGER_HEADER = os.path.join(ROOT, 'src', 'diagnostics', 'DiagnosticLogger.h')
+
+# DIAG_LOG(level, tag, "format", ...), DIAG_LOG_RATE(level, tag, rate, burst, "format", ...)
+# or DIAG_<LEVEL>(tag, "format", ...); adjacent literals concatenate
+LOG_SITE = re.compile(
+    r'\bDIAG_(?:LOG\s*\(\s*\w+\s*,|LOG_RATE\s*\(\s*\w+\s*,\s*\w+\s*,\s*\w+\s*,'
+    r'|(?:CRITICAL|ERROR|WARNING|INFO|DEBUG|TRACE)\s*\()'
+    r'\s*\w+\s*,\s*((?:"(?:[^"\\\n]|\\.)*"\s*)+)')
+LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+CONVERSION = re.compile(r'%([-+ #0]*)(\d+)?(?:\.(\d+))?(hh|h|ll|l|z|j|t|L)?([diouxXeEfFgGcsp%])')
+
+ESCAPES = {'n': '\n', 't': '\t', 'r': '\r', '0': '\0', '\\': '\\', '"': '"', "'": "'", '?': '?', 'a': '\a'}
+
+
+class TraceError(Exception):
+    pass
+
+
+def fnv1a(data):
+    """Same hash as TraceBuffer::hash()."""
+    value = 2166136261
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def unescape(literal):
+    """Bytes of a C string literal body."""
+    out = []
+    i = 0
+    while i < len(literal):
+        c = literal[i]
+        if c != '\\':
+            out.append(c)
+            i += 1
+            continue
+        nxt = literal[i + 1]
+        if nxt == 'x':
+            match = re.match(r'[0-9a-fA-F]+', literal[i + 2:])
+            out.append(chr(int(match.group(0), 16)))
+            i += 2 + len(match.group(0))
+        elif nxt in '01234567':
+            match = re.match(r'[0-7]{1,3}', literal[i + 1:])
+            out.append(chr(int(match.group(0), 8)))
+            i += 1 + len(match.group(0))
+        else:
+            out.append(ESCAPES.get(nxt, nxt))
+            i += 2
+    return ''.join(out)
+
+
+def escape(text):
+    """C string literal body for text."""
+    out = []
+    for c in text:
+        if c == '\\' or c == '"':
+            out.append('\\' + c)
+        elif c == '\n':
+            out.append('\\n')
+        elif c == '\t':
+            out.append('\\t')
+        elif ord(c) < 0x20 or ord(c) > 0x7E:
+            out.append(f'\\{ord(c):03o}')
+        else:
+            out.append(c)
+    return ''.join(out)
+
+
+def scan(roots):
+    """Map of id -> format string for every log site under roots."""
+    table = {}
+    for root in roots:
+        for dirpath, _, files in os.walk(root):
+            for name in sorted(files):
+                if not name.endswith(('.cpp', '.h')):
+                    continue
+                path = os.path.join(dirpath, name)
+                with open(path, 'r', encoding='utf-8', errors='replace') as f:
+                    text = f.read()
+                for match in LOG_SITE.finditer(text):
+                    fmt = ''.join(unescape(lit) for lit in LITERAL.findall(match.group(1)))
+                    ident = fnv1a(fmt.encode('latin-1'))
+                    if ident in table and table[ident] != fmt:
+                        raise TraceError(f"{path}: '{fmt}' and '{table[ident]}' share id 0x{ident:08X}")
+                    table[ident] = fmt
+    return table
+
+
+def to_header(table):
+    lines = [
+        '#ifndef TRACE_STRINGS_H',
+        '#define TRACE_STRINGS_H',
+        '',
+        '#include <stdint.h>',
+        '',
+        '/**',
+        ' * @brief Format strings of the diagnostic log sites, by trace ID',
+        ' *',
+        ' * GENERATED by utils/trace_tool.py - do not edit by hand.',
+        ' * Sorted by ID for binary search.',
+        ' */',
+        'struct TraceString {',
+        '  uint32_t id;',
+        '  const char* format;',
+        '};',
+        '',
+        'const TraceString TRACE_STRINGS[] = {',
+    ]
+    for ident in sorted(table):
+        lines.append(f'  {{0x{ident:08X}, "{escape(table[ident])}"}},')
+    lines.append('};')
+    lines.append('constexpr uint16_t TRACE_STRING_COUNT = sizeof(TRACE_STRINGS) / sizeof(TRACE_STRINGS[0]);')
+    lines.append('')
+    lines.append('#endif // TRACE_STRINGS_H')
+    return '\n'.join(lines) + '\n'
+
+
+def names(prefix):
+    """Value -> name for the #defines or enumerators with prefix in DiagnosticLogger.h."""
+    with open(LOGGER_HEADER, 'r') as f:
+        text = f.read()
+    pattern = re.compile(r'\b' + prefix + r'(\w+)\s*(?:=\s*)?(0x[0-9A-Fa-f]+|\d+)')
+    return {int(value, 0): name for name, value in pattern.findall(text)}
+
+
+def format_entry(fmt, args):
+    """printf-style formatting of raw 32-bit argument words."""
+    out = []
+    pos = 0
+    index = 0
+    for match in CONVERSION.finditer(fmt):
+        out.append(fmt[pos:match.start()])
+        pos = match.end()
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+        word = args[index] if index < len(args) else 0
+        index += 1
+        spec = '%' + flags + (width or '') + ('.' + precision if precision else '')
+        if conv in 'di':
+            out.append((spec + 'd') % struct.unpack('<i', struct.pack('<I', word))[0])
+        elif conv == 'u':
+            out.append((spec + 'd') % word)
+        elif conv in 'oxX':
+            out.append((spec + conv) % word)
+        elif conv in 'eEfFgG':
+            out.append((spec + conv) % struct.unpack('<f', struct.pack('<I', word))[0])
+        elif conv == 'c':
+            out.append((spec + 'c') % chr(word & 0xFF))
+        elif conv == 's':
+            out.append((spec + 's') % f'<str@0x{word:08x}>')
+        else:
+            out.append(f'0x{word:08x}')
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def decode(data, table):
+    """Formatted lines for a binary dump."""
+    if data[:4] != DUMP_MAGIC:
+        raise TraceError('not a trace dump (bad magic)')
+    version, count, dropped = struct.unpack_from('<HHI', data, 4)
+    if version != DUMP_VERSION:
+        raise TraceError(f'unsupported dump version {version}')
+    # Short names as DiagnosticLogger::getLevelName() prints them
+    levels = {k: {'CRITICAL': 'CRIT', 'WARNING': 'WARN'}.get(v, v) for k, v in names('DIAG_LEVEL_').items()}
+    tags = {k: v for k, v in names('DIAG_TAG_').items() if v not in ('COUNT', 'ALL')}
+
+    lines = []
+    offset = 12
+    for _ in range(count):
+        if offset + 12 > len(data):
+            raise TraceError('dump truncated')
+        timestamp, ident, level, tag, argc, _ = struct.unpack_from('<IIBBBB', data, offset)
+        offset += 12
+        args = list(struct.unpack_from(f'<{argc}I', data, offset))
+        offset += 4 * argc
+        fmt = table.get(ident)
+        message = format_entry(fmt, args) if fmt is not None else \
+            f'<unknown id 0x{ident:08X}> ' + ' '.join(f'0x{a:08x}' for a in args)
+        lines.append(f'{timestamp:10d} [{levels.get(level, "?")}:{tags.get(tag, "UNKNOWN")}] {message}')
+    if dropped:
+        lines.append(f'({dropped} entries dropped on the device)')
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Trace string table generator and decoder')
+    sub = parser.add_subparsers(dest='command', required=True)
+
+    table_cmd = sub.add_parser('table', help='write the string table header')
+    table_cmd.add_argument('-o', '--output', required=True, help='C++ header to write')
+    table_cmd.add_argument('--src', nargs='+', default=[DEFAULT_SOURCES], help='source directories to scan')
+    table_cmd.add_argument('--check', action='store_true', help='fail if the header is out of date')
+
+    decode_cmd = sub.add_parser('decode', help='format a binary trace dump')
+    decode_cmd.add_argument('dump', help='file captured from the trace dump command')
+    decode_cmd.add_argument('--src', nargs='+', default=[DEFAULT_SOURCES], help='source directories to scan')
+
+    args = parser.parse_args()
+    try:
+        table = scan(args.src)
+        if args.command == 'table':
+            header = to_header(table)
+            if args.check:
+                with open(args.output, 'r') as f:
+                    if f.read() != header:
+                        print(f"{args.output} is out of date; run utils/trace_tool.py table", file=sys.stderr)
+                        return 1
+                print(f"{args.output}: {len(table)} strings, up to date")
+                return 0
+            with open(args.output, 'w', newline='\n') as f:
+                f.write(header)
+            print(f"Wrote {args.output} ({len(table)} strings)")
+        else:
+            with open(args.dump, 'rb') as f:
+                data = f.read()
+            for line in decode(data, table):
+                print(line)
+    except TraceError as e:
+        print(f"error: {e}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())